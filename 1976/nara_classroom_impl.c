@@ -7,18 +7,7 @@
 
 #include "nara_classroom.h"
 
-int
-__nara_record_is_type_classroom(
-    nara_record_t*      theRecord,
-    size_t              byteSize
-)
-{
-    return 0;
-}
-
-/**/
-
-nara_record_t*
+static nara_record_t*
 __nara_record_process_classroom(
     nara_record_t*      theRecord
 )
@@ -28,7 +17,7 @@ __nara_record_process_classroom(
 
 /**/
 
-void
+static void
 __nara_export_init_classroom(
     nara_export_context_t   exportContext
 )
@@ -37,7 +26,7 @@ __nara_export_init_classroom(
 
 /**/
 
-void
+static void
 __nara_export_destroy_classroom(
     nara_export_context_t   exportContext
 )
@@ -46,7 +35,7 @@ __nara_export_destroy_classroom(
 
 /**/
 
-void
+static void
 __nara_record_export_classroom(
     nara_export_context_t   exportContext,
     nara_record_t           *theRecord
@@ -56,11 +45,10 @@ __nara_record_export_classroom(
 
 /**/
 
-nara_record_t*
-__nara_record_destroy_classroom(
-    nara_record_t       *theRecord
+static void
+__nara_record_columns_classroom(
+    nara_record_columns_t   columns
 )
 {
-    return NULL;
 }
     
\ No newline at end of file
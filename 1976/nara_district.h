@@ -22,17 +22,12 @@ enum {
     nara_ethnicity_max
 };
 
-extern const char* nara_ethnicity_labels[nara_ethnicity_max];
-
 enum {
     nara_gender_male = 0,
     nara_gender_female,
     nara_gender_max
 };
 
-extern const char* nara_gender_labels[nara_gender_max];
-
-
 typedef struct {
     uint32_t        systemOECode;
     uint32_t        recordType;
@@ -7,7 +7,7 @@
 
 #include "nara_district.h"
 
-const char* nara_ethnicity_labels[nara_ethnicity_max] = {
+static const char* nara_ethnicity_labels[nara_ethnicity_max] = {
                 "American or Alaskan Indian",
                 "Asian or Pacific",
                 "Black (not Hispanic)",
@@ -16,7 +16,7 @@ const char* nara_ethnicity_labels[nara_ethnicity_max] = {
                 "Total"
             };
 
-const char* nara_gender_labels[nara_gender_max] = {
+static const char* nara_gender_labels[nara_gender_max] = {
                 "Male",
                 "Female"
             };
@@ -42,18 +42,7 @@ typedef union {
 
 /**/
 
-int
-__nara_record_is_type_district(
-    nara_record_t*      theRecord,
-    size_t              byteSize
-)
-{
-    return ( (byteSize == NARA_1976_RECORD_SIZE) && (nara_be_to_host_32(theRecord->recordType) == nara_record_type_district) );
-}
-
-/**/
-
-nara_record_t*
+static nara_record_t*
 __nara_record_process_district(
     nara_record_t*      theRecord
 )
@@ -63,18 +52,13 @@ __nara_record_process_district(
     char                        *fromPtr, *toPtr;
     size_t                      fromLen, toLen;
     
-    unsigned int                i, iMax;
+    nara_be_to_host_u32_array(district->compact.f1, sizeof(district->compact.f1) / sizeof(uint32_t));
     
-    iMax = sizeof(district->compact.f1) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) district->compact.f1[i] = nara_be_to_host_32(district->compact.f1[i]);
+    nara_be_to_host_u32_array(district->compact.f2, sizeof(district->compact.f2) / sizeof(uint32_t));
     
-    iMax = sizeof(district->compact.f2) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) district->compact.f2[i] = nara_be_to_host_32(district->compact.f2[i]);
+    district->compact.f3 = nara_be_to_host_f32(district->compact.f3);
     
-    district->compact.f3 = nara_be_to_host_float(district->compact.f3);
-    
-    iMax = sizeof(district->compact.f4) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) district->compact.f4[i] = nara_be_to_host_32(district->compact.f4[i]);
+    nara_be_to_host_u32_array(district->compact.f4, sizeof(district->compact.f4) / sizeof(uint32_t));
     
     TRANSCODE(district, systemName, "district name");
     TRANSCODE(district, systemCounty, "district county");
@@ -86,7 +70,7 @@ __nara_record_process_district(
 
 /**/
 
-void
+static void
 __nara_export_init_district(
     nara_export_context_t   exportContext
 )
@@ -106,8 +90,8 @@ __nara_export_init_district(
             /*
              * Write column headers to the file:
              */
-            if ( CONTEXT->districtFptr ) {
-                fprintf(CONTEXT->districtFptr,
+            if ( CONTEXT->districtOut ) {
+                EMIT_LITERAL(CONTEXT->districtOut,
                         "systemOECode,"
                         "selectionCode,"
                         "systemName,"
@@ -137,43 +121,49 @@ __nara_export_init_district(
                         "isESAADistrict,"
                         "samplingWeight,"
                     );
-                    
+                
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->districtFptr, "\"pupils_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->districtOut, "\"pupils_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->districtOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
                 
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->districtFptr, "\"pupilsEnrolledVocationEd_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->districtOut, "\"pupilsEnrolledVocationEd_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->districtOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
                 
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->districtFptr, "\"pupilsSuspendedAtLeastOneDay_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
-    
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->districtOut, "\"pupilsSuspendedAtLeastOneDay_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->districtOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsSuspendedAtLeastOneDayTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsSuspendedAtLeastOneDayTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsPrimaryLangNotEnglishTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsPrimaryLangNotEnglishTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsSpecialEdTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsSpecialEdTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsSpecialEdForGiftedOrTalentedTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsSpecialEdForGiftedOrTalentedTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal_%s\",", nara_ethnicity_labels[i]);
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal_", nara_ethnicity_labels[i], "\",");
                 
                 for ( i = 1; i <= 42; i++ )
-                    fprintf(CONTEXT->districtFptr, "errorBitArray_%d,", i);
-                fprintf(CONTEXT->districtFptr, "errorBitArray_%d\n", i);
+                    EMIT_U32(CONTEXT->districtOut, "errorBitArray_", i, ",");
+                EMIT_U32(CONTEXT->districtOut, "errorBitArray_", i, "\n");
             }
             break;
         }
@@ -182,7 +172,7 @@ __nara_export_init_district(
 
 /**/
 
-void
+static void
 __nara_export_destroy_district(
     nara_export_context_t   exportContext
 )
@@ -191,7 +181,7 @@ __nara_export_destroy_district(
 
 /**/
 
-void
+static void
 __nara_record_export_district(
     nara_export_context_t   exportContext,
     nara_record_t           *theRecord
@@ -216,119 +206,109 @@ __nara_record_export_district(
         case nara_export_format_yaml: {
             nara_export_context_yaml_t  *CONTEXT = (nara_export_context_yaml_t*)exportContext;
             
-            if ( CONTEXT->fptr ) {
-                fprintf(CONTEXT->fptr,
-                        "- recordType: district\n"
-                        "  systemOECode: %u\n"
-                        "  selectionCode: %u\n"
-                        "  systemName: %s\n"
-                        "  systemCounty: %s\n"
-                        "  systemCity: %s\n"
-                        "  systemZipCode: %s\n"
-                        "  numSchoolsInSchoolSystem: %u\n"
-                        "  isInConsolidation: %u\n"
-                        "  isInUnification: %u\n"
-                        "  isInDivision: %u\n"
-                        "  isInAnnexation: %u\n"
-                        "  isNotInAnyStateOfChange: %u\n"
-                        "  isUnderCourtOrderToDesegregate: %u\n"
-                        "  doGenderGradRequirementsDiffer: %u\n"
-                        "  numSchoolsWith5OrMoreVocationEdPrograms: %u\n"
-                        "  residentSchoolAgeChildrenIdentifiedRequiringSpecialEd: %u\n"
-                        "  residentPupilsInSpecialEdOperatedWithOtherSchoolSystems: %u\n"
-                        "  residentPupilsInSpecialEdOperatedExclOtherSchoolSystem: %u\n"
-                        "  residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem: %u\n"
-                        "  nonResidentPupilsInSpecialEd: %u\n"
-                        "  residentSchoolAgeChildrenOutOfSchoolHandicappingCondition: %u\n"
-                        "  residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction: %u\n"
-                        "  residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds: %u\n"
-                        "  fullTimeTeachersAssignedToSpecialEd: %u\n"
-                        "  partTimeTeachersAssignedToSpecialEd: %u\n"
-                        "  hasOtherReportingDates: %u\n"
-                        "  isESAADistrict: %u\n"
-                        "  samplingWeight: %g\n",
-                        district->systemOECode,
-                        district->selectionCode,
-                        systemName,
-                        systemCounty,
-                        systemCity,
-                        systemZipCode,
-                        district->numSchoolsInSchoolSystem,
-                        district->isInConsolidation,
-                        district->isInUnification,
-                        district->isInDivision,
-                        district->isInAnnexation,
-                        district->isNotInAnyStateOfChange,
-                        district->isUnderCourtOrderToDesegregate,
-                        district->doGenderGradRequirementsDiffer,
-                        district->numSchoolsWith5OrMoreVocationEdPrograms,
-                        district->residentSchoolAgeChildrenIdentifiedRequiringSpecialEd,
-                        district->residentPupilsInSpecialEdOperatedWithOtherSchoolSystems,
-                        district->residentPupilsInSpecialEdOperatedExclOtherSchoolSystem,
-                        district->residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem,
-                        district->nonResidentPupilsInSpecialEd,
-                        district->residentSchoolAgeChildrenOutOfSchoolHandicappingCondition,
-                        district->residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction,
-                        district->residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds,
-                        district->fullTimeTeachersAssignedToSpecialEd,
-                        district->partTimeTeachersAssignedToSpecialEd,
-                        district->hasOtherReportingDates,
-                        district->isESAADistrict,
-                        district->samplingWeight
-                    );
-
-                fprintf(CONTEXT->fptr, "  pupils:\n");
+            if ( CONTEXT->out ) {
+                EMIT_LITERAL(CONTEXT->out, "- recordType: district\n");
+                EMIT_U32(CONTEXT->out, "  systemOECode: ", district->systemOECode, "\n");
+                EMIT_U32(CONTEXT->out, "  selectionCode: ", district->selectionCode, "\n");
+                EMIT_STR(CONTEXT->out, "  systemName: ", systemName, "\n");
+                EMIT_STR(CONTEXT->out, "  systemCounty: ", systemCounty, "\n");
+                EMIT_STR(CONTEXT->out, "  systemCity: ", systemCity, "\n");
+                EMIT_STR(CONTEXT->out, "  systemZipCode: ", systemZipCode, "\n");
+                EMIT_U32(CONTEXT->out, "  numSchoolsInSchoolSystem: ", district->numSchoolsInSchoolSystem, "\n");
+                EMIT_U32(CONTEXT->out, "  isInConsolidation: ", district->isInConsolidation, "\n");
+                EMIT_U32(CONTEXT->out, "  isInUnification: ", district->isInUnification, "\n");
+                EMIT_U32(CONTEXT->out, "  isInDivision: ", district->isInDivision, "\n");
+                EMIT_U32(CONTEXT->out, "  isInAnnexation: ", district->isInAnnexation, "\n");
+                EMIT_U32(CONTEXT->out, "  isNotInAnyStateOfChange: ", district->isNotInAnyStateOfChange, "\n");
+                EMIT_U32(CONTEXT->out, "  isUnderCourtOrderToDesegregate: ", district->isUnderCourtOrderToDesegregate, "\n");
+                EMIT_U32(CONTEXT->out, "  doGenderGradRequirementsDiffer: ", district->doGenderGradRequirementsDiffer, "\n");
+                EMIT_U32(CONTEXT->out, "  numSchoolsWith5OrMoreVocationEdPrograms: ", district->numSchoolsWith5OrMoreVocationEdPrograms, "\n");
+                EMIT_U32(CONTEXT->out, "  residentSchoolAgeChildrenIdentifiedRequiringSpecialEd: ", district->residentSchoolAgeChildrenIdentifiedRequiringSpecialEd, "\n");
+                EMIT_U32(CONTEXT->out, "  residentPupilsInSpecialEdOperatedWithOtherSchoolSystems: ", district->residentPupilsInSpecialEdOperatedWithOtherSchoolSystems, "\n");
+                EMIT_U32(CONTEXT->out, "  residentPupilsInSpecialEdOperatedExclOtherSchoolSystem: ", district->residentPupilsInSpecialEdOperatedExclOtherSchoolSystem, "\n");
+                EMIT_U32(CONTEXT->out, "  residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem: ", district->residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem, "\n");
+                EMIT_U32(CONTEXT->out, "  nonResidentPupilsInSpecialEd: ", district->nonResidentPupilsInSpecialEd, "\n");
+                EMIT_U32(CONTEXT->out, "  residentSchoolAgeChildrenOutOfSchoolHandicappingCondition: ", district->residentSchoolAgeChildrenOutOfSchoolHandicappingCondition, "\n");
+                EMIT_U32(CONTEXT->out, "  residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction: ", district->residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction, "\n");
+                EMIT_U32(CONTEXT->out, "  residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds: ", district->residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds, "\n");
+                EMIT_U32(CONTEXT->out, "  fullTimeTeachersAssignedToSpecialEd: ", district->fullTimeTeachersAssignedToSpecialEd, "\n");
+                EMIT_U32(CONTEXT->out, "  partTimeTeachersAssignedToSpecialEd: ", district->partTimeTeachersAssignedToSpecialEd, "\n");
+                EMIT_U32(CONTEXT->out, "  hasOtherReportingDates: ", district->hasOtherReportingDates, "\n");
+                EMIT_U32(CONTEXT->out, "  isESAADistrict: ", district->isESAADistrict, "\n");
+                EMIT_FLOAT(CONTEXT->out, "  samplingWeight: ", district->samplingWeight, "\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupils:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n",  nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], district->pupils[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", district->pupils[j][i], "\n");
+                    }
                 }
                 
-                fprintf(CONTEXT->fptr, "  pupilsEnrolledVocationEd:\n");
+                EMIT_LITERAL(CONTEXT->out, "  pupilsEnrolledVocationEd:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n",  nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsEnrolledVocationEd[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", district->pupilsEnrolledVocationEd[j][i], "\n");
+                    }
                 }
                 
-                fprintf(CONTEXT->fptr, "  pupilsSuspendedAtLeastOneDay:\n");
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSuspendedAtLeastOneDay:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n",  nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsSuspendedAtLeastOneDay[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", district->pupilsSuspendedAtLeastOneDay[j][i], "\n");
+                    }
                 }
                 
-                fprintf(CONTEXT->fptr, "  pupilsSuspendedAtLeastOneDayTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsSuspendedAtLeastOneDayTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsPrimaryLangNotEnglishTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsPrimaryLangNotEnglishTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsSpecialEdTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsSpecialEdTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsSpecialEdForGiftedOrTalentedTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsSpecialEdForGiftedOrTalentedTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  errorBitArray:\n");
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSuspendedAtLeastOneDayTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsSuspendedAtLeastOneDayTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsPrimaryLangNotEnglishTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsPrimaryLangNotEnglishTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSpecialEdTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsSpecialEdTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSpecialEdForGiftedOrTalentedTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsSpecialEdForGiftedOrTalentedTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  errorBitArray:\n");
                 for ( i = 0; i < 43; i++ )
-                    fprintf(CONTEXT->fptr, "    - %u\n", district->errorBitArray[i]);
+                    EMIT_U32(CONTEXT->out, "    - ", district->errorBitArray[i], "\n");
             }            
             break;
         }
@@ -336,102 +316,72 @@ __nara_record_export_district(
         case nara_export_format_csv: {
             nara_export_context_csv_t   *CONTEXT = (nara_export_context_csv_t*)exportContext;
             
-            if ( CONTEXT->districtFptr ) {
-                fprintf(CONTEXT->districtFptr,
-                        "%u,"
-                        "%u,"
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%g,",
-                        district->systemOECode,
-                        district->selectionCode,
-                        systemName,
-                        systemCounty,
-                        systemCity,
-                        systemZipCode,
-                        district->numSchoolsInSchoolSystem,
-                        district->isInConsolidation,
-                        district->isInUnification,
-                        district->isInDivision,
-                        district->isInAnnexation,
-                        district->isNotInAnyStateOfChange,
-                        district->isUnderCourtOrderToDesegregate,
-                        district->doGenderGradRequirementsDiffer,
-                        district->numSchoolsWith5OrMoreVocationEdPrograms,
-                        district->residentSchoolAgeChildrenIdentifiedRequiringSpecialEd,
-                        district->residentPupilsInSpecialEdOperatedWithOtherSchoolSystems,
-                        district->residentPupilsInSpecialEdOperatedExclOtherSchoolSystem,
-                        district->residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem,
-                        district->nonResidentPupilsInSpecialEd,
-                        district->residentSchoolAgeChildrenOutOfSchoolHandicappingCondition,
-                        district->residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction,
-                        district->residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds,
-                        district->fullTimeTeachersAssignedToSpecialEd,
-                        district->partTimeTeachersAssignedToSpecialEd,
-                        district->hasOtherReportingDates,
-                        district->isESAADistrict,
-                        district->samplingWeight
-                    );
-
+            if ( CONTEXT->districtOut ) {
+                EMIT_U32(CONTEXT->districtOut, "", district->systemOECode, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->selectionCode, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemName, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemCounty, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemCity, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemZipCode, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->numSchoolsInSchoolSystem, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isInConsolidation, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isInUnification, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isInDivision, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isInAnnexation, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isNotInAnyStateOfChange, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isUnderCourtOrderToDesegregate, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->doGenderGradRequirementsDiffer, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->numSchoolsWith5OrMoreVocationEdPrograms, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->residentSchoolAgeChildrenIdentifiedRequiringSpecialEd, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->residentPupilsInSpecialEdOperatedWithOtherSchoolSystems, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->residentPupilsInSpecialEdOperatedExclOtherSchoolSystem, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->nonResidentPupilsInSpecialEd, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->residentSchoolAgeChildrenOutOfSchoolHandicappingCondition, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->fullTimeTeachersAssignedToSpecialEd, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->partTimeTeachersAssignedToSpecialEd, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->hasOtherReportingDates, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isESAADistrict, ",");
+                EMIT_FLOAT(CONTEXT->districtOut, "", district->samplingWeight, ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->districtFptr, "%u,", district->pupils[j][i]);
-
+                        EMIT_U32(CONTEXT->districtOut, "", district->pupils[j][i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->districtFptr, "%u,", district->pupilsEnrolledVocationEd[j][i]);
-
+                        EMIT_U32(CONTEXT->districtOut, "", district->pupilsEnrolledVocationEd[j][i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->districtFptr, "%u,", district->pupilsSuspendedAtLeastOneDay[j][i]);
-
+                        EMIT_U32(CONTEXT->districtOut, "", district->pupilsSuspendedAtLeastOneDay[j][i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsSuspendedAtLeastOneDayTotal[i]);
-
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsSuspendedAtLeastOneDayTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsPrimaryLangNotEnglishTotal[i]);
-
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsPrimaryLangNotEnglishTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i]);
-
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsSpecialEdTotal[i]);
-
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsSpecialEdTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal[i]);
-
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsSpecialEdForGiftedOrTalentedTotal[i]);
-
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsSpecialEdForGiftedOrTalentedTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal[i]);
-
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal[i], ",");
+                
                 for ( i = 0; i < 42; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->errorBitArray[i]);
-                fprintf(CONTEXT->districtFptr, "%u\n", district->errorBitArray[i]);
+                    EMIT_U32(CONTEXT->districtOut, "", district->errorBitArray[i], ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->errorBitArray[i], "\n");
             }
             break;
         }
@@ -441,12 +391,65 @@ __nara_record_export_district(
 
 /**/
 
-nara_record_t*
-__nara_record_destroy_district(
-    nara_record_t       *theRecord
+static void
+__nara_record_columns_district(
+    nara_record_columns_t   columns
 )
 {
-    free((void*)theRecord);
-    return NULL;
+    unsigned int            i, j;
+    
+    COLUMN_U32(columns, nara_district_t, systemOECode, "systemOECode");
+    COLUMN_U32(columns, nara_district_t, selectionCode, "selectionCode");
+    COLUMN_STR(columns, nara_district_t, systemName, "systemName");
+    COLUMN_STR(columns, nara_district_t, systemCounty, "systemCounty");
+    COLUMN_STR(columns, nara_district_t, systemCity, "systemCity");
+    COLUMN_STR(columns, nara_district_t, systemZipCode, "systemZipCode");
+    COLUMN_U32(columns, nara_district_t, numSchoolsInSchoolSystem, "numSchoolsInSchoolSystem");
+    COLUMN_U32(columns, nara_district_t, isInConsolidation, "isInConsolidation");
+    COLUMN_U32(columns, nara_district_t, isInUnification, "isInUnification");
+    COLUMN_U32(columns, nara_district_t, isInDivision, "isInDivision");
+    COLUMN_U32(columns, nara_district_t, isInAnnexation, "isInAnnexation");
+    COLUMN_U32(columns, nara_district_t, isNotInAnyStateOfChange, "isNotInAnyStateOfChange");
+    COLUMN_U32(columns, nara_district_t, isUnderCourtOrderToDesegregate, "isUnderCourtOrderToDesegregate");
+    COLUMN_U32(columns, nara_district_t, doGenderGradRequirementsDiffer, "doGenderGradRequirementsDiffer");
+    COLUMN_U32(columns, nara_district_t, numSchoolsWith5OrMoreVocationEdPrograms, "numSchoolsWith5OrMoreVocationEdPrograms");
+    COLUMN_U32(columns, nara_district_t, residentSchoolAgeChildrenIdentifiedRequiringSpecialEd, "residentSchoolAgeChildrenIdentifiedRequiringSpecialEd");
+    COLUMN_U32(columns, nara_district_t, residentPupilsInSpecialEdOperatedWithOtherSchoolSystems, "residentPupilsInSpecialEdOperatedWithOtherSchoolSystems");
+    COLUMN_U32(columns, nara_district_t, residentPupilsInSpecialEdOperatedExclOtherSchoolSystem, "residentPupilsInSpecialEdOperatedExclOtherSchoolSystem");
+    COLUMN_U32(columns, nara_district_t, residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem, "residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem");
+    COLUMN_U32(columns, nara_district_t, nonResidentPupilsInSpecialEd, "nonResidentPupilsInSpecialEd");
+    COLUMN_U32(columns, nara_district_t, residentSchoolAgeChildrenOutOfSchoolHandicappingCondition, "residentSchoolAgeChildrenOutOfSchoolHandicappingCondition");
+    COLUMN_U32(columns, nara_district_t, residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction, "residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction");
+    COLUMN_U32(columns, nara_district_t, residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds, "residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds");
+    COLUMN_U32(columns, nara_district_t, fullTimeTeachersAssignedToSpecialEd, "fullTimeTeachersAssignedToSpecialEd");
+    COLUMN_U32(columns, nara_district_t, partTimeTeachersAssignedToSpecialEd, "partTimeTeachersAssignedToSpecialEd");
+    COLUMN_U32(columns, nara_district_t, hasOtherReportingDates, "hasOtherReportingDates");
+    COLUMN_U32(columns, nara_district_t, isESAADistrict, "isESAADistrict");
+    COLUMN_FLOAT(columns, nara_district_t, samplingWeight, "samplingWeight");
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_district_t, pupils[j][i], "\"pupils_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_district_t, pupilsEnrolledVocationEd[j][i], "\"pupilsEnrolledVocationEd_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_district_t, pupilsSuspendedAtLeastOneDay[j][i], "\"pupilsSuspendedAtLeastOneDay_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsSuspendedAtLeastOneDayTotal[i], "\"pupilsSuspendedAtLeastOneDayTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsPrimaryLangNotEnglishTotal[i], "\"pupilsPrimaryLangNotEnglishTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i], "\"pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsSpecialEdTotal[i], "\"pupilsSpecialEdTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal[i], "\"pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsSpecialEdForGiftedOrTalentedTotal[i], "\"pupilsSpecialEdForGiftedOrTalentedTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal[i], "\"pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < 43; i++ )
+        COLUMN_U32(columns, nara_district_t, errorBitArray[i], "errorBitArray_%u", i + 1);
 }
     
\ No newline at end of file
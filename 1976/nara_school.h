@@ -31,8 +31,6 @@ enum {
     nara_grade_max
 };
 
-extern const char* nara_grade_labels[nara_grade_max];
-
 enum {
     nara_suspension_1_to_3_days = 0,
     nara_suspension_4_to_10_days,
@@ -40,8 +38,6 @@ enum {
     nara_suspension_max
 };
 
-extern const char* nara_suspension_labels[nara_suspension_max];
-
 enum {
     nara_special_ed_educable_mentally_retarded = 0,
     nara_special_ed_trainable_metally_retarded,
@@ -66,16 +62,12 @@ typedef struct {
     uint32_t        fullTime;
 } nara_special_ed_subtype_t;
 
-extern const char* nara_special_ed_labels[nara_special_ed_max];
-
 enum {
     nara_empl_status_full_time = 0,
     nara_empl_status_part_time,
     nara_empl_status_max
 };
 
-extern const char* nara_empl_status_labels[nara_empl_status_max];
-
 enum {
     nara_assignment_class_first = 0,
     nara_assignment_class_middle,
@@ -83,8 +75,6 @@ enum {
     nara_assignment_class_max
 };
 
-extern const char* nara_assignment_class_labels[nara_assignment_class_max];
-
 typedef struct {
     uint32_t        gradeOrAge;
     uint32_t        subjectCode;
@@ -7,7 +7,7 @@
 
 #include "nara_school.h"
 
-const char* nara_grade_labels[nara_grade_max] = {
+static const char* nara_grade_labels[nara_grade_max] = {
             "Ungraded",
             "Pre-K",
             "Kindergarten",
@@ -25,13 +25,13 @@ const char* nara_grade_labels[nara_grade_max] = {
             "12th"
         };
 
-const char* nara_suspension_labels[nara_suspension_max] = {
+static const char* nara_suspension_labels[nara_suspension_max] = {
             "1 to 3 days",
             "4 to 10 days",
             "11 or more days"
         };
 
-const char* nara_special_ed_labels[nara_special_ed_max] = {
+static const char* nara_special_ed_labels[nara_special_ed_max] = {
             "Educable Mentally Retarded",
             "Trainable Mentally Retarded",
             "Serious Emotional Disturbance",
@@ -46,12 +46,12 @@ const char* nara_special_ed_labels[nara_special_ed_max] = {
             "Gifted or Talented"
         };
 
-const char* nara_empl_status_labels[nara_empl_status_max] = {
+static const char* nara_empl_status_labels[nara_empl_status_max] = {
             "Full Time",
             "Part Time"
         };
 
-const char* nara_assignment_class_labels[nara_assignment_class_max] = {
+static const char* nara_assignment_class_labels[nara_assignment_class_max] = {
             "First",
             "Middle",
             "Last"
@@ -83,18 +83,7 @@ typedef union {
 
 /**/
 
-int
-__nara_record_is_type_school(
-    nara_record_t*      theRecord,
-    size_t              byteSize
-)
-{
-    return ( (byteSize == NARA_1976_RECORD_SIZE) && (nara_be_to_host_32(theRecord->recordType) == nara_record_type_school) );
-}
-
-/**/
-
-nara_record_t*
+static nara_record_t*
 __nara_record_process_school(
     nara_record_t*      theRecord
 )
@@ -104,21 +93,15 @@ __nara_record_process_school(
     char                        *fromPtr, *toPtr;
     size_t                      fromLen, toLen;
     
-    unsigned int                i, iMax;
+    nara_be_to_host_u32_array(school->compact.f1, sizeof(school->compact.f1) / sizeof(uint32_t));
     
-    iMax = sizeof(school->compact.f1) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) school->compact.f1[i] = nara_be_to_host_32(school->compact.f1[i]);
+    nara_be_to_host_u32_array(school->compact.f2, sizeof(school->compact.f2) / sizeof(uint32_t));
     
-    iMax = sizeof(school->compact.f2) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) school->compact.f2[i] = nara_be_to_host_32(school->compact.f2[i]);
+    school->compact.f3 = nara_be_to_host_f32(school->compact.f3);
     
-    school->compact.f3 = nara_be_to_host_float(school->compact.f3);
+    nara_be_to_host_u32_array(school->compact.f4, sizeof(school->compact.f4) / sizeof(uint32_t));
     
-    iMax = sizeof(school->compact.f4) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) school->compact.f4[i] = nara_be_to_host_32(school->compact.f4[i]);
-    
-    iMax = sizeof(school->compact.f5) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) school->compact.f5[i] = nara_be_to_host_32(school->compact.f5[i]);
+    nara_be_to_host_u32_array(school->compact.f5, sizeof(school->compact.f5) / sizeof(uint32_t));
     
     TRANSCODE(school, systemName, "district name");
     TRANSCODE(school, systemCounty, "district county");
@@ -131,7 +114,7 @@ __nara_record_process_school(
 
 /**/
 
-void
+static void
 __nara_export_init_school(
     nara_export_context_t   exportContext
 )
@@ -151,8 +134,8 @@ __nara_export_init_school(
             /*
              * Write column headers to the file:
              */
-            if ( CONTEXT->schoolFptr ) {
-                fprintf(CONTEXT->schoolFptr,
+            if ( CONTEXT->schoolOut ) {
+                EMIT_LITERAL(CONTEXT->schoolOut,
                         "systemOECode,"
                         "selectionCode,"
                         "systemName,"
@@ -182,41 +165,47 @@ __nara_export_init_school(
                         "isESAADistrict,"
                         "samplingWeight,"
                     );
-                    
+                
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupils_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupils_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
                 
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsEnrolledVocationEd_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsEnrolledVocationEd_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
                 
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsSuspendedAtLeastOneDay_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
-    
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsSuspendedAtLeastOneDay_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsSuspendedAtLeastOneDayTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsSuspendedAtLeastOneDayTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsPrimaryLangNotEnglishTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsPrimaryLangNotEnglishTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsSpecialEdTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsSpecialEdTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsSpecialEdForGiftedOrTalentedTotal_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsSpecialEdForGiftedOrTalentedTotal_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal_%s\",", nara_ethnicity_labels[i]);
-                    
-                fprintf(CONTEXT->schoolFptr,
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal_", nara_ethnicity_labels[i], "\",");
+                
+                EMIT_LITERAL(CONTEXT->schoolOut,
                         "schoolOECode,"
                         "schoolName,"
                         "firstGradeLevelOfferedOrYoungestAgeOfPupilsForUngradedSection,"
@@ -241,129 +230,163 @@ __nara_export_init_school(
                         "numFullTimeTeachers,"
                         "selectionNumber,"
                     );
-
+                
                 for ( i = 0; i < nara_grade_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"isGradeOffered_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"isGradeOffered_", nara_grade_labels[i], "\",");
+                
                 for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupils6To9InHomeEc_%s\",", nara_gender_labels[i]);
-                    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupils6To9InHomeEc_", nara_gender_labels[i], "\",");
+                
                 for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupils6To9InIndustrialArts_%s\",", nara_gender_labels[i]);
-                    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupils6To9InIndustrialArts_", nara_gender_labels[i], "\",");
+                
                 for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupils6To9InSingleSexHomeEconOrIndustrialArts_%s\",", nara_gender_labels[i]);
-                    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupils6To9InSingleSexHomeEconOrIndustrialArts_", nara_gender_labels[i], "\",");
+                
                 for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupils7To12EnrolledInHighestLevelMath_%s\",", nara_gender_labels[i]);
-                    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupils7To12EnrolledInHighestLevelMath_", nara_gender_labels[i], "\",");
+                
                 for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupils7To12EnrolledInHighestLevelNatSci_%s\",", nara_gender_labels[i]);
-                    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupils7To12EnrolledInHighestLevelNatSci_", nara_gender_labels[i], "\",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsInMembership_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
-
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsInMembership_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsDroppedOutOrDiscontinuedSchooling_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
-
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsDroppedOutOrDiscontinuedSchooling_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsDroppedOutOrDiscontinuedSchoolingTotal_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsDroppedOutOrDiscontinuedSchoolingTotal_", nara_grade_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsRecvHighSchoolDiplomaOrEquivMale_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsRecvHighSchoolDiplomaOrEquivMale_", nara_grade_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsRecvHighSchoolDiplomaOrEquivFemale_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsRecvHighSchoolDiplomaOrEquivFemale_", nara_grade_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsRecvHighSchoolDiplomaOrEquivTotal_%s\",", nara_grade_labels[i]);
-                    
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsRecvHighSchoolDiplomaOrEquivTotal_", nara_grade_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsInSchoolPrimaryLangNotEnglishTotal_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsInSchoolPrimaryLangNotEnglishTotal_", nara_grade_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsInSchoolPrimaryLangNotEnglishInProgramsNotInEnglishTotal_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsInSchoolPrimaryLangNotEnglishInProgramsNotInEnglishTotal_", nara_grade_labels[i], "\",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsSuspendedOneTimeOnly_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
-
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsSuspendedOneTimeOnly_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsSuspendedOneTimeOnlyTotal_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsSuspendedOneTimeOnlyTotal_", nara_grade_labels[i], "\",");
+                
                 for ( j = 0; j < nara_suspension_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsSuspendedOneTimeOnlyByDayCountTotal_%s_%s\",", nara_suspension_labels[j], nara_ethnicity_labels[i]);
-
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsSuspendedOneTimeOnlyByDayCountTotal_", nara_suspension_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsSuspendedMoreThanOnce_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
-
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsSuspendedMoreThanOnce_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsSuspendedMoreThanOnceTotal_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsSuspendedMoreThanOnceTotal_", nara_grade_labels[i], "\",");
+                
                 for ( j = 0; j < nara_suspension_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsSuspendedMoreThanOnceDayCountTotal_%s_%s\",", nara_suspension_labels[j], nara_ethnicity_labels[i]);
-
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsSuspendedMoreThanOnceDayCountTotal_", nara_suspension_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsExpelled_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
-
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsExpelled_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsExpelledTotal_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsExpelledTotal_", nara_grade_labels[i], "\",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsRecvCorporalPunishAsFormalDiscipline_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
-
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsRecvCorporalPunishAsFormalDiscipline_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsRecvCorporalPunishAsFormalDisciplineTotal_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsRecvCorporalPunishAsFormalDisciplineTotal_", nara_grade_labels[i], "\",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsReferredForDisciplinaryActionToCourtOrJuvAuthor_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
-
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsReferredForDisciplinaryActionToCourtOrJuvAuthor_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsReferredForDisciplinaryActionToCourtOrJuvAuthorTotal_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsReferredForDisciplinaryActionToCourtOrJuvAuthorTotal_", nara_grade_labels[i], "\",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsReferredToAltEducProgAsFormalDiscipline_%s_%s\",", nara_gender_labels[j], nara_ethnicity_labels[i]);
-
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsReferredToAltEducProgAsFormalDiscipline_", nara_gender_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsReferredToAltEducProgAsFormalDisciplineTotal_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsReferredToAltEducProgAsFormalDisciplineTotal_", nara_grade_labels[i], "\",");
+                
                 for ( j = 0; j < nara_special_ed_max; j++ ) {
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsInSpecialEd_total_%s_%s\",", nara_special_ed_labels[j], nara_ethnicity_labels[i]);
-                    for ( i = 0; i < nara_gender_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupilsInSpecialEd_byGender_%s_%s\",", nara_special_ed_labels[j], nara_gender_labels[i]);
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsInSpecialEd_lessThan10HrsPerWeek_%s\",", nara_special_ed_labels[j]);
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsInSpecialEd_moreThan10HrsPerWeekNotFullTime_%s\",", nara_special_ed_labels[j]);
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsInSpecialEd_fullTime_%s\",", nara_special_ed_labels[j]);
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsInSpecialEd_total_", nara_special_ed_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                    for ( i = 0; i < nara_gender_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupilsInSpecialEd_byGender_", nara_special_ed_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_gender_labels[i], "\",");
+                    }
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsInSpecialEd_lessThan10HrsPerWeek_", nara_special_ed_labels[j], "\",");
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsInSpecialEd_moreThan10HrsPerWeekNotFullTime_", nara_special_ed_labels[j], "\",");
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsInSpecialEd_fullTime_", nara_special_ed_labels[j], "\",");
                 }
                 
                 for ( j = 0; j < nara_special_ed_total_of_all_impaired_subtypes; j++ )
-                    for ( i = 0; i < nara_empl_status_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"teachersAssignedToSpecialEdPrograms_%s_%s\",", nara_special_ed_labels[j], nara_empl_status_labels[i]);
-                for ( i = 0; i < nara_empl_status_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"teachersAssignedToSpecialEdPrograms_%s_%s\",", nara_special_ed_labels[nara_special_ed_gifted_or_talented], nara_empl_status_labels[i]);
+                    for ( i = 0; i < nara_empl_status_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"teachersAssignedToSpecialEdPrograms_", nara_special_ed_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_empl_status_labels[i], "\",");
+                    }
+                for ( i = 0; i < nara_empl_status_max; i++ ) {
+                    EMIT_STR(CONTEXT->schoolOut, "\"teachersAssignedToSpecialEdPrograms_", nara_special_ed_labels[nara_special_ed_gifted_or_talented], "");
+                    EMIT_STR(CONTEXT->schoolOut, "_", nara_empl_status_labels[i], "\",");
+                }
                 
                 for ( i = 0; i < nara_ethnicity_max - 1; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalented_%s\",", nara_grade_labels[i]);
-
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalented_", nara_grade_labels[i], "\",");
+                
                 idx = 1;
                 for ( m = 0; m < 2; m++ ) {
                     for ( l = 0; l < nara_assignment_class_max; l++ ) {
                         for ( k = 0; k < 3; k++ ) {
-                            fprintf(CONTEXT->schoolFptr, "\"pupilAssignments_%d_gradeOrAge_%s\",", idx, nara_assignment_class_labels[l]);
-                            fprintf(CONTEXT->schoolFptr, "\"pupilAssignments_%d_subjectCode_%s\",", idx, nara_assignment_class_labels[l]);
+                            EMIT_U32(CONTEXT->schoolOut, "\"pupilAssignments_", idx, "");
+                            EMIT_STR(CONTEXT->schoolOut, "_gradeOrAge_", nara_assignment_class_labels[l], "\",");
+                            EMIT_U32(CONTEXT->schoolOut, "\"pupilAssignments_", idx, "");
+                            EMIT_STR(CONTEXT->schoolOut, "_subjectCode_", nara_assignment_class_labels[l], "\",");
                             for ( j = 0; j < nara_gender_max; j++ )
-                                for ( i = 0; i < nara_ethnicity_max; i++ )
-                                    fprintf(CONTEXT->schoolFptr, "\"pupilAssignments_%d_gradeOrAge_pupils_%s_%s_%s\",", idx, nara_assignment_class_labels[l], nara_gender_labels[j], nara_ethnicity_labels[i]);
+                                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                                    EMIT_U32(CONTEXT->schoolOut, "\"pupilAssignments_", idx, "");
+                                    EMIT_STR(CONTEXT->schoolOut, "_gradeOrAge_pupils_", nara_assignment_class_labels[l], "");
+                                    EMIT_STR(CONTEXT->schoolOut, "_", nara_gender_labels[j], "");
+                                    EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                                }
                             idx++;
                         }
                     }
@@ -372,12 +395,14 @@ __nara_export_init_school(
                 idx = 1;
                 for ( k = 0; k < 2; k++ )
                     for ( j = 0; j < nara_assignment_class_max; j++ )
-                        for ( i = 0; i < 3; i++ )
-                            fprintf(CONTEXT->schoolFptr, "\"pupilAssignmentsEndOfSpanOrSingleEntryGradeOrAge_%d_%s\",", idx++, nara_assignment_class_labels[j]);
+                        for ( i = 0; i < 3; i++ ) {
+                            EMIT_U32(CONTEXT->schoolOut, "\"pupilAssignmentsEndOfSpanOrSingleEntryGradeOrAge_", idx++, "");
+                            EMIT_STR(CONTEXT->schoolOut, "_", nara_assignment_class_labels[j], "\",");
+                        }
                 
                 for ( i = 1; i <= 42; i++ )
-                    fprintf(CONTEXT->schoolFptr, "errorBitArray_%d,", i);
-                fprintf(CONTEXT->schoolFptr, "errorBitArray_%d\n", i);
+                    EMIT_U32(CONTEXT->schoolOut, "errorBitArray_", i, ",");
+                EMIT_U32(CONTEXT->schoolOut, "errorBitArray_", i, "\n");
             }
             break;
         }
@@ -386,7 +411,7 @@ __nara_export_init_school(
 
 /**/
 
-void
+static void
 __nara_export_destroy_school(
     nara_export_context_t   exportContext
 )
@@ -395,7 +420,7 @@ __nara_export_destroy_school(
 
 /**/
 
-void
+static void
 __nara_record_export_school(
     nara_export_context_t   exportContext,
     nara_record_t           *theRecord
@@ -422,366 +447,399 @@ __nara_record_export_school(
         case nara_export_format_yaml: {
             nara_export_context_yaml_t  *CONTEXT = (nara_export_context_yaml_t*)exportContext;
             
-            if ( CONTEXT->fptr ) {
-                fprintf(CONTEXT->fptr,
-                        "- recordType: school\n"
-                        "  systemOECode: %u\n"
-                        "  selectionCode: %u\n"
-                        "  systemName: %s\n"
-                        "  systemCounty: %s\n"
-                        "  systemCity: %s\n"
-                        "  systemZipCode: %s\n"
-                        "  numSchoolsInSchoolSystem: %u\n"
-                        "  isInConsolidation: %u\n"
-                        "  isInUnification: %u\n"
-                        "  isInDivision: %u\n"
-                        "  isInAnnexation: %u\n"
-                        "  isNotInAnyStateOfChange: %u\n"
-                        "  isUnderCourtOrderToDesegregate: %u\n"
-                        "  doGenderGradRequirementsDiffer: %u\n"
-                        "  numSchoolsWith5OrMoreVocationEdPrograms: %u\n"
-                        "  residentSchoolAgeChildrenIdentifiedRequiringSpecialEd: %u\n"
-                        "  residentPupilsInSpecialEdOperatedWithOtherSchoolSystems: %u\n"
-                        "  residentPupilsInSpecialEdOperatedExclOtherSchoolSystem: %u\n"
-                        "  residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem: %u\n"
-                        "  nonResidentPupilsInSpecialEd: %u\n"
-                        "  residentSchoolAgeChildrenOutOfSchoolHandicappingCondition: %u\n"
-                        "  residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction: %u\n"
-                        "  residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds: %u\n"
-                        "  fullTimeTeachersAssignedToSpecialEd: %u\n"
-                        "  partTimeTeachersAssignedToSpecialEd: %u\n"
-                        "  hasOtherReportingDates: %u\n"
-                        "  isESAADistrict: %u\n"
-                        "  samplingWeight: %g\n",
-                        school->systemOECode,
-                        school->selectionCode,
-                        systemName,
-                        systemCounty,
-                        systemCity,
-                        systemZipCode,
-                        school->numSchoolsInSchoolSystem,
-                        school->isInConsolidation,
-                        school->isInUnification,
-                        school->isInDivision,
-                        school->isInAnnexation,
-                        school->isNotInAnyStateOfChange,
-                        school->isUnderCourtOrderToDesegregate,
-                        school->doGenderGradRequirementsDiffer,
-                        school->numSchoolsWith5OrMoreVocationEdPrograms,
-                        school->residentSchoolAgeChildrenIdentifiedRequiringSpecialEd,
-                        school->residentPupilsInSpecialEdOperatedWithOtherSchoolSystems,
-                        school->residentPupilsInSpecialEdOperatedExclOtherSchoolSystem,
-                        school->residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem,
-                        school->nonResidentPupilsInSpecialEd,
-                        school->residentSchoolAgeChildrenOutOfSchoolHandicappingCondition,
-                        school->residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction,
-                        school->residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds,
-                        school->fullTimeTeachersAssignedToSpecialEd,
-                        school->partTimeTeachersAssignedToSpecialEd,
-                        school->hasOtherReportingDates,
-                        school->isESAADistrict,
-                        school->samplingWeight
-                    );
-
-                fprintf(CONTEXT->fptr, "  pupils:\n");
+            if ( CONTEXT->out ) {
+                EMIT_LITERAL(CONTEXT->out, "- recordType: school\n");
+                EMIT_U32(CONTEXT->out, "  systemOECode: ", school->systemOECode, "\n");
+                EMIT_U32(CONTEXT->out, "  selectionCode: ", school->selectionCode, "\n");
+                EMIT_STR(CONTEXT->out, "  systemName: ", systemName, "\n");
+                EMIT_STR(CONTEXT->out, "  systemCounty: ", systemCounty, "\n");
+                EMIT_STR(CONTEXT->out, "  systemCity: ", systemCity, "\n");
+                EMIT_STR(CONTEXT->out, "  systemZipCode: ", systemZipCode, "\n");
+                EMIT_U32(CONTEXT->out, "  numSchoolsInSchoolSystem: ", school->numSchoolsInSchoolSystem, "\n");
+                EMIT_U32(CONTEXT->out, "  isInConsolidation: ", school->isInConsolidation, "\n");
+                EMIT_U32(CONTEXT->out, "  isInUnification: ", school->isInUnification, "\n");
+                EMIT_U32(CONTEXT->out, "  isInDivision: ", school->isInDivision, "\n");
+                EMIT_U32(CONTEXT->out, "  isInAnnexation: ", school->isInAnnexation, "\n");
+                EMIT_U32(CONTEXT->out, "  isNotInAnyStateOfChange: ", school->isNotInAnyStateOfChange, "\n");
+                EMIT_U32(CONTEXT->out, "  isUnderCourtOrderToDesegregate: ", school->isUnderCourtOrderToDesegregate, "\n");
+                EMIT_U32(CONTEXT->out, "  doGenderGradRequirementsDiffer: ", school->doGenderGradRequirementsDiffer, "\n");
+                EMIT_U32(CONTEXT->out, "  numSchoolsWith5OrMoreVocationEdPrograms: ", school->numSchoolsWith5OrMoreVocationEdPrograms, "\n");
+                EMIT_U32(CONTEXT->out, "  residentSchoolAgeChildrenIdentifiedRequiringSpecialEd: ", school->residentSchoolAgeChildrenIdentifiedRequiringSpecialEd, "\n");
+                EMIT_U32(CONTEXT->out, "  residentPupilsInSpecialEdOperatedWithOtherSchoolSystems: ", school->residentPupilsInSpecialEdOperatedWithOtherSchoolSystems, "\n");
+                EMIT_U32(CONTEXT->out, "  residentPupilsInSpecialEdOperatedExclOtherSchoolSystem: ", school->residentPupilsInSpecialEdOperatedExclOtherSchoolSystem, "\n");
+                EMIT_U32(CONTEXT->out, "  residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem: ", school->residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem, "\n");
+                EMIT_U32(CONTEXT->out, "  nonResidentPupilsInSpecialEd: ", school->nonResidentPupilsInSpecialEd, "\n");
+                EMIT_U32(CONTEXT->out, "  residentSchoolAgeChildrenOutOfSchoolHandicappingCondition: ", school->residentSchoolAgeChildrenOutOfSchoolHandicappingCondition, "\n");
+                EMIT_U32(CONTEXT->out, "  residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction: ", school->residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction, "\n");
+                EMIT_U32(CONTEXT->out, "  residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds: ", school->residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds, "\n");
+                EMIT_U32(CONTEXT->out, "  fullTimeTeachersAssignedToSpecialEd: ", school->fullTimeTeachersAssignedToSpecialEd, "\n");
+                EMIT_U32(CONTEXT->out, "  partTimeTeachersAssignedToSpecialEd: ", school->partTimeTeachersAssignedToSpecialEd, "\n");
+                EMIT_U32(CONTEXT->out, "  hasOtherReportingDates: ", school->hasOtherReportingDates, "\n");
+                EMIT_U32(CONTEXT->out, "  isESAADistrict: ", school->isESAADistrict, "\n");
+                EMIT_FLOAT(CONTEXT->out, "  samplingWeight: ", school->samplingWeight, "\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupils:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n",  nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupils[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupils[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsEnrolledVocationEd:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsEnrolledVocationEd:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n",  nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsEnrolledVocationEd[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsEnrolledVocationEd[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsSuspendedAtLeastOneDay:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSuspendedAtLeastOneDay:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n",  nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsSuspendedAtLeastOneDay[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsSuspendedAtLeastOneDay[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsSuspendedAtLeastOneDayTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsSuspendedAtLeastOneDayTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsPrimaryLangNotEnglishTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsPrimaryLangNotEnglishTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsSpecialEdTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsSpecialEdTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsSpecialEdForGiftedOrTalentedTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsSpecialEdForGiftedOrTalentedTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal[i]);
-                    
-                    
-                fprintf(CONTEXT->fptr,
-                        "  schoolOECode: %u\n"
-                        "  schoolName: \"%s\"\n"
-                        "  firstGradeLevelOfferedOrYoungestAgeOfPupilsForUngradedSection: %u\n"
-                        "  lastGradeLevelOfferedOrOldestAgeOfPupilsForUngradedSection: %u\n"
-                        "  isSchoolCampusExclusivelySpecialEd: %u\n"
-                        "  numVocationEdProgramsAtSchool: %u\n"
-                        "  hasFacilOrEquipForHandicapGroundLevelRampsWithHandrail: %u\n"
-                        "  hasFacilOrEquipForHandicapSingleStoryOrElevator: %u\n"
-                        "  hasFacilOrEquipForHandicapToiletStalls: %u\n"
-                        "  hasFacilOrEquipForHandicapDoors32InOrMore: %u\n"
-                        "  hasFacilOrEquipForHandicapSimultWarningSignals: %u\n"
-                        "  isBldgOrFacilConstructedOrAlteredUsingFedAssist: %u\n"
-                        "  pupilsHandicapNeedingSpecialAccom: %u\n"
-                        "  pupilsPhysOrMentallyHandicappedReqTransport: %u\n"
-                        "  pupilsHandicappedRecvPublicSubsidizedTransport: %u\n"
-                        "  doesTransportAccomodateWheelchairs: %u\n"
-                        "  pupilsTransportedAtPublicExpense: %u\n"
-                        "  doesNotAwardHighSchoolDiplomaOrEquiv: %u\n"
-                        "  hasPupilsWhoWereSuspendedOrExpelled: %u\n"
-                        "  hasSpecialEdPrograms: %u\n"
-                        "  checkOnNumberOfFullTimeTeachers: %u\n"
-                        "  numFullTimeTeachers: %u\n"
-                        "  selectionNumber: %u\n",
-                        school->schoolOECode,
-                        schoolName,
-                        school->firstGradeLevelOfferedOrYoungestAgeOfPupilsForUngradedSection,
-                        school->lastGradeLevelOfferedOrOldestAgeOfPupilsForUngradedSection,
-                        school->isSchoolCampusExclusivelySpecialEd,
-                        school->numVocationEdProgramsAtSchool,
-                        school->hasFacilOrEquipForHandicapGroundLevelRampsWithHandrail,
-                        school->hasFacilOrEquipForHandicapSingleStoryOrElevator,
-                        school->hasFacilOrEquipForHandicapToiletStalls,
-                        school->hasFacilOrEquipForHandicapDoors32InOrMore,
-                        school->hasFacilOrEquipForHandicapSimultWarningSignals,
-                        school->isBldgOrFacilConstructedOrAlteredUsingFedAssist,
-                        school->pupilsHandicapNeedingSpecialAccom,
-                        school->pupilsPhysOrMentallyHandicappedReqTransport,
-                        school->pupilsHandicappedRecvPublicSubsidizedTransport,
-                        school->doesTransportAccomodateWheelchairs,
-                        school->pupilsTransportedAtPublicExpense,
-                        school->doesNotAwardHighSchoolDiplomaOrEquiv,
-                        school->hasPupilsWhoWereSuspendedOrExpelled,
-                        school->hasSpecialEdPrograms,
-                        school->checkOnNumberOfFullTimeTeachers,
-                        school->numFullTimeTeachers,
-                        school->selectionNumber
-                    );
-
-                fprintf(CONTEXT->fptr, "  isGradeOffered:\n");
-                for ( i = 0; i < nara_grade_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->isGradeOffered[i]);
-
-                fprintf(CONTEXT->fptr, "  pupils6To9InHomeEc:\n");
-                for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_gender_labels[i], school->pupils6To9InHomeEc[i]);
-                    
-                fprintf(CONTEXT->fptr, "  pupils6To9InIndustrialArts:\n");
-                for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_gender_labels[i], school->pupils6To9InIndustrialArts[i]);
-                    
-                fprintf(CONTEXT->fptr, "  pupils6To9InSingleSexHomeEconOrIndustrialArts:\n");
-                for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_gender_labels[i], school->pupils6To9InSingleSexHomeEconOrIndustrialArts[i]);
-                    
-                fprintf(CONTEXT->fptr, "  pupils7To12EnrolledInHighestLevelMath:\n");
-                for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_gender_labels[i], school->pupils7To12EnrolledInHighestLevelMath[i]);
-                    
-                fprintf(CONTEXT->fptr, "  pupils7To12EnrolledInHighestLevelNatSci:\n");
-                for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_gender_labels[i], school->pupils7To12EnrolledInHighestLevelNatSci[i]);
-                    
-                fprintf(CONTEXT->fptr, "  pupilsInMembership:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSuspendedAtLeastOneDayTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsSuspendedAtLeastOneDayTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsPrimaryLangNotEnglishTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsPrimaryLangNotEnglishTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSpecialEdTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsSpecialEdTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSpecialEdForGiftedOrTalentedTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsSpecialEdForGiftedOrTalentedTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal[i], "\n");
+                }
+                
+                
+                EMIT_U32(CONTEXT->out, "  schoolOECode: ", school->schoolOECode, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  schoolName: ", schoolName, "\n");
+                EMIT_U32(CONTEXT->out, "  firstGradeLevelOfferedOrYoungestAgeOfPupilsForUngradedSection: ", school->firstGradeLevelOfferedOrYoungestAgeOfPupilsForUngradedSection, "\n");
+                EMIT_U32(CONTEXT->out, "  lastGradeLevelOfferedOrOldestAgeOfPupilsForUngradedSection: ", school->lastGradeLevelOfferedOrOldestAgeOfPupilsForUngradedSection, "\n");
+                EMIT_U32(CONTEXT->out, "  isSchoolCampusExclusivelySpecialEd: ", school->isSchoolCampusExclusivelySpecialEd, "\n");
+                EMIT_U32(CONTEXT->out, "  numVocationEdProgramsAtSchool: ", school->numVocationEdProgramsAtSchool, "\n");
+                EMIT_U32(CONTEXT->out, "  hasFacilOrEquipForHandicapGroundLevelRampsWithHandrail: ", school->hasFacilOrEquipForHandicapGroundLevelRampsWithHandrail, "\n");
+                EMIT_U32(CONTEXT->out, "  hasFacilOrEquipForHandicapSingleStoryOrElevator: ", school->hasFacilOrEquipForHandicapSingleStoryOrElevator, "\n");
+                EMIT_U32(CONTEXT->out, "  hasFacilOrEquipForHandicapToiletStalls: ", school->hasFacilOrEquipForHandicapToiletStalls, "\n");
+                EMIT_U32(CONTEXT->out, "  hasFacilOrEquipForHandicapDoors32InOrMore: ", school->hasFacilOrEquipForHandicapDoors32InOrMore, "\n");
+                EMIT_U32(CONTEXT->out, "  hasFacilOrEquipForHandicapSimultWarningSignals: ", school->hasFacilOrEquipForHandicapSimultWarningSignals, "\n");
+                EMIT_U32(CONTEXT->out, "  isBldgOrFacilConstructedOrAlteredUsingFedAssist: ", school->isBldgOrFacilConstructedOrAlteredUsingFedAssist, "\n");
+                EMIT_U32(CONTEXT->out, "  pupilsHandicapNeedingSpecialAccom: ", school->pupilsHandicapNeedingSpecialAccom, "\n");
+                EMIT_U32(CONTEXT->out, "  pupilsPhysOrMentallyHandicappedReqTransport: ", school->pupilsPhysOrMentallyHandicappedReqTransport, "\n");
+                EMIT_U32(CONTEXT->out, "  pupilsHandicappedRecvPublicSubsidizedTransport: ", school->pupilsHandicappedRecvPublicSubsidizedTransport, "\n");
+                EMIT_U32(CONTEXT->out, "  doesTransportAccomodateWheelchairs: ", school->doesTransportAccomodateWheelchairs, "\n");
+                EMIT_U32(CONTEXT->out, "  pupilsTransportedAtPublicExpense: ", school->pupilsTransportedAtPublicExpense, "\n");
+                EMIT_U32(CONTEXT->out, "  doesNotAwardHighSchoolDiplomaOrEquiv: ", school->doesNotAwardHighSchoolDiplomaOrEquiv, "\n");
+                EMIT_U32(CONTEXT->out, "  hasPupilsWhoWereSuspendedOrExpelled: ", school->hasPupilsWhoWereSuspendedOrExpelled, "\n");
+                EMIT_U32(CONTEXT->out, "  hasSpecialEdPrograms: ", school->hasSpecialEdPrograms, "\n");
+                EMIT_U32(CONTEXT->out, "  checkOnNumberOfFullTimeTeachers: ", school->checkOnNumberOfFullTimeTeachers, "\n");
+                EMIT_U32(CONTEXT->out, "  numFullTimeTeachers: ", school->numFullTimeTeachers, "\n");
+                EMIT_U32(CONTEXT->out, "  selectionNumber: ", school->selectionNumber, "\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  isGradeOffered:\n");
+                for ( i = 0; i < nara_grade_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->isGradeOffered[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupils6To9InHomeEc:\n");
+                for ( i = 0; i < nara_gender_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupils6To9InHomeEc[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupils6To9InIndustrialArts:\n");
+                for ( i = 0; i < nara_gender_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupils6To9InIndustrialArts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupils6To9InSingleSexHomeEconOrIndustrialArts:\n");
+                for ( i = 0; i < nara_gender_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupils6To9InSingleSexHomeEconOrIndustrialArts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupils7To12EnrolledInHighestLevelMath:\n");
+                for ( i = 0; i < nara_gender_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupils7To12EnrolledInHighestLevelMath[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupils7To12EnrolledInHighestLevelNatSci:\n");
+                for ( i = 0; i < nara_gender_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupils7To12EnrolledInHighestLevelNatSci[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsInMembership:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsInMembership[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsInMembership[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsDroppedOutOrDiscontinuedSchooling:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsDroppedOutOrDiscontinuedSchooling:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsDroppedOutOrDiscontinuedSchooling[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsDroppedOutOrDiscontinuedSchooling[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsDroppedOutOrDiscontinuedSchoolingTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsDroppedOutOrDiscontinuedSchoolingTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsRecvHighSchoolDiplomaOrEquivMale:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsRecvHighSchoolDiplomaOrEquivMale[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsRecvHighSchoolDiplomaOrEquivFemale:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsRecvHighSchoolDiplomaOrEquivFemale[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsRecvHighSchoolDiplomaOrEquivTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsRecvHighSchoolDiplomaOrEquivTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsInSchoolPrimaryLangNotEnglishTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsInSchoolPrimaryLangNotEnglishTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsInSchoolPrimaryLangNotEnglishInProgramsNotInEnglishTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsInSchoolPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsSuspendedOneTimeOnly:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsDroppedOutOrDiscontinuedSchoolingTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsDroppedOutOrDiscontinuedSchoolingTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsRecvHighSchoolDiplomaOrEquivMale:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsRecvHighSchoolDiplomaOrEquivMale[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsRecvHighSchoolDiplomaOrEquivFemale:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsRecvHighSchoolDiplomaOrEquivFemale[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsRecvHighSchoolDiplomaOrEquivTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsRecvHighSchoolDiplomaOrEquivTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsInSchoolPrimaryLangNotEnglishTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsInSchoolPrimaryLangNotEnglishTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsInSchoolPrimaryLangNotEnglishInProgramsNotInEnglishTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsInSchoolPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSuspendedOneTimeOnly:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsSuspendedOneTimeOnly[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsSuspendedOneTimeOnly[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsSuspendedOneTimeOnlyTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsSuspendedOneTimeOnlyTotal[i]);
-
-
-                fprintf(CONTEXT->fptr, "  pupilsSuspendedOneTimeOnlyByDayCountTotal:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSuspendedOneTimeOnlyTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsSuspendedOneTimeOnlyTotal[i], "\n");
+                }
+                
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSuspendedOneTimeOnlyByDayCountTotal:\n");
                 for ( j = 0; j < nara_suspension_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_suspension_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsSuspendedOneTimeOnlyByDayCountTotal[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_suspension_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsSuspendedOneTimeOnlyByDayCountTotal[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsSuspendedMoreThanOnce:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSuspendedMoreThanOnce:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsSuspendedMoreThanOnce[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsSuspendedMoreThanOnce[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsSuspendedMoreThanOnceTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsSuspendedMoreThanOnceTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsSuspendedMoreThanOnceDayCountTotal:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSuspendedMoreThanOnceTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsSuspendedMoreThanOnceTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSuspendedMoreThanOnceDayCountTotal:\n");
                 for ( j = 0; j < nara_suspension_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_suspension_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsSuspendedMoreThanOnceDayCountTotal[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_suspension_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsSuspendedMoreThanOnceDayCountTotal[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsExpelled:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsExpelled:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsExpelled[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsExpelled[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsExpelledTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsExpelledTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsRecvCorporalPunishAsFormalDiscipline:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsExpelledTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsExpelledTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsRecvCorporalPunishAsFormalDiscipline:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsRecvCorporalPunishAsFormalDiscipline[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsRecvCorporalPunishAsFormalDiscipline[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsRecvCorporalPunishAsFormalDisciplineTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsRecvCorporalPunishAsFormalDisciplineTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsReferredForDisciplinaryActionToCourtOrJuvAuthor:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsRecvCorporalPunishAsFormalDisciplineTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsRecvCorporalPunishAsFormalDisciplineTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsReferredForDisciplinaryActionToCourtOrJuvAuthor:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsReferredForDisciplinaryActionToCourtOrJuvAuthor[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsReferredForDisciplinaryActionToCourtOrJuvAuthor[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsReferredForDisciplinaryActionToCourtOrJuvAuthorTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsReferredForDisciplinaryActionToCourtOrJuvAuthorTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsReferredToAltEducProgAsFormalDiscipline:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsReferredForDisciplinaryActionToCourtOrJuvAuthorTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsReferredForDisciplinaryActionToCourtOrJuvAuthorTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsReferredToAltEducProgAsFormalDiscipline:\n");
                 for ( j = 0; j < nara_gender_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_gender_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsReferredToAltEducProgAsFormalDiscipline[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_gender_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsReferredToAltEducProgAsFormalDiscipline[j][i], "\n");
+                    }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilsReferredToAltEducProgAsFormalDisciplineTotal:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsReferredToAltEducProgAsFormalDisciplineTotal[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilsInSpecialEd:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsReferredToAltEducProgAsFormalDisciplineTotal:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsReferredToAltEducProgAsFormalDisciplineTotal[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsInSpecialEd:\n");
                 for ( j = 0; j < nara_special_ed_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_special_ed_labels[j]);
-                    fprintf(CONTEXT->fptr, "      total:\n");
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "         \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilsInSpecialEd[j].total[i]);
-                    fprintf(CONTEXT->fptr, "      byGender:\n");
-                    for ( i = 0; i < nara_gender_max; i++ )
-                        fprintf(CONTEXT->fptr, "         \"%s\": %u\n", nara_gender_labels[i], school->pupilsInSpecialEd[j].byGender[i]);
-                    fprintf(CONTEXT->fptr, "      lessThan10HrsPerWeek: %u\n", school->pupilsInSpecialEd[j].lessThan10HrsPerWeek);
-                    fprintf(CONTEXT->fptr, "      moreThan10HrsPerWeekNotFullTime: %u\n", school->pupilsInSpecialEd[j].moreThan10HrsPerWeekNotFullTime);
-                    fprintf(CONTEXT->fptr, "      fullTime: %u\n", school->pupilsInSpecialEd[j].fullTime);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_special_ed_labels[j], ":\n");
+                    EMIT_LITERAL(CONTEXT->out, "      total:\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "         ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsInSpecialEd[j].total[i], "\n");
+                    }
+                    EMIT_LITERAL(CONTEXT->out, "      byGender:\n");
+                    for ( i = 0; i < nara_gender_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "         ", nara_gender_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilsInSpecialEd[j].byGender[i], "\n");
+                    }
+                    EMIT_U32(CONTEXT->out, "      lessThan10HrsPerWeek: ", school->pupilsInSpecialEd[j].lessThan10HrsPerWeek, "\n");
+                    EMIT_U32(CONTEXT->out, "      moreThan10HrsPerWeekNotFullTime: ", school->pupilsInSpecialEd[j].moreThan10HrsPerWeekNotFullTime, "\n");
+                    EMIT_U32(CONTEXT->out, "      fullTime: ", school->pupilsInSpecialEd[j].fullTime, "\n");
                 }
-
-                fprintf(CONTEXT->fptr, "  teachersAssignedToSpecialEdPrograms:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  teachersAssignedToSpecialEdPrograms:\n");
                 for ( j = 0; j < nara_special_ed_total_of_all_impaired_subtypes; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_special_ed_labels[j]);
-                    for ( i = 0; i < nara_empl_status_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_empl_status_labels[i], school->teachersAssignedToSpecialEdPrograms[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_special_ed_labels[j], ":\n");
+                    for ( i = 0; i < nara_empl_status_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_empl_status_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->teachersAssignedToSpecialEdPrograms[j][i], "\n");
+                    }
+                }
+                EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_special_ed_labels[nara_special_ed_gifted_or_talented], ":\n");
+                for ( i = 0; i < nara_empl_status_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_empl_status_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->teachersAssignedToSpecialEdPrograms[j][i], "\n");
                 }
-                fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_special_ed_labels[nara_special_ed_gifted_or_talented]);
-                for ( i = 0; i < nara_empl_status_max; i++ )
-                    fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_empl_status_labels[i], school->teachersAssignedToSpecialEdPrograms[j][i]);
                 
-                fprintf(CONTEXT->fptr, "  pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalented:\n");
-                for ( i = 0; i < nara_ethnicity_max - 1; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalented[i]);
-
-                fprintf(CONTEXT->fptr, "  pupilAssignments:\n");
+                EMIT_LITERAL(CONTEXT->out, "  pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalented:\n");
+                for ( i = 0; i < nara_ethnicity_max - 1; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalented[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilAssignments:\n");
                 for ( m = 0; m < 2; m++ ) {
                     for ( l = 0; l < nara_assignment_class_max; l++ ) {
-                        fprintf(CONTEXT->fptr, "    - \"%s\":\n", nara_assignment_class_labels[l]);
+                        EMIT_QUOTED_STR(CONTEXT->out, "    - ", nara_assignment_class_labels[l], ":\n");
                         for ( k = 0; k < 3; k++ ) {
-                            fprintf(CONTEXT->fptr, "      - gradeOrAge: %u\n", school->pupilAssignments[m][l][k].gradeOrAge);
-                            fprintf(CONTEXT->fptr, "        subjectCode: %u\n", school->pupilAssignments[m][l][k].subjectCode);
-                            fprintf(CONTEXT->fptr, "        pupils:\n");
+                            EMIT_U32(CONTEXT->out, "      - gradeOrAge: ", school->pupilAssignments[m][l][k].gradeOrAge, "\n");
+                            EMIT_U32(CONTEXT->out, "        subjectCode: ", school->pupilAssignments[m][l][k].subjectCode, "\n");
+                            EMIT_LITERAL(CONTEXT->out, "        pupils:\n");
                             for ( j = 0; j < nara_gender_max; j++ ) {
-                                fprintf(CONTEXT->fptr, "          \"%s\":\n", nara_gender_labels[j]);
-                                for ( i = 0; i < nara_ethnicity_max; i++ )
-                                    fprintf(CONTEXT->fptr, "            \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilAssignments[m][l][k].pupils[j][i]);
+                                EMIT_QUOTED_STR(CONTEXT->out, "          ", nara_gender_labels[j], ":\n");
+                                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                                    EMIT_QUOTED_STR(CONTEXT->out, "            ", nara_ethnicity_labels[i], "");
+                                    EMIT_U32(CONTEXT->out, ": ", school->pupilAssignments[m][l][k].pupils[j][i], "\n");
+                                }
                             }
                         }
                     }
                 }
-
-                fprintf(CONTEXT->fptr, "  pupilAssignmentsEndOfSpanOrSingleEntryGradeOrAge:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilAssignmentsEndOfSpanOrSingleEntryGradeOrAge:\n");
                 for ( k = 0; k < 2; k++ ) {
                     for ( j = 0; j < nara_assignment_class_max; j++ ) {
-                        fprintf(CONTEXT->fptr, "    - \"%s\":\n", nara_assignment_class_labels[j]);
+                        EMIT_QUOTED_STR(CONTEXT->out, "    - ", nara_assignment_class_labels[j], ":\n");
                         for ( i = 0; i < 3; i++ )
-                            fprintf(CONTEXT->fptr, "      - %u\n", school->pupilAssignmentsEndOfSpanOrSingleEntryGradeOrAge[k][j][i]);
+                            EMIT_U32(CONTEXT->out, "      - ", school->pupilAssignmentsEndOfSpanOrSingleEntryGradeOrAge[k][j][i], "\n");
                     }
                 }
-
-                fprintf(CONTEXT->fptr, "  errorBitArray:\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  errorBitArray:\n");
                 for ( i = 0; i < 43; i++ )
-                    fprintf(CONTEXT->fptr, "    - %u\n", school->errorBitArray[i]);
+                    EMIT_U32(CONTEXT->out, "    - ", school->errorBitArray[i], "\n");
             }            
             break;
         }
@@ -789,281 +847,226 @@ __nara_record_export_school(
         case nara_export_format_csv: {
             nara_export_context_csv_t   *CONTEXT = (nara_export_context_csv_t*)exportContext;
             
-            if ( CONTEXT->schoolFptr ) {
-                fprintf(CONTEXT->schoolFptr,
-                        "%u,"
-                        "%u,"
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%g,",
-                        school->systemOECode,
-                        school->selectionCode,
-                        systemName,
-                        systemCounty,
-                        systemCity,
-                        systemZipCode,
-                        school->numSchoolsInSchoolSystem,
-                        school->isInConsolidation,
-                        school->isInUnification,
-                        school->isInDivision,
-                        school->isInAnnexation,
-                        school->isNotInAnyStateOfChange,
-                        school->isUnderCourtOrderToDesegregate,
-                        school->doGenderGradRequirementsDiffer,
-                        school->numSchoolsWith5OrMoreVocationEdPrograms,
-                        school->residentSchoolAgeChildrenIdentifiedRequiringSpecialEd,
-                        school->residentPupilsInSpecialEdOperatedWithOtherSchoolSystems,
-                        school->residentPupilsInSpecialEdOperatedExclOtherSchoolSystem,
-                        school->residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem,
-                        school->nonResidentPupilsInSpecialEd,
-                        school->residentSchoolAgeChildrenOutOfSchoolHandicappingCondition,
-                        school->residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction,
-                        school->residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds,
-                        school->fullTimeTeachersAssignedToSpecialEd,
-                        school->partTimeTeachersAssignedToSpecialEd,
-                        school->hasOtherReportingDates,
-                        school->isESAADistrict,
-                        school->samplingWeight
-                    );
-
+            if ( CONTEXT->schoolOut ) {
+                EMIT_U32(CONTEXT->schoolOut, "", school->systemOECode, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->selectionCode, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", systemName, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", systemCounty, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", systemCity, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", systemZipCode, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->numSchoolsInSchoolSystem, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isInConsolidation, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isInUnification, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isInDivision, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isInAnnexation, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isNotInAnyStateOfChange, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isUnderCourtOrderToDesegregate, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->doGenderGradRequirementsDiffer, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->numSchoolsWith5OrMoreVocationEdPrograms, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->residentSchoolAgeChildrenIdentifiedRequiringSpecialEd, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->residentPupilsInSpecialEdOperatedWithOtherSchoolSystems, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->residentPupilsInSpecialEdOperatedExclOtherSchoolSystem, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->nonResidentPupilsInSpecialEd, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->residentSchoolAgeChildrenOutOfSchoolHandicappingCondition, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->fullTimeTeachersAssignedToSpecialEd, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->partTimeTeachersAssignedToSpecialEd, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->hasOtherReportingDates, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isESAADistrict, ",");
+                EMIT_FLOAT(CONTEXT->schoolOut, "", school->samplingWeight, ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupils[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupils[j][i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsEnrolledVocationEd[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsEnrolledVocationEd[j][i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsSuspendedAtLeastOneDay[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsSuspendedAtLeastOneDay[j][i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsSuspendedAtLeastOneDayTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsSuspendedAtLeastOneDayTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsPrimaryLangNotEnglishTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsPrimaryLangNotEnglishTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsSpecialEdTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsSpecialEdTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsSpecialEdForGiftedOrTalentedTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsSpecialEdForGiftedOrTalentedTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal[i]);
-                    
-                fprintf(CONTEXT->schoolFptr,
-                        "%u,"
-                        "\"%s\","
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,",
-                        school->schoolOECode,
-                        schoolName,
-                        school->firstGradeLevelOfferedOrYoungestAgeOfPupilsForUngradedSection,
-                        school->lastGradeLevelOfferedOrOldestAgeOfPupilsForUngradedSection,
-                        school->isSchoolCampusExclusivelySpecialEd,
-                        school->numVocationEdProgramsAtSchool,
-                        school->hasFacilOrEquipForHandicapGroundLevelRampsWithHandrail,
-                        school->hasFacilOrEquipForHandicapSingleStoryOrElevator,
-                        school->hasFacilOrEquipForHandicapToiletStalls,
-                        school->hasFacilOrEquipForHandicapDoors32InOrMore,
-                        school->hasFacilOrEquipForHandicapSimultWarningSignals,
-                        school->isBldgOrFacilConstructedOrAlteredUsingFedAssist,
-                        school->pupilsHandicapNeedingSpecialAccom,
-                        school->pupilsPhysOrMentallyHandicappedReqTransport,
-                        school->pupilsHandicappedRecvPublicSubsidizedTransport,
-                        school->doesTransportAccomodateWheelchairs,
-                        school->pupilsTransportedAtPublicExpense,
-                        school->doesNotAwardHighSchoolDiplomaOrEquiv,
-                        school->hasPupilsWhoWereSuspendedOrExpelled,
-                        school->hasSpecialEdPrograms,
-                        school->checkOnNumberOfFullTimeTeachers,
-                        school->numFullTimeTeachers,
-                        school->selectionNumber
-                    );
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal[i], ",");
+                
+                EMIT_U32(CONTEXT->schoolOut, "", school->schoolOECode, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", schoolName, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->firstGradeLevelOfferedOrYoungestAgeOfPupilsForUngradedSection, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->lastGradeLevelOfferedOrOldestAgeOfPupilsForUngradedSection, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isSchoolCampusExclusivelySpecialEd, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->numVocationEdProgramsAtSchool, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->hasFacilOrEquipForHandicapGroundLevelRampsWithHandrail, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->hasFacilOrEquipForHandicapSingleStoryOrElevator, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->hasFacilOrEquipForHandicapToiletStalls, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->hasFacilOrEquipForHandicapDoors32InOrMore, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->hasFacilOrEquipForHandicapSimultWarningSignals, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isBldgOrFacilConstructedOrAlteredUsingFedAssist, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->pupilsHandicapNeedingSpecialAccom, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->pupilsPhysOrMentallyHandicappedReqTransport, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->pupilsHandicappedRecvPublicSubsidizedTransport, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->doesTransportAccomodateWheelchairs, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->pupilsTransportedAtPublicExpense, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->doesNotAwardHighSchoolDiplomaOrEquiv, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->hasPupilsWhoWereSuspendedOrExpelled, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->hasSpecialEdPrograms, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->checkOnNumberOfFullTimeTeachers, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->numFullTimeTeachers, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->selectionNumber, ",");
+                
                 for ( i = 0; i < nara_grade_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->isGradeOffered[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->isGradeOffered[i], ",");
+                
                 for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupils6To9InHomeEc[i]);
-                    
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupils6To9InHomeEc[i], ",");
+                
                 for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupils6To9InIndustrialArts[i]);
-                    
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupils6To9InIndustrialArts[i], ",");
+                
                 for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupils6To9InSingleSexHomeEconOrIndustrialArts[i]);
-                    
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupils6To9InSingleSexHomeEconOrIndustrialArts[i], ",");
+                
                 for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupils7To12EnrolledInHighestLevelMath[i]);
-                    
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupils7To12EnrolledInHighestLevelMath[i], ",");
+                
                 for ( i = 0; i < nara_gender_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupils7To12EnrolledInHighestLevelNatSci[i]);
-                    
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupils7To12EnrolledInHighestLevelNatSci[i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsInMembership[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsInMembership[j][i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsDroppedOutOrDiscontinuedSchooling[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsDroppedOutOrDiscontinuedSchooling[j][i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsDroppedOutOrDiscontinuedSchoolingTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsDroppedOutOrDiscontinuedSchoolingTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsRecvHighSchoolDiplomaOrEquivMale[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsRecvHighSchoolDiplomaOrEquivMale[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsRecvHighSchoolDiplomaOrEquivFemale[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsRecvHighSchoolDiplomaOrEquivFemale[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsRecvHighSchoolDiplomaOrEquivTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsRecvHighSchoolDiplomaOrEquivTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsInSchoolPrimaryLangNotEnglishTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsInSchoolPrimaryLangNotEnglishTotal[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsInSchoolPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsInSchoolPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsSuspendedOneTimeOnly[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsSuspendedOneTimeOnly[j][i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsSuspendedOneTimeOnlyTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsSuspendedOneTimeOnlyTotal[i], ",");
+                
                 for ( j = 0; j < nara_suspension_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsSuspendedOneTimeOnlyByDayCountTotal[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsSuspendedOneTimeOnlyByDayCountTotal[j][i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsSuspendedMoreThanOnce[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsSuspendedMoreThanOnce[j][i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsSuspendedMoreThanOnceTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsSuspendedMoreThanOnceTotal[i], ",");
+                
                 for ( j = 0; j < nara_suspension_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsSuspendedMoreThanOnceDayCountTotal[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsSuspendedMoreThanOnceDayCountTotal[j][i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsExpelled[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsExpelled[j][i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsExpelledTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsExpelledTotal[i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsRecvCorporalPunishAsFormalDiscipline[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsRecvCorporalPunishAsFormalDiscipline[j][i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsRecvCorporalPunishAsFormalDisciplineTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsRecvCorporalPunishAsFormalDisciplineTotal[i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsReferredForDisciplinaryActionToCourtOrJuvAuthor[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsReferredForDisciplinaryActionToCourtOrJuvAuthor[j][i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsReferredForDisciplinaryActionToCourtOrJuvAuthorTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsReferredForDisciplinaryActionToCourtOrJuvAuthorTotal[i], ",");
+                
                 for ( j = 0; j < nara_gender_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsReferredToAltEducProgAsFormalDiscipline[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsReferredToAltEducProgAsFormalDiscipline[j][i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsReferredToAltEducProgAsFormalDisciplineTotal[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsReferredToAltEducProgAsFormalDisciplineTotal[i], ",");
+                
                 for ( j = 0; j < nara_special_ed_max; j++ ) {
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsInSpecialEd[j].total[i]);
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsInSpecialEd[j].total[i], ",");
                     for ( i = 0; i < nara_gender_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsInSpecialEd[j].byGender[i]);
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsInSpecialEd[j].lessThan10HrsPerWeek);
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsInSpecialEd[j].moreThan10HrsPerWeekNotFullTime);
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsInSpecialEd[j].fullTime);
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilsInSpecialEd[j].byGender[i], ",");
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsInSpecialEd[j].lessThan10HrsPerWeek, ",");
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsInSpecialEd[j].moreThan10HrsPerWeekNotFullTime, ",");
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsInSpecialEd[j].fullTime, ",");
                 }
-
+                
                 for ( j = 0; j < nara_special_ed_total_of_all_impaired_subtypes; j++ )
                     for ( i = 0; i < nara_empl_status_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->teachersAssignedToSpecialEdPrograms[j][i]);
+                        EMIT_U32(CONTEXT->schoolOut, "", school->teachersAssignedToSpecialEdPrograms[j][i], ",");
                 for ( i = 0; i < nara_empl_status_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->teachersAssignedToSpecialEdPrograms[j][i]);
+                    EMIT_U32(CONTEXT->schoolOut, "", school->teachersAssignedToSpecialEdPrograms[j][i], ",");
                 
                 for ( i = 0; i < nara_ethnicity_max - 1; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalented[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalented[i], ",");
+                
                 for ( m = 0; m < 2; m++ ) {
                     for ( l = 0; l < nara_assignment_class_max; l++ ) {
                         for ( k = 0; k < 3; k++ ) {
-                            fprintf(CONTEXT->schoolFptr, "%u,", school->pupilAssignments[m][l][k].gradeOrAge);
-                            fprintf(CONTEXT->schoolFptr, "%u,", school->pupilAssignments[m][l][k].subjectCode);
+                            EMIT_U32(CONTEXT->schoolOut, "", school->pupilAssignments[m][l][k].gradeOrAge, ",");
+                            EMIT_U32(CONTEXT->schoolOut, "", school->pupilAssignments[m][l][k].subjectCode, ",");
                             for ( j = 0; j < nara_gender_max; j++ )
                                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilAssignments[m][l][k].pupils[j][i]);
+                                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilAssignments[m][l][k].pupils[j][i], ",");
                         }
                     }
                 }
-
+                
                 for ( k = 0; k < 2; k++ )
                     for ( j = 0; j < nara_assignment_class_max; j++ )
                         for ( i = 0; i < 3; i++ )
-                            fprintf(CONTEXT->schoolFptr, "%u,", school->pupilAssignmentsEndOfSpanOrSingleEntryGradeOrAge[k][j][i]);
+                            EMIT_U32(CONTEXT->schoolOut, "", school->pupilAssignmentsEndOfSpanOrSingleEntryGradeOrAge[k][j][i], ",");
                 
                 for ( i = 0; i < 42; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->errorBitArray[i]);
-                fprintf(CONTEXT->schoolFptr, "%u\n", school->errorBitArray[i]);
+                    EMIT_U32(CONTEXT->schoolOut, "", school->errorBitArray[i], ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->errorBitArray[i], "\n");
             }
             break;
         }
@@ -1073,11 +1076,191 @@ __nara_record_export_school(
 
 /**/
 
-nara_record_t*
-__nara_record_destroy_school(
-    nara_record_t       *theRecord
+static void
+__nara_record_columns_school(
+    nara_record_columns_t   columns
 )
 {
-    free((void*)theRecord);
-    return NULL;
+    unsigned int            i, j, k, l, m, idx;
+    
+    COLUMN_U32(columns, nara_school_t, systemOECode, "systemOECode");
+    COLUMN_U32(columns, nara_school_t, selectionCode, "selectionCode");
+    COLUMN_STR(columns, nara_school_t, systemName, "systemName");
+    COLUMN_STR(columns, nara_school_t, systemCounty, "systemCounty");
+    COLUMN_STR(columns, nara_school_t, systemCity, "systemCity");
+    COLUMN_STR(columns, nara_school_t, systemZipCode, "systemZipCode");
+    COLUMN_U32(columns, nara_school_t, numSchoolsInSchoolSystem, "numSchoolsInSchoolSystem");
+    COLUMN_U32(columns, nara_school_t, isInConsolidation, "isInConsolidation");
+    COLUMN_U32(columns, nara_school_t, isInUnification, "isInUnification");
+    COLUMN_U32(columns, nara_school_t, isInDivision, "isInDivision");
+    COLUMN_U32(columns, nara_school_t, isInAnnexation, "isInAnnexation");
+    COLUMN_U32(columns, nara_school_t, isNotInAnyStateOfChange, "isNotInAnyStateOfChange");
+    COLUMN_U32(columns, nara_school_t, isUnderCourtOrderToDesegregate, "isUnderCourtOrderToDesegregate");
+    COLUMN_U32(columns, nara_school_t, doGenderGradRequirementsDiffer, "doGenderGradRequirementsDiffer");
+    COLUMN_U32(columns, nara_school_t, numSchoolsWith5OrMoreVocationEdPrograms, "numSchoolsWith5OrMoreVocationEdPrograms");
+    COLUMN_U32(columns, nara_school_t, residentSchoolAgeChildrenIdentifiedRequiringSpecialEd, "residentSchoolAgeChildrenIdentifiedRequiringSpecialEd");
+    COLUMN_U32(columns, nara_school_t, residentPupilsInSpecialEdOperatedWithOtherSchoolSystems, "residentPupilsInSpecialEdOperatedWithOtherSchoolSystems");
+    COLUMN_U32(columns, nara_school_t, residentPupilsInSpecialEdOperatedExclOtherSchoolSystem, "residentPupilsInSpecialEdOperatedExclOtherSchoolSystem");
+    COLUMN_U32(columns, nara_school_t, residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem, "residentPupilsInSpecialEdOperatedEntityNotPublicSchoolSystem");
+    COLUMN_U32(columns, nara_school_t, nonResidentPupilsInSpecialEd, "nonResidentPupilsInSpecialEd");
+    COLUMN_U32(columns, nara_school_t, residentSchoolAgeChildrenOutOfSchoolHandicappingCondition, "residentSchoolAgeChildrenOutOfSchoolHandicappingCondition");
+    COLUMN_U32(columns, nara_school_t, residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction, "residentSchoolAgeChildrenOutOfSchoolHandicappingConditionHomeboundInstruction");
+    COLUMN_U32(columns, nara_school_t, residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds, "residentSchoolAgeChildrenEvaluatedForSpecialEdNeeds");
+    COLUMN_U32(columns, nara_school_t, fullTimeTeachersAssignedToSpecialEd, "fullTimeTeachersAssignedToSpecialEd");
+    COLUMN_U32(columns, nara_school_t, partTimeTeachersAssignedToSpecialEd, "partTimeTeachersAssignedToSpecialEd");
+    COLUMN_U32(columns, nara_school_t, hasOtherReportingDates, "hasOtherReportingDates");
+    COLUMN_U32(columns, nara_school_t, isESAADistrict, "isESAADistrict");
+    COLUMN_FLOAT(columns, nara_school_t, samplingWeight, "samplingWeight");
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupils[j][i], "\"pupils_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsEnrolledVocationEd[j][i], "\"pupilsEnrolledVocationEd_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsSuspendedAtLeastOneDay[j][i], "\"pupilsSuspendedAtLeastOneDay_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsSuspendedAtLeastOneDayTotal[i], "\"pupilsSuspendedAtLeastOneDayTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsPrimaryLangNotEnglishTotal[i], "\"pupilsPrimaryLangNotEnglishTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i], "\"pupilsPrimaryLangNotEnglishInProgramsNotInEnglishTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsSpecialEdTotal[i], "\"pupilsSpecialEdTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal[i], "\"pupilsSpecialEdForEducableMetallyRetardedOrHandicappedTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsSpecialEdForGiftedOrTalentedTotal[i], "\"pupilsSpecialEdForGiftedOrTalentedTotal_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal[i], "\"pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalentedTotal_%s\"", nara_ethnicity_labels[i]);
+    COLUMN_U32(columns, nara_school_t, schoolOECode, "schoolOECode");
+    COLUMN_STR(columns, nara_school_t, schoolName, "schoolName");
+    COLUMN_U32(columns, nara_school_t, firstGradeLevelOfferedOrYoungestAgeOfPupilsForUngradedSection, "firstGradeLevelOfferedOrYoungestAgeOfPupilsForUngradedSection");
+    COLUMN_U32(columns, nara_school_t, lastGradeLevelOfferedOrOldestAgeOfPupilsForUngradedSection, "lastGradeLevelOfferedOrOldestAgeOfPupilsForUngradedSection");
+    COLUMN_U32(columns, nara_school_t, isSchoolCampusExclusivelySpecialEd, "isSchoolCampusExclusivelySpecialEd");
+    COLUMN_U32(columns, nara_school_t, numVocationEdProgramsAtSchool, "numVocationEdProgramsAtSchool");
+    COLUMN_U32(columns, nara_school_t, hasFacilOrEquipForHandicapGroundLevelRampsWithHandrail, "hasFacilOrEquipForHandicapGroundLevelRampsWithHandrail");
+    COLUMN_U32(columns, nara_school_t, hasFacilOrEquipForHandicapSingleStoryOrElevator, "hasFacilOrEquipForHandicapSingleStoryOrElevator");
+    COLUMN_U32(columns, nara_school_t, hasFacilOrEquipForHandicapToiletStalls, "hasFacilOrEquipForHandicapToiletStalls");
+    COLUMN_U32(columns, nara_school_t, hasFacilOrEquipForHandicapDoors32InOrMore, "hasFacilOrEquipForHandicapDoors32InOrMore");
+    COLUMN_U32(columns, nara_school_t, hasFacilOrEquipForHandicapSimultWarningSignals, "hasFacilOrEquipForHandicapSimultWarningSignals");
+    COLUMN_U32(columns, nara_school_t, isBldgOrFacilConstructedOrAlteredUsingFedAssist, "isBldgOrFacilConstructedOrAlteredUsingFedAssist");
+    COLUMN_U32(columns, nara_school_t, pupilsHandicapNeedingSpecialAccom, "pupilsHandicapNeedingSpecialAccom");
+    COLUMN_U32(columns, nara_school_t, pupilsPhysOrMentallyHandicappedReqTransport, "pupilsPhysOrMentallyHandicappedReqTransport");
+    COLUMN_U32(columns, nara_school_t, pupilsHandicappedRecvPublicSubsidizedTransport, "pupilsHandicappedRecvPublicSubsidizedTransport");
+    COLUMN_U32(columns, nara_school_t, doesTransportAccomodateWheelchairs, "doesTransportAccomodateWheelchairs");
+    COLUMN_U32(columns, nara_school_t, pupilsTransportedAtPublicExpense, "pupilsTransportedAtPublicExpense");
+    COLUMN_U32(columns, nara_school_t, doesNotAwardHighSchoolDiplomaOrEquiv, "doesNotAwardHighSchoolDiplomaOrEquiv");
+    COLUMN_U32(columns, nara_school_t, hasPupilsWhoWereSuspendedOrExpelled, "hasPupilsWhoWereSuspendedOrExpelled");
+    COLUMN_U32(columns, nara_school_t, hasSpecialEdPrograms, "hasSpecialEdPrograms");
+    COLUMN_U32(columns, nara_school_t, checkOnNumberOfFullTimeTeachers, "checkOnNumberOfFullTimeTeachers");
+    COLUMN_U32(columns, nara_school_t, numFullTimeTeachers, "numFullTimeTeachers");
+    COLUMN_U32(columns, nara_school_t, selectionNumber, "selectionNumber");
+    for ( i = 0; i < nara_grade_max; i++ )
+        COLUMN_U32(columns, nara_school_t, isGradeOffered[i], "\"isGradeOffered_%s\"", nara_grade_labels[i]);
+    for ( i = 0; i < nara_gender_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupils6To9InHomeEc[i], "\"pupils6To9InHomeEc_%s\"", nara_gender_labels[i]);
+    for ( i = 0; i < nara_gender_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupils6To9InIndustrialArts[i], "\"pupils6To9InIndustrialArts_%s\"", nara_gender_labels[i]);
+    for ( i = 0; i < nara_gender_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupils6To9InSingleSexHomeEconOrIndustrialArts[i], "\"pupils6To9InSingleSexHomeEconOrIndustrialArts_%s\"", nara_gender_labels[i]);
+    for ( i = 0; i < nara_gender_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupils7To12EnrolledInHighestLevelMath[i], "\"pupils7To12EnrolledInHighestLevelMath_%s\"", nara_gender_labels[i]);
+    for ( i = 0; i < nara_gender_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupils7To12EnrolledInHighestLevelNatSci[i], "\"pupils7To12EnrolledInHighestLevelNatSci_%s\"", nara_gender_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsInMembership[j][i], "\"pupilsInMembership_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsDroppedOutOrDiscontinuedSchooling[j][i], "\"pupilsDroppedOutOrDiscontinuedSchooling_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    
+    /* These are by ethnicity, but their headers carry grade labels: */
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsDroppedOutOrDiscontinuedSchoolingTotal[i], "\"pupilsDroppedOutOrDiscontinuedSchoolingTotal_%s\"", nara_grade_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsRecvHighSchoolDiplomaOrEquivMale[i], "\"pupilsRecvHighSchoolDiplomaOrEquivMale_%s\"", nara_grade_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsRecvHighSchoolDiplomaOrEquivFemale[i], "\"pupilsRecvHighSchoolDiplomaOrEquivFemale_%s\"", nara_grade_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsRecvHighSchoolDiplomaOrEquivTotal[i], "\"pupilsRecvHighSchoolDiplomaOrEquivTotal_%s\"", nara_grade_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsInSchoolPrimaryLangNotEnglishTotal[i], "\"pupilsInSchoolPrimaryLangNotEnglishTotal_%s\"", nara_grade_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsInSchoolPrimaryLangNotEnglishInProgramsNotInEnglishTotal[i], "\"pupilsInSchoolPrimaryLangNotEnglishInProgramsNotInEnglishTotal_%s\"", nara_grade_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsSuspendedOneTimeOnly[j][i], "\"pupilsSuspendedOneTimeOnly_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsSuspendedOneTimeOnlyTotal[i], "\"pupilsSuspendedOneTimeOnlyTotal_%s\"", nara_grade_labels[i]);
+    for ( j = 0; j < nara_suspension_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsSuspendedOneTimeOnlyByDayCountTotal[j][i], "\"pupilsSuspendedOneTimeOnlyByDayCountTotal_%s_%s\"", nara_suspension_labels[j], nara_ethnicity_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsSuspendedMoreThanOnce[j][i], "\"pupilsSuspendedMoreThanOnce_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsSuspendedMoreThanOnceTotal[i], "\"pupilsSuspendedMoreThanOnceTotal_%s\"", nara_grade_labels[i]);
+    for ( j = 0; j < nara_suspension_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsSuspendedMoreThanOnceDayCountTotal[j][i], "\"pupilsSuspendedMoreThanOnceDayCountTotal_%s_%s\"", nara_suspension_labels[j], nara_ethnicity_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsExpelled[j][i], "\"pupilsExpelled_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsExpelledTotal[i], "\"pupilsExpelledTotal_%s\"", nara_grade_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsRecvCorporalPunishAsFormalDiscipline[j][i], "\"pupilsRecvCorporalPunishAsFormalDiscipline_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsRecvCorporalPunishAsFormalDisciplineTotal[i], "\"pupilsRecvCorporalPunishAsFormalDisciplineTotal_%s\"", nara_grade_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsReferredForDisciplinaryActionToCourtOrJuvAuthor[j][i], "\"pupilsReferredForDisciplinaryActionToCourtOrJuvAuthor_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsReferredForDisciplinaryActionToCourtOrJuvAuthorTotal[i], "\"pupilsReferredForDisciplinaryActionToCourtOrJuvAuthorTotal_%s\"", nara_grade_labels[i]);
+    for ( j = 0; j < nara_gender_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsReferredToAltEducProgAsFormalDiscipline[j][i], "\"pupilsReferredToAltEducProgAsFormalDiscipline_%s_%s\"", nara_gender_labels[j], nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsReferredToAltEducProgAsFormalDisciplineTotal[i], "\"pupilsReferredToAltEducProgAsFormalDisciplineTotal_%s\"", nara_grade_labels[i]);
+    for ( j = 0; j < nara_special_ed_max; j++ ) {
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsInSpecialEd[j].total[i], "\"pupilsInSpecialEd_total_%s_%s\"", nara_special_ed_labels[j], nara_ethnicity_labels[i]);
+        for ( i = 0; i < nara_gender_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilsInSpecialEd[j].byGender[i], "\"pupilsInSpecialEd_byGender_%s_%s\"", nara_special_ed_labels[j], nara_gender_labels[i]);
+        COLUMN_U32(columns, nara_school_t, pupilsInSpecialEd[j].lessThan10HrsPerWeek, "\"pupilsInSpecialEd_lessThan10HrsPerWeek_%s\"", nara_special_ed_labels[j]);
+        COLUMN_U32(columns, nara_school_t, pupilsInSpecialEd[j].moreThan10HrsPerWeekNotFullTime, "\"pupilsInSpecialEd_moreThan10HrsPerWeekNotFullTime_%s\"", nara_special_ed_labels[j]);
+        COLUMN_U32(columns, nara_school_t, pupilsInSpecialEd[j].fullTime, "\"pupilsInSpecialEd_fullTime_%s\"", nara_special_ed_labels[j]);
+    }
+    for ( j = 0; j < nara_special_ed_total_of_all_impaired_subtypes; j++ )
+        for ( i = 0; i < nara_empl_status_max; i++ )
+            COLUMN_U32(columns, nara_school_t, teachersAssignedToSpecialEdPrograms[j][i], "\"teachersAssignedToSpecialEdPrograms_%s_%s\"", nara_special_ed_labels[j], nara_empl_status_labels[i]);
+    
+    /* The last of these is headed as gifted-or-talented but written from the next row: */
+    for ( i = 0; i < nara_empl_status_max; i++ )
+        COLUMN_U32(columns, nara_school_t, teachersAssignedToSpecialEdPrograms[j][i], "\"teachersAssignedToSpecialEdPrograms_%s_%s\"", nara_special_ed_labels[nara_special_ed_gifted_or_talented], nara_empl_status_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max - 1; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalented[i], "\"pupilsHonorsOrAdvPlaceOrEnrichmentIfNoGiftedOrTalented_%s\"", nara_grade_labels[i]);
+    idx = 1;
+    for ( m = 0; m < 2; m++ ) {
+        for ( l = 0; l < nara_assignment_class_max; l++ ) {
+            for ( k = 0; k < 3; k++ ) {
+                COLUMN_U32(columns, nara_school_t, pupilAssignments[m][l][k].gradeOrAge, "\"pupilAssignments_%u_gradeOrAge_%s\"", idx, nara_assignment_class_labels[l]);
+                COLUMN_U32(columns, nara_school_t, pupilAssignments[m][l][k].subjectCode, "\"pupilAssignments_%u_subjectCode_%s\"", idx, nara_assignment_class_labels[l]);
+                for ( j = 0; j < nara_gender_max; j++ )
+                    for ( i = 0; i < nara_ethnicity_max; i++ )
+                        COLUMN_U32(columns, nara_school_t, pupilAssignments[m][l][k].pupils[j][i], "\"pupilAssignments_%u_gradeOrAge_pupils_%s_%s_%s\"", idx, nara_assignment_class_labels[l], nara_gender_labels[j], nara_ethnicity_labels[i]);
+                idx++;
+            }
+        }
+    }
+    idx = 1;
+    for ( k = 0; k < 2; k++ )
+        for ( j = 0; j < nara_assignment_class_max; j++ )
+            for ( i = 0; i < 3; i++ )
+                COLUMN_U32(columns, nara_school_t, pupilAssignmentsEndOfSpanOrSingleEntryGradeOrAge[k][j][i], "\"pupilAssignmentsEndOfSpanOrSingleEntryGradeOrAge_%u_%s\"", idx++, nara_assignment_class_labels[j]);
+    for ( i = 0; i < 43; i++ )
+        COLUMN_U32(columns, nara_school_t, errorBitArray[i], "errorBitArray_%u", i + 1);
 }
@@ -34,18 +34,7 @@ typedef union {
 
 /**/
 
-int
-__nara_record_is_type_district(
-    nara_record_t*      theRecord,
-    size_t              byteSize
-)
-{
-    return ( (byteSize == NARA_1986_RECORD_SIZE) && (nara_be_to_host_32(theRecord->recordType) == nara_record_type_district) );
-}
-
-/**/
-
-nara_record_t*
+static nara_record_t*
 __nara_record_process_district(
     nara_record_t*      theRecord
 )
@@ -55,24 +44,19 @@ __nara_record_process_district(
     char                        *fromPtr, *toPtr;
     size_t                      fromLen, toLen;
     
-    unsigned int                i, iMax;
-    
-    iMax = sizeof(district->compact.f1) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) district->compact.f1[i] = nara_be_to_host_32(district->compact.f1[i]);
+    nara_be_to_host_u32_array(district->compact.f1, sizeof(district->compact.f1) / sizeof(uint32_t));
     
-    iMax = sizeof(district->compact.f2) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) district->compact.f2[i] = nara_be_to_host_32(district->compact.f2[i]);
+    nara_be_to_host_u32_array(district->compact.f2, sizeof(district->compact.f2) / sizeof(uint32_t));
     
-    district->compact.f3 = nara_be_to_host_float(district->compact.f3);
+    district->compact.f3 = nara_be_to_host_f32(district->compact.f3);
     
-    district->compact.f4 = nara_be_to_host_32(district->compact.f4);
+    district->compact.f4 = nara_be_to_host_u32(district->compact.f4);
     
-    district->compact.f5 = nara_be_to_host_float(district->compact.f5);
+    district->compact.f5 = nara_be_to_host_f32(district->compact.f5);
     
-    district->compact.f6 = nara_be_to_host_32(district->compact.f6);
+    district->compact.f6 = nara_be_to_host_u32(district->compact.f6);
     
-    iMax = sizeof(district->compact.f7) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) district->compact.f7[i] = nara_be_to_host_32(district->compact.f7[i]);
+    nara_be_to_host_u32_array(district->compact.f7, sizeof(district->compact.f7) / sizeof(uint32_t));
     
     TRANSCODE(district, systemName, "district name");
     TRANSCODE(district, systemStreetAddress, "district street address");
@@ -86,7 +70,7 @@ __nara_record_process_district(
 
 /**/
 
-void
+static void
 __nara_export_init_district(
     nara_export_context_t   exportContext
 )
@@ -106,8 +90,8 @@ __nara_export_init_district(
             /*
              * Write column headers to the file:
              */
-            if ( CONTEXT->districtFptr ) {
-                fprintf(CONTEXT->districtFptr,
+            if ( CONTEXT->districtOut ) {
+                EMIT_LITERAL(CONTEXT->districtOut,
                         "systemOECode,"
                         "selectionCode,"
                         "systemName,"
@@ -131,11 +115,11 @@ __nara_export_init_district(
                     );
                 
                 for ( i = 1; i <= 32; i++ )
-                    fprintf(CONTEXT->districtFptr, "errorBitArray_%d,", i);
-                    
+                    EMIT_U32(CONTEXT->districtOut, "errorBitArray_", i, ",");
+                
                 for ( i = 1; i <= 82; i++ )
-                    fprintf(CONTEXT->districtFptr, "conditionCode_%d,", i);
-                fprintf(CONTEXT->districtFptr, "conditionCode_%d\n", i);
+                    EMIT_U32(CONTEXT->districtOut, "conditionCode_", i, ",");
+                EMIT_U32(CONTEXT->districtOut, "conditionCode_", i, "\n");
             }
             break;
         }
@@ -144,7 +128,7 @@ __nara_export_init_district(
 
 /**/
 
-void
+static void
 __nara_export_destroy_district(
     nara_export_context_t   exportContext
 )
@@ -153,7 +137,7 @@ __nara_export_destroy_district(
 
 /**/
 
-void
+static void
 __nara_record_export_district(
     nara_export_context_t   exportContext,
     nara_record_t           *theRecord
@@ -182,58 +166,36 @@ __nara_record_export_district(
         case nara_export_format_yaml: {
             nara_export_context_yaml_t  *CONTEXT = (nara_export_context_yaml_t*)exportContext;
             
-            if ( CONTEXT->fptr ) {
-                fprintf(CONTEXT->fptr,
-                        "- recordType: district\n"
-                        "  systemOECode: %u\n"
-                        "  selectionCode: %u\n"
-                        "  systemName: %s\n"
-                        "  systemStreetAddress: %s\n"
-                        "  systemCounty: %s\n"
-                        "  systemCity: %s\n"
-                        "  systemStatAbbrev: %s\n"
-                        "  systemZipCode: %s\n"
-                        "  numSchoolsInSchoolSystem: %u\n"
-                        "  isCourtOrderYesFederal: %u\n"
-                        "  isCourtOrderYesState: %u\n"
-                        "  isCourtOrderNo: %u\n"
-                        "  childrenAwaitingInitEval: %u\n"
-                        "  childrenRequireSpecialEd: %u\n"
-                        "  childrenReceiveSpecialEdInDistrict: %u\n"
-                        "  childrenReceiveSpecialEdNonDistrict: %u\n"
-                        "  samplingWeight: %g\n"
-                        "  isSubSampledDistrict: %u\n"
-                        "  subSampledWeight: %g\n"
-                        "  isSubSampledSchool: %u\n",
-                        district->systemOECode,
-                        district->selectionCode,
-                        systemName,
-                        systemStreetAddress,
-                        systemCounty,
-                        systemCity,
-                        systemStateAbbrev,
-                        systemZipCode,
-                        district->numSchoolsInSchoolSystem,
-                        district->isCourtOrderYesFederal,
-                        district->isCourtOrderYesState,
-                        district->isCourtOrderNo,
-                        district->childrenAwaitingInitEval,
-                        district->childrenRequireSpecialEd,
-                        district->childrenReceiveSpecialEdInDistrict,
-                        district->childrenReceiveSpecialEdNonDistrict,
-                        district->sampleWeight,
-                        district->isSubSampledDistrict,
-                        district->subSampledWeight,
-                        district->isSubSampledSchool
-                    );
-
-                fprintf(CONTEXT->fptr, "  errorBitArray:\n");
+            if ( CONTEXT->out ) {
+                EMIT_LITERAL(CONTEXT->out, "- recordType: district\n");
+                EMIT_U32(CONTEXT->out, "  systemOECode: ", district->systemOECode, "\n");
+                EMIT_U32(CONTEXT->out, "  selectionCode: ", district->selectionCode, "\n");
+                EMIT_STR(CONTEXT->out, "  systemName: ", systemName, "\n");
+                EMIT_STR(CONTEXT->out, "  systemStreetAddress: ", systemStreetAddress, "\n");
+                EMIT_STR(CONTEXT->out, "  systemCounty: ", systemCounty, "\n");
+                EMIT_STR(CONTEXT->out, "  systemCity: ", systemCity, "\n");
+                EMIT_STR(CONTEXT->out, "  systemStatAbbrev: ", systemStateAbbrev, "\n");
+                EMIT_STR(CONTEXT->out, "  systemZipCode: ", systemZipCode, "\n");
+                EMIT_U32(CONTEXT->out, "  numSchoolsInSchoolSystem: ", district->numSchoolsInSchoolSystem, "\n");
+                EMIT_U32(CONTEXT->out, "  isCourtOrderYesFederal: ", district->isCourtOrderYesFederal, "\n");
+                EMIT_U32(CONTEXT->out, "  isCourtOrderYesState: ", district->isCourtOrderYesState, "\n");
+                EMIT_U32(CONTEXT->out, "  isCourtOrderNo: ", district->isCourtOrderNo, "\n");
+                EMIT_U32(CONTEXT->out, "  childrenAwaitingInitEval: ", district->childrenAwaitingInitEval, "\n");
+                EMIT_U32(CONTEXT->out, "  childrenRequireSpecialEd: ", district->childrenRequireSpecialEd, "\n");
+                EMIT_U32(CONTEXT->out, "  childrenReceiveSpecialEdInDistrict: ", district->childrenReceiveSpecialEdInDistrict, "\n");
+                EMIT_U32(CONTEXT->out, "  childrenReceiveSpecialEdNonDistrict: ", district->childrenReceiveSpecialEdNonDistrict, "\n");
+                EMIT_FLOAT(CONTEXT->out, "  samplingWeight: ", district->sampleWeight, "\n");
+                EMIT_U32(CONTEXT->out, "  isSubSampledDistrict: ", district->isSubSampledDistrict, "\n");
+                EMIT_FLOAT(CONTEXT->out, "  subSampledWeight: ", district->subSampledWeight, "\n");
+                EMIT_U32(CONTEXT->out, "  isSubSampledSchool: ", district->isSubSampledSchool, "\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  errorBitArray:\n");
                 for ( i = 0; i < 32; i++ )
-                    fprintf(CONTEXT->fptr, "    - %u\n", district->errorBitArray[i]);
-
-                fprintf(CONTEXT->fptr, "  conditionCodes:\n");
+                    EMIT_U32(CONTEXT->out, "    - ", district->errorBitArray[i], "\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  conditionCodes:\n");
                 for ( i = 0; i < 82; i++ )
-                    fprintf(CONTEXT->fptr, "    - %u\n", district->conditionCodes[i]);
+                    EMIT_U32(CONTEXT->out, "    - ", district->conditionCodes[i], "\n");
             }            
             break;
         }
@@ -241,56 +203,34 @@ __nara_record_export_district(
         case nara_export_format_csv: {
             nara_export_context_csv_t   *CONTEXT = (nara_export_context_csv_t*)exportContext;
             
-            if ( CONTEXT->districtFptr ) {
-                fprintf(CONTEXT->districtFptr,
-                        "%u,"
-                        "%u,"
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%g,"
-                        "%u,"
-                        "%g,"
-                        "%u,",
-                        district->systemOECode,
-                        district->selectionCode,
-                        systemName,
-                        systemStreetAddress,
-                        systemCounty,
-                        systemCity,
-                        systemStateAbbrev,
-                        systemZipCode,
-                        district->numSchoolsInSchoolSystem,
-                        district->isCourtOrderYesFederal,
-                        district->isCourtOrderYesState,
-                        district->isCourtOrderNo,
-                        district->childrenAwaitingInitEval,
-                        district->childrenRequireSpecialEd,
-                        district->childrenReceiveSpecialEdInDistrict,
-                        district->childrenReceiveSpecialEdNonDistrict,
-                        district->sampleWeight,
-                        district->isSubSampledDistrict,
-                        district->subSampledWeight,
-                        district->isSubSampledSchool
-                    );
-
+            if ( CONTEXT->districtOut ) {
+                EMIT_U32(CONTEXT->districtOut, "", district->systemOECode, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->selectionCode, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemName, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemStreetAddress, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemCounty, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemCity, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemStateAbbrev, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemZipCode, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->numSchoolsInSchoolSystem, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isCourtOrderYesFederal, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isCourtOrderYesState, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isCourtOrderNo, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->childrenAwaitingInitEval, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->childrenRequireSpecialEd, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->childrenReceiveSpecialEdInDistrict, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->childrenReceiveSpecialEdNonDistrict, ",");
+                EMIT_FLOAT(CONTEXT->districtOut, "", district->sampleWeight, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isSubSampledDistrict, ",");
+                EMIT_FLOAT(CONTEXT->districtOut, "", district->subSampledWeight, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->isSubSampledSchool, ",");
+                
                 for ( i = 0; i < 32; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->errorBitArray[i]);
-                    
+                    EMIT_U32(CONTEXT->districtOut, "", district->errorBitArray[i], ",");
+                
                 for ( i = 0; i < 82; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->conditionCodes[i]);
-                fprintf(CONTEXT->districtFptr, "%u\n", district->conditionCodes[i]);
+                    EMIT_U32(CONTEXT->districtOut, "", district->conditionCodes[i], ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->conditionCodes[i], "\n");
             }
             break;
         }
@@ -300,12 +240,36 @@ __nara_record_export_district(
 
 /**/
 
-nara_record_t*
-__nara_record_destroy_district(
-    nara_record_t       *theRecord
+static void
+__nara_record_columns_district(
+    nara_record_columns_t   columns
 )
 {
-    free((void*)theRecord);
-    return NULL;
+    unsigned int            i;
+    
+    COLUMN_U32(columns, nara_district_t, systemOECode, "systemOECode");
+    COLUMN_U32(columns, nara_district_t, selectionCode, "selectionCode");
+    COLUMN_STR(columns, nara_district_t, systemName, "systemName");
+    COLUMN_STR(columns, nara_district_t, systemStreetAddress, "systemStreetAddress");
+    COLUMN_STR(columns, nara_district_t, systemCounty, "systemCounty");
+    COLUMN_STR(columns, nara_district_t, systemCity, "systemCity");
+    COLUMN_STR(columns, nara_district_t, systemStateAbbrev, "systemStateAbbrev");
+    COLUMN_STR(columns, nara_district_t, systemZipCode, "systemZipCode");
+    COLUMN_U32(columns, nara_district_t, numSchoolsInSchoolSystem, "numSchoolsInSchoolSystem");
+    COLUMN_U32(columns, nara_district_t, isCourtOrderYesFederal, "isCourtOrderYesFederal");
+    COLUMN_U32(columns, nara_district_t, isCourtOrderYesState, "isCourtOrderYesState");
+    COLUMN_U32(columns, nara_district_t, isCourtOrderNo, "isCourtOrderNo");
+    COLUMN_U32(columns, nara_district_t, childrenAwaitingInitEval, "childrenAwaitingInitEval");
+    COLUMN_U32(columns, nara_district_t, childrenRequireSpecialEd, "childrenRequireSpecialEd");
+    COLUMN_U32(columns, nara_district_t, childrenReceiveSpecialEdInDistrict, "childrenReceiveSpecialEdInDistrict");
+    COLUMN_U32(columns, nara_district_t, childrenReceiveSpecialEdNonDistrict, "childrenReceiveSpecialEdNonDistrict");
+    COLUMN_FLOAT(columns, nara_district_t, sampleWeight, "sampleWeight");
+    COLUMN_U32(columns, nara_district_t, isSubSampledDistrict, "isSubSampledDistrict");
+    COLUMN_FLOAT(columns, nara_district_t, subSampledWeight, "subSampledWeight");
+    COLUMN_U32(columns, nara_district_t, isSubSampledSchool, "isSubSampledSchool");
+    for ( i = 0; i < 32; i++ )
+        COLUMN_U32(columns, nara_district_t, errorBitArray[i], "errorBitArray_%u", i + 1);
+    for ( i = 0; i < 83; i++ )
+        COLUMN_U32(columns, nara_district_t, conditionCodes[i], "conditionCode_%u", i + 1);
 }
     
\ No newline at end of file
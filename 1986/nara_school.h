@@ -24,9 +24,6 @@ enum {
     nara_ethnicity_max
 };
 
-extern const char* nara_ethnicity_labels[nara_ethnicity_max];
-
-
 enum {
     nara_grade_totally_ungraded = 0,
     nara_grade_only_special_ed,
@@ -47,9 +44,6 @@ enum {
     nara_grade_max
 };
 
-extern const char* nara_grade_labels[nara_grade_max];
-
-
 enum {
     nara_pupils_total = 0,
     nara_pupils_needing_language_assistance,
@@ -60,9 +54,6 @@ enum {
     nara_pupils_max
 };
 
-extern const char* nara_pupils_labels[nara_pupils_max];
-
-
 enum {
     nara_classroom_survey_grade = 0,
     nara_classroom_survey_american_indian,
@@ -74,8 +65,6 @@ enum {
     nara_classroom_survey_max
 };
 
-extern const char* nara_classroom_survey_labels[nara_classroom_survey_max];
-
 enum {
     nara_classroom_survey_slots = 10
 };
@@ -96,9 +85,6 @@ enum {
     nara_special_ed_category_max
 };
 
-extern const char* nara_special_ed_category_labels[nara_special_ed_category_max];
-
-
 enum {
     nara_special_ed_educable_mentally_retarded = 0,
     nara_special_ed_trainable_metally_retarded,
@@ -116,9 +102,6 @@ enum {
     nara_special_ed_max
 };
 
-extern const char* nara_special_ed_labels[nara_special_ed_max];
-
-
 enum {
     nara_selected_course_category_all_male = 0,
     nara_selected_course_category_all_female,
@@ -128,9 +111,6 @@ enum {
     nara_selected_course_category_max
 };
 
-extern const char* nara_selected_course_category_labels[nara_selected_course_category_max];
-
-
 enum {
     nara_selected_course_home_economics = 0,
     nara_selected_course_industrial_arts,
@@ -138,9 +118,6 @@ enum {
     nara_selected_course_max
 };
 
-extern const char* nara_selected_course_labels[nara_selected_course_max];
-
-
 typedef struct {
     uint32_t        systemOECode;
     uint32_t        recordType;
@@ -7,7 +7,7 @@
 
 #include "nara_school.h"
 
-const char* nara_ethnicity_labels[nara_ethnicity_max] = {
+static const char* nara_ethnicity_labels[nara_ethnicity_max] = {
             "American Indian",
             "Asian or Pacific",
             "Hispanic",
@@ -18,7 +18,7 @@ const char* nara_ethnicity_labels[nara_ethnicity_max] = {
             "Total (Female)"
         };
 
-const char* nara_grade_labels[nara_grade_max] = {
+static const char* nara_grade_labels[nara_grade_max] = {
             "Ungraded",
             "Only Special-Ed",
             "Pre-K",
@@ -37,7 +37,7 @@ const char* nara_grade_labels[nara_grade_max] = {
             "12th"
         };
 
-const char* nara_pupils_labels[nara_pupils_max] = {
+static const char* nara_pupils_labels[nara_pupils_max] = {
             "Total Pupils",
             "Pupils Needing Language Assistance",
             "Pupils Enrolled Language Assistance",
@@ -46,7 +46,7 @@ const char* nara_pupils_labels[nara_pupils_max] = {
             "Pupils Suspended"
         };
 
-const char* nara_classroom_survey_labels[nara_classroom_survey_max] = {
+static const char* nara_classroom_survey_labels[nara_classroom_survey_max] = {
             "Grade Level",
             "American Indian",
             "Asian or Pacific",
@@ -56,7 +56,7 @@ const char* nara_classroom_survey_labels[nara_classroom_survey_max] = {
             "Total"
         };
 
-const char* nara_special_ed_category_labels[nara_special_ed_category_max] = {
+static const char* nara_special_ed_category_labels[nara_special_ed_category_max] = {
             "Total",
             "American Indian",
             "Asian or Pacific",
@@ -71,7 +71,7 @@ const char* nara_special_ed_category_labels[nara_special_ed_category_max] = {
         };
 
 
-const char* nara_special_ed_labels[nara_special_ed_max] = {
+static const char* nara_special_ed_labels[nara_special_ed_max] = {
             "Educable Mentally Retarded",
             "Trainable Mentally Retarded",
             "Hard of Hearing",
@@ -87,7 +87,7 @@ const char* nara_special_ed_labels[nara_special_ed_max] = {
             "Total of All Impairments"
         };
 
-const char* nara_selected_course_category_labels[nara_selected_course_category_max] = {
+static const char* nara_selected_course_category_labels[nara_selected_course_category_max] = {
             "Non-mixed (Male)",
             "Non-mixed (Female)",
             "Mixed (Male)",
@@ -95,7 +95,7 @@ const char* nara_selected_course_category_labels[nara_selected_course_category_m
             "Total"
         };
 
-const char* nara_selected_course_labels[nara_selected_course_max] = {
+static const char* nara_selected_course_labels[nara_selected_course_max] = {
             "Home Economics",
             "Industrial Arts",
             "Physical Education"
@@ -121,18 +121,7 @@ typedef union {
 
 /**/
 
-int
-__nara_record_is_type_school(
-    nara_record_t*      theRecord,
-    size_t              byteSize
-)
-{
-    return ( (byteSize == NARA_1986_RECORD_SIZE) && (nara_be_to_host_32(theRecord->recordType) == nara_record_type_school) );
-}
-
-/**/
-
-nara_record_t*
+static nara_record_t*
 __nara_record_process_school(
     nara_record_t*      theRecord
 )
@@ -142,21 +131,17 @@ __nara_record_process_school(
     char                        *fromPtr, *toPtr;
     size_t                      fromLen, toLen;
     
-    unsigned int                i, iMax;
-    
-    iMax = sizeof(school->compact.f1) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) school->compact.f1[i] = nara_be_to_host_32(school->compact.f1[i]);
+    nara_be_to_host_u32_array(school->compact.f1, sizeof(school->compact.f1) / sizeof(uint32_t));
     
-    iMax = sizeof(school->compact.f2) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) school->compact.f2[i] = nara_be_to_host_32(school->compact.f2[i]);
+    nara_be_to_host_u32_array(school->compact.f2, sizeof(school->compact.f2) / sizeof(uint32_t));
     
-    school->compact.f3 = nara_be_to_host_float(school->compact.f3);
+    school->compact.f3 = nara_be_to_host_f32(school->compact.f3);
     
-    school->compact.f4 = nara_be_to_host_32(school->compact.f4);
+    school->compact.f4 = nara_be_to_host_u32(school->compact.f4);
     
-    school->compact.f5 = nara_be_to_host_float(school->compact.f5);
+    school->compact.f5 = nara_be_to_host_f32(school->compact.f5);
     
-    school->compact.f6 = nara_be_to_host_32(school->compact.f6);
+    school->compact.f6 = nara_be_to_host_u32(school->compact.f6);
     
     TRANSCODE(school, schoolName, "school name");
     TRANSCODE(school, schoolStreetAddress, "school street address");
@@ -167,7 +152,7 @@ __nara_record_process_school(
 
 /**/
 
-void
+static void
 __nara_export_init_school(
     nara_export_context_t   exportContext
 )
@@ -187,8 +172,8 @@ __nara_export_init_school(
             /*
              * Write column headers to the file:
              */
-            if ( CONTEXT->schoolFptr ) {
-                fprintf(CONTEXT->schoolFptr,
+            if ( CONTEXT->schoolOut ) {
+                EMIT_LITERAL(CONTEXT->schoolOut,
                         "systemOECode,"
                         "selectionCode,"
                         "schoolName,"
@@ -208,27 +193,35 @@ __nara_export_init_school(
                     );
                 
                 for ( j = 0; j < nara_classroom_survey_slots; j++ )
-                    for ( i = 0; i < nara_classroom_survey_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"classroomSurvey_%u_%s\",", (j + 1), nara_classroom_survey_labels[i]);
+                    for ( i = 0; i < nara_classroom_survey_max; i++ ) {
+                        EMIT_U32(CONTEXT->schoolOut, "\"classroomSurvey_", (j + 1), "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_classroom_survey_labels[i], "\",");
+                    }
                 
                 for ( j = 0; j < nara_grade_max; j++ )
-                    fprintf(CONTEXT->schoolFptr, "\"isGradeOffered%s\",", nara_grade_labels[j]);
+                    EMIT_STR(CONTEXT->schoolOut, "\"isGradeOffered", nara_grade_labels[j], "\",");
                 
                 for ( j = 0; j < nara_pupils_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"pupils_%s_%s\",", nara_pupils_labels[j], nara_ethnicity_labels[i]);
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"pupils_", nara_pupils_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
                 
                 for ( j = 0; j < nara_special_ed_max; j++ )
-                    for ( i = 0; i < nara_special_ed_category_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"specialEd_%s_%s\",", nara_special_ed_labels[j], nara_special_ed_category_labels[i]);
+                    for ( i = 0; i < nara_special_ed_category_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"specialEd_", nara_special_ed_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_special_ed_category_labels[i], "\",");
+                    }
                 
                 for ( j = 0; j < nara_selected_course_max; j++ )
-                    for ( i = 0; i < nara_selected_course_category_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"selectedCourse_%s_%s\",", nara_selected_course_labels[j], nara_selected_course_category_labels[i]);
+                    for ( i = 0; i < nara_selected_course_category_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"selectedCourse_", nara_selected_course_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_selected_course_category_labels[i], "\",");
+                    }
                 
                 for ( j = 0; j < nara_ethnicity_max - 1; j++ )
-                    fprintf(CONTEXT->schoolFptr, "\"graduates_%s\",", nara_ethnicity_labels[j]);
-                fprintf(CONTEXT->schoolFptr, "\"graduates_%s\"\n", nara_ethnicity_labels[j]);
+                    EMIT_STR(CONTEXT->schoolOut, "\"graduates_", nara_ethnicity_labels[j], "\",");
+                EMIT_STR(CONTEXT->schoolOut, "\"graduates_", nara_ethnicity_labels[j], "\"\n");
             }
             break;
         }
@@ -237,7 +230,7 @@ __nara_export_init_school(
 
 /**/
 
-void
+static void
 __nara_export_destroy_school(
     nara_export_context_t   exportContext
 )
@@ -246,7 +239,7 @@ __nara_export_destroy_school(
 
 /**/
 
-void
+static void
 __nara_record_export_school(
     nara_export_context_t   exportContext,
     nara_record_t           *theRecord
@@ -269,83 +262,77 @@ __nara_record_export_school(
         case nara_export_format_yaml: {
             nara_export_context_yaml_t  *CONTEXT = (nara_export_context_yaml_t*)exportContext;
             
-            if ( CONTEXT->fptr ) {
-                fprintf(CONTEXT->fptr,
-                        "- recordType: school\n"
-                        "  systemOECode: %u\n"
-                        "  selectionCode: %u\n"
-                        "  schoolName: %s\n"
-                        "  schoolStreetAddress: %s\n"
-                        "  schoolZipCode: %s\n"
-                        "  schoolShouldHaveCompletedPart6: %u\n"
-                        "  isSpecialEdProgramNotOffered: %u\n"
-                        "  isItem7Completed: %u\n"
-                        "  isSection3Completed: %u\n"
-                        "  shouldSchoolHaveCompletedItem8: %u\n"
-                        "  shouldSchoolHaveCompletedItem9: %u\n"
-                        "  samplingWeight: %g\n"
-                        "  isSubSampledDistrict: %u\n"
-                        "  subSampledWeight: %g\n"
-                        "  isSubSampledSchool: %u\n"
-                        "  numberOfClassroomsSurveyed: %u\n",
-                        school->systemOECode,
-                        school->selectionCode,
-                        schoolName,
-                        schoolStreetAddress,
-                        schoolZipCode,
-                        school->shouldSchoolHaveCompletedPart6,
-                        school->isSpecialEdProgramNotOffered,
-                        school->isItem7Completed,
-                        school->isSection3Completed,
-                        school->shouldSchoolHaveCompletedItem8,
-                        school->shouldSchoolHaveCompletedItem9,
-                        school->sampleWeight,
-                        school->isSubSampledDistrict,
-                        school->subSampledWeight,
-                        school->isSubSampledSchool,
-                        school->numberOfClassroomsSurveyed
-                    );
+            if ( CONTEXT->out ) {
+                EMIT_LITERAL(CONTEXT->out, "- recordType: school\n");
+                EMIT_U32(CONTEXT->out, "  systemOECode: ", school->systemOECode, "\n");
+                EMIT_U32(CONTEXT->out, "  selectionCode: ", school->selectionCode, "\n");
+                EMIT_STR(CONTEXT->out, "  schoolName: ", schoolName, "\n");
+                EMIT_STR(CONTEXT->out, "  schoolStreetAddress: ", schoolStreetAddress, "\n");
+                EMIT_STR(CONTEXT->out, "  schoolZipCode: ", schoolZipCode, "\n");
+                EMIT_U32(CONTEXT->out, "  schoolShouldHaveCompletedPart6: ", school->shouldSchoolHaveCompletedPart6, "\n");
+                EMIT_U32(CONTEXT->out, "  isSpecialEdProgramNotOffered: ", school->isSpecialEdProgramNotOffered, "\n");
+                EMIT_U32(CONTEXT->out, "  isItem7Completed: ", school->isItem7Completed, "\n");
+                EMIT_U32(CONTEXT->out, "  isSection3Completed: ", school->isSection3Completed, "\n");
+                EMIT_U32(CONTEXT->out, "  shouldSchoolHaveCompletedItem8: ", school->shouldSchoolHaveCompletedItem8, "\n");
+                EMIT_U32(CONTEXT->out, "  shouldSchoolHaveCompletedItem9: ", school->shouldSchoolHaveCompletedItem9, "\n");
+                EMIT_FLOAT(CONTEXT->out, "  samplingWeight: ", school->sampleWeight, "\n");
+                EMIT_U32(CONTEXT->out, "  isSubSampledDistrict: ", school->isSubSampledDistrict, "\n");
+                EMIT_FLOAT(CONTEXT->out, "  subSampledWeight: ", school->subSampledWeight, "\n");
+                EMIT_U32(CONTEXT->out, "  isSubSampledSchool: ", school->isSubSampledSchool, "\n");
+                EMIT_U32(CONTEXT->out, "  numberOfClassroomsSurveyed: ", school->numberOfClassroomsSurveyed, "\n");
                 
                 if ( school->numberOfClassroomsSurveyed > 0 ) {
-                    fprintf(CONTEXT->fptr, "  classroomSurvey:\n");
+                    EMIT_LITERAL(CONTEXT->out, "  classroomSurvey:\n");
                     k = (school->numberOfClassroomsSurveyed < nara_classroom_survey_slots) ? school->numberOfClassroomsSurveyed : nara_classroom_survey_slots;
                     for ( j = 0; j < k; j++ ) {
                         char        *prefix = "    - ";
                         for ( i = 0; i < nara_classroom_survey_max; i++ ) {
-                            fprintf(CONTEXT->fptr, "%s\"%s\": %u\n", prefix, nara_classroom_survey_labels[i], school->classroomSurveys[j][i]);
+                            EMIT_STR(CONTEXT->out, "", prefix, "");
+                            EMIT_QUOTED_STR(CONTEXT->out, "", nara_classroom_survey_labels[i], "");
+                            EMIT_U32(CONTEXT->out, ": ", school->classroomSurveys[j][i], "\n");
                             prefix = "      ";
                         }
                     }
                 }
                 
-                fprintf(CONTEXT->fptr, "  isGradeOffered:\n");
-                for ( j = 0; j < nara_grade_max; j++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[j], school->isGradeOffered[j]);
+                EMIT_LITERAL(CONTEXT->out, "  isGradeOffered:\n");
+                for ( j = 0; j < nara_grade_max; j++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[j], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->isGradeOffered[j], "\n");
+                }
                 
-                fprintf(CONTEXT->fptr, "  pupils:\n");
+                EMIT_LITERAL(CONTEXT->out, "  pupils:\n");
                 for ( j = 0; j < nara_pupils_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_pupils_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilCounts[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_pupils_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->pupilCounts[j][i], "\n");
+                    }
                 }
                 
-                fprintf(CONTEXT->fptr, "  specialEd:\n");
+                EMIT_LITERAL(CONTEXT->out, "  specialEd:\n");
                 for ( j = 0; j < nara_special_ed_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_special_ed_labels[j]);
-                    for ( i = 0; i < nara_special_ed_category_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_special_ed_category_labels[i], school->specialEd[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_special_ed_labels[j], ":\n");
+                    for ( i = 0; i < nara_special_ed_category_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_special_ed_category_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->specialEd[j][i], "\n");
+                    }
                 }
                 
-                fprintf(CONTEXT->fptr, "  selectedCourses:\n");
+                EMIT_LITERAL(CONTEXT->out, "  selectedCourses:\n");
                 for ( j = 0; j < nara_selected_course_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_selected_course_labels[j]);
-                    for ( i = 0; i < nara_selected_course_category_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_selected_course_category_labels[i], school->selectedCourses[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_selected_course_labels[j], ":\n");
+                    for ( i = 0; i < nara_selected_course_category_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_selected_course_category_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->selectedCourses[j][i], "\n");
+                    }
                 }
                 
-                fprintf(CONTEXT->fptr, "  graduates:\n");
-                for ( j = 0; j < nara_ethnicity_max; j++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[j], school->graduateCounts[j]);
+                EMIT_LITERAL(CONTEXT->out, "  graduates:\n");
+                for ( j = 0; j < nara_ethnicity_max; j++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[j], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->graduateCounts[j], "\n");
+                }
             }            
             break;
         }
@@ -353,64 +340,46 @@ __nara_record_export_school(
         case nara_export_format_csv: {
             nara_export_context_csv_t   *CONTEXT = (nara_export_context_csv_t*)exportContext;
             
-            if ( CONTEXT->schoolFptr ) {
-                fprintf(CONTEXT->schoolFptr,
-                        "%u,"
-                        "%u,"
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%g,"
-                        "%u,"
-                        "%g,"
-                        "%u,"
-                        "%u,",
-                        school->systemOECode,
-                        school->selectionCode,
-                        schoolName,
-                        schoolStreetAddress,
-                        schoolZipCode,
-                        school->shouldSchoolHaveCompletedPart6,
-                        school->isSpecialEdProgramNotOffered,
-                        school->isItem7Completed,
-                        school->isSection3Completed,
-                        school->shouldSchoolHaveCompletedItem8,
-                        school->shouldSchoolHaveCompletedItem9,
-                        school->sampleWeight,
-                        school->isSubSampledDistrict,
-                        school->subSampledWeight,
-                        school->isSubSampledSchool,
-                        school->numberOfClassroomsSurveyed
-                    );
+            if ( CONTEXT->schoolOut ) {
+                EMIT_U32(CONTEXT->schoolOut, "", school->systemOECode, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->selectionCode, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", schoolName, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", schoolStreetAddress, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", schoolZipCode, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->shouldSchoolHaveCompletedPart6, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isSpecialEdProgramNotOffered, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isItem7Completed, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isSection3Completed, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->shouldSchoolHaveCompletedItem8, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->shouldSchoolHaveCompletedItem9, ",");
+                EMIT_FLOAT(CONTEXT->schoolOut, "", school->sampleWeight, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isSubSampledDistrict, ",");
+                EMIT_FLOAT(CONTEXT->schoolOut, "", school->subSampledWeight, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->isSubSampledSchool, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->numberOfClassroomsSurveyed, ",");
                 
                 for ( j = 0; j < nara_classroom_survey_slots; j++ )
                     for ( i = 0; i < nara_classroom_survey_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->classroomSurveys[j][i]);
+                        EMIT_U32(CONTEXT->schoolOut, "", school->classroomSurveys[j][i], ",");
                 
                 for ( j = 0; j < nara_grade_max; j++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->isGradeOffered[j]);
+                    EMIT_U32(CONTEXT->schoolOut, "", school->isGradeOffered[j], ",");
                 
                 for ( j = 0; j < nara_pupils_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->pupilCounts[j][i]);
+                        EMIT_U32(CONTEXT->schoolOut, "", school->pupilCounts[j][i], ",");
                 
                 for ( j = 0; j < nara_special_ed_max; j++ )
                     for ( i = 0; i < nara_special_ed_category_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->specialEd[j][i]);
+                        EMIT_U32(CONTEXT->schoolOut, "", school->specialEd[j][i], ",");
                 
                 for ( j = 0; j < nara_selected_course_max; j++ )
                     for ( i = 0; i < nara_selected_course_category_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->selectedCourses[j][i]);
+                        EMIT_U32(CONTEXT->schoolOut, "", school->selectedCourses[j][i], ",");
                 
                 for ( j = 0; j < nara_ethnicity_max - 1; j++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->graduateCounts[j]);
-                fprintf(CONTEXT->schoolFptr, "%u\n", school->graduateCounts[j]);
+                    EMIT_U32(CONTEXT->schoolOut, "", school->graduateCounts[j], ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->graduateCounts[j], "\n");
             }
             break;
         }
@@ -420,11 +389,43 @@ __nara_record_export_school(
 
 /**/
 
-nara_record_t*
-__nara_record_destroy_school(
-    nara_record_t       *theRecord
+static void
+__nara_record_columns_school(
+    nara_record_columns_t   columns
 )
 {
-    free((void*)theRecord);
-    return NULL;
+    unsigned int            i, j;
+    
+    COLUMN_U32(columns, nara_school_t, systemOECode, "systemOECode");
+    COLUMN_U32(columns, nara_school_t, selectionCode, "selectionCode");
+    COLUMN_STR(columns, nara_school_t, schoolName, "schoolName");
+    COLUMN_STR(columns, nara_school_t, schoolStreetAddress, "schoolStreetAddress");
+    COLUMN_STR(columns, nara_school_t, schoolZipCode, "schoolZipCode");
+    COLUMN_U32(columns, nara_school_t, shouldSchoolHaveCompletedPart6, "schoolShouldHaveCompletedPart6");
+    COLUMN_U32(columns, nara_school_t, isSpecialEdProgramNotOffered, "isSpecialEdProgramNotOffered");
+    COLUMN_U32(columns, nara_school_t, isItem7Completed, "isItem7Completed");
+    COLUMN_U32(columns, nara_school_t, isSection3Completed, "isSection3Completed");
+    COLUMN_U32(columns, nara_school_t, shouldSchoolHaveCompletedItem8, "shouldSchoolHaveCompletedItem8");
+    COLUMN_U32(columns, nara_school_t, shouldSchoolHaveCompletedItem9, "shouldSchoolHaveCompletedItem9");
+    COLUMN_FLOAT(columns, nara_school_t, sampleWeight, "samplingWeight");
+    COLUMN_U32(columns, nara_school_t, isSubSampledDistrict, "isSubSampledDistrict");
+    COLUMN_FLOAT(columns, nara_school_t, subSampledWeight, "subSampledWeight");
+    COLUMN_U32(columns, nara_school_t, isSubSampledSchool, "isSubSampledSchool");
+    COLUMN_U32(columns, nara_school_t, numberOfClassroomsSurveyed, "numberOfClassroomsSurveyed");
+    for ( j = 0; j < nara_classroom_survey_slots; j++ )
+        for ( i = 0; i < nara_classroom_survey_max; i++ )
+            COLUMN_U32(columns, nara_school_t, classroomSurveys[j][i], "\"classroomSurvey_%u_%s\"", j + 1, nara_classroom_survey_labels[i]);
+    for ( j = 0; j < nara_grade_max; j++ )
+        COLUMN_U32(columns, nara_school_t, isGradeOffered[j], "\"isGradeOffered%s\"", nara_grade_labels[j]);
+    for ( j = 0; j < nara_pupils_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, pupilCounts[j][i], "\"pupils_%s_%s\"", nara_pupils_labels[j], nara_ethnicity_labels[i]);
+    for ( j = 0; j < nara_special_ed_max; j++ )
+        for ( i = 0; i < nara_special_ed_category_max; i++ )
+            COLUMN_U32(columns, nara_school_t, specialEd[j][i], "\"specialEd_%s_%s\"", nara_special_ed_labels[j], nara_special_ed_category_labels[i]);
+    for ( j = 0; j < nara_selected_course_max; j++ )
+        for ( i = 0; i < nara_selected_course_category_max; i++ )
+            COLUMN_U32(columns, nara_school_t, selectedCourses[j][i], "\"selectedCourse_%s_%s\"", nara_selected_course_labels[j], nara_selected_course_category_labels[i]);
+    for ( j = 0; j < nara_ethnicity_max; j++ )
+        COLUMN_U32(columns, nara_school_t, graduateCounts[j], "\"graduates_%s\"", nara_ethnicity_labels[j]);
 }
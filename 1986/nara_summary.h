@@ -12,12 +12,11 @@
 
 
 /* Alias the classroom type to summary: */
-#define __nara_record_is_type_classroom __nara_record_is_type_summary
 #define __nara_record_process_classroom __nara_record_process_summary
 #define __nara_export_init_classroom __nara_export_init_summary
 #define __nara_record_export_classroom __nara_record_export_summary
 #define __nara_export_destroy_classroom __nara_export_destroy_summary
-#define __nara_record_destroy_classroom __nara_record_destroy_summary
+#define __nara_record_columns_classroom __nara_record_columns_summary
 
 
 #include "nara_district.h"
@@ -33,18 +33,7 @@ typedef union {
 
 /**/
 
-int
-__nara_record_is_type_summary(
-    nara_record_t*      theRecord,
-    size_t              byteSize
-)
-{
-    return ( (byteSize == NARA_1986_RECORD_SIZE) && (nara_be_to_host_32(theRecord->recordType) == nara_record_type_classroom) );
-}
-
-/**/
-
-nara_record_t*
+static nara_record_t*
 __nara_record_process_summary(
     nara_record_t*      theRecord
 )
@@ -54,28 +43,21 @@ __nara_record_process_summary(
     char                        *fromPtr, *toPtr;
     size_t                      fromLen, toLen;
     
-    unsigned int                i, iMax;
-    
-    iMax = sizeof(summary->compact.f1) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) summary->compact.f1[i] = nara_be_to_host_32(summary->compact.f1[i]);
+    nara_be_to_host_u32_array(summary->compact.f1, sizeof(summary->compact.f1) / sizeof(uint32_t));
     
-    iMax = sizeof(summary->compact.f2) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) summary->compact.f2[i] = nara_be_to_host_32(summary->compact.f2[i]);
+    nara_be_to_host_u32_array(summary->compact.f2, sizeof(summary->compact.f2) / sizeof(uint32_t));
     
-    summary->compact.f3 = nara_be_to_host_float(summary->compact.f3);
+    summary->compact.f3 = nara_be_to_host_f32(summary->compact.f3);
     
-    summary->compact.f4 = nara_be_to_host_32(summary->compact.f4);
+    summary->compact.f4 = nara_be_to_host_u32(summary->compact.f4);
     
-    summary->compact.f5 = nara_be_to_host_float(summary->compact.f5);
+    summary->compact.f5 = nara_be_to_host_f32(summary->compact.f5);
     
-    iMax = sizeof(summary->compact.f6) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) summary->compact.f6[i] = nara_be_to_host_32(summary->compact.f6[i]);
+    nara_be_to_host_u32_array(summary->compact.f6, sizeof(summary->compact.f6) / sizeof(uint32_t));
     
-    iMax = sizeof(summary->compact.f7) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) summary->compact.f7[i] = nara_be_to_host_32(summary->compact.f7[i]);
+    nara_be_to_host_u32_array(summary->compact.f7, sizeof(summary->compact.f7) / sizeof(uint32_t));
     
-    iMax = sizeof(summary->compact.f8) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) summary->compact.f8[i] = nara_be_to_host_32(summary->compact.f8[i]);
+    nara_be_to_host_u32_array(summary->compact.f8, sizeof(summary->compact.f8) / sizeof(uint32_t));
     
     TRANSCODE(summary, systemName, "district name");
     TRANSCODE(summary, systemStreetAddress, "district street address");
@@ -89,7 +71,7 @@ __nara_record_process_summary(
 
 /**/
 
-void
+static void
 __nara_export_init_summary(
     nara_export_context_t   exportContext
 )
@@ -109,8 +91,8 @@ __nara_export_init_summary(
             /*
              * Write column headers to the file:
              */
-            if ( CONTEXT->classroomFptr ) {
-                fprintf(CONTEXT->classroomFptr,
+            if ( CONTEXT->classroomOut ) {
+                EMIT_LITERAL(CONTEXT->classroomOut,
                         "systemOECode,"
                         "selectionCode,"
                         "systemName,"
@@ -125,7 +107,6 @@ __nara_export_init_summary(
                         "isSubSampledDistrict,"
                         "subSampledWeight,"
                         "isSubSampledSchool,"
-                        
                         "schoolShouldHaveCompletedPart6,"
                         "numberOfClassroomsSurveyed,"
                         "isSpecialEdProgramNotOffered,"
@@ -133,7 +114,6 @@ __nara_export_init_summary(
                         "isSection3Completed,"
                         "shouldSchoolHaveCompletedItem8,"
                         "shouldSchoolHaveCompletedItem9,"
-                        
                         "isCourtOrderYesFederal,"
                         "isCourtOrderYesState,"
                         "isCourtOrderNo,"
@@ -145,30 +125,38 @@ __nara_export_init_summary(
                     );
                 
                 for ( j = 0; j < nara_pupils_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->classroomFptr, "\"pupils_%s_%s\",", nara_pupils_labels[j], nara_ethnicity_labels[i]);
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->classroomOut, "\"pupils_", nara_pupils_labels[j], "");
+                        EMIT_STR(CONTEXT->classroomOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
                 
                 for ( j = 0; j < nara_special_ed_max; j++ )
-                    for ( i = 0; i < nara_special_ed_category_max; i++ )
-                        fprintf(CONTEXT->classroomFptr, "\"specialEd_%s_%s\",", nara_special_ed_labels[j], nara_special_ed_category_labels[i]);
+                    for ( i = 0; i < nara_special_ed_category_max; i++ ) {
+                        EMIT_STR(CONTEXT->classroomOut, "\"specialEd_", nara_special_ed_labels[j], "");
+                        EMIT_STR(CONTEXT->classroomOut, "_", nara_special_ed_category_labels[i], "\",");
+                    }
                 
                 for ( j = 0; j < nara_selected_course_max; j++ )
-                    for ( i = 0; i < nara_selected_course_category_max; i++ )
-                        fprintf(CONTEXT->classroomFptr, "\"selectedCourse_%s_%s\",", nara_selected_course_labels[j], nara_selected_course_category_labels[i]);
+                    for ( i = 0; i < nara_selected_course_category_max; i++ ) {
+                        EMIT_STR(CONTEXT->classroomOut, "\"selectedCourse_", nara_selected_course_labels[j], "");
+                        EMIT_STR(CONTEXT->classroomOut, "_", nara_selected_course_category_labels[i], "\",");
+                    }
                 
                 for ( j = 0; j < nara_ethnicity_max; j++ )
-                    fprintf(CONTEXT->classroomFptr, "\"graduates_%s\",", nara_ethnicity_labels[j]);
+                    EMIT_STR(CONTEXT->classroomOut, "\"graduates_", nara_ethnicity_labels[j], "\",");
                 
                 for ( j = 0; j < nara_classroom_survey_slots + nara_classroom_survey_slots_additional; j++ )
-                    for ( i = 0; i < nara_classroom_survey_max; i++ )
-                        fprintf(CONTEXT->classroomFptr, "\"classroomSurvey_%u_%s\",", (j + 1), nara_classroom_survey_labels[i]);
+                    for ( i = 0; i < nara_classroom_survey_max; i++ ) {
+                        EMIT_U32(CONTEXT->classroomOut, "\"classroomSurvey_", (j + 1), "");
+                        EMIT_STR(CONTEXT->classroomOut, "_", nara_classroom_survey_labels[i], "\",");
+                    }
                 
                 for ( i = 1; i <= 32; i++ )
-                    fprintf(CONTEXT->classroomFptr, "errorBitArray_%d,", i);
-                    
+                    EMIT_U32(CONTEXT->classroomOut, "errorBitArray_", i, ",");
+                
                 for ( i = 1; i <= 82; i++ )
-                    fprintf(CONTEXT->classroomFptr, "conditionCode_%d,", i);
-                fprintf(CONTEXT->classroomFptr, "conditionCode_%d\n", i);
+                    EMIT_U32(CONTEXT->classroomOut, "conditionCode_", i, ",");
+                EMIT_U32(CONTEXT->classroomOut, "conditionCode_", i, "\n");
             }
             break;
         }
@@ -177,7 +165,7 @@ __nara_export_init_summary(
 
 /**/
 
-void
+static void
 __nara_export_destroy_summary(
     nara_export_context_t   exportContext
 )
@@ -186,7 +174,7 @@ __nara_export_destroy_summary(
 
 /**/
 
-void
+static void
 __nara_record_export_summary(
     nara_export_context_t   exportContext,
     nara_record_t           *theRecord
@@ -215,76 +203,47 @@ __nara_record_export_summary(
         case nara_export_format_yaml: {
             nara_export_context_yaml_t  *CONTEXT = (nara_export_context_yaml_t*)exportContext;
             
-            if ( CONTEXT->fptr ) {
-                fprintf(CONTEXT->fptr,
-                        "- recordType: summary\n"
-                        "  systemOECode: %u\n"
-                        "  selectionCode: %u\n"
-                        "  systemName: %s\n"
-                        "  systemStreetAddress: %s\n"
-                        "  systemCounty: %s\n"
-                        "  systemCity: %s\n"
-                        "  systemStatAbbrev: %s\n"
-                        "  systemZipCode: %s\n"
-                        "  numSchoolsInSchoolSystem: %u\n"
-                        "  numSchoolsReporting: %u\n"
-                        "  samplingWeight: %g\n"
-                        "  isSubSampledDistrict: %u\n"
-                        "  subSampledWeight: %g\n"
-                        "  isSubSampledSchool: %u\n"
-                        "  schoolShouldHaveCompletedPart6: %u\n"
-                        "  numberOfClassroomsSurveyed: %u\n"
-                        "  isSpecialEdProgramNotOffered: %u\n"
-                        "  isItem7Completed: %u\n"
-                        "  isSection3Completed: %u\n"
-                        "  shouldSchoolHaveCompletedItem8: %u\n"
-                        "  shouldSchoolHaveCompletedItem9: %u\n"
-                        "  isCourtOrderYesFederal: %u\n"
-                        "  isCourtOrderYesState: %u\n"
-                        "  isCourtOrderNo: %u\n"
-                        "  childrenAwaitingInitEval: %u\n"
-                        "  childrenRequireSpecialEd: %u\n"
-                        "  childrenReceiveSpecialEdInDistrict: %u\n"
-                        "  childrenReceiveSpecialEdNonDistrict: %u\n"
-                        "  hasMoreThan10Classes: %u\n",
-                        summary->systemOECode,
-                        summary->selectionCode,
-                        systemName,
-                        systemStreetAddress,
-                        systemCounty,
-                        systemCity,
-                        systemStateAbbrev,
-                        systemZipCode,
-                        summary->numSchoolsInSchoolSystem,
-                        summary->numSchoolsReporting,
-                        summary->sampleWeight,
-                        summary->isSubSampledDistrict,
-                        summary->subSampledWeight,
-                        summary->isSubSampledSchool,
-                        summary->shouldSchoolHaveCompletedPart6,
-                        summary->numberOfClassroomsSurveyed,
-                        summary->isSpecialEdProgramNotOffered,
-                        summary->isItem7Completed,
-                        summary->isSection3Completed,
-                        summary->shouldSchoolHaveCompletedItem8,
-                        summary->shouldSchoolHaveCompletedItem9,
-                        summary->isCourtOrderYesFederal,
-                        summary->isCourtOrderYesState,
-                        summary->isCourtOrderNo,
-                        summary->childrenAwaitingInitEval,
-                        summary->childrenRequireSpecialEd,
-                        summary->childrenReceiveSpecialEdInDistrict,
-                        summary->childrenReceiveSpecialEdNonDistrict,
-                        summary->hasMoreThan10Classes
-                    );
+            if ( CONTEXT->out ) {
+                EMIT_LITERAL(CONTEXT->out, "- recordType: summary\n");
+                EMIT_U32(CONTEXT->out, "  systemOECode: ", summary->systemOECode, "\n");
+                EMIT_U32(CONTEXT->out, "  selectionCode: ", summary->selectionCode, "\n");
+                EMIT_STR(CONTEXT->out, "  systemName: ", systemName, "\n");
+                EMIT_STR(CONTEXT->out, "  systemStreetAddress: ", systemStreetAddress, "\n");
+                EMIT_STR(CONTEXT->out, "  systemCounty: ", systemCounty, "\n");
+                EMIT_STR(CONTEXT->out, "  systemCity: ", systemCity, "\n");
+                EMIT_STR(CONTEXT->out, "  systemStatAbbrev: ", systemStateAbbrev, "\n");
+                EMIT_STR(CONTEXT->out, "  systemZipCode: ", systemZipCode, "\n");
+                EMIT_U32(CONTEXT->out, "  numSchoolsInSchoolSystem: ", summary->numSchoolsInSchoolSystem, "\n");
+                EMIT_U32(CONTEXT->out, "  numSchoolsReporting: ", summary->numSchoolsReporting, "\n");
+                EMIT_FLOAT(CONTEXT->out, "  samplingWeight: ", summary->sampleWeight, "\n");
+                EMIT_U32(CONTEXT->out, "  isSubSampledDistrict: ", summary->isSubSampledDistrict, "\n");
+                EMIT_FLOAT(CONTEXT->out, "  subSampledWeight: ", summary->subSampledWeight, "\n");
+                EMIT_U32(CONTEXT->out, "  isSubSampledSchool: ", summary->isSubSampledSchool, "\n");
+                EMIT_U32(CONTEXT->out, "  schoolShouldHaveCompletedPart6: ", summary->shouldSchoolHaveCompletedPart6, "\n");
+                EMIT_U32(CONTEXT->out, "  numberOfClassroomsSurveyed: ", summary->numberOfClassroomsSurveyed, "\n");
+                EMIT_U32(CONTEXT->out, "  isSpecialEdProgramNotOffered: ", summary->isSpecialEdProgramNotOffered, "\n");
+                EMIT_U32(CONTEXT->out, "  isItem7Completed: ", summary->isItem7Completed, "\n");
+                EMIT_U32(CONTEXT->out, "  isSection3Completed: ", summary->isSection3Completed, "\n");
+                EMIT_U32(CONTEXT->out, "  shouldSchoolHaveCompletedItem8: ", summary->shouldSchoolHaveCompletedItem8, "\n");
+                EMIT_U32(CONTEXT->out, "  shouldSchoolHaveCompletedItem9: ", summary->shouldSchoolHaveCompletedItem9, "\n");
+                EMIT_U32(CONTEXT->out, "  isCourtOrderYesFederal: ", summary->isCourtOrderYesFederal, "\n");
+                EMIT_U32(CONTEXT->out, "  isCourtOrderYesState: ", summary->isCourtOrderYesState, "\n");
+                EMIT_U32(CONTEXT->out, "  isCourtOrderNo: ", summary->isCourtOrderNo, "\n");
+                EMIT_U32(CONTEXT->out, "  childrenAwaitingInitEval: ", summary->childrenAwaitingInitEval, "\n");
+                EMIT_U32(CONTEXT->out, "  childrenRequireSpecialEd: ", summary->childrenRequireSpecialEd, "\n");
+                EMIT_U32(CONTEXT->out, "  childrenReceiveSpecialEdInDistrict: ", summary->childrenReceiveSpecialEdInDistrict, "\n");
+                EMIT_U32(CONTEXT->out, "  childrenReceiveSpecialEdNonDistrict: ", summary->childrenReceiveSpecialEdNonDistrict, "\n");
+                EMIT_U32(CONTEXT->out, "  hasMoreThan10Classes: ", summary->hasMoreThan10Classes, "\n");
                 
                 if ( summary->numberOfClassroomsSurveyed > 0 ) {
-                    fprintf(CONTEXT->fptr, "  classroomSurvey:\n");
+                    EMIT_LITERAL(CONTEXT->out, "  classroomSurvey:\n");
                     k = (summary->numberOfClassroomsSurveyed < nara_classroom_survey_slots) ? summary->numberOfClassroomsSurveyed : nara_classroom_survey_slots;
                     for ( j = 0; j < k; j++ ) {
                         char        *prefix = "    - ";
                         for ( i = 0; i < nara_classroom_survey_max; i++ ) {
-                            fprintf(CONTEXT->fptr, "%s\"%s\": %u\n", prefix, nara_classroom_survey_labels[i], summary->classroomSurveys[j][i]);
+                            EMIT_STR(CONTEXT->out, "", prefix, "");
+                            EMIT_QUOTED_STR(CONTEXT->out, "", nara_classroom_survey_labels[i], "");
+                            EMIT_U32(CONTEXT->out, ": ", summary->classroomSurveys[j][i], "\n");
                             prefix = "      ";
                         }
                     }
@@ -294,45 +253,55 @@ __nara_record_export_summary(
                         for ( j = 0; j < k; j++ ) {
                             char        *prefix = "    - ";
                             for ( i = 0; i < nara_classroom_survey_max; i++ ) {
-                                fprintf(CONTEXT->fptr, "%s\"%s\": %u\n", prefix, nara_classroom_survey_labels[i], summary->additionalClassroomSurveys[j][i]);
+                                EMIT_STR(CONTEXT->out, "", prefix, "");
+                                EMIT_QUOTED_STR(CONTEXT->out, "", nara_classroom_survey_labels[i], "");
+                                EMIT_U32(CONTEXT->out, ": ", summary->additionalClassroomSurveys[j][i], "\n");
                                 prefix = "      ";
                             }
                         }
                     }
                 }
                 
-                fprintf(CONTEXT->fptr, "  pupils:\n");
+                EMIT_LITERAL(CONTEXT->out, "  pupils:\n");
                 for ( j = 0; j < nara_pupils_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_pupils_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], summary->pupilCounts[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_pupils_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", summary->pupilCounts[j][i], "\n");
+                    }
                 }
                 
-                fprintf(CONTEXT->fptr, "  specialEd:\n");
+                EMIT_LITERAL(CONTEXT->out, "  specialEd:\n");
                 for ( j = 0; j < nara_special_ed_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_special_ed_labels[j]);
-                    for ( i = 0; i < nara_special_ed_category_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_special_ed_category_labels[i], summary->specialEd[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_special_ed_labels[j], ":\n");
+                    for ( i = 0; i < nara_special_ed_category_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_special_ed_category_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", summary->specialEd[j][i], "\n");
+                    }
                 }
                 
-                fprintf(CONTEXT->fptr, "  selectedCourses:\n");
+                EMIT_LITERAL(CONTEXT->out, "  selectedCourses:\n");
                 for ( j = 0; j < nara_selected_course_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_selected_course_labels[j]);
-                    for ( i = 0; i < nara_selected_course_category_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_selected_course_category_labels[i], summary->selectedCourses[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_selected_course_labels[j], ":\n");
+                    for ( i = 0; i < nara_selected_course_category_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_selected_course_category_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", summary->selectedCourses[j][i], "\n");
+                    }
                 }
                 
-                fprintf(CONTEXT->fptr, "  graduates:\n");
-                for ( j = 0; j < nara_ethnicity_max; j++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[j], summary->graduateCounts[j]);
-
-                fprintf(CONTEXT->fptr, "  errorBitArray:\n");
+                EMIT_LITERAL(CONTEXT->out, "  graduates:\n");
+                for ( j = 0; j < nara_ethnicity_max; j++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[j], "");
+                    EMIT_U32(CONTEXT->out, ": ", summary->graduateCounts[j], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  errorBitArray:\n");
                 for ( i = 0; i < 32; i++ )
-                    fprintf(CONTEXT->fptr, "    - %u\n", summary->errorBitArray[i]);
-
-                fprintf(CONTEXT->fptr, "  conditionCodes:\n");
+                    EMIT_U32(CONTEXT->out, "    - ", summary->errorBitArray[i], "\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  conditionCodes:\n");
                 for ( i = 0; i < 82; i++ )
-                    fprintf(CONTEXT->fptr, "    - %u\n", summary->conditionCodes[i]);
+                    EMIT_U32(CONTEXT->out, "    - ", summary->conditionCodes[i], "\n");
             }            
             break;
         }
@@ -340,93 +309,66 @@ __nara_record_export_summary(
         case nara_export_format_csv: {
             nara_export_context_csv_t   *CONTEXT = (nara_export_context_csv_t*)exportContext;
             
-            if ( CONTEXT->classroomFptr ) {
-                fprintf(CONTEXT->classroomFptr,
-                        "%u,"
-                        "%u,"
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "%u,"
-                        "%u,"
-                        "%g,"
-                        "%u,"
-                        "%g,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,",
-                        summary->systemOECode,
-                        summary->selectionCode,
-                        systemName,
-                        systemStreetAddress,
-                        systemCounty,
-                        systemCity,
-                        systemStateAbbrev,
-                        systemZipCode,
-                        summary->numSchoolsInSchoolSystem,
-                        summary->numSchoolsReporting,
-                        summary->sampleWeight,
-                        summary->isSubSampledDistrict,
-                        summary->subSampledWeight,
-                        summary->isSubSampledSchool,
-                        summary->shouldSchoolHaveCompletedPart6,
-                        summary->numberOfClassroomsSurveyed,
-                        summary->isSpecialEdProgramNotOffered,
-                        summary->isItem7Completed,
-                        summary->isSection3Completed,
-                        summary->shouldSchoolHaveCompletedItem8,
-                        summary->shouldSchoolHaveCompletedItem9,
-                        summary->isCourtOrderYesFederal,
-                        summary->isCourtOrderYesState,
-                        summary->isCourtOrderNo,
-                        summary->childrenAwaitingInitEval,
-                        summary->childrenRequireSpecialEd,
-                        summary->childrenReceiveSpecialEdInDistrict,
-                        summary->childrenReceiveSpecialEdNonDistrict,
-                        summary->hasMoreThan10Classes
-                    );
+            if ( CONTEXT->classroomOut ) {
+                EMIT_U32(CONTEXT->classroomOut, "", summary->systemOECode, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->selectionCode, ",");
+                EMIT_QUOTED_STR(CONTEXT->classroomOut, "", systemName, ",");
+                EMIT_QUOTED_STR(CONTEXT->classroomOut, "", systemStreetAddress, ",");
+                EMIT_QUOTED_STR(CONTEXT->classroomOut, "", systemCounty, ",");
+                EMIT_QUOTED_STR(CONTEXT->classroomOut, "", systemCity, ",");
+                EMIT_QUOTED_STR(CONTEXT->classroomOut, "", systemStateAbbrev, ",");
+                EMIT_QUOTED_STR(CONTEXT->classroomOut, "", systemZipCode, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->numSchoolsInSchoolSystem, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->numSchoolsReporting, ",");
+                EMIT_FLOAT(CONTEXT->classroomOut, "", summary->sampleWeight, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->isSubSampledDistrict, ",");
+                EMIT_FLOAT(CONTEXT->classroomOut, "", summary->subSampledWeight, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->isSubSampledSchool, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->shouldSchoolHaveCompletedPart6, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->numberOfClassroomsSurveyed, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->isSpecialEdProgramNotOffered, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->isItem7Completed, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->isSection3Completed, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->shouldSchoolHaveCompletedItem8, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->shouldSchoolHaveCompletedItem9, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->isCourtOrderYesFederal, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->isCourtOrderYesState, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->isCourtOrderNo, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->childrenAwaitingInitEval, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->childrenRequireSpecialEd, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->childrenReceiveSpecialEdInDistrict, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->childrenReceiveSpecialEdNonDistrict, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->hasMoreThan10Classes, ",");
                 
                 for ( j = 0; j < nara_pupils_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->classroomFptr, "%u,", summary->pupilCounts[j][i]);
+                        EMIT_U32(CONTEXT->classroomOut, "", summary->pupilCounts[j][i], ",");
                 
                 for ( j = 0; j < nara_special_ed_max; j++ )
                     for ( i = 0; i < nara_special_ed_category_max; i++ )
-                        fprintf(CONTEXT->classroomFptr, "%u,", summary->specialEd[j][i]);
+                        EMIT_U32(CONTEXT->classroomOut, "", summary->specialEd[j][i], ",");
                 
                 for ( j = 0; j < nara_selected_course_max; j++ )
                     for ( i = 0; i < nara_selected_course_category_max; i++ )
-                        fprintf(CONTEXT->classroomFptr, "%u,", summary->selectedCourses[j][i]);
+                        EMIT_U32(CONTEXT->classroomOut, "", summary->selectedCourses[j][i], ",");
                 
                 for ( j = 0; j < nara_ethnicity_max; j++ )
-                    fprintf(CONTEXT->classroomFptr, "%u,", summary->graduateCounts[j]);
+                    EMIT_U32(CONTEXT->classroomOut, "", summary->graduateCounts[j], ",");
                 
                 for ( j = 0; j < nara_classroom_survey_slots; j++ )
                     for ( i = 0; i < nara_classroom_survey_max; i++ )
-                        fprintf(CONTEXT->classroomFptr, "%u,", summary->classroomSurveys[j][i]);
-
+                        EMIT_U32(CONTEXT->classroomOut, "", summary->classroomSurveys[j][i], ",");
+                
+                for ( j = 0; j < nara_classroom_survey_slots_additional; j++ )
+                    for ( i = 0; i < nara_classroom_survey_max; i++ )
+                        EMIT_U32(CONTEXT->classroomOut, "", summary->additionalClassroomSurveys[j][i], ",");
+                
                 for ( i = 0; i < 32; i++ )
-                    fprintf(CONTEXT->classroomFptr, "%u,", summary->errorBitArray[i]);
-                    
+                    EMIT_U32(CONTEXT->classroomOut, "", summary->errorBitArray[i], ",");
+                
                 for ( i = 0; i < 82; i++ )
-                    fprintf(CONTEXT->classroomFptr, "%u,", summary->conditionCodes[i]);
-                fprintf(CONTEXT->classroomFptr, "%u\n", summary->conditionCodes[i]);
+                    EMIT_U32(CONTEXT->classroomOut, "", summary->conditionCodes[i], ",");
+                EMIT_U32(CONTEXT->classroomOut, "", summary->conditionCodes[i], "\n");
             }
             break;
         }
@@ -435,12 +377,62 @@ __nara_record_export_summary(
 
 /**/
 
-nara_record_t*
-__nara_record_destroy_summary(
-    nara_record_t       *theRecord
+static void
+__nara_record_columns_summary(
+    nara_record_columns_t   columns
 )
 {
-    free((void*)theRecord);
-    return NULL;
+    unsigned int            i, j;
+    
+    COLUMN_U32(columns, nara_summary_t, systemOECode, "systemOECode");
+    COLUMN_U32(columns, nara_summary_t, selectionCode, "selectionCode");
+    COLUMN_STR(columns, nara_summary_t, systemName, "systemName");
+    COLUMN_STR(columns, nara_summary_t, systemStreetAddress, "systemStreetAddress");
+    COLUMN_STR(columns, nara_summary_t, systemCounty, "systemCounty");
+    COLUMN_STR(columns, nara_summary_t, systemCity, "systemCity");
+    COLUMN_STR(columns, nara_summary_t, systemStateAbbrev, "systemStateAbbrev");
+    COLUMN_STR(columns, nara_summary_t, systemZipCode, "systemZipCode");
+    COLUMN_U32(columns, nara_summary_t, numSchoolsInSchoolSystem, "numSchoolsInSchoolSystem");
+    COLUMN_U32(columns, nara_summary_t, numSchoolsReporting, "numSchoolsReporting");
+    COLUMN_FLOAT(columns, nara_summary_t, sampleWeight, "sampleWeight");
+    COLUMN_U32(columns, nara_summary_t, isSubSampledDistrict, "isSubSampledDistrict");
+    COLUMN_FLOAT(columns, nara_summary_t, subSampledWeight, "subSampledWeight");
+    COLUMN_U32(columns, nara_summary_t, isSubSampledSchool, "isSubSampledSchool");
+    COLUMN_U32(columns, nara_summary_t, shouldSchoolHaveCompletedPart6, "schoolShouldHaveCompletedPart6");
+    COLUMN_U32(columns, nara_summary_t, numberOfClassroomsSurveyed, "numberOfClassroomsSurveyed");
+    COLUMN_U32(columns, nara_summary_t, isSpecialEdProgramNotOffered, "isSpecialEdProgramNotOffered");
+    COLUMN_U32(columns, nara_summary_t, isItem7Completed, "isItem7Completed");
+    COLUMN_U32(columns, nara_summary_t, isSection3Completed, "isSection3Completed");
+    COLUMN_U32(columns, nara_summary_t, shouldSchoolHaveCompletedItem8, "shouldSchoolHaveCompletedItem8");
+    COLUMN_U32(columns, nara_summary_t, shouldSchoolHaveCompletedItem9, "shouldSchoolHaveCompletedItem9");
+    COLUMN_U32(columns, nara_summary_t, isCourtOrderYesFederal, "isCourtOrderYesFederal");
+    COLUMN_U32(columns, nara_summary_t, isCourtOrderYesState, "isCourtOrderYesState");
+    COLUMN_U32(columns, nara_summary_t, isCourtOrderNo, "isCourtOrderNo");
+    COLUMN_U32(columns, nara_summary_t, childrenAwaitingInitEval, "childrenAwaitingInitEval");
+    COLUMN_U32(columns, nara_summary_t, childrenRequireSpecialEd, "childrenRequireSpecialEd");
+    COLUMN_U32(columns, nara_summary_t, childrenReceiveSpecialEdInDistrict, "childrenReceiveSpecialEdInDistrict");
+    COLUMN_U32(columns, nara_summary_t, childrenReceiveSpecialEdNonDistrict, "childrenReceiveSpecialEdNonDistrict");
+    COLUMN_U32(columns, nara_summary_t, hasMoreThan10Classes, "hasMoreThan10Classes");
+    for ( j = 0; j < nara_pupils_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_summary_t, pupilCounts[j][i], "\"pupils_%s_%s\"", nara_pupils_labels[j], nara_ethnicity_labels[i]);
+    for ( j = 0; j < nara_special_ed_max; j++ )
+        for ( i = 0; i < nara_special_ed_category_max; i++ )
+            COLUMN_U32(columns, nara_summary_t, specialEd[j][i], "\"specialEd_%s_%s\"", nara_special_ed_labels[j], nara_special_ed_category_labels[i]);
+    for ( j = 0; j < nara_selected_course_max; j++ )
+        for ( i = 0; i < nara_selected_course_category_max; i++ )
+            COLUMN_U32(columns, nara_summary_t, selectedCourses[j][i], "\"selectedCourse_%s_%s\"", nara_selected_course_labels[j], nara_selected_course_category_labels[i]);
+    for ( j = 0; j < nara_ethnicity_max; j++ )
+        COLUMN_U32(columns, nara_summary_t, graduateCounts[j], "\"graduates_%s\"", nara_ethnicity_labels[j]);
+    for ( j = 0; j < nara_classroom_survey_slots; j++ )
+        for ( i = 0; i < nara_classroom_survey_max; i++ )
+            COLUMN_U32(columns, nara_summary_t, classroomSurveys[j][i], "\"classroomSurvey_%u_%s\"", j + 1, nara_classroom_survey_labels[i]);
+    for ( j = 0; j < nara_classroom_survey_slots_additional; j++ )
+        for ( i = 0; i < nara_classroom_survey_max; i++ )
+            COLUMN_U32(columns, nara_summary_t, additionalClassroomSurveys[j][i], "\"classroomSurvey_%u_%s\"", nara_classroom_survey_slots + j + 1, nara_classroom_survey_labels[i]);
+    for ( i = 0; i < 32; i++ )
+        COLUMN_U32(columns, nara_summary_t, errorBitArray[i], "errorBitArray_%u", i + 1);
+    for ( i = 0; i < 83; i++ )
+        COLUMN_U32(columns, nara_summary_t, conditionCodes[i], "conditionCode_%u", i + 1);
 }
     
\ No newline at end of file
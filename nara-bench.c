@@ -0,0 +1,777 @@
+/*
+* nara-bench
+*
+* Program to benchmark the full read-process-export path on synthetic NARA
+* data archives over a range of file formats, input sizes, export formats,
+* and thread counts.
+*
+* Each conversion runs in a child process so that its peak resident set
+* size and CPU time can be collected on its own.
+*
+* Given a baseline (the JSON lines of an earlier run) the records/s of each
+* combination is checked against it, and the program exits non-zero if any
+* has fallen by more than the tolerance.
+*
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "nara_convert.h"
+#include "nara_gen.h"
+
+/*
+ * Upper limit on the number of items in each list option:
+ */
+#define NARA_BENCH_MAX_LIST         32
+
+/*
+ * Exit status when throughput has regressed against the baseline:
+ */
+#define NARA_BENCH_REGRESSED        1
+
+/*
+ * Exit status when the baseline file does not exist (yet); the perf-check test
+ * counts it as skipped rather than failed:
+ */
+#define NARA_BENCH_NO_BASELINE      77
+
+/**/
+
+/*
+ * The export formats:  the output format, the number of files it writes (zero
+ * for the columnar formats, which write a file per record type to a directory),
+ * the extension of their names (.gz or .zst compresses YAML and CSV), and any
+ * options appended to the output spec:
+ */
+typedef struct {
+    const char      *name;
+    const char      *format;
+    unsigned int    nFiles;
+    const char      *extension;
+    const char      *options;
+} nara_bench_export_t;
+
+static const nara_bench_export_t __nara_bench_exports[] = {
+        { "yaml", "yaml", 1, "yaml", "" },
+        { "csv", "csv", 3, "csv", "" },
+        { "yaml.gz", "yaml", 1, "yaml.gz", "" },
+        { "yaml.gz-1", "yaml", 1, "yaml.gz", ":level=1" },
+        { "csv.gz", "csv", 3, "csv.gz", "" },
+#ifdef HAVE_ZSTD
+        { "yaml.zst", "yaml", 1, "yaml.zst", "" },
+#endif
+        { "arrow", "arrow", 0, "arrow", "" },
+        { "parquet", "parquet", 0, "parquet", "" }
+    };
+static const unsigned int __nara_bench_n_exports = sizeof(__nara_bench_exports) / sizeof(__nara_bench_exports[0]);
+
+/*
+ * Measurements for one combination of input, export format, and thread count:
+ */
+typedef struct {
+    double          wallSeconds;
+    double          userSeconds;
+    double          systemSeconds;
+    uint64_t        peakRSSBytes;
+    uint64_t        outputBytes;
+} nara_bench_result_t;
+
+/*
+ * One combination from a baseline file:
+ */
+typedef struct {
+    char            format[16];
+    int             isEBCDIC;
+    char            export[16];
+    uint64_t        inputBytes;
+    unsigned int    nThreads;
+    double          recordsPerSecond;
+} nara_bench_baseline_t;
+
+/**/
+
+static struct option cliOptions[] = {
+        { "help",           no_argument,            0, 'h' },
+        { "directory",      required_argument,      0, 'd' },
+        { "sizes",          required_argument,      0, 's' },
+        { "exports",        required_argument,      0, 'e' },
+        { "threads",        required_argument,      0, 't' },
+        { "repeat",         required_argument,      0, 'r' },
+        { "seed",           required_argument,      0, 'S' },
+        { "mix",            required_argument,      0, 'm' },
+        { "formats",        required_argument,      0, 'f' },
+        { "json",           no_argument,            0, 'j' },
+        { "keep",           no_argument,            0, 'k' },
+        { "baseline",       required_argument,      0, 'b' },
+        { "tolerance",      required_argument,      0, 'T' },
+        { NULL, 0, 0, 0 }
+    };
+const char *cliOptionsStr = "hd:s:e:t:r:S:m:f:jkb:T:";
+
+/**/
+
+void
+usage(
+    const char      *exe
+)
+{
+    printf(
+            "usage:\n\n"
+            "    %s {options}\n\n"
+            "  options:\n\n"
+            "    -h/--help                      display this help info\n"
+            "    -d/--directory <path>          directory to hold the synthetic inputs and the\n"
+            "                                   outputs (default: .)\n"
+            "    -s/--sizes <size>{,<size>..}   input sizes to generate (default: 64M)\n"
+            "    -e/--exports <format>{,..}     export formats to benchmark (default: all)\n"
+            "    -t/--threads <N>{,<N>..}       thread counts to benchmark (default: 1 and the\n"
+            "                                   number of online CPUs)\n"
+            "    -r/--repeat <N>                run each combination N times and report the\n"
+            "                                   fastest (default: 3)\n"
+            "    -S/--seed <N>                  seed for the synthetic inputs (default: 1)\n"
+            "    -m/--mix <mix>                 record-type mix for the synthetic inputs\n"
+            "                                   (default: depends on the format, see\n"
+            "                                   nara-gen)\n"
+            "    -f/--formats <format-spec>{,..}\n"
+            "                                   file formats to benchmark (default: %s)\n"
+            "    -j/--json                      write one JSON object per line rather than a\n"
+            "                                   table\n"
+            "    -k/--keep                      do not remove the synthetic inputs when done\n"
+            "    -b/--baseline <filename>       compare records/s against the JSON lines of an\n"
+            "                                   earlier run (the last line for each format,\n"
+            "                                   export, input size, and thread count counts)\n"
+            "    -T/--tolerance <percent>       largest drop in records/s from the baseline\n"
+            "                                   that is not a regression (default: 10)\n"
+            "\n"
+            "    <size> = <N>{K|M|G|T}\n"
+            "    <format> = yaml | yaml.gz | yaml.gz-1 | csv | csv.gz | arrow | parquet\n"
+#ifdef HAVE_ZSTD
+            "               | yaml.zst\n"
+#endif
+            "    <mix> = <district-weight>:<school-weight>:<classroom-weight>\n"
+            "    <format-spec> = <layout> | <encoding> | <layout>:<encoding>\n"
+            "    <layout> = pre-1976 | 1976 | 1986\n"
+            "    <encoding> = ebcdic | ascii\n"
+            "\n"
+            "    With --baseline the exit status is %d if any combination regressed, %d if\n"
+            "    the baseline file does not exist.\n"
+            "\n",
+            exe,
+            NARA_DEFAULT_FORMAT,
+            NARA_BENCH_REGRESSED,
+            NARA_BENCH_NO_BASELINE
+        );
+}
+
+/**/
+
+/*
+ * Split a comma-separated list in-place; returns the number of items or
+ * zero if there are too many or any is empty.
+ */
+static unsigned int
+__nara_bench_split_list(
+    char            *list,
+    char            *items[NARA_BENCH_MAX_LIST]
+)
+{
+    unsigned int    nItems = 0;
+    
+    while ( 1 ) {
+        char        *comma = strchr(list, ',');
+        
+        if ( (nItems == NARA_BENCH_MAX_LIST) || (comma == list) || ! *list ) return 0;
+        items[nItems++] = list;
+        if ( ! comma ) break;
+        *comma = '\0';
+        list = comma + 1;
+    }
+    return nItems;
+}
+
+/**/
+
+static double
+__nara_bench_now(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/**/
+
+static int
+__nara_bench_convert(
+    nara_format_t           format,
+    const char              *inputPath,
+    const char              *outputSpec,
+    unsigned int            nThreads
+)
+{
+    nara_export_context_t   exportContext = nara_export_init(outputSpec);
+    nara_reader_t           reader;
+    int                     rc;
+    
+    if ( ! exportContext ) return EINVAL;
+    reader = nara_reader_open(inputPath);
+    if ( ! reader ) {
+        fprintf(stderr, "ERROR:  unable to open %s (errno = %d)\n", inputPath, errno);
+        nara_export_destroy(exportContext);
+        return errno;
+    }
+    nara_reader_set_format(reader, format);
+    rc = nara_convert(reader, exportContext, nThreads);
+    nara_reader_close(reader);
+    if ( nara_export_destroy(exportContext) && (rc == 0) ) rc = EIO;
+    return rc;
+}
+
+/**/
+
+/*
+ * Remove an output directory and the files in it; returns their total size:
+ */
+static uint64_t
+__nara_bench_remove_directory(
+    const char                  *path
+)
+{
+    DIR                         *dir = opendir(path);
+    struct dirent               *entry;
+    uint64_t                    nBytes = 0;
+    
+    if ( ! dir ) return 0;
+    while ( (entry = readdir(dir)) ) {
+        char                    filePath[2048];
+        struct stat             finfo;
+        
+        if ( (strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0) ) continue;
+        snprintf(filePath, sizeof(filePath), "%s/%s", path, entry->d_name);
+        if ( stat(filePath, &finfo) == 0 ) nBytes += finfo.st_size;
+        unlink(filePath);
+    }
+    closedir(dir);
+    rmdir(path);
+    return nBytes;
+}
+
+/**/
+
+static int
+__nara_bench_run(
+    nara_format_t               format,
+    const char                  *directory,
+    const char                  *inputPath,
+    const nara_bench_export_t   *export,
+    unsigned int                nThreads,
+    nara_bench_result_t         *result
+)
+{
+    char                        outputSpec[4096], outputPaths[3][1024];
+    size_t                      outputSpecLen;
+    struct rusage               usage;
+    double                      t0;
+    pid_t                       child;
+    int                         status;
+    unsigned int                i;
+    
+    if ( strlen(directory) > 960 ) {
+        fprintf(stderr, "ERROR:  directory path is too long: %s\n", directory);
+        return ENAMETOOLONG;
+    }
+    outputSpecLen = snprintf(outputSpec, sizeof(outputSpec), "%s", export->format);
+    if ( export->nFiles == 0 ) {
+        snprintf(outputPaths[0], sizeof(outputPaths[0]), "%s/nara-bench-output.%s", directory, export->extension);
+        outputSpecLen += snprintf(outputSpec + outputSpecLen, sizeof(outputSpec) - outputSpecLen, ":%s", outputPaths[0]);
+    }
+    for ( i = 0; i < export->nFiles; i++ ) {
+        snprintf(outputPaths[i], sizeof(outputPaths[i]), "%s/nara-bench-output.%u.%s", directory, i, export->extension);
+        outputSpecLen += snprintf(outputSpec + outputSpecLen, sizeof(outputSpec) - outputSpecLen, ":%s", outputPaths[i]);
+    }
+    snprintf(outputSpec + outputSpecLen, sizeof(outputSpec) - outputSpecLen, "%s", export->options);
+    
+    fflush(stdout);
+    t0 = __nara_bench_now();
+    child = fork();
+    if ( child < 0 ) {
+        fprintf(stderr, "ERROR:  unable to fork (errno = %d)\n", errno);
+        return errno;
+    }
+    if ( child == 0 ) _exit(__nara_bench_convert(format, inputPath, outputSpec, nThreads));
+    if ( wait4(child, &status, 0, &usage) != child ) {
+        fprintf(stderr, "ERROR:  unable to wait for conversion (errno = %d)\n", errno);
+        return errno;
+    }
+    result->wallSeconds = __nara_bench_now() - t0;
+    if ( ! WIFEXITED(status) || (WEXITSTATUS(status) != 0) ) {
+        fprintf(stderr, "ERROR:  conversion of %s to %s failed\n", inputPath, export->name);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : EINTR;
+    }
+    result->userSeconds = usage.ru_utime.tv_sec + 1e-6 * usage.ru_utime.tv_usec;
+    result->systemSeconds = usage.ru_stime.tv_sec + 1e-6 * usage.ru_stime.tv_usec;
+    result->peakRSSBytes = (uint64_t)usage.ru_maxrss * 1024;
+    
+    result->outputBytes = 0;
+    if ( export->nFiles == 0 ) result->outputBytes = __nara_bench_remove_directory(outputPaths[0]);
+    for ( i = 0; i < export->nFiles; i++ ) {
+        struct stat             finfo;
+        
+        if ( stat(outputPaths[i], &finfo) == 0 ) result->outputBytes += finfo.st_size;
+        unlink(outputPaths[i]);
+    }
+    return 0;
+}
+
+/**/
+
+static void
+__nara_bench_report(
+    int                         asJSON,
+    nara_format_t               format,
+    const nara_bench_export_t   *export,
+    uint64_t                    inputBytes,
+    uint64_t                    nRecords,
+    unsigned int                nThreads,
+    unsigned int                nRepeat,
+    const nara_bench_result_t   *result
+)
+{
+    if ( asJSON ) {
+        printf(
+                "{\"format\":\"%s\",\"ebcdic\":%s,\"export\":\"%s\",\"inputBytes\":%llu,\"records\":%llu,"
+                "\"threads\":%u,\"repeat\":%u,\"wallSeconds\":%.6f,\"cpuSeconds\":{\"user\":%.6f,\"system\":%.6f},"
+                "\"recordsPerSecond\":%.1f,\"megabytesPerSecond\":%.3f,\"peakRSSBytes\":%llu,\"outputBytes\":%llu}\n",
+                nara_format_name(format), nara_format_is_ebcdic(format) ? "true" : "false", export->name,
+                (unsigned long long)inputBytes, (unsigned long long)nRecords,
+                nThreads, nRepeat, result->wallSeconds, result->userSeconds, result->systemSeconds,
+                nRecords / result->wallSeconds, 1e-6 * inputBytes / result->wallSeconds,
+                (unsigned long long)result->peakRSSBytes, (unsigned long long)result->outputBytes
+            );
+    } else {
+        printf("%-9s %-7s %-9s %10.1f %10llu %7u %12.0f %9.2f %9.3f %9.3f %9.1f %10.1f\n",
+                nara_format_name(format), nara_format_is_ebcdic(format) ? "ebcdic" : "ascii", export->name, 1e-6 * inputBytes, (unsigned long long)nRecords,
+                nThreads, nRecords / result->wallSeconds, 1e-6 * inputBytes / result->wallSeconds,
+                result->wallSeconds, result->userSeconds + result->systemSeconds,
+                1e-6 * result->peakRSSBytes, 1e-6 * result->outputBytes
+            );
+    }
+    fflush(stdout);
+}
+
+/**/
+
+/*
+ * Copy the value of "key" in a JSON line written by __nara_bench_report() to
+ * value (without quotes); returns zero if the key is not present.
+ */
+static int
+__nara_bench_json_value(
+    const char      *line,
+    const char      *key,
+    char            *value,
+    size_t          valueLen
+)
+{
+    char            pattern[64];
+    const char      *start, *end;
+    
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    if ( ! (start = strstr(line, pattern)) ) return 0;
+    start += strlen(pattern);
+    if ( *start == '"' ) {
+        end = strchr(++start, '"');
+    } else {
+        end = start + strcspn(start, ",}");
+    }
+    if ( ! end || (end == start) || ((size_t)(end - start) >= valueLen) ) return 0;
+    memcpy(value, start, end - start);
+    value[end - start] = '\0';
+    return 1;
+}
+
+/**/
+
+/*
+ * Read a baseline file of JSON lines; lines that are not nara-bench results
+ * are skipped.  Returns zero on success.
+ */
+static int
+__nara_bench_baseline_load(
+    const char              *path,
+    nara_bench_baseline_t   **baselines,
+    unsigned int            *nBaselines
+)
+{
+    FILE                    *fptr = fopen(path, "r");
+    char                    line[1024];
+    unsigned int            capacity = 0;
+    
+    *baselines = NULL;
+    *nBaselines = 0;
+    if ( ! fptr ) {
+        fprintf(stderr, "ERROR:  unable to open baseline %s (errno = %d)\n", path, errno);
+        return errno;
+    }
+    while ( fgets(line, sizeof(line), fptr) ) {
+        nara_bench_baseline_t   baseline;
+        char                    value[64];
+        
+        memset(&baseline, 0, sizeof(baseline));
+        if ( ! __nara_bench_json_value(line, "format", baseline.format, sizeof(baseline.format)) ) continue;
+        if ( ! __nara_bench_json_value(line, "export", baseline.export, sizeof(baseline.export)) ) continue;
+        if ( ! __nara_bench_json_value(line, "ebcdic", value, sizeof(value)) ) continue;
+        baseline.isEBCDIC = (strcmp(value, "true") == 0);
+        if ( ! __nara_bench_json_value(line, "inputBytes", value, sizeof(value)) ) continue;
+        baseline.inputBytes = strtoull(value, NULL, 10);
+        if ( ! __nara_bench_json_value(line, "threads", value, sizeof(value)) ) continue;
+        baseline.nThreads = (unsigned int)strtoul(value, NULL, 10);
+        if ( ! __nara_bench_json_value(line, "recordsPerSecond", value, sizeof(value)) ) continue;
+        baseline.recordsPerSecond = strtod(value, NULL);
+        
+        if ( *nBaselines == capacity ) {
+            nara_bench_baseline_t   *more;
+            
+            capacity = capacity ? 2 * capacity : 64;
+            more = (nara_bench_baseline_t*)realloc(*baselines, capacity * sizeof(nara_bench_baseline_t));
+            if ( ! more ) {
+                fclose(fptr);
+                return ENOMEM;
+            }
+            *baselines = more;
+        }
+        (*baselines)[(*nBaselines)++] = baseline;
+    }
+    fclose(fptr);
+    return 0;
+}
+
+/**/
+
+/*
+ * Compare a result against the last matching baseline; returns non-zero if
+ * records/s fell by more than tolerance percent.
+ */
+static int
+__nara_bench_baseline_check(
+    const nara_bench_baseline_t *baselines,
+    unsigned int                nBaselines,
+    double                      tolerance,
+    nara_format_t               format,
+    const nara_bench_export_t   *export,
+    uint64_t                    inputBytes,
+    uint64_t                    nRecords,
+    unsigned int                nThreads,
+    const nara_bench_result_t   *result
+)
+{
+    const nara_bench_baseline_t *baseline = NULL;
+    double                      recordsPerSecond = nRecords / result->wallSeconds, change;
+    const char                  *formatName = nara_format_name(format);
+    unsigned int                i;
+    
+    for ( i = 0; i < nBaselines; i++ ) {
+        if ( strcmp(baselines[i].format, formatName) || (baselines[i].isEBCDIC != nara_format_is_ebcdic(format)) ) continue;
+        if ( strcmp(baselines[i].export, export->name) || (baselines[i].inputBytes != inputBytes) || (baselines[i].nThreads != nThreads) ) continue;
+        baseline = &baselines[i];
+    }
+    if ( ! baseline || (baseline->recordsPerSecond <= 0.0) ) {
+        fprintf(stderr, "WARNING:  no baseline for %s %s, %llu bytes, %u thread(s)\n",
+                formatName, export->name, (unsigned long long)inputBytes, nThreads);
+        return 0;
+    }
+    change = 100.0 * (recordsPerSecond - baseline->recordsPerSecond) / baseline->recordsPerSecond;
+    if ( change < -tolerance ) {
+        fprintf(stderr, "REGRESSION:  %s %s, %llu bytes, %u thread(s):  %.0f records/s vs. %.0f in the baseline (%+.1f%%, tolerance %.1f%%)\n",
+                formatName, export->name, (unsigned long long)inputBytes, nThreads,
+                recordsPerSecond, baseline->recordsPerSecond, change, tolerance);
+        return 1;
+    }
+    fprintf(stderr, "OK:  %s %s, %llu bytes, %u thread(s):  %.0f records/s vs. %.0f in the baseline (%+.1f%%)\n",
+            formatName, export->name, (unsigned long long)inputBytes, nThreads,
+            recordsPerSecond, baseline->recordsPerSecond, change);
+    return 0;
+}
+
+/**/
+
+int
+main(
+    int                     argc,
+    char* const             argv[]
+)
+{
+    int                     optc;
+    int                     rc = 0;
+    
+    const char              *directory = ".";
+    char                    defaultSizes[] = "64M", *sizesArg = defaultSizes;
+    char                    *exportsArg = NULL, *threadsArg = NULL, *formatsArg = NULL;
+    const char              *mixArg = NULL;
+    char                    *items[NARA_BENCH_MAX_LIST];
+    uint64_t                sizes[NARA_BENCH_MAX_LIST];
+    unsigned int            threads[NARA_BENCH_MAX_LIST];
+    const nara_bench_export_t   *exports[NARA_BENCH_MAX_LIST];
+    nara_format_t           formats[NARA_BENCH_MAX_LIST];
+    unsigned int            nSizes, nExports, nThreads, nFormats, nRepeat = 3;
+    unsigned int            iSize, iExport, iThreads, iFormat, iRepeat;
+    int                     asJSON = 0, shouldKeep = 0;
+    nara_gen_options_t      genOptions;
+    const char              *baselinePath = NULL;
+    nara_bench_baseline_t   *baselines = NULL;
+    unsigned int            nBaselines = 0, nRegressions = 0;
+    double                  tolerance = 10.0;
+    
+    nara_gen_options_init(&genOptions);
+    
+    while ( (optc = getopt_long(argc, argv, cliOptionsStr, cliOptions, NULL)) != -1 ) {
+        switch ( optc ) {
+            
+            case 'h':
+                usage(argv[0]);
+                exit(0);
+            
+            case 'd':
+                directory = optarg;
+                break;
+            
+            case 's':
+                sizesArg = optarg;
+                break;
+            
+            case 'e':
+                exportsArg = optarg;
+                break;
+            
+            case 't':
+                threadsArg = optarg;
+                break;
+            
+            case 'r': {
+                char        *endPtr;
+                long        n = strtol(optarg, &endPtr, 10);
+                
+                if ( (endPtr == optarg) || *endPtr || (n < 1) ) {
+                    fprintf(stderr, "ERROR:  invalid repeat count: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                nRepeat = (unsigned int)n;
+                break;
+            }
+            
+            case 'S': {
+                char        *endPtr;
+                
+                genOptions.seed = strtoull(optarg, &endPtr, 0);
+                if ( (endPtr == optarg) || *endPtr ) {
+                    fprintf(stderr, "ERROR:  invalid seed: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            }
+            
+            case 'm':
+                mixArg = optarg;
+                break;
+            
+            case 'f':
+                formatsArg = optarg;
+                break;
+            
+            case 'j':
+                asJSON = 1;
+                break;
+            
+            case 'k':
+                shouldKeep = 1;
+                break;
+            
+            case 'b':
+                baselinePath = optarg;
+                break;
+            
+            case 'T': {
+                char        *endPtr;
+                
+                tolerance = strtod(optarg, &endPtr);
+                if ( (endPtr == optarg) || *endPtr || (tolerance < 0.0) || (tolerance >= 100.0) ) {
+                    fprintf(stderr, "ERROR:  invalid tolerance: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            }
+            
+            default:
+                usage(argv[0]);
+                exit(EINVAL);
+            
+        }
+    }
+    if ( optind != argc ) {
+        fprintf(stderr, "ERROR:  unexpected argument: %s\n", argv[optind]);
+        usage(argv[0]);
+        exit(EINVAL);
+    }
+    
+    /* Input sizes: */
+    nSizes = __nara_bench_split_list(sizesArg, items);
+    if ( nSizes == 0 ) {
+        fprintf(stderr, "ERROR:  invalid size list\n");
+        exit(EINVAL);
+    }
+    for ( iSize = 0; iSize < nSizes; iSize++ ) {
+        if ( ! nara_gen_parse_size(items[iSize], &sizes[iSize]) || (sizes[iSize] == 0) ) {
+            fprintf(stderr, "ERROR:  invalid size: %s\n", items[iSize]);
+            exit(EINVAL);
+        }
+    }
+    
+    /* File formats (any part not given comes from the default): */
+    if ( formatsArg ) {
+        nara_format_t   defaultFormat = nara_format_default();
+        
+        nFormats = __nara_bench_split_list(formatsArg, items);
+        if ( nFormats == 0 ) {
+            fprintf(stderr, "ERROR:  invalid file format list\n");
+            exit(EINVAL);
+        }
+        for ( iFormat = 0; iFormat < nFormats; iFormat++ ) {
+            int         layout, isEBCDIC;
+            
+            if ( ! nara_format_parse(items[iFormat], &layout, &isEBCDIC) ) {
+                fprintf(stderr, "ERROR:  invalid format: %s\n", items[iFormat]);
+                exit(EINVAL);
+            }
+            formats[iFormat] = nara_format_get(( layout < 0 ) ? nara_format_layout(defaultFormat) : (unsigned int)layout, ( isEBCDIC < 0 ) ? nara_format_is_ebcdic(defaultFormat) : isEBCDIC);
+        }
+    } else {
+        formats[0] = nara_format_default();
+        nFormats = 1;
+    }
+    
+    /* Export formats: */
+    if ( exportsArg ) {
+        nExports = __nara_bench_split_list(exportsArg, items);
+        if ( nExports == 0 ) {
+            fprintf(stderr, "ERROR:  invalid export format list\n");
+            exit(EINVAL);
+        }
+        for ( iExport = 0; iExport < nExports; iExport++ ) {
+            unsigned int    i = 0;
+            
+            while ( (i < __nara_bench_n_exports) && strcmp(items[iExport], __nara_bench_exports[i].name) ) i++;
+            if ( i == __nara_bench_n_exports ) {
+                fprintf(stderr, "ERROR:  unknown export format: %s\n", items[iExport]);
+                exit(EINVAL);
+            }
+            exports[iExport] = &__nara_bench_exports[i];
+        }
+    } else {
+        for ( nExports = 0; nExports < __nara_bench_n_exports; nExports++ ) exports[nExports] = &__nara_bench_exports[nExports];
+    }
+    
+    /* Thread counts: */
+    if ( threadsArg ) {
+        nThreads = __nara_bench_split_list(threadsArg, items);
+        if ( nThreads == 0 ) {
+            fprintf(stderr, "ERROR:  invalid thread count list\n");
+            exit(EINVAL);
+        }
+        for ( iThreads = 0; iThreads < nThreads; iThreads++ ) {
+            char        *endPtr;
+            long        n = strtol(items[iThreads], &endPtr, 10);
+            
+            if ( (endPtr == items[iThreads]) || *endPtr || (n < 1) ) {
+                fprintf(stderr, "ERROR:  invalid thread count: %s\n", items[iThreads]);
+                exit(EINVAL);
+            }
+            threads[iThreads] = (unsigned int)n;
+        }
+    } else {
+        long        nCPU = sysconf(_SC_NPROCESSORS_ONLN);
+        
+        threads[0] = 1;
+        nThreads = 1;
+        if ( nCPU > 1 ) threads[nThreads++] = (unsigned int)nCPU;
+    }
+    
+    if ( baselinePath && ((rc = __nara_bench_baseline_load(baselinePath, &baselines, &nBaselines)) != 0) ) exit(( rc == ENOENT ) ? NARA_BENCH_NO_BASELINE : rc);
+    
+    nara_endian_init();
+    
+    if ( ! asJSON ) {
+        printf("%-9s %-7s %-9s %10s %10s %7s %12s %9s %9s %9s %9s %10s\n",
+                "format", "strings", "export", "input MB", "records", "threads", "records/s", "MB/s", "wall s", "cpu s", "RSS MB", "output MB"
+            );
+    }
+    
+    for ( iFormat = 0; (rc == 0) && (iFormat < nFormats); iFormat++ ) {
+        nara_format_t       format = formats[iFormat];
+        const char          *mix = mixArg ? mixArg : nara_gen_default_mix(format);
+        
+        genOptions.format = format;
+        if ( ! nara_gen_parse_mix(mix, format, genOptions.weights) ) {
+            fprintf(stderr, "ERROR:  invalid record mix for the %s format: %s\n", nara_format_name(format), mix);
+            rc = EINVAL;
+            break;
+        }
+        for ( iSize = 0; (rc == 0) && (iSize < nSizes); iSize++ ) {
+            char                inputPath[1280];
+            nara_emitter_t      out;
+            uint64_t            nRecords = 0;
+            struct stat         finfo;
+            
+            /* Generate the synthetic input: */
+            snprintf(inputPath, sizeof(inputPath), "%s/nara-bench-input.%s.%s.%llu.%llu.dat", directory, nara_format_name(format), nara_format_is_ebcdic(format) ? "ebcdic" : "ascii", (unsigned long long)sizes[iSize], (unsigned long long)genOptions.seed);
+            out = nara_emitter_open(inputPath);
+            if ( ! out ) {
+                fprintf(stderr, "ERROR:  unable to create %s (errno = %d)\n", inputPath, errno);
+                rc = errno;
+                break;
+            }
+            genOptions.targetBytes = sizes[iSize];
+            rc = nara_gen_write(out, &genOptions, &nRecords);
+            nara_emitter_close(out);
+            if ( (rc == 0) && (stat(inputPath, &finfo) != 0) ) rc = errno;
+            
+            for ( iExport = 0; (rc == 0) && (iExport < nExports); iExport++ ) {
+                for ( iThreads = 0; (rc == 0) && (iThreads < nThreads); iThreads++ ) {
+                    nara_bench_result_t     best, result;
+                    
+                    memset(&best, 0, sizeof(best));
+                    memset(&result, 0, sizeof(result));
+                    for ( iRepeat = 0; (rc == 0) && (iRepeat < nRepeat); iRepeat++ ) {
+                        rc = __nara_bench_run(format, directory, inputPath, exports[iExport], threads[iThreads], &result);
+                        if ( (rc == 0) && ((iRepeat == 0) || (result.wallSeconds < best.wallSeconds)) ) best = result;
+                    }
+                    if ( rc == 0 ) {
+                        __nara_bench_report(asJSON, format, exports[iExport], finfo.st_size, nRecords, threads[iThreads], nRepeat, &best);
+                        if ( baselinePath ) nRegressions += __nara_bench_baseline_check(baselines, nBaselines, tolerance, format, exports[iExport], finfo.st_size, nRecords, threads[iThreads], &best);
+                    }
+                }
+            }
+            if ( ! shouldKeep ) unlink(inputPath);
+        }
+    }
+    free((void*)baselines);
+    
+    if ( (rc == 0) && nRegressions ) {
+        fprintf(stderr, "ERROR:  %u combination(s) regressed by more than %.1f%%\n", nRegressions, tolerance);
+        rc = NARA_BENCH_REGRESSED;
+    }
+    return rc;
+}
@@ -0,0 +1,170 @@
+/*
+* nara-gen
+*
+* Program to write a synthetic NARA data archive file in any of the
+* formats (pre-1976, 1976, or 1986; EBCDIC or ASCII strings) for testing
+* and benchmarking.
+*
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+
+#include "nara_gen.h"
+
+/**/
+
+static struct option cliOptions[] = {
+        { "help",           no_argument,            0, 'h' },
+        { "output",         required_argument,      0, 'o' },
+        { "size",           required_argument,      0, 's' },
+        { "records",        required_argument,      0, 'n' },
+        { "seed",           required_argument,      0, 'S' },
+        { "mix",            required_argument,      0, 'm' },
+        { "format",         required_argument,      0, 'f' },
+        { NULL, 0, 0, 0 }
+    };
+const char *cliOptionsStr = "ho:s:n:S:m:f:";
+
+/**/
+
+void
+usage(
+    const char      *exe
+)
+{
+    printf(
+            "usage:\n\n"
+            "    %s {options}\n\n"
+            "  options:\n\n"
+            "    -h/--help                      display this help info\n"
+            "    -o/--output <filename>         write the archive to this file (default: - for\n"
+            "                                   stdout)\n"
+            "    -s/--size <size>               stop once at least this many bytes have been\n"
+            "                                   written (default: 64M)\n"
+            "    -n/--records <N>               write exactly N records (overrides --size)\n"
+            "    -S/--seed <N>                  seed for the random number generator (default:\n"
+            "                                   1); the same seed and options always produce\n"
+            "                                   the same file\n"
+            "    -m/--mix <mix>                 relative frequency of each record type\n"
+            "                                   (default: 1:10:40 for pre-1976, 1:20:0 for\n"
+            "                                   1976, 1:20:1 for 1986)\n"
+            "    -f/--format <format-spec>      write records in this format (default: %s)\n"
+            "\n"
+            "    <size> = <N>{K|M|G|T}\n"
+            "    <mix> = <district-weight>:<school-weight>:<classroom-weight>\n"
+            "    <format-spec> = <layout> | <encoding> | <layout>:<encoding>\n"
+            "    <layout> = pre-1976 | 1976 | 1986\n"
+            "    <encoding> = ebcdic | ascii\n"
+            "\n"
+            "    The classroom weight is that of the summary records in the 1986 format.\n"
+            "\n",
+            exe,
+            NARA_DEFAULT_FORMAT
+        );
+}
+
+/**/
+
+int
+main(
+    int                     argc,
+    char* const             argv[]
+)
+{
+    int                     optc;
+    int                     rc;
+    
+    const char              *outputPath = "-";
+    const char              *mix = NULL;
+    nara_format_t           defaultFormat;
+    int                     layout = -1, isEBCDIC = -1;
+    nara_emitter_t          out;
+    nara_gen_options_t      options;
+    
+    nara_gen_options_init(&options);
+    
+    while ( (optc = getopt_long(argc, argv, cliOptionsStr, cliOptions, NULL)) != -1 ) {
+        switch ( optc ) {
+            
+            case 'h':
+                usage(argv[0]);
+                exit(0);
+            
+            case 'o':
+                outputPath = optarg;
+                break;
+            
+            case 's':
+                if ( ! nara_gen_parse_size(optarg, &options.targetBytes) || (options.targetBytes == 0) ) {
+                    fprintf(stderr, "ERROR:  invalid size: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            
+            case 'n':
+                if ( ! nara_gen_parse_size(optarg, &options.targetRecords) || (options.targetRecords == 0) ) {
+                    fprintf(stderr, "ERROR:  invalid record count: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            
+            case 'S': {
+                char        *endPtr;
+                
+                options.seed = strtoull(optarg, &endPtr, 0);
+                if ( (endPtr == optarg) || *endPtr ) {
+                    fprintf(stderr, "ERROR:  invalid seed: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            }
+            
+            case 'm':
+                mix = optarg;
+                break;
+            
+            case 'f':
+                if ( ! nara_format_parse(optarg, &layout, &isEBCDIC) ) {
+                    fprintf(stderr, "ERROR:  invalid format: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            
+            default:
+                usage(argv[0]);
+                exit(EINVAL);
+            
+        }
+    }
+    if ( optind != argc ) {
+        fprintf(stderr, "ERROR:  unexpected argument: %s\n", argv[optind]);
+        usage(argv[0]);
+        exit(EINVAL);
+    }
+    
+    /* Whatever part of the format is not given comes from the default: */
+    defaultFormat = nara_format_default();
+    options.format = nara_format_get(( layout < 0 ) ? nara_format_layout(defaultFormat) : (unsigned int)layout, ( isEBCDIC < 0 ) ? nara_format_is_ebcdic(defaultFormat) : isEBCDIC);
+    if ( ! mix ) mix = nara_gen_default_mix(options.format);
+    if ( ! nara_gen_parse_mix(mix, options.format, options.weights) ) {
+        fprintf(stderr, "ERROR:  invalid record mix: %s\n", mix);
+        exit(EINVAL);
+    }
+    
+    nara_endian_init();
+    
+    out = nara_emitter_open(outputPath);
+    if ( ! out ) {
+        fprintf(stderr, "ERROR:  unable to open output file %s (errno = %d)\n", outputPath, errno);
+        exit(errno);
+    }
+    rc = nara_gen_write(out, &options, NULL);
+    if ( nara_emitter_close(out) && (rc == 0) ) rc = EIO;
+    
+    return rc;
+}
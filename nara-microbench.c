@@ -0,0 +1,761 @@
+/*
+* nara-microbench
+*
+* Program to time each hot kernel of the conversion in isolation on synthetic
+* records in any of the formats:  the framing headers, the per-record
+* process (byte swap) functions, EBCDIC transcoding, the LOCAL_STR_FILL()
+* trim-and-quote macro, and integer formatting.
+*
+* Each kernel runs over a set of records that fits in cache.  The warm figures
+* are the median of back-to-back passes over the set; the cold figures are the
+* median of passes that each follow a write to a buffer larger than the
+* last-level cache.
+*
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <getopt.h>
+#include <time.h>
+
+#include "nara_record.h"
+#include "nara_record_impl.h"
+#include "nara_state_header.h"
+#include "nara_record_header.h"
+#include "nara_ebcdic.h"
+#include "nara_gen.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define NARA_HAVE_TSC
+#   include <x86intrin.h>
+#endif
+
+/*
+ * Record copies are kept in cache-line-aligned slots:
+ */
+#define NARA_MICROBENCH_SLOT_ALIGN      64
+
+/*
+ * Upper limit on the number of passes timed for one measurement:
+ */
+#define NARA_MICROBENCH_MAX_PASSES      100000
+
+/*
+ * Field widths the EBCDIC kernels are compared over:
+ */
+static const size_t __nara_microbench_ebcdic_widths[] = { 4, 8, 12, 16, 24, 32, 48, 64 };
+
+/**/
+
+/*
+ * A set of records (or, for the framing kernel, a run of state chunks) that a
+ * kernel makes one pass over:
+ */
+typedef struct {
+    nara_format_t               format;
+    uint32_t                    recordType;
+    size_t                      recordSize;
+    uint8_t                     *slots;
+    size_t                      slotSize;
+    unsigned int                nRecords;
+    const nara_format_field_t   *strings;
+    unsigned int                nStrings;
+    const uint8_t               *framing;
+    size_t                      framingLength;
+    nara_emitter_t              out;
+    nara_ebcdic_kernel_t        ebcdicKernel;
+    size_t                      bytesPerPass;
+    uint64_t                    sink;
+} nara_microbench_set_t;
+
+typedef void (*nara_microbench_fn)(nara_microbench_set_t *set);
+
+/*
+ * Median time of a pass over a set:
+ */
+typedef struct {
+    double                  ns;
+    double                  cycles;
+} nara_microbench_timing_t;
+
+/**/
+
+static struct option cliOptions[] = {
+        { "help",           no_argument,            0, 'h' },
+        { "set-size",       required_argument,      0, 's' },
+        { "evict-size",     required_argument,      0, 'e' },
+        { "time",           required_argument,      0, 't' },
+        { "passes",         required_argument,      0, 'p' },
+        { "seed",           required_argument,      0, 'S' },
+        { "json",           no_argument,            0, 'j' },
+        { "format",         required_argument,      0, 'f' },
+        { NULL, 0, 0, 0 }
+    };
+const char *cliOptionsStr = "hs:e:t:p:S:jf:";
+
+/**/
+
+void
+usage(
+    const char      *exe
+)
+{
+    printf(
+            "usage:\n\n"
+            "    %s {options}\n\n"
+            "  options:\n\n"
+            "    -h/--help                      display this help info\n"
+            "    -s/--set-size <size>           bytes of records each kernel passes over\n"
+            "                                   (default: 64K)\n"
+            "    -e/--evict-size <size>         bytes written between cold passes to evict the\n"
+            "                                   set from the caches (default: 256M)\n"
+            "    -t/--time <seconds>            minimum time spent on warm passes for each\n"
+            "                                   kernel (default: 0.2)\n"
+            "    -p/--passes <N>                number of cold passes for each kernel\n"
+            "                                   (default: 15)\n"
+            "    -S/--seed <N>                  seed for the synthetic records (default: 1)\n"
+            "    -j/--json                      write one JSON object per line rather than a\n"
+            "                                   table\n"
+            "    -f/--format <format-spec>      time the kernels on records in this format\n"
+            "                                   (default: %s)\n"
+            "\n"
+            "    <size> = <N>{K|M|G|T}\n"
+            "    <format-spec> = <layout> | <encoding> | <layout>:<encoding>\n"
+            "    <layout> = pre-1976 | 1976 | 1986\n"
+            "    <encoding> = ebcdic | ascii\n"
+            "\n"
+            "    Cycles are %s.\n"
+            "\n",
+            exe,
+            NARA_DEFAULT_FORMAT,
+#ifdef NARA_HAVE_TSC
+            "time-stamp counter cycles"
+#else
+            "not available on this platform"
+#endif
+        );
+}
+
+/**/
+
+static inline void
+__nara_microbench_now(
+    double          *ns,
+    uint64_t        *cycles
+)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    *ns = 1e9 * ts.tv_sec + ts.tv_nsec;
+#ifdef NARA_HAVE_TSC
+    *cycles = __rdtsc();
+#else
+    *cycles = 0;
+#endif
+}
+
+/**/
+
+static int
+__nara_microbench_compare(
+    const void      *a,
+    const void      *b
+)
+{
+    double          A = *((const double*)a), B = *((const double*)b);
+    
+    return ( A < B ) ? -1 : ( A > B );
+}
+
+/**/
+
+static double
+__nara_microbench_median(
+    double          *values,
+    unsigned int    nValues
+)
+{
+    qsort(values, nValues, sizeof(double), __nara_microbench_compare);
+    return ( nValues % 2 ) ? values[nValues / 2] : 0.5 * (values[nValues / 2 - 1] + values[nValues / 2]);
+}
+
+/**/
+
+static void
+__nara_microbench_framing(
+    nara_microbench_set_t   *set
+)
+{
+    size_t                  offset = 0;
+    uint64_t                nRecords = 0;
+    
+    while ( offset < set->framingLength ) {
+        nara_state_header_t stateHeader;
+        size_t              recordOffset = offset + sizeof(stateHeader);
+        
+        memcpy(&stateHeader, set->framing + offset, sizeof(stateHeader));
+        nara_state_header_process(&stateHeader);
+        offset += stateHeader.recordLength;
+        while ( recordOffset < offset ) {
+            nara_record_header_t    recordHeader;
+            
+            memcpy(&recordHeader, set->framing + recordOffset, sizeof(recordHeader));
+            nara_record_header_process(&recordHeader);
+            recordOffset += recordHeader.recordLength;
+            nRecords++;
+        }
+    }
+    set->sink += nRecords;
+}
+
+/**/
+
+static void
+__nara_microbench_process(
+    nara_microbench_set_t   *set
+)
+{
+    nara_record_process_fn  processFn = set->format->processFns[set->recordType];
+    uint8_t                 *slot = set->slots;
+    unsigned int            i;
+    
+    for ( i = 0; i < set->nRecords; i++, slot += set->slotSize ) set->sink += (uintptr_t)processFn((nara_record_t*)slot);
+}
+
+/**/
+
+static void
+__nara_microbench_ebcdic(
+    nara_microbench_set_t   *set
+)
+{
+    uint8_t                 *slot = set->slots;
+    unsigned int            i, j;
+    
+    /* The records are left intact by transcoding a copy of each field: */
+    for ( i = 0; i < set->nRecords; i++, slot += set->slotSize ) {
+        for ( j = 0; j < set->nStrings; j++ ) {
+            char            s[64];
+            
+            memcpy(s, slot + set->strings[j].offset, set->strings[j].length);
+            nara_ebcdic_to_ascii_field_kernel(set->ebcdicKernel, s, set->strings[j].length);
+            set->sink += s[0];
+        }
+    }
+}
+
+/**/
+
+static void
+__nara_microbench_str_fill(
+    nara_microbench_set_t   *set
+)
+{
+    uint8_t                 *slot = set->slots;
+    unsigned int            i, j;
+    
+    for ( i = 0; i < set->nRecords; i++, slot += set->slotSize ) {
+        for ( j = 0; j < set->nStrings; j++ ) {
+            LOCAL_STR_DECL(s, 64);
+            
+            LOCAL_STR_FILL(s, set->strings[j].length, slot + set->strings[j].offset);
+            set->sink += s[0];
+        }
+    }
+}
+
+/**/
+
+static void
+__nara_microbench_format_u32(
+    nara_microbench_set_t   *set
+)
+{
+    uint8_t                 *slot = set->slots;
+    size_t                  nWords = set->recordSize / sizeof(uint32_t);
+    unsigned int            i;
+    
+    for ( i = 0; i < set->nRecords; i++, slot += set->slotSize ) {
+        const uint32_t      *words = (const uint32_t*)slot;
+        size_t              j;
+        
+        for ( j = 0; j < nWords; j++ ) EMIT_U32(set->out, "", words[j], ",");
+        EMIT_LITERAL(set->out, "\n");
+    }
+}
+
+/**/
+
+static void
+__nara_microbench_measure(
+    nara_microbench_set_t       *set,
+    nara_microbench_fn          kernelFn,
+    double                      warmSeconds,
+    unsigned int                nColdPasses,
+    uint8_t                     *evictBuffer,
+    size_t                      evictBytes,
+    double                      *passNs,
+    double                      *passCycles,
+    nara_microbench_timing_t    *warm,
+    nara_microbench_timing_t    *cold
+)
+{
+    double                      t0, t1, elapsed = 0.0;
+    uint64_t                    c0, c1;
+    unsigned int                nPasses = 0;
+    
+    /* Warm:  back-to-back passes after one to load the caches: */
+    kernelFn(set);
+    while ( (nPasses < NARA_MICROBENCH_MAX_PASSES) && ((nPasses < 5) || (elapsed < 1e9 * warmSeconds)) ) {
+        __nara_microbench_now(&t0, &c0);
+        kernelFn(set);
+        __nara_microbench_now(&t1, &c1);
+        passNs[nPasses] = t1 - t0;
+        passCycles[nPasses++] = (double)(c1 - c0);
+        elapsed += t1 - t0;
+    }
+    warm->ns = __nara_microbench_median(passNs, nPasses);
+    warm->cycles = __nara_microbench_median(passCycles, nPasses);
+    
+    /* Cold:  each pass follows a sweep through the eviction buffer: */
+    for ( nPasses = 0; nPasses < nColdPasses; nPasses++ ) {
+        memset(evictBuffer, (int)nPasses, evictBytes);
+        __nara_microbench_now(&t0, &c0);
+        kernelFn(set);
+        __nara_microbench_now(&t1, &c1);
+        passNs[nPasses] = t1 - t0;
+        passCycles[nPasses] = (double)(c1 - c0);
+    }
+    cold->ns = __nara_microbench_median(passNs, nColdPasses);
+    cold->cycles = __nara_microbench_median(passCycles, nColdPasses);
+}
+
+/**/
+
+static void
+__nara_microbench_report(
+    int                             asJSON,
+    const char                      *kernel,
+    const char                      *recordType,
+    const nara_microbench_set_t     *set,
+    const nara_microbench_timing_t  *warm,
+    const nara_microbench_timing_t  *cold
+)
+{
+    double                          bytesPerRecord = (double)set->bytesPerPass / set->nRecords;
+    
+    if ( asJSON ) {
+        printf(
+                "{\"format\":\"%s\",\"encoding\":\"%s\",\"kernel\":\"%s\",\"recordType\":\"%s\",\"records\":%u,\"bytesPerRecord\":%.1f,"
+                "\"warm\":{\"nsPerRecord\":%.3f,\"cyclesPerByte\":%.4f},\"cold\":{\"nsPerRecord\":%.3f,\"cyclesPerByte\":%.4f}}\n",
+                nara_format_name(set->format), nara_format_is_ebcdic(set->format) ? "ebcdic" : "ascii", kernel, recordType, set->nRecords, bytesPerRecord,
+                warm->ns / set->nRecords, warm->cycles / set->bytesPerPass,
+                cold->ns / set->nRecords, cold->cycles / set->bytesPerPass
+            );
+    } else {
+        printf("%-16s %-10s %8u %10.1f %12.2f %11.3f %12.2f %11.3f\n",
+                kernel, recordType, set->nRecords, bytesPerRecord,
+                warm->ns / set->nRecords, warm->cycles / set->bytesPerPass,
+                cold->ns / set->nRecords, cold->cycles / set->bytesPerPass
+            );
+    }
+    fflush(stdout);
+}
+
+/**/
+
+/*
+ * Walk the synthetic archive and call recordFn (if not NULL) on each record;
+ * for the pre-1976 format *framingLength is set to the length of the leading
+ * whole state chunks that hold at least framingLength bytes.
+ */
+typedef void (*nara_microbench_record_fn)(void *context, uint32_t recordType, const uint8_t *record);
+
+static void
+__nara_microbench_walk(
+    nara_format_t               format,
+    const uint8_t               *corpus,
+    size_t                      corpusLength,
+    size_t                      *framingLength,
+    nara_microbench_record_fn   recordFn,
+    void                        *context
+)
+{
+    size_t                      offset = 0;
+    size_t                      recordSize = nara_format_fixed_size(format);
+    size_t                      recordTypeOffset = nara_format_record_type_offset(format);
+    size_t                      framingWanted = *framingLength;
+    uint32_t                    recordType;
+    
+    *framingLength = 0;
+    if ( recordSize ) {
+        while ( offset + recordSize <= corpusLength ) {
+            memcpy(&recordType, corpus + offset + recordTypeOffset, sizeof(recordType));
+            if ( recordFn ) recordFn(context, nara_be_to_host_u32(recordType), corpus + offset);
+            offset += recordSize;
+        }
+        return;
+    }
+    while ( offset + sizeof(nara_state_header_t) <= corpusLength ) {
+        nara_state_header_t     stateHeader;
+        size_t                  recordOffset = offset + sizeof(stateHeader);
+        
+        memcpy(&stateHeader, corpus + offset, sizeof(stateHeader));
+        nara_state_header_process(&stateHeader);
+        offset += stateHeader.recordLength;
+        while ( recordOffset < offset ) {
+            nara_record_header_t    recordHeader;
+            
+            memcpy(&recordHeader, corpus + recordOffset, sizeof(recordHeader));
+            nara_record_header_process(&recordHeader);
+            memcpy(&recordType, corpus + recordOffset + sizeof(recordHeader) + recordTypeOffset, sizeof(recordType));
+            if ( recordFn ) recordFn(context, nara_be_to_host_u32(recordType), corpus + recordOffset + sizeof(recordHeader));
+            recordOffset += recordHeader.recordLength;
+        }
+        if ( *framingLength < framingWanted ) *framingLength = offset;
+    }
+}
+
+/**/
+
+/*
+ * Copy up to nRecords records of one type from the archive into a set:
+ */
+static void
+__nara_microbench_collect(
+    void                    *context,
+    uint32_t                recordType,
+    const uint8_t           *record
+)
+{
+    nara_microbench_set_t   *set = (nara_microbench_set_t*)context;
+    
+    if ( (recordType == set->recordType) && (set->bytesPerPass < set->nRecords) ) {
+        memcpy(set->slots + set->bytesPerPass * set->slotSize, record, set->recordSize);
+        set->bytesPerPass++;
+    }
+}
+
+/**/
+
+static int
+__nara_microbench_fill_set(
+    nara_microbench_set_t   *set,
+    nara_format_t           format,
+    uint32_t                recordType,
+    size_t                  setBytes,
+    const uint8_t           *corpus,
+    size_t                  corpusLength
+)
+{
+    size_t                  framingLength = 0;
+    
+    memset(set, 0, sizeof(*set));
+    set->format = format;
+    set->recordType = recordType;
+    set->recordSize = nara_format_record_size(format, recordType);
+    set->slotSize = (set->recordSize + NARA_MICROBENCH_SLOT_ALIGN - 1) & ~((size_t)NARA_MICROBENCH_SLOT_ALIGN - 1);
+    set->nRecords = ( setBytes > set->recordSize ) ? (unsigned int)(setBytes / set->recordSize) : 1;
+    set->nStrings = nara_format_string_fields(format, recordType, &set->strings);
+    if ( posix_memalign((void**)&set->slots, NARA_MICROBENCH_SLOT_ALIGN, set->nRecords * set->slotSize) != 0 ) return ENOMEM;
+    
+    /* bytesPerPass counts the records collected until it's set properly: */
+    __nara_microbench_walk(format, corpus, corpusLength, &framingLength, __nara_microbench_collect, set);
+    set->nRecords = (unsigned int)set->bytesPerPass;
+    set->bytesPerPass = 0;
+    return 0;
+}
+
+/**/
+
+/*
+ * Time each available EBCDIC kernel (auto being nara_ebcdic_to_ascii_field()
+ * itself) on the set's string fields:
+ */
+static void
+__nara_microbench_ebcdic_kernels(
+    int                         asJSON,
+    const char                  *recordType,
+    nara_microbench_set_t       *set,
+    double                      warmSeconds,
+    unsigned int                nColdPasses,
+    uint8_t                     *evictBuffer,
+    size_t                      evictBytes,
+    double                      *passNs,
+    double                      *passCycles,
+    uint64_t                    *sink
+)
+{
+    nara_microbench_timing_t    warm, cold;
+    nara_ebcdic_kernel_t        kernel;
+    
+    for ( kernel = nara_ebcdic_kernel_auto; kernel < nara_ebcdic_kernel_max; kernel++ ) {
+        char                    kernelName[32];
+        
+        if ( ! nara_ebcdic_kernel_is_available(kernel) ) continue;
+        set->ebcdicKernel = kernel;
+        __nara_microbench_measure(set, __nara_microbench_ebcdic, warmSeconds, nColdPasses, evictBuffer, evictBytes, passNs, passCycles, &warm, &cold);
+        snprintf(kernelName, sizeof(kernelName), "ebcdic_%s", nara_ebcdic_kernel_name(kernel));
+        __nara_microbench_report(asJSON, kernelName, recordType, set, &warm, &cold);
+        *sink += set->sink;
+    }
+}
+
+/**/
+
+int
+main(
+    int                         argc,
+    char* const                 argv[]
+)
+{
+    int                         optc;
+    int                         rc = 0;
+    
+    uint64_t                    setBytes = 64 << 10, evictBytes = (uint64_t)256 << 20;
+    double                      warmSeconds = 0.2;
+    unsigned int                nColdPasses = 15;
+    int                         asJSON = 0;
+    int                         layout = -1, isEBCDIC = -1;
+    nara_format_t               format, defaultFormat;
+    nara_gen_options_t          genOptions;
+    nara_emitter_t              corpusOut;
+    const uint8_t               *corpus;
+    size_t                      corpusLength;
+    uint8_t                     *evictBuffer, *ebcdicText;
+    size_t                      ebcdicTextLength = 0;
+    double                      *passNs, *passCycles;
+    nara_microbench_set_t       set;
+    nara_microbench_timing_t    warm, cold;
+    uint32_t                    recordType;
+    uint64_t                    sink = 0;
+    
+    nara_gen_options_init(&genOptions);
+    
+    while ( (optc = getopt_long(argc, argv, cliOptionsStr, cliOptions, NULL)) != -1 ) {
+        switch ( optc ) {
+            
+            case 'h':
+                usage(argv[0]);
+                exit(0);
+            
+            case 's':
+                if ( ! nara_gen_parse_size(optarg, &setBytes) || (setBytes == 0) || (setBytes > ((uint64_t)1 << 30)) ) {
+                    fprintf(stderr, "ERROR:  invalid set size: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            
+            case 'e':
+                if ( ! nara_gen_parse_size(optarg, &evictBytes) || (evictBytes == 0) ) {
+                    fprintf(stderr, "ERROR:  invalid eviction size: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            
+            case 't': {
+                char        *endPtr;
+                
+                warmSeconds = strtod(optarg, &endPtr);
+                if ( (endPtr == optarg) || *endPtr || (warmSeconds < 0.0) ) {
+                    fprintf(stderr, "ERROR:  invalid time: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            }
+            
+            case 'p': {
+                char        *endPtr;
+                long        n = strtol(optarg, &endPtr, 10);
+                
+                if ( (endPtr == optarg) || *endPtr || (n < 1) || (n > NARA_MICROBENCH_MAX_PASSES) ) {
+                    fprintf(stderr, "ERROR:  invalid pass count: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                nColdPasses = (unsigned int)n;
+                break;
+            }
+            
+            case 'S': {
+                char        *endPtr;
+                
+                genOptions.seed = strtoull(optarg, &endPtr, 0);
+                if ( (endPtr == optarg) || *endPtr ) {
+                    fprintf(stderr, "ERROR:  invalid seed: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            }
+            
+            case 'j':
+                asJSON = 1;
+                break;
+            
+            case 'f':
+                if ( ! nara_format_parse(optarg, &layout, &isEBCDIC) ) {
+                    fprintf(stderr, "ERROR:  invalid format: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            
+            default:
+                usage(argv[0]);
+                exit(EINVAL);
+            
+        }
+    }
+    if ( optind != argc ) {
+        fprintf(stderr, "ERROR:  unexpected argument: %s\n", argv[optind]);
+        usage(argv[0]);
+        exit(EINVAL);
+    }
+    
+    /* Whatever part of the format is not given comes from the default: */
+    defaultFormat = nara_format_default();
+    format = nara_format_get(( layout < 0 ) ? nara_format_layout(defaultFormat) : (unsigned int)layout, ( isEBCDIC < 0 ) ? nara_format_is_ebcdic(defaultFormat) : isEBCDIC);
+    genOptions.format = format;
+    nara_gen_parse_mix(nara_gen_default_mix(format), format, genOptions.weights);
+    
+    nara_endian_init();
+    
+    /*
+     * Generate enough records that even the rarest record type fills a set (the
+     * default mixes have at least one district per 51 records):
+     */
+    corpusOut = nara_emitter_open_memory();
+    evictBuffer = (uint8_t*)malloc(evictBytes);
+    ebcdicText = (uint8_t*)malloc(setBytes);
+    passNs = (double*)malloc(NARA_MICROBENCH_MAX_PASSES * sizeof(double));
+    passCycles = (double*)malloc(NARA_MICROBENCH_MAX_PASSES * sizeof(double));
+    if ( ! corpusOut || ! evictBuffer || ! ebcdicText || ! passNs || ! passCycles ) {
+        fprintf(stderr, "ERROR:  unable to allocate buffers\n");
+        exit(ENOMEM);
+    }
+    genOptions.targetBytes = 64 * setBytes;
+    if ( genOptions.targetBytes < ((uint64_t)16 << 20) ) genOptions.targetBytes = (uint64_t)16 << 20;
+    if ( (rc = nara_gen_write(corpusOut, &genOptions, NULL)) != 0 ) exit(rc);
+    corpus = (const uint8_t*)nara_emitter_bytes(corpusOut, &corpusLength);
+    
+    if ( ! asJSON ) {
+        printf("%-16s %-10s %8s %10s %12s %11s %12s %11s\n",
+                "kernel", "type", "records", "bytes/rec", "warm ns/rec", "warm cyc/B", "cold ns/rec", "cold cyc/B"
+            );
+    }
+    
+    if ( nara_format_fixed_size(format) == 0 ) {
+        /* Framing:  the state and record headers of the leading state chunks: */
+        memset(&set, 0, sizeof(set));
+        set.format = format;
+        set.framingLength = setBytes;
+        __nara_microbench_walk(format, corpus, corpusLength, &set.framingLength, NULL, NULL);
+        set.framing = corpus;
+        set.bytesPerPass = set.framingLength;
+        __nara_microbench_framing(&set);
+        set.nRecords = (unsigned int)set.sink;
+        __nara_microbench_measure(&set, __nara_microbench_framing, warmSeconds, nColdPasses, evictBuffer, evictBytes, passNs, passCycles, &warm, &cold);
+        __nara_microbench_report(asJSON, "framing", "all", &set, &warm, &cold);
+        sink += set.sink;
+    }
+    
+    for ( recordType = nara_record_type_district; (rc == 0) && (recordType < nara_record_type_max); recordType++ ) {
+        const char              *typeName = nara_format_record_type_name(format, recordType);
+        unsigned int            i, j;
+        
+        if ( ! nara_format_record_size(format, recordType) ) continue;
+        
+        /* Process (byte swap, plus transcoding for EBCDIC formats) in-place: */
+        if ( (rc = __nara_microbench_fill_set(&set, format, recordType, setBytes, corpus, corpusLength)) != 0 ) break;
+        if ( set.nRecords == 0 ) {
+            free((void*)set.slots);
+            continue;
+        }
+        set.bytesPerPass = set.nRecords * set.recordSize;
+        __nara_microbench_measure(&set, __nara_microbench_process, warmSeconds, nColdPasses, evictBuffer, evictBytes, passNs, passCycles, &warm, &cold);
+        __nara_microbench_report(asJSON, "process", typeName, &set, &warm, &cold);
+        sink += set.sink;
+        free((void*)set.slots);
+        
+        if ( (rc = __nara_microbench_fill_set(&set, format, recordType, setBytes, corpus, corpusLength)) != 0 ) break;
+        for ( j = 0; j < set.nStrings; j++ ) set.bytesPerPass += set.nRecords * set.strings[j].length;
+        if ( nara_format_is_ebcdic(format) ) {
+            /* Transcoding of each string field: */
+            if ( set.nStrings ) {
+                __nara_microbench_ebcdic_kernels(asJSON, typeName, &set, warmSeconds, nColdPasses, evictBuffer, evictBytes, passNs, passCycles, &sink);
+                
+                /* Keep the string bytes for the width sweep below: */
+                for ( i = 0; (i < set.nRecords) && (ebcdicTextLength < setBytes); i++ ) {
+                    for ( j = 0; (j < set.nStrings) && (ebcdicTextLength + set.strings[j].length <= setBytes); j++ ) {
+                        memcpy(ebcdicText + ebcdicTextLength, set.slots + i * set.slotSize + set.strings[j].offset, set.strings[j].length);
+                        ebcdicTextLength += set.strings[j].length;
+                    }
+                }
+            }
+            
+            /* The exporters trim strings that have already been transcoded: */
+            for ( i = 0; i < set.nRecords; i++ ) {
+                for ( j = 0; j < set.nStrings; j++ ) nara_ebcdic_to_ascii_field((char*)set.slots + i * set.slotSize + set.strings[j].offset, set.strings[j].length);
+            }
+        }
+        /* Trim-and-quote of each string field: */
+        if ( set.nStrings ) {
+            __nara_microbench_measure(&set, __nara_microbench_str_fill, warmSeconds, nColdPasses, evictBuffer, evictBytes, passNs, passCycles, &warm, &cold);
+            __nara_microbench_report(asJSON, "LOCAL_STR_FILL", typeName, &set, &warm, &cold);
+            sink += set.sink;
+        }
+        
+        /* Decimal formatting of every (host-order) word of the record: */
+        for ( i = 0; i < set.nRecords; i++ ) nara_be_to_host_u32_array((uint32_t*)(set.slots + i * set.slotSize), set.recordSize / sizeof(uint32_t));
+        set.bytesPerPass = set.nRecords * (set.recordSize & ~(sizeof(uint32_t) - 1));
+        set.out = nara_emitter_open("/dev/null");
+        if ( ! set.out ) {
+            fprintf(stderr, "ERROR:  unable to open /dev/null (errno = %d)\n", errno);
+            rc = errno;
+        } else {
+            __nara_microbench_measure(&set, __nara_microbench_format_u32, warmSeconds, nColdPasses, evictBuffer, evictBytes, passNs, passCycles, &warm, &cold);
+            __nara_microbench_report(asJSON, "format_u32", typeName, &set, &warm, &cold);
+            nara_emitter_close(set.out);
+        }
+        free((void*)set.slots);
+    }
+    
+    /*
+     * EBCDIC kernels on fields of fixed widths cut from the records' string
+     * bytes, which shows where the vector kernels start to pay off:
+     */
+    if ( (rc == 0) && ebcdicTextLength ) {
+        nara_format_field_t     field = { 0, 0, nara_format_string_text };
+        unsigned int            w;
+        
+        for ( w = 0; w < sizeof(__nara_microbench_ebcdic_widths) / sizeof(__nara_microbench_ebcdic_widths[0]); w++ ) {
+            char                widthName[16];
+            
+            memset(&set, 0, sizeof(set));
+            set.format = format;
+            field.length = __nara_microbench_ebcdic_widths[w];
+            set.strings = &field;
+            set.nStrings = 1;
+            set.slots = ebcdicText;
+            set.slotSize = field.length;
+            set.nRecords = (unsigned int)(ebcdicTextLength / field.length);
+            if ( set.nRecords == 0 ) continue;
+            set.bytesPerPass = set.nRecords * field.length;
+            snprintf(widthName, sizeof(widthName), "%zu B", field.length);
+            __nara_microbench_ebcdic_kernels(asJSON, widthName, &set, warmSeconds, nColdPasses, evictBuffer, evictBytes, passNs, passCycles, &sink);
+        }
+    }
+    
+    /* Keeps the compiler from discarding the kernels' work: */
+    if ( sink == 1 ) fprintf(stderr, "\n");
+    
+    nara_emitter_close(corpusOut);
+    free((void*)evictBuffer);
+    free((void*)ebcdicText);
+    free((void*)passNs);
+    free((void*)passCycles);
+    return rc;
+}
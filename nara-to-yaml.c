@@ -14,18 +14,28 @@
 #include <errno.h>
 #include <getopt.h>
 
-#include "nara_state_header.h"
-#include "nara_record_header.h"
-#include "nara_record.h"
+#include "nara_convert.h"
+#include "nara_stats.h"
+#include "nara_fields.h"
+#include "nara_arrow.h"
+#include "nara_parquet.h"
+#include "nara_cache.h"
 
 /**/
 
 static struct option cliOptions[] = {
         { "help",           no_argument,            0, 'h' },
         { "output",         required_argument,      0, 'o' },
+        { "threads",        required_argument,      0, 't' },
+        { "format",         required_argument,      0, 'f' },
+        { "fields",         required_argument,      0, 'F' },
+        { "where",          required_argument,      0, 'w' },
+        { "types",          required_argument,      0, 'T' },
+        { "cache",          required_argument,      0, 'c' },
+        { "stats",          optional_argument,      0, 'S' },
         { NULL, 0, 0, 0 }
     };
-const char *cliOptionsStr = "ho:";
+const char *cliOptionsStr = "ho:t:f:F:w:T:c:";
 
 /**/
 
@@ -40,33 +50,126 @@ usage(
             "  options:\n\n"
             "    -h/--help                      display this help info\n"
             "    -o/--output <output-spec>      select the format and file(s) to which output is\n"
-            "                                   written\n"
+            "                                   written; may be repeated to produce several\n"
+            "                                   outputs from a single pass over the input\n"
+            "    -t/--threads <N>               convert using N threads (regular files\n"
+            "                                   only); output is identical to a single-\n"
+            "                                   threaded run\n"
+            "    -f/--format <format-spec>      read the files in this format rather than\n"
+            "                                   detecting it (default: auto)\n"
+            "    -F/--fields <fields-spec>      output only the selected columns of a record\n"
+            "                                   type; may be repeated\n"
+            "    -w/--where <filter-spec>       output only the records for which the filter\n"
+            "                                   holds; may be repeated (all must hold)\n"
+            "    -T/--types <type-list>         output only records of these types; the others\n"
+            "                                   are skipped without being decoded\n"
+            "    -c/--cache <path>              keep the decoded records of the file in this\n"
+            "                                   cache file (of each file in it, if a directory)\n"
+            "                                   and read them from there on later runs; not\n"
+            "                                   used with --fields or --where\n"
+            "    --stats{=<stats-format>}       when done, write conversion statistics (bytes\n"
+            "                                   and records read, time per stage, throughput)\n"
+            "                                   to stderr\n"
             "\n"
             "    <output-spec> = <format>:<format-arguments>\n"
-            "    <format> = yaml | csv\n"
+            "    <format> = yaml | csv | arrow | parquet\n"
             "    <format-arguments> =\n"
-            "        yaml:   <filename>\n"
-            "        csv:    <filename>:<filename>:<filename>\n"
+            "        yaml:     <filename>{:<compression-option>..}\n"
+            "        csv:      <filename>:<filename>:<filename>{:<compression-option>..}\n"
+            "        arrow:    <directory>{:<batch-rows>}\n"
+            "        parquet:  <directory>{:<row-group-size>}\n"
             "    <filename> = <path-to-a-file> | - (meaning stdout) | <empty> (no output)\n"
             "    <empty> = \"\"\n"
+            "    <compression-option> = compress=<compression> | level=<N>\n"
+            "    <compression> = gzip | zstd | none\n"
+            "    <stats-format> = text (the default) | json\n"
+            "    <format-spec> = auto | <layout> | <encoding> | <layout>:<encoding>\n"
+            "    <layout> = pre-1976 | 1976 | 1986\n"
+            "    <encoding> = ebcdic | ascii\n"
+            "    <fields-spec> = <record-type>:<pattern>{,<pattern>..}\n"
+            "    <record-type> = district | school | classroom | summary\n"
+            "    <pattern> = a CSV column name, or a glob pattern such as pupils_*\n"
+            "    <filter-spec> = {<record-type>:}<expression>\n"
+            "    <expression> = comparisons of CSV columns and constants joined by && and ||,\n"
+            "                   e.g. 'systemState == \"ALA\" && pupils_Total > 1000'\n"
+            "    <type-list> = <record-type>{,<record-type>..}\n"
             "\n"
             "    YAML outputs to a single file, whereas CSV outputs to three separate files for\n"
             "    each record type (first is district filename, second is school filename, third\n"
-            "    is %s file name)\n"
+            "    is classroom (summary for 1986) file name)\n"
+            "\n"
+            "    A YAML or CSV file whose name ends in .gz or .zst is compressed with gzip or\n"
+            "    zstd (as is every file of the output with compress=), in blocks compressed by\n"
+            "    a pool of threads and written in order; level= sets the compression level\n"
+            "\n"
+            "    Arrow outputs an Arrow IPC (Feather v2) file per record type to the directory\n"
+            "    (district.arrow, school.arrow, classroom.arrow or summary.arrow), gathering\n"
+            "    <batch-rows> records (default: %u) into each record batch\n"
+            "\n"
+            "    Parquet likewise outputs a file per record type (district.parquet, etc.), in\n"
+            "    row groups of about <row-group-size> bytes of column data (default: %uM; K, M\n"
+            "    and G suffixes are allowed), dictionary-encoding each column and recording its\n"
+            "    minimum and maximum values\n"
             "\n"
             "    The default output specification is \"yaml:-\" to output YAML to stdout.\n"
+            "\n"
+            "    A <nara-file> of the form <archive>#<member> is a member of a zip or tar\n"
+            "    archive (the tar archive possibly compressed), read without extracting it\n"
+            "\n"
+            "    The layout and string encoding of each file are detected from its leading\n"
+            "    bytes; %s is assumed where there is nothing to go on.  Files\n"
+            "    of different layouts may be converted together to YAML, but not to CSV,\n"
+            "    Arrow or Parquet.\n"
             "\n",
             exe,
-#if defined(NARA_1986_FORMAT)
-            "summary"
-#else
-            "classroom"
-#endif
+            NARA_ARROW_DEFAULT_BATCH_ROWS,
+            NARA_PARQUET_DEFAULT_ROW_GROUP_BYTES >> 20,
+            NARA_DEFAULT_FORMAT
         );
 }
 
 /**/
 
+/*
+ * Initialize the export context(s); with more than one output every record is
+ * decoded once and handed to each of them:
+ */
+static nara_export_context_t
+__nara_to_yaml_open_outputs(
+    const char              **outputSpecs,
+    unsigned int            nOutputSpecs
+)
+{
+    nara_export_context_t   exportContext;
+    nara_export_context_t   *exportContexts;
+    unsigned int            i;
+    
+    if ( nOutputSpecs == 1 ) {
+        exportContext = nara_export_init(outputSpecs[0]);
+        if ( ! exportContext ) exit(EINVAL);
+        return exportContext;
+    }
+    
+    exportContexts = (nara_export_context_t*)calloc(nOutputSpecs, sizeof(nara_export_context_t));
+    if ( ! exportContexts ) {
+        fprintf(stderr, "ERROR:  unable to allocate output list\n");
+        exit(ENOMEM);
+    }
+    for ( i = 0; i < nOutputSpecs; i++ ) {
+        exportContexts[i] = nara_export_init(outputSpecs[i]);
+        if ( ! exportContexts[i] ) {
+            while ( i-- ) nara_export_destroy(exportContexts[i]);
+            exit(EINVAL);
+        }
+    }
+    exportContext = nara_export_fanout(exportContexts, nOutputSpecs, 1);
+    if ( ! exportContext ) exit(ENOMEM);
+    free((void*)exportContexts);
+    return exportContext;
+}
+
+/**/
+
 int
 main(
     int                     argc,
@@ -74,11 +177,18 @@ main(
 )
 {
     int                     argi = 1, optc;
-    int                     rc = 0;
+    int                     rc = 0, destroyRc;
     int                     sawStdin = 0;
     
     nara_export_context_t   exportContext = NULL;
-    const char              *outputSpec = "yaml:-";
+    const char              *defaultOutputSpec = "yaml:-";
+    const char              **outputSpecs = NULL;
+    unsigned int            nOutputSpecs = 0;
+    unsigned int            nThreads = 1;
+    int                     statsFormat = -1;
+    int                     layout = -1, isEBCDIC = -1;
+    nara_fields_t           fields = NULL;
+    const char              *cachePath = NULL;
     
     if ( argc < 2 ) {
         usage(argv[0]);
@@ -87,15 +197,72 @@ main(
     
     while ( (optc = getopt_long(argc, argv, cliOptionsStr, cliOptions, NULL)) != -1 ) {
         switch ( optc ) {
-        
+            
             case 'h':
                 usage(argv[0]);
                 exit(0);
             
-            case 'o':
-                outputSpec = optarg;
+            case 'o': {
+                const char  **newOutputSpecs = (const char**)realloc(outputSpecs, (nOutputSpecs + 1) * sizeof(const char*));
+                
+                if ( ! newOutputSpecs ) {
+                    fprintf(stderr, "ERROR:  unable to allocate output list\n");
+                    exit(ENOMEM);
+                }
+                outputSpecs = newOutputSpecs;
+                outputSpecs[nOutputSpecs++] = optarg;
                 break;
-        
+            }
+            
+            case 't': {
+                char        *endPtr;
+                long        n = strtol(optarg, &endPtr, 10);
+                
+                if ( (endPtr == optarg) || *endPtr || (n < 1) ) {
+                    fprintf(stderr, "ERROR:  invalid thread count: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                nThreads = (unsigned int)n;
+                break;
+            }
+            
+            case 'f':
+                if ( ! nara_format_parse(optarg, &layout, &isEBCDIC) ) {
+                    fprintf(stderr, "ERROR:  invalid format: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            
+            case 'F':
+                if ( ! fields && ! (fields = nara_fields_create()) ) exit(ENOMEM);
+                if ( nara_fields_add(fields, optarg) != 0 ) exit(EINVAL);
+                break;
+            
+            case 'w':
+                if ( ! fields && ! (fields = nara_fields_create()) ) exit(ENOMEM);
+                if ( nara_fields_add_filter(fields, optarg) != 0 ) exit(EINVAL);
+                break;
+            
+            case 'T':
+                if ( ! fields && ! (fields = nara_fields_create()) ) exit(ENOMEM);
+                if ( nara_fields_add_types(fields, optarg) != 0 ) exit(EINVAL);
+                break;
+            
+            case 'c':
+                cachePath = optarg;
+                break;
+            
+            case 'S':
+                if ( ! optarg || (strcmp(optarg, "text") == 0) ) {
+                    statsFormat = nara_stats_report_text;
+                } else if ( strcmp(optarg, "json") == 0 ) {
+                    statsFormat = nara_stats_report_json;
+                } else {
+                    fprintf(stderr, "ERROR:  invalid statistics format: %s\n", optarg);
+                    exit(EINVAL);
+                }
+                break;
+            
         }
     }
     argi = optind;
@@ -105,105 +272,88 @@ main(
         exit(EINVAL);
     }
     
+    if ( cachePath && (argc - argi > 1) ) {
+        char    *path = nara_cache_path(cachePath, argv[argi]);
+        
+        /* A single cache file serves a single input: */
+        if ( path && (strcmp(path, cachePath) == 0) ) {
+            fprintf(stderr, "ERROR:  --cache must name a directory when several NARA files are given\n");
+            exit(EINVAL);
+        }
+        free((void*)path);
+    }
+    
     nara_endian_init();
     
-    /*
-     * Initialize export context:
-     */
-    exportContext = nara_export_init(outputSpec);
-    if ( ! exportContext ) exit(EINVAL);
+    if ( nOutputSpecs == 0 ) {
+        outputSpecs = &defaultOutputSpec;
+        nOutputSpecs = 1;
+    }
+    
+    if ( statsFormat >= 0 ) nara_stats_enable();
     
     while ( (rc == 0) && (argi < argc) ) {
-        FILE    *fptr;
-        int     shouldFClose = 1;
+        nara_reader_t   reader;
         
         if ( strcmp(argv[argi], "-") == 0 ) {
             if ( sawStdin ) {
                 fprintf(stderr, "ERROR:  saw stdin ('-') file multiple times!\n");
                 exit(EINVAL);
             }
-            fptr = stdin;
             sawStdin = 1;
-            shouldFClose = 0;
-        } else {
-            fptr = fopen(argv[argi], "r");
         }
         
-        if ( fptr ) {
-#if defined(NARA_1976_FORMAT) || defined(NARA_1986_FORMAT)
-            nara_record_t       *nextRecord;
-            
-            while ( (rc == 0) && ! feof(fptr) && (nextRecord = nara_record_read(fptr, 0)) ) {
-                nara_record_export(exportContext, nextRecord);
-                nextRecord = nara_record_destroy(nextRecord);
-            }
-            if ( ! feof(fptr) ) rc = 5;
-#else
-            nara_state_header_t         stateHeader;
-            uint64_t                    stateRecordCount = 0, totalRecordCount = 0, nextStateRecordOffset = 0;
-            size_t                      bytesRead;
-            
-            /* Loop over variable-length state records in the file: */
-            while ( (rc == 0) && ((bytesRead = fread(&stateHeader, sizeof(stateHeader), 1, fptr)) == 1) ) {
-                nara_record_header_t    recordHeader;
-                uint64_t                nextRecordOffset;
-                
-                /* Process the header (endian swap, etc.): */
-                nara_state_header_process(&stateHeader);
-                
-                /*
-                 * Calculate offset of the first record for the state and the next state in the file:
-                 */
-                ++stateRecordCount;
-                nextRecordOffset = nextStateRecordOffset + sizeof(stateHeader);
-                nextStateRecordOffset += stateHeader.recordLength;
+        /* Regular files are memory-mapped, stdin/pipes are read via stdio, compressed files are decompressed: */
+        reader = nara_reader_open(argv[argi]);
+        
+        if ( reader ) {
+            if ( ! nara_reader_detect_format(reader, layout, isEBCDIC) ) {
+                fprintf(stderr, "ERROR:  unable to determine the format of %s (use --format)\n", argv[argi]);
+                rc = EINVAL;
+            } else {
+                /* Only the selected columns of the wanted records that pass the filters are decoded: */
+                nara_format_t   format = fields ? nara_fields_project(fields, nara_reader_format(reader)) : nara_reader_format(reader);
                 
-                /* Now handle each one of this state's records: */
-                while ( (bytesRead = fread(&recordHeader, sizeof(recordHeader), 1, fptr)) == 1 ) {
-                    nara_record_t       *nextRecord;
-                    size_t              wantToRead;
-                    
-                    /* Process the header (endian swap, etc.): */
-                    nara_record_header_process(&recordHeader);
-                    
+                if ( ! format ) {
+                    rc = EINVAL;
+                } else {
                     /*
-                     * Increase the total record count and calculate how large this record is and
-                     * where the next record will occur:
+                     * The outputs are only opened once the first file's --fields and --where
+                     * have checked out, so a mistake in them leaves earlier output alone:
                      */
-                    ++totalRecordCount;
-                    wantToRead = recordHeader.recordLength - sizeof(recordHeader);
-                    nextRecordOffset += recordHeader.recordLength;
-                    
-                    /* Read the record: */
-                    nextRecord = nara_record_read(fptr, wantToRead);
+                    if ( ! exportContext ) exportContext = __nara_to_yaml_open_outputs(outputSpecs, nOutputSpecs);
                     
-                    /* Read the record type: */
-                    if ( nextRecord ) {
-                        nara_record_export(exportContext, nextRecord);
-                        nextRecord = nara_record_destroy(nextRecord);
+                    if ( cachePath && nara_cache_can_export(format) ) {
+                        /* The cache is built from (and checked against) the file in its own format: */
+                        char    *path = nara_cache_path(cachePath, argv[argi]);
+                        
+                        if ( path ) {
+                            rc = nara_cache_convert(path, reader, argv[argi], format, exportContext, nThreads);
+                            free((void*)path);
+                        } else {
+                            fprintf(stderr, "ERROR:  unable to allocate cache path\n");
+                            rc = ENOMEM;
+                        }
                     } else {
-                        printf("ERROR:  unable to read record\n");
-                        rc = 5;
+                        nara_reader_set_format(reader, format);
+                        rc = nara_convert(reader, exportContext, nThreads);
                     }
-                    
-                    /*
-                     * If we're now past the end of the current chunk move on to the
-                     * next one:
-                     */
-                    if ( nextRecordOffset >= nextStateRecordOffset ) break;
-                }
-                if ( nextRecordOffset != nextStateRecordOffset ) {
-                    printf("ERROR:  end of secondary records extends beyond primary record bounds\n");
-                    rc = 2;
                 }
             }
-#endif
-            if ( shouldFClose ) fclose(fptr);
+            nara_reader_close(reader);
+        } else {
+            fprintf(stderr, "ERROR:  unable to open %s (errno = %d)\n", argv[argi], errno);
+            rc = errno ? errno : EIO;
         }
         argi++;
     }
     
-    nara_export_destroy(exportContext);
+    /* Output that could not be written (e.g. a full disk) fails the run: */
+    if ( (destroyRc = nara_export_destroy(exportContext)) && (rc == 0) ) rc = destroyRc;
+    if ( outputSpecs != &defaultOutputSpec ) free((void*)outputSpecs);
+    nara_fields_destroy(fields);
+    
+    if ( statsFormat >= 0 ) nara_stats_report(stderr, statsFormat);
     
     return rc;
 }
@@ -0,0 +1,492 @@
+/*
+ * nara_archive
+ *
+ * Members of zip and tar archives.
+ *
+ * A zip archive ends with an end of central directory record (preceded, in
+ * ZIP64 archives, by a locator for a 64-bit one) that leads to the central
+ * directory, whose entries give each member's sizes, compression method, and
+ * the offset of its local header; the member's data follows that header.  All
+ * fields are little-endian.
+ *
+ * A tar archive is a sequence of 512-byte headers, each followed by the
+ * member's data padded to a multiple of 512 bytes, and ends with blocks of
+ * zeroes.  Headers are only read through nara_reader_peek() and passed over
+ * with nara_reader_skip(), so they are not counted as input.
+ *
+ */
+
+#include "nara_archive.h"
+
+/*
+ * A member's name (from a GNU long name or pax header) may be at most this
+ * long:
+ */
+#define NARA_ARCHIVE_MAX_HEADER_BYTES   (1024 * 1024)
+
+/*
+ * The size of a tar header (and the unit tar data is padded to):
+ */
+#define NARA_ARCHIVE_TAR_BLOCK_BYTES    512
+
+/*
+ * Sizes of the fixed parts of zip records:
+ */
+#define NARA_ARCHIVE_ZIP_EOCD_BYTES     22
+#define NARA_ARCHIVE_ZIP_LOCATOR_BYTES  20
+#define NARA_ARCHIVE_ZIP_EOCD64_BYTES   56
+#define NARA_ARCHIVE_ZIP_ENTRY_BYTES    46
+#define NARA_ARCHIVE_ZIP_LOCAL_BYTES    30
+
+/**/
+
+/*
+ * The little-endian integer of nBytes at bytes:
+ */
+static uint64_t
+__nara_archive_le(
+    const unsigned char *bytes,
+    unsigned int        nBytes
+)
+{
+    uint64_t            value = 0;
+    
+    while ( nBytes-- ) value = (value << 8) | bytes[nBytes];
+    return value;
+}
+
+/**/
+
+/*
+ * The numeric tar header field of nBytes at field:  octal digits (amid
+ * spaces and NULs), or base-256 if the high bit of the first byte is set:
+ */
+static uint64_t
+__nara_archive_tar_number(
+    const unsigned char *field,
+    size_t              nBytes
+)
+{
+    uint64_t            value = 0;
+    size_t              i = 0;
+    
+    if ( field[0] & 0x80 ) {
+        value = field[0] & 0x7F;
+        for ( i = 1; i < nBytes; i++ ) value = (value << 8) | field[i];
+        return value;
+    }
+    while ( (i < nBytes) && (field[i] == ' ') ) i++;
+    while ( (i < nBytes) && (field[i] >= '0') && (field[i] <= '7') ) value = (value << 3) | (field[i++] - '0');
+    return value;
+}
+
+/**/
+
+/*
+ * Copy the next nBytes of the archive into buffer and pass over them; returns
+ * zero if the archive ends first:
+ */
+static int
+__nara_archive_take(
+    nara_reader_t   reader,
+    void            *buffer,
+    size_t          nBytes
+)
+{
+    size_t          nAvail;
+    const void      *bytes = nara_reader_peek(reader, nBytes, &nAvail);
+    
+    if ( ! bytes || (nAvail < nBytes) ) return 0;
+    memcpy(buffer, bytes, nBytes);
+    return ( nara_reader_skip(reader, nBytes) == nBytes );
+}
+
+/**/
+
+/*
+ * Returns non-zero if the member name in an archive is memberName (ignoring
+ * a leading "./" on either):
+ */
+static int
+__nara_archive_is_member(
+    const char      *name,
+    size_t          nameLen,
+    const char      *memberName
+)
+{
+    if ( (nameLen >= 2) && (name[0] == '.') && (name[1] == '/') ) {
+        name += 2;
+        nameLen -= 2;
+    }
+    if ( (memberName[0] == '.') && (memberName[1] == '/') ) memberName += 2;
+    return ( (strlen(memberName) == nameLen) && (memcmp(name, memberName, nameLen) == 0) );
+}
+
+/**/
+
+/*
+ * Locate the central directory of the mapped zip archive:  returns zero if
+ * there is no end of central directory record:
+ */
+static int
+__nara_archive_zip_directory(
+    const unsigned char *archive,
+    uint64_t            length,
+    uint64_t            *directoryOffset,
+    uint64_t            *directoryLength,
+    uint64_t            *nEntries
+)
+{
+    const unsigned char *eocd;
+    uint64_t            i;
+    
+    if ( length < NARA_ARCHIVE_ZIP_EOCD_BYTES ) return 0;
+    
+    /* The record is followed only by a comment of up to 64 KiB: */
+    for ( i = length - NARA_ARCHIVE_ZIP_EOCD_BYTES; ; i-- ) {
+        eocd = archive + i;
+        if ( (memcmp(eocd, "PK\5\6", 4) == 0) && (i + NARA_ARCHIVE_ZIP_EOCD_BYTES + __nara_archive_le(eocd + 20, 2) == length) ) break;
+        if ( (i == 0) || (length - i > NARA_ARCHIVE_ZIP_EOCD_BYTES + 0xFFFF) ) return 0;
+    }
+    *nEntries = __nara_archive_le(eocd + 10, 2);
+    *directoryLength = __nara_archive_le(eocd + 12, 4);
+    *directoryOffset = __nara_archive_le(eocd + 16, 4);
+    
+    /* A ZIP64 archive has the real values in a record the locator before this one points to: */
+    if ( (i >= NARA_ARCHIVE_ZIP_LOCATOR_BYTES) && (memcmp(eocd - NARA_ARCHIVE_ZIP_LOCATOR_BYTES, "PK\6\7", 4) == 0) ) {
+        uint64_t        eocd64Offset = __nara_archive_le(eocd - NARA_ARCHIVE_ZIP_LOCATOR_BYTES + 8, 8);
+        
+        if ( (eocd64Offset <= length - NARA_ARCHIVE_ZIP_EOCD64_BYTES) && (memcmp(archive + eocd64Offset, "PK\6\6", 4) == 0) ) {
+            *nEntries = __nara_archive_le(archive + eocd64Offset + 32, 8);
+            *directoryLength = __nara_archive_le(archive + eocd64Offset + 40, 8);
+            *directoryOffset = __nara_archive_le(archive + eocd64Offset + 48, 8);
+        }
+    }
+    if ( (*directoryOffset > length) || (*directoryLength > length - *directoryOffset) ) return 0;
+    return 1;
+}
+
+/**/
+
+/*
+ * Position the mapped zip archive read by reader at its member memberName:
+ */
+static int
+__nara_archive_open_zip(
+    nara_reader_t       reader,
+    const char          *archivePath,
+    const char          *memberName
+)
+{
+    uint64_t            length = nara_reader_length(reader);
+    const unsigned char *archive = (const unsigned char*)nara_reader_bytes(reader, 0, (size_t)length);
+    uint64_t            directoryOffset, directoryLength, nEntries, offset;
+    
+    if ( ! __nara_archive_zip_directory(archive, length, &directoryOffset, &directoryLength, &nEntries) ) {
+        fprintf(stderr, "ERROR:  no zip central directory found in %s\n", archivePath);
+        return EINVAL;
+    }
+    
+    for ( offset = directoryOffset; nEntries-- && (directoryOffset + directoryLength - offset >= NARA_ARCHIVE_ZIP_ENTRY_BYTES); ) {
+        const unsigned char *entry = archive + offset;
+        uint64_t            nameLen = __nara_archive_le(entry + 28, 2);
+        uint64_t            extraLen = __nara_archive_le(entry + 30, 2);
+        uint64_t            entryLen = NARA_ARCHIVE_ZIP_ENTRY_BYTES + nameLen + extraLen + __nara_archive_le(entry + 32, 2);
+        
+        if ( (memcmp(entry, "PK\1\2", 4) != 0) || (entryLen > directoryOffset + directoryLength - offset) ) break;
+        if ( __nara_archive_is_member((const char*)entry + NARA_ARCHIVE_ZIP_ENTRY_BYTES, (size_t)nameLen, memberName) ) {
+            unsigned int        flags = (unsigned int)__nara_archive_le(entry + 8, 2);
+            unsigned int        method = (unsigned int)__nara_archive_le(entry + 10, 2);
+            uint64_t            compressedSize = __nara_archive_le(entry + 20, 4);
+            uint64_t            uncompressedSize = __nara_archive_le(entry + 24, 4);
+            uint64_t            localOffset = __nara_archive_le(entry + 42, 4);
+            const unsigned char *extra = entry + NARA_ARCHIVE_ZIP_ENTRY_BYTES + nameLen;
+            const unsigned char *extraEnd = extra + extraLen;
+            uint64_t            dataOffset;
+            
+            /* ZIP64 sizes and offset are in an extra field, those that overflowed in order: */
+            while ( extraEnd - extra >= 4 ) {
+                unsigned int    fieldId = (unsigned int)__nara_archive_le(extra, 2);
+                uint64_t        fieldLen = __nara_archive_le(extra + 2, 2);
+                const unsigned char *field = extra + 4;
+                
+                if ( fieldLen > (uint64_t)(extraEnd - field) ) break;
+                if ( fieldId == 0x0001 ) {
+                    const unsigned char *fieldEnd = field + fieldLen;
+                    
+                    if ( (uncompressedSize == 0xFFFFFFFF) && (fieldEnd - field >= 8) ) {
+                        uncompressedSize = __nara_archive_le(field, 8);
+                        field += 8;
+                    }
+                    if ( (compressedSize == 0xFFFFFFFF) && (fieldEnd - field >= 8) ) {
+                        compressedSize = __nara_archive_le(field, 8);
+                        field += 8;
+                    }
+                    if ( (localOffset == 0xFFFFFFFF) && (fieldEnd - field >= 8) ) localOffset = __nara_archive_le(field, 8);
+                    break;
+                }
+                extra = field + fieldLen;
+            }
+            
+            if ( flags & 0x0001 ) {
+                fprintf(stderr, "ERROR:  %s in %s is encrypted\n", memberName, archivePath);
+                return ENOTSUP;
+            }
+            if ( (method != 0) && (method != 8) ) {
+                fprintf(stderr, "ERROR:  %s in %s uses unsupported zip compression method %u\n", memberName, archivePath, method);
+                return ENOTSUP;
+            }
+            
+            /* The local header repeats the name but may have an extra field of its own: */
+            if ( (localOffset > length - NARA_ARCHIVE_ZIP_LOCAL_BYTES) || (memcmp(archive + localOffset, "PK\3\4", 4) != 0) ) {
+                fprintf(stderr, "ERROR:  invalid local header for %s in %s\n", memberName, archivePath);
+                return EINVAL;
+            }
+            dataOffset = localOffset + NARA_ARCHIVE_ZIP_LOCAL_BYTES + __nara_archive_le(archive + localOffset + 26, 2) + __nara_archive_le(archive + localOffset + 28, 2);
+            if ( (dataOffset > length) || (compressedSize > length - dataOffset) ) {
+                fprintf(stderr, "ERROR:  %s in %s is truncated\n", memberName, archivePath);
+                return EINVAL;
+            }
+            if ( (method == 0) && (compressedSize != uncompressedSize) ) {
+                fprintf(stderr, "ERROR:  invalid sizes for %s in %s\n", memberName, archivePath);
+                return EINVAL;
+            }
+            
+            nara_reader_skip(reader, dataOffset);
+            if ( method == 0 ) return nara_reader_limit(reader, compressedSize);
+            return nara_reader_decompress(reader, nara_compression_deflate, compressedSize);
+        }
+        offset += entryLen;
+    }
+    fprintf(stderr, "ERROR:  no member named %s in %s\n", memberName, archivePath);
+    return ENOENT;
+}
+
+/**/
+
+/*
+ * Read the nBytes of data (a GNU long name or pax records) that follow a tar
+ * header as a NUL-terminated string in *data:
+ */
+static int
+__nara_archive_tar_data(
+    nara_reader_t   reader,
+    const char      *archivePath,
+    uint64_t        nBytes,
+    char            **data
+)
+{
+    uint64_t        paddedBytes = (nBytes + NARA_ARCHIVE_TAR_BLOCK_BYTES - 1) & ~(uint64_t)(NARA_ARCHIVE_TAR_BLOCK_BYTES - 1);
+    char            *newData;
+    
+    if ( nBytes > NARA_ARCHIVE_MAX_HEADER_BYTES ) {
+        fprintf(stderr, "ERROR:  oversized tar header in %s\n", archivePath);
+        return EINVAL;
+    }
+    if ( ! (newData = (char*)realloc(*data, (size_t)paddedBytes + 1)) ) {
+        fprintf(stderr, "ERROR:  unable to allocate tar header\n");
+        return ENOMEM;
+    }
+    *data = newData;
+    if ( ! __nara_archive_take(reader, newData, (size_t)paddedBytes) ) {
+        fprintf(stderr, "ERROR:  %s is truncated\n", archivePath);
+        return EINVAL;
+    }
+    newData[nBytes] = '\0';
+    return 0;
+}
+
+/**/
+
+/*
+ * Position the tar archive read by reader at its member memberName:
+ */
+static int
+__nara_archive_open_tar(
+    nara_reader_t   reader,
+    const char      *archivePath,
+    const char      *memberName
+)
+{
+    unsigned char   header[NARA_ARCHIVE_TAR_BLOCK_BYTES];
+    char            *longName = NULL, *pax = NULL;
+    char            *paxPath = NULL;
+    uint64_t        paxSize = 0;
+    int             hasPaxSize = 0, nHeaders = 0, rc = ENOENT;
+    
+    while ( __nara_archive_take(reader, header, sizeof(header)) ) {
+        uint64_t    checksum = 0, size;
+        char        name[256 + 1];
+        const char  *entryName = name;
+        char        type = (char)header[156];
+        size_t      i;
+        
+        /* The archive ends with a block of zeroes: */
+        for ( i = 0; (i < sizeof(header)) && ! header[i]; i++ );
+        if ( i == sizeof(header) ) break;
+        
+        /* The checksum is taken with its own field as spaces: */
+        for ( i = 0; i < sizeof(header); i++ ) checksum += ( (i >= 148) && (i < 156) ) ? ' ' : header[i];
+        if ( checksum != __nara_archive_tar_number(header + 148, 8) ) {
+            if ( nHeaders ) fprintf(stderr, "ERROR:  invalid tar header in %s\n", archivePath);
+            else fprintf(stderr, "ERROR:  %s is not a zip or tar archive\n", archivePath);
+            rc = EINVAL;
+            break;
+        }
+        nHeaders++;
+        size = __nara_archive_tar_number(header + 124, 12);
+        
+        /* A GNU long name or pax header describes the entry after it: */
+        if ( (type == 'L') || (type == 'x') ) {
+            char    **data = ( type == 'L' ) ? &longName : &pax;
+            
+            if ( type == 'x' ) {
+                paxPath = NULL;
+                hasPaxSize = 0;
+            }
+            if ( (rc = __nara_archive_tar_data(reader, archivePath, size, data)) ) break;
+            rc = ENOENT;
+            if ( type == 'x' ) {
+                char    *record = pax, *paxEnd = pax + size;
+                
+                /* Records are "<length> <key>=<value>\n": */
+                while ( record < paxEnd ) {
+                    char                *key, *recordEnd;
+                    unsigned long long  recordLen = strtoull(record, &key, 10);
+                    
+                    if ( (key == record) || (*key != ' ') || (recordLen == 0) || (recordLen > (unsigned long long)(paxEnd - record)) ) break;
+                    recordEnd = record + recordLen - 1;
+                    *recordEnd = '\0';
+                    key++;
+                    if ( strncmp(key, "path=", 5) == 0 ) paxPath = key + 5;
+                    else if ( strncmp(key, "size=", 5) == 0 ) {
+                        paxSize = strtoull(key + 5, NULL, 10);
+                        hasPaxSize = 1;
+                    }
+                    record = recordEnd + 1;
+                }
+            }
+            continue;
+        }
+        
+        if ( longName ) {
+            entryName = longName;
+        } else if ( paxPath ) {
+            entryName = paxPath;
+        } else {
+            /* A POSIX ustar name may have a prefix (GNU headers use the field otherwise): */
+            size_t  prefixLen = ( memcmp(header + 257, "ustar\0", 6) == 0 ) ? strnlen((const char*)header + 345, 155) : 0;
+            size_t  nameLen = strnlen((const char*)header, 100);
+            
+            if ( prefixLen ) {
+                memcpy(name, header + 345, prefixLen);
+                name[prefixLen++] = '/';
+            }
+            memcpy(name + prefixLen, header, nameLen);
+            name[prefixLen + nameLen] = '\0';
+        }
+        if ( hasPaxSize ) size = paxSize;
+        
+        if ( ((type == '0') || (type == '\0') || (type == '7')) && __nara_archive_is_member(entryName, strlen(entryName), memberName) ) {
+            if ( (rc = nara_reader_limit(reader, size)) == EINVAL ) fprintf(stderr, "ERROR:  %s in %s is truncated\n", memberName, archivePath);
+            break;
+        }
+        if ( (type != 'g') && longName ) {
+            free((void*)longName);
+            longName = NULL;
+        }
+        if ( type != 'g' ) {
+            paxPath = NULL;
+            hasPaxSize = 0;
+        }
+        
+        size = (size + NARA_ARCHIVE_TAR_BLOCK_BYTES - 1) & ~(uint64_t)(NARA_ARCHIVE_TAR_BLOCK_BYTES - 1);
+        if ( nara_reader_skip(reader, size) != size ) {
+            fprintf(stderr, "ERROR:  %s is truncated\n", archivePath);
+            rc = EINVAL;
+            break;
+        }
+    }
+    if ( (rc == ENOENT) && nHeaders ) fprintf(stderr, "ERROR:  no member named %s in %s\n", memberName, archivePath);
+    else if ( rc == ENOENT ) fprintf(stderr, "ERROR:  %s is not a zip or tar archive\n", archivePath);
+    if ( longName ) free((void*)longName);
+    if ( pax ) free((void*)pax);
+    return rc;
+}
+
+/**/
+
+nara_reader_t
+nara_archive_open(
+    const char      *path
+)
+{
+    const char      *hash = strrchr(path, '#');
+    char            *archivePath;
+    nara_reader_t   reader;
+    size_t          nBytes;
+    const void      *bytes;
+    int             rc;
+    
+    if ( ! hash || (hash == path) || ! hash[1] ) {
+        errno = ENOENT;
+        return NULL;
+    }
+    if ( ! (archivePath = (char*)malloc(hash - path + 1)) ) {
+        fprintf(stderr, "ERROR:  unable to allocate archive path\n");
+        errno = ENOMEM;
+        return NULL;
+    }
+    memcpy(archivePath, path, hash - path);
+    archivePath[hash - path] = '\0';
+    
+    /* The archive itself may be compressed, or be a member of another: */
+    if ( ! (reader = nara_reader_open(archivePath)) ) {
+        rc = errno;
+        free((void*)archivePath);
+        errno = rc;
+        return NULL;
+    }
+    
+    /* A zip archive is recognized by the signature of its first local header (or of an empty archive): */
+    bytes = nara_reader_peek(reader, 4, &nBytes);
+    if ( bytes && (nBytes == 4) && ((memcmp(bytes, "PK\3\4", 4) == 0) || (memcmp(bytes, "PK\5\6", 4) == 0)) ) {
+        if ( nara_reader_is_mapped(reader) ) {
+            rc = __nara_archive_open_zip(reader, archivePath, hash + 1);
+        } else {
+            fprintf(stderr, "ERROR:  zip archive %s must be an uncompressed regular file\n", archivePath);
+            rc = ENOTSUP;
+        }
+    } else {
+        rc = __nara_archive_open_tar(reader, archivePath, hash + 1);
+    }
+    free((void*)archivePath);
+    if ( rc ) {
+        nara_reader_close(reader);
+        reader = NULL;
+        errno = rc;
+    }
+    return reader;
+}
+
+/**/
+
+int
+nara_archive_stat(
+    const char      *path,
+    struct stat     *finfo
+)
+{
+    const char      *hash = strrchr(path, '#');
+    char            *archivePath;
+    int             rc;
+    
+    if ( ! hash || ! (archivePath = strdup(path)) ) return -1;
+    archivePath[hash - path] = '\0';
+    
+    /* The archive may itself be a member of another: */
+    rc = stat(archivePath, finfo);
+    if ( (rc != 0) && (errno == ENOENT) ) rc = nara_archive_stat(archivePath, finfo);
+    free((void*)archivePath);
+    return rc;
+}
@@ -0,0 +1,48 @@
+/*
+ * nara_archive
+ *
+ * Members of zip and tar archives.  Data sets are often distributed as a
+ * bundle of files; a path of the form <archive>#<member> (e.g.
+ * bundle.zip#RG441.dat) reads one member of the bundle without extracting
+ * it first.
+ *
+ * A zip archive is read from its central directory, so it must be a regular
+ * file (it is memory-mapped).  A stored member is then a window on the mapped
+ * archive -- read in-place, and by as many threads as a plain file -- and a
+ * deflated member is inflated as it is read.
+ *
+ * A tar archive (compressed or not, see nara_compression) is scanned header
+ * by header up to the member, whose data is then read in-place from the
+ * mapped archive or from the stream.  POSIX ustar, GNU long names, and pax
+ * path and size records are understood.
+ *
+ */
+
+#ifndef __NARA_ARCHIVE_H__
+#define __NARA_ARCHIVE_H__
+
+#include "nara_base.h"
+#include "nara_reader.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+/*!
+    @function nara_archive_open
+
+    Open the member of an archive named by path, <archive>#<member> (split at
+    the last '#'), for reading.  Returns NULL (after reporting why, with errno
+    set) if the archive could not be opened, is neither a zip nor a tar
+    archive, or has no such member.
+ */
+nara_reader_t nara_archive_open(const char *path);
+
+/*!
+    @function nara_archive_stat
+
+    Fill in *finfo for the archive part of a path of the form
+    <archive>#<member>, see stat(2).  Returns zero on success.
+ */
+int nara_archive_stat(const char *path, struct stat *finfo);
+
+#endif /* __NARA_ARCHIVE_H__ */
@@ -0,0 +1,825 @@
+/*
+ * nara_arrow
+ *
+ * Apache Arrow IPC file ("Feather v2") export.
+ *
+ * A file is the magic "ARROW1", a stream of encapsulated messages -- the schema,
+ * the record batches, and the dictionary batches -- and a footer that locates
+ * the batches:
+ *
+ *     <message> = 0xFFFFFFFF <int32 metadata length> <Message flatbuffer> <body>
+ *
+ * Readers of the file format find the dictionaries through the footer, so they
+ * are written after the record batches that refer to them, once every string
+ * has been seen.  All flatbuffer scalars are little-endian; the column data is
+ * in host byte order, as the schema says.
+ *
+ */
+
+#include "nara_arrow.h"
+#include "nara_columns.h"
+#include "nara_record_impl.h"
+#include "nara_emitter.h"
+
+#include <sys/stat.h>
+
+/*
+ * Constants from the Arrow format's Schema.fbs, Message.fbs, and File.fbs:
+ */
+enum {
+    nara_arrow_metadata_v5 = 4,
+    nara_arrow_header_schema = 1,
+    nara_arrow_header_dictionary_batch = 2,
+    nara_arrow_header_record_batch = 3,
+    nara_arrow_type_int = 2,
+    nara_arrow_type_floating_point = 3,
+    nara_arrow_type_utf8 = 5,
+    nara_arrow_precision_single = 1,
+    nara_arrow_endianness_little = 0,
+    nara_arrow_endianness_big = 1
+};
+
+static const uint8_t __nara_arrow_magic[8] = { 'A', 'R', 'R', 'O', 'W', '1', 0, 0 };
+static const uint8_t __nara_arrow_padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+/**/
+
+static void
+__nara_arrow_align(
+    nara_columns_buffer_t *buffer,
+    size_t                alignment
+)
+{
+    nara_columns_buffer_reserve(buffer, (alignment - (buffer->length % alignment)) % alignment);
+}
+
+/**/
+
+/*
+ * Store a little-endian scalar of nBytes at position:
+ */
+static void
+__nara_arrow_put(
+    nara_columns_buffer_t *buffer,
+    size_t                position,
+    uint64_t              value,
+    unsigned int          nBytes
+)
+{
+    if ( buffer->didFail ) return;
+    while ( nBytes-- ) {
+        buffer->bytes[position++] = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+/**/
+
+/*
+ * Flatbuffers, written front to back:  a table's offsets to its children are
+ * filled-in (with __nara_arrow_fb_patch()) once the children have been written
+ * after it.  A field of a table is a scalar of 1, 2, 4, or 8 bytes, an offset,
+ * or absent (size zero, i.e. the default value):
+ */
+typedef struct {
+    unsigned int    size;
+    int             isOffset;
+    uint64_t        value;
+    size_t          position;
+} nara_arrow_fb_field_t;
+
+#define NARA_ARROW_FB_MAX_FIELDS    8
+
+static void
+__nara_arrow_fb_scalar(
+    nara_arrow_fb_field_t   *field,
+    unsigned int            size,
+    uint64_t                value
+)
+{
+    field->size = size;
+    field->isOffset = 0;
+    field->value = value;
+}
+
+/**/
+
+static void
+__nara_arrow_fb_offset(
+    nara_arrow_fb_field_t   *field
+)
+{
+    field->size = sizeof(uint32_t);
+    field->isOffset = 1;
+    field->value = 0;
+}
+
+/**/
+
+static void
+__nara_arrow_fb_patch(
+    nara_columns_buffer_t *fb,
+    size_t                position,
+    size_t                target
+)
+{
+    __nara_arrow_put(fb, position, target - position, sizeof(uint32_t));
+}
+
+/**/
+
+/*
+ * Write a table (preceded by its vtable); the position of each field is stored
+ * in the field.  Returns the position of the table.
+ */
+static size_t
+__nara_arrow_fb_table(
+    nara_columns_buffer_t     *fb,
+    nara_arrow_fb_field_t     *fields,
+    unsigned int              nFields
+)
+{
+    size_t                  fieldOffsets[NARA_ARROW_FB_MAX_FIELDS];
+    size_t                  vtable, table, inlineSize = sizeof(int32_t);
+    unsigned int            size, i;
+    
+    /* The largest fields come first so each is aligned within the (8-aligned) table: */
+    for ( size = 8; size >= 1; size /= 2 ) {
+        for ( i = 0; i < nFields; i++ ) {
+            if ( fields[i].size != size ) continue;
+            inlineSize = (inlineSize + size - 1) & ~(size_t)(size - 1);
+            fieldOffsets[i] = inlineSize;
+            inlineSize += size;
+        }
+    }
+    __nara_arrow_align(fb, sizeof(uint16_t));
+    vtable = nara_columns_buffer_reserve(fb, 2 * (2 + nFields));
+    __nara_arrow_align(fb, sizeof(uint64_t));
+    table = nara_columns_buffer_reserve(fb, inlineSize);
+    
+    __nara_arrow_put(fb, vtable, 2 * (2 + nFields), sizeof(uint16_t));
+    __nara_arrow_put(fb, vtable + 2, inlineSize, sizeof(uint16_t));
+    __nara_arrow_put(fb, table, table - vtable, sizeof(int32_t));
+    for ( i = 0; i < nFields; i++ ) {
+        if ( ! fields[i].size ) continue;
+        __nara_arrow_put(fb, vtable + 2 * (2 + i), fieldOffsets[i], sizeof(uint16_t));
+        fields[i].position = table + fieldOffsets[i];
+        if ( ! fields[i].isOffset ) __nara_arrow_put(fb, fields[i].position, fields[i].value, fields[i].size);
+    }
+    return table;
+}
+
+/**/
+
+/*
+ * Write the length of a vector of nElements of elementSize bytes and reserve its
+ * elements, aligned to alignment; returns the position of the vector (its length).
+ */
+static size_t
+__nara_arrow_fb_vector(
+    nara_columns_buffer_t *fb,
+    uint32_t              nElements,
+    size_t                elementSize,
+    size_t                alignment
+)
+{
+    size_t              vector;
+    
+    __nara_arrow_align(fb, sizeof(uint64_t));
+    if ( alignment > sizeof(uint32_t) ) nara_columns_buffer_reserve(fb, sizeof(uint32_t));
+    vector = nara_columns_buffer_reserve(fb, sizeof(uint32_t) + nElements * elementSize);
+    __nara_arrow_put(fb, vector, nElements, sizeof(uint32_t));
+    return vector;
+}
+
+/**/
+
+static size_t
+__nara_arrow_fb_string(
+    nara_columns_buffer_t *fb,
+    const char            *s
+)
+{
+    size_t              sLen = strlen(s);
+    size_t              string;
+    
+    __nara_arrow_align(fb, sizeof(uint32_t));
+    string = nara_columns_buffer_reserve(fb, sizeof(uint32_t) + sLen + 1);
+    __nara_arrow_put(fb, string, sLen, sizeof(uint32_t));
+    if ( ! fb->didFail ) memcpy(fb->bytes + string + sizeof(uint32_t), s, sLen);
+    return string;
+}
+
+/**/
+
+/*
+ * The location of a message in the file, for the footer:
+ */
+typedef struct {
+    uint64_t                offset;
+    uint32_t                metaDataLength;
+    uint64_t                bodyLength;
+} nara_arrow_block_t;
+
+/*
+ * The file of one record type (its rows first, so the table can stand in for
+ * them in a flush):
+ */
+typedef struct {
+    nara_columns_table_t    base;
+    nara_emitter_t          out;
+    uint64_t                fileOffset;
+    nara_arrow_block_t      *batches;
+    unsigned int            nBatches;
+} nara_arrow_table_t;
+
+typedef struct {
+    nara_export_context_base_t  base;
+    char                        *directory;
+    uint32_t                    batchRows;
+    nara_arrow_table_t          tables[nara_record_type_max];
+} nara_export_context_arrow_t;
+
+/**/
+
+/*
+ * Write the Schema table (and everything under it); returns its position:
+ */
+static size_t
+__nara_arrow_fb_schema(
+    nara_columns_buffer_t         *fb,
+    const nara_arrow_table_t      *table
+)
+{
+    nara_arrow_fb_field_t       schemaFields[2];
+    size_t                      schema, fieldsVector;
+    unsigned int                c;
+
+#ifdef NARA_HOST_BIG_ENDIAN
+    __nara_arrow_fb_scalar(&schemaFields[0], sizeof(uint16_t), nara_arrow_endianness_big);
+#else
+    __nara_arrow_fb_scalar(&schemaFields[0], 0, nara_arrow_endianness_little);
+#endif
+    __nara_arrow_fb_offset(&schemaFields[1]);
+    schema = __nara_arrow_fb_table(fb, schemaFields, 2);
+    fieldsVector = __nara_arrow_fb_vector(fb, table->base.nColumns, sizeof(uint32_t), sizeof(uint32_t));
+    __nara_arrow_fb_patch(fb, schemaFields[1].position, fieldsVector);
+    
+    for ( c = 0; c < table->base.nColumns; c++ ) {
+        const nara_fields_column_info_t *info = &table->base.infos[c];
+        nara_arrow_fb_field_t   fieldFields[6], typeFields[2], dictionaryFields[2], indexFields[2];
+        size_t                  field, position;
+        
+        /* Field:  name, nullable, type_type, type, dictionary, children */
+        __nara_arrow_fb_offset(&fieldFields[0]);
+        __nara_arrow_fb_scalar(&fieldFields[1], 0, 0);
+        __nara_arrow_fb_offset(&fieldFields[3]);
+        __nara_arrow_fb_scalar(&fieldFields[4], 0, 0);
+        __nara_arrow_fb_offset(&fieldFields[5]);
+        switch ( info->kind ) {
+            case nara_fields_column_u32:
+                __nara_arrow_fb_scalar(&fieldFields[2], sizeof(uint8_t), nara_arrow_type_int);
+                break;
+            case nara_fields_column_float:
+                __nara_arrow_fb_scalar(&fieldFields[2], sizeof(uint8_t), nara_arrow_type_floating_point);
+                break;
+            default:
+                __nara_arrow_fb_scalar(&fieldFields[2], sizeof(uint8_t), nara_arrow_type_utf8);
+                __nara_arrow_fb_offset(&fieldFields[4]);
+                break;
+        }
+        field = __nara_arrow_fb_table(fb, fieldFields, 6);
+        __nara_arrow_fb_patch(fb, fieldsVector + sizeof(uint32_t) * (1 + c), field);
+        __nara_arrow_fb_patch(fb, fieldFields[0].position, __nara_arrow_fb_string(fb, info->name));
+        
+        /* The type:  Int { bitWidth, is_signed }, FloatingPoint { precision }, or Utf8 {} */
+        switch ( info->kind ) {
+            case nara_fields_column_u32:
+                __nara_arrow_fb_scalar(&typeFields[0], sizeof(int32_t), 32);
+                __nara_arrow_fb_scalar(&typeFields[1], 0, 0);
+                position = __nara_arrow_fb_table(fb, typeFields, 2);
+                break;
+            case nara_fields_column_float:
+                __nara_arrow_fb_scalar(&typeFields[0], sizeof(int16_t), nara_arrow_precision_single);
+                position = __nara_arrow_fb_table(fb, typeFields, 1);
+                break;
+            default:
+                position = __nara_arrow_fb_table(fb, typeFields, 0);
+                break;
+        }
+        __nara_arrow_fb_patch(fb, fieldFields[3].position, position);
+        
+        /* DictionaryEncoding { id, indexType:  Int { 32, signed } } */
+        if ( fieldFields[4].size ) {
+            __nara_arrow_fb_scalar(&dictionaryFields[0], sizeof(int64_t), c);
+            __nara_arrow_fb_offset(&dictionaryFields[1]);
+            position = __nara_arrow_fb_table(fb, dictionaryFields, 2);
+            __nara_arrow_fb_patch(fb, fieldFields[4].position, position);
+            __nara_arrow_fb_scalar(&indexFields[0], sizeof(int32_t), 32);
+            __nara_arrow_fb_scalar(&indexFields[1], sizeof(uint8_t), 1);
+            position = __nara_arrow_fb_table(fb, indexFields, 2);
+            __nara_arrow_fb_patch(fb, dictionaryFields[1].position, position);
+        }
+        
+        /* No children: */
+        __nara_arrow_fb_patch(fb, fieldFields[5].position, __nara_arrow_fb_vector(fb, 0, sizeof(uint32_t), sizeof(uint32_t)));
+    }
+    return schema;
+}
+
+/**/
+
+/*
+ * Start a Message flatbuffer with the given header type and body length; returns
+ * the position of the header's offset, to be patched:
+ */
+static size_t
+__nara_arrow_fb_message(
+    nara_columns_buffer_t     *fb,
+    unsigned int              headerType,
+    uint64_t                  bodyLength
+)
+{
+    nara_arrow_fb_field_t   messageFields[4];
+    size_t                  root = nara_columns_buffer_reserve(fb, sizeof(uint32_t));
+    
+    /* Message:  version, header_type, header, bodyLength */
+    __nara_arrow_fb_scalar(&messageFields[0], sizeof(int16_t), nara_arrow_metadata_v5);
+    __nara_arrow_fb_scalar(&messageFields[1], sizeof(uint8_t), headerType);
+    __nara_arrow_fb_offset(&messageFields[2]);
+    __nara_arrow_fb_scalar(&messageFields[3], bodyLength ? sizeof(int64_t) : 0, bodyLength);
+    __nara_arrow_fb_patch(fb, root, __nara_arrow_fb_table(fb, messageFields, 4));
+    return messageFields[2].position;
+}
+
+/**/
+
+/*
+ * Write a RecordBatch table for nRows rows whose nNodes field nodes each have
+ * their buffers (validity and data, or validity, offsets, and data) at the given
+ * lengths within the body; returns its position:
+ */
+static size_t
+__nara_arrow_fb_record_batch(
+    nara_columns_buffer_t     *fb,
+    uint64_t                  nRows,
+    unsigned int              nNodes,
+    const uint64_t            *bufferLengths,
+    unsigned int              nBuffers
+)
+{
+    nara_arrow_fb_field_t   batchFields[3];
+    size_t                  batch, nodes, buffers;
+    uint64_t                bodyOffset = 0;
+    unsigned int            i;
+    
+    /* RecordBatch:  length, nodes, buffers */
+    __nara_arrow_fb_scalar(&batchFields[0], sizeof(int64_t), nRows);
+    __nara_arrow_fb_offset(&batchFields[1]);
+    __nara_arrow_fb_offset(&batchFields[2]);
+    batch = __nara_arrow_fb_table(fb, batchFields, 3);
+    
+    /* FieldNode { length, null_count } */
+    nodes = __nara_arrow_fb_vector(fb, nNodes, 2 * sizeof(int64_t), sizeof(int64_t));
+    __nara_arrow_fb_patch(fb, batchFields[1].position, nodes);
+    for ( i = 0; i < nNodes; i++ ) __nara_arrow_put(fb, nodes + sizeof(uint32_t) + 2 * sizeof(int64_t) * i, nRows, sizeof(int64_t));
+    
+    /* Buffer { offset, length }, each padded to 8 bytes within the body: */
+    buffers = __nara_arrow_fb_vector(fb, nBuffers, 2 * sizeof(int64_t), sizeof(int64_t));
+    __nara_arrow_fb_patch(fb, batchFields[2].position, buffers);
+    for ( i = 0; i < nBuffers; i++ ) {
+        __nara_arrow_put(fb, buffers + sizeof(uint32_t) + 2 * sizeof(int64_t) * i, bodyOffset, sizeof(int64_t));
+        __nara_arrow_put(fb, buffers + sizeof(uint32_t) + 2 * sizeof(int64_t) * i + sizeof(int64_t), bufferLengths[i], sizeof(int64_t));
+        bodyOffset += (bufferLengths[i] + 7) & ~(uint64_t)7;
+    }
+    return batch;
+}
+
+/**/
+
+static void
+__nara_arrow_write(
+    nara_arrow_table_t  *table,
+    const void          *bytes,
+    size_t              nBytes
+)
+{
+    if ( ! nBytes ) return;
+    nara_emitter_append(table->out, bytes, nBytes);
+    table->fileOffset += nBytes;
+}
+
+/**/
+
+/*
+ * Write the encapsulated message in fb (its body follows, written by the caller);
+ * its location is stored in block if not NULL:
+ */
+static void
+__nara_arrow_write_message(
+    nara_arrow_table_t    *table,
+    nara_columns_buffer_t *fb,
+    uint64_t              bodyLength,
+    nara_arrow_block_t    *block
+)
+{
+    uint32_t            metaDataLength = (uint32_t)((fb->length + 7) & ~(size_t)7);
+    uint8_t             prefix[8] = { 0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0 };
+    
+    if ( fb->didFail ) {
+        table->base.didFail = 1;
+        return;
+    }
+    prefix[4] = (uint8_t)metaDataLength;
+    prefix[5] = (uint8_t)(metaDataLength >> 8);
+    prefix[6] = (uint8_t)(metaDataLength >> 16);
+    prefix[7] = (uint8_t)(metaDataLength >> 24);
+    if ( block ) {
+        block->offset = table->fileOffset;
+        block->metaDataLength = sizeof(prefix) + metaDataLength;
+        block->bodyLength = bodyLength;
+    }
+    __nara_arrow_write(table, prefix, sizeof(prefix));
+    __nara_arrow_write(table, fb->bytes, fb->length);
+    __nara_arrow_write(table, __nara_arrow_padding, metaDataLength - fb->length);
+}
+
+/**/
+
+/*
+ * Write a body buffer padded to 8 bytes:
+ */
+static void
+__nara_arrow_write_body(
+    nara_arrow_table_t  *table,
+    const void          *bytes,
+    size_t              nBytes
+)
+{
+    __nara_arrow_write(table, bytes, nBytes);
+    __nara_arrow_write(table, __nara_arrow_padding, ((nBytes + 7) & ~(size_t)7) - nBytes);
+}
+
+/**/
+
+/*
+ * Write the rows gathered so far as a record batch:
+ */
+static void
+__nara_arrow_flush_batch(
+    nara_arrow_table_t  *table
+)
+{
+    nara_columns_buffer_t fb;
+    nara_arrow_block_t    *newBatches;
+    uint64_t              *bufferLengths, bodyLength = 0;
+    size_t                header;
+    unsigned int          c;
+    
+    if ( table->base.didFail ) return;
+    if ( ! (bufferLengths = (uint64_t*)calloc(2 * table->base.nColumns + 1, sizeof(uint64_t))) ||
+         ! (newBatches = (nara_arrow_block_t*)realloc(table->batches, (table->nBatches + 1) * sizeof(nara_arrow_block_t))) ) {
+        fprintf(stderr, "ERROR:  unable to allocate Arrow record batch\n");
+        free((void*)bufferLengths);
+        table->base.didFail = 1;
+        return;
+    }
+    table->batches = newBatches;
+    
+    /* No validity bitmaps (there are no nulls), just the values: */
+    for ( c = 0; c < table->base.nColumns; c++ ) {
+        bufferLengths[2 * c + 1] = table->base.columns[c].values.length;
+        bodyLength += (bufferLengths[2 * c + 1] + 7) & ~(uint64_t)7;
+    }
+    memset(&fb, 0, sizeof(fb));
+    header = __nara_arrow_fb_message(&fb, nara_arrow_header_record_batch, bodyLength);
+    __nara_arrow_fb_patch(&fb, header, __nara_arrow_fb_record_batch(&fb, table->base.nRows, table->base.nColumns, bufferLengths, 2 * table->base.nColumns));
+    __nara_arrow_write_message(table, &fb, bodyLength, &table->batches[table->nBatches++]);
+    for ( c = 0; c < table->base.nColumns; c++ ) __nara_arrow_write_body(table, table->base.columns[c].values.bytes, table->base.columns[c].values.length);
+    nara_columns_table_clear(&table->base, 0);
+    nara_columns_buffer_free(&fb);
+    free((void*)bufferLengths);
+}
+
+/**/
+
+/*
+ * Write the footer Block vector of a list of messages; returns its position:
+ */
+static size_t
+__nara_arrow_fb_blocks(
+    nara_columns_buffer_t         *fb,
+    const nara_arrow_block_t      *blocks,
+    unsigned int                  nBlocks
+)
+{
+    size_t                      vector = __nara_arrow_fb_vector(fb, nBlocks, 3 * sizeof(int64_t), sizeof(int64_t));
+    unsigned int                i;
+    
+    /* Block { offset, metaDataLength (padded to 8 bytes), bodyLength } */
+    for ( i = 0; i < nBlocks; i++ ) {
+        size_t                  block = vector + sizeof(uint32_t) + 3 * sizeof(int64_t) * i;
+        
+        __nara_arrow_put(fb, block, blocks[i].offset, sizeof(int64_t));
+        __nara_arrow_put(fb, block + sizeof(int64_t), blocks[i].metaDataLength, sizeof(int32_t));
+        __nara_arrow_put(fb, block + 2 * sizeof(int64_t), blocks[i].bodyLength, sizeof(int64_t));
+    }
+    return vector;
+}
+
+/**/
+
+/*
+ * Finish a file:  the last record batch, each string column's dictionary, the
+ * end-of-stream marker, and the footer:
+ */
+static void
+__nara_arrow_finish_table(
+    nara_arrow_table_t  *table
+)
+{
+    static const uint8_t  endOfStream[8] = { 0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0 };
+    nara_arrow_block_t    *dictionaries;
+    nara_columns_buffer_t fb;
+    nara_arrow_fb_field_t footerFields[4];
+    unsigned int          nDictionaries = 0, c;
+    size_t                root;
+    uint8_t               footerLength[4];
+    
+    if ( table->base.nRows || ! table->nBatches ) __nara_arrow_flush_batch(table);
+    if ( ! (dictionaries = (nara_arrow_block_t*)calloc(table->base.nColumns + 1, sizeof(nara_arrow_block_t))) ) {
+        fprintf(stderr, "ERROR:  unable to allocate Arrow footer\n");
+        table->base.didFail = 1;
+    }
+    if ( table->base.didFail ) goto early_exit;
+    
+    for ( c = 0; c < table->base.nColumns; c++ ) {
+        nara_columns_dictionary_t *dictionary = &table->base.columns[c].dictionary;
+        nara_arrow_fb_field_t   dictionaryFields[2];
+        uint64_t                bufferLengths[3], bodyLength;
+        size_t                  header;
+        uint32_t                offset = 0;
+        
+        if ( table->base.infos[c].kind != nara_fields_column_string ) continue;
+        
+        /* An empty dictionary still has the offset of its end: */
+        if ( ! dictionary->nEntries ) nara_columns_buffer_append(&dictionary->offsets, &offset, sizeof(offset));
+        bufferLengths[0] = 0;
+        bufferLengths[1] = dictionary->offsets.length;
+        bufferLengths[2] = dictionary->data.length;
+        
+        /* DictionaryBatch:  id, data */
+        memset(&fb, 0, sizeof(fb));
+        __nara_arrow_fb_scalar(&dictionaryFields[0], sizeof(int64_t), c);
+        __nara_arrow_fb_offset(&dictionaryFields[1]);
+        bodyLength = ((bufferLengths[1] + 7) & ~(uint64_t)7) + ((bufferLengths[2] + 7) & ~(uint64_t)7);
+        header = __nara_arrow_fb_message(&fb, nara_arrow_header_dictionary_batch, bodyLength);
+        __nara_arrow_fb_patch(&fb, header, __nara_arrow_fb_table(&fb, dictionaryFields, 2));
+        __nara_arrow_fb_patch(&fb, dictionaryFields[1].position, __nara_arrow_fb_record_batch(&fb, dictionary->nEntries, 1, bufferLengths, 3));
+        __nara_arrow_write_message(table, &fb, bodyLength, &dictionaries[nDictionaries++]);
+        __nara_arrow_write_body(table, dictionary->offsets.bytes, dictionary->offsets.length);
+        __nara_arrow_write_body(table, dictionary->data.bytes, dictionary->data.length);
+        nara_columns_buffer_free(&fb);
+        if ( dictionary->offsets.didFail ) table->base.didFail = 1;
+    }
+    __nara_arrow_write(table, endOfStream, sizeof(endOfStream));
+    
+    /* Footer:  version, schema, dictionaries, recordBatches */
+    memset(&fb, 0, sizeof(fb));
+    __nara_arrow_fb_scalar(&footerFields[0], sizeof(int16_t), nara_arrow_metadata_v5);
+    __nara_arrow_fb_offset(&footerFields[1]);
+    __nara_arrow_fb_offset(&footerFields[2]);
+    __nara_arrow_fb_offset(&footerFields[3]);
+    root = nara_columns_buffer_reserve(&fb, sizeof(uint32_t));
+    __nara_arrow_fb_patch(&fb, root, __nara_arrow_fb_table(&fb, footerFields, 4));
+    __nara_arrow_fb_patch(&fb, footerFields[1].position, __nara_arrow_fb_schema(&fb, table));
+    __nara_arrow_fb_patch(&fb, footerFields[2].position, __nara_arrow_fb_blocks(&fb, dictionaries, nDictionaries));
+    __nara_arrow_fb_patch(&fb, footerFields[3].position, __nara_arrow_fb_blocks(&fb, table->batches, table->nBatches));
+    if ( fb.didFail ) {
+        table->base.didFail = 1;
+    } else {
+        footerLength[0] = (uint8_t)fb.length;
+        footerLength[1] = (uint8_t)(fb.length >> 8);
+        footerLength[2] = (uint8_t)(fb.length >> 16);
+        footerLength[3] = (uint8_t)(fb.length >> 24);
+        __nara_arrow_write(table, fb.bytes, fb.length);
+        __nara_arrow_write(table, footerLength, sizeof(footerLength));
+        __nara_arrow_write(table, __nara_arrow_magic, 6);
+    }
+    nara_columns_buffer_free(&fb);
+
+early_exit:
+    if ( table->base.didFail ) fprintf(stderr, "ERROR:  Arrow file is incomplete\n");
+    free((void*)dictionaries);
+}
+
+/**/
+
+/*
+ * The flush function of a table:  write its rows as a record batch (the table
+ * has all it needs, there is no flush context).
+ */
+static void
+__nara_arrow_flush(
+    nara_columns_table_t    *table,
+    void                    *context
+)
+{
+    (void)context;
+    __nara_arrow_flush_batch((nara_arrow_table_t*)table);
+}
+
+/**/
+
+nara_export_context_t
+nara_arrow_export_init(
+    const char                  *exportArgs
+)
+{
+    nara_export_context_arrow_t *context = (nara_export_context_arrow_t*)calloc(1, sizeof(nara_export_context_arrow_t));
+    const char                  *colon = strrchr(exportArgs, ':');
+    unsigned long               batchRows = NARA_ARROW_DEFAULT_BATCH_ROWS;
+    
+    if ( ! context ) {
+        fprintf(stderr, "ERROR:  unable to allocate export context\n");
+        return NULL;
+    }
+    
+    /* A trailing :<batch-rows>: */
+    if ( colon && colon[1] && (strspn(colon + 1, "0123456789") == strlen(colon + 1)) ) {
+        batchRows = strtoul(colon + 1, NULL, 10);
+        if ( (batchRows == 0) || (batchRows > INT32_MAX) ) {
+            fprintf(stderr, "ERROR:  invalid Arrow batch size: %s\n", colon + 1);
+            free((void*)context);
+            return NULL;
+        }
+    } else {
+        colon = exportArgs + strlen(exportArgs);
+    }
+    if ( (colon == exportArgs) || ! (context->directory = strndup(exportArgs, colon - exportArgs)) ) {
+        fprintf(stderr, ( colon == exportArgs ) ? "ERROR:  no directory in Arrow output specifier\n" : "ERROR:  unable to allocate export context\n");
+        free((void*)context);
+        return NULL;
+    }
+    if ( (mkdir(context->directory, 0777) != 0) && (errno != EEXIST) ) {
+        fprintf(stderr, "ERROR:  unable to create Arrow output directory %s (errno = %d)\n", context->directory, errno);
+        free((void*)context->directory);
+        free((void*)context);
+        return NULL;
+    }
+    context->base.format = nara_export_format_arrow;
+    context->base.recordFormat = NULL;
+    context->batchRows = (uint32_t)batchRows;
+    return context;
+}
+
+/**/
+
+/*
+ * Create the file for a record type and write its schema:
+ */
+static int
+__nara_arrow_open_table(
+    nara_export_context_arrow_t *context,
+    nara_arrow_table_t          *table,
+    const char                  *typeName
+)
+{
+    size_t                      pathLen = strlen(context->directory) + strlen(typeName) + 8;
+    char                        *path = (char*)malloc(pathLen);
+    nara_columns_buffer_t       fb;
+    size_t                      header;
+    
+    if ( ! path ) {
+        fprintf(stderr, "ERROR:  unable to allocate Arrow table\n");
+        return ENOMEM;
+    }
+    snprintf(path, pathLen, "%s/%s.arrow", context->directory, typeName);
+    table->out = nara_emitter_open(path);
+    if ( ! table->out ) {
+        fprintf(stderr, "ERROR:  unable to open Arrow file %s for output (errno = %d)\n", path, errno);
+        free((void*)path);
+        return EIO;
+    }
+    free((void*)path);
+    table->base.flushRows = context->batchRows;
+    table->base.flushFn = __nara_arrow_flush;
+    
+    __nara_arrow_write(table, __nara_arrow_magic, sizeof(__nara_arrow_magic));
+    memset(&fb, 0, sizeof(fb));
+    header = __nara_arrow_fb_message(&fb, nara_arrow_header_schema, 0);
+    __nara_arrow_fb_patch(&fb, header, __nara_arrow_fb_schema(&fb, table));
+    __nara_arrow_write_message(table, &fb, 0, NULL);
+    nara_columns_buffer_free(&fb);
+    return table->base.didFail ? ENOMEM : 0;
+}
+
+/**/
+
+int
+nara_arrow_export_bind(
+    nara_export_context_t       exportContext,
+    nara_format_t               format
+)
+{
+    nara_export_context_arrow_t *context = (nara_export_context_arrow_t*)exportContext;
+    nara_format_t               oldFormat = context->base.recordFormat;
+    uint32_t                    t;
+    int                         rc;
+    
+    /* The columns are fixed by the first layout seen: */
+    if ( oldFormat && (oldFormat->layout != format->layout) ) {
+        fprintf(stderr, "ERROR:  cannot write %s records to Arrow files that hold %s records\n", format->name, oldFormat->name);
+        return EINVAL;
+    }
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        if ( ! format->recordTypes[t].byteSize || (format->skippedTypes & (1u << t)) ) continue;
+        if ( (rc = nara_columns_table_bind(&context->tables[t].base, format, t, "Arrow")) != 0 ) return rc;
+        if ( ! oldFormat && ((rc = __nara_arrow_open_table(context, &context->tables[t], format->recordTypes[t].name)) != 0) ) return rc;
+    }
+    context->base.recordFormat = format;
+    return 0;
+}
+
+/**/
+
+void
+nara_arrow_export(
+    nara_export_context_t       exportContext,
+    uint32_t                    recordType,
+    const nara_record_t         *theRecord
+)
+{
+    nara_columns_table_add(&((nara_export_context_arrow_t*)exportContext)->tables[recordType].base, theRecord);
+}
+
+/**/
+
+nara_export_context_t
+nara_arrow_export_fork(
+    nara_export_context_t       exportContext
+)
+{
+    nara_export_context_arrow_t *context = (nara_export_context_arrow_t*)exportContext;
+    nara_export_context_arrow_t *fork = (nara_export_context_arrow_t*)calloc(1, sizeof(nara_export_context_arrow_t));
+    uint32_t                    t;
+    
+    if ( ! fork ) return NULL;
+    fork->base = context->base;
+    fork->batchRows = context->batchRows;
+    
+    /* The forked tables borrow the parent's columns and are never flushed: */
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        if ( nara_columns_table_fork(&fork->tables[t].base, &context->tables[t].base) != 0 ) {
+            nara_arrow_export_join(exportContext, fork, 0);
+            return NULL;
+        }
+    }
+    return fork;
+}
+
+/**/
+
+void
+nara_arrow_export_join(
+    nara_export_context_t       exportContext,
+    nara_export_context_t       forkedContext,
+    int                         shouldWrite
+)
+{
+    nara_export_context_arrow_t *context = (nara_export_context_arrow_t*)exportContext;
+    nara_export_context_arrow_t *fork = (nara_export_context_arrow_t*)forkedContext;
+    uint32_t                    t;
+    
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        if ( shouldWrite ) nara_columns_table_join(&context->tables[t].base, &fork->tables[t].base);
+        nara_columns_table_destroy(&fork->tables[t].base);
+    }
+    free((void*)fork);
+}
+
+/**/
+
+int
+nara_arrow_export_destroy(
+    nara_export_context_t       exportContext
+)
+{
+    nara_export_context_arrow_t *context = (nara_export_context_arrow_t*)exportContext;
+    uint32_t                    t;
+    int                         rc = 0;
+    
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        nara_arrow_table_t      *table = &context->tables[t];
+        
+        if ( table->out ) {
+            __nara_arrow_finish_table(table);
+            if ( nara_emitter_close(table->out) || table->base.didFail ) rc = EIO;
+        }
+        nara_columns_table_destroy(&table->base);
+        free((void*)table->batches);
+    }
+    free((void*)context->directory);
+    free((void*)context);
+    return rc;
+}
@@ -0,0 +1,84 @@
+/*
+ * nara_arrow
+ *
+ * Apache Arrow IPC file ("Feather v2") export.  Each record type is written to
+ * its own file in an output directory, named for the type (district.arrow,
+ * school.arrow, and classroom.arrow or summary.arrow), so the files can be
+ * memory-mapped by pandas, R, polars, etc. instead of being parsed.
+ *
+ * A file has a column per CSV column of its record type:  integers are uint32,
+ * floating-point fields float32, and strings dictionary-encoded utf8 (with int32
+ * indices).  Records are gathered into record batches of a fixed number of rows;
+ * each string column's dictionary is written once, when the file is finished.
+ *
+ * The Arrow metadata (flatbuffers) is written directly; the Arrow libraries are
+ * not needed.  The columns are found with nara_fields_columns().
+ *
+ */
+
+#ifndef __NARA_ARROW_H__
+#define __NARA_ARROW_H__
+
+#include "nara_base.h"
+#include "nara_record.h"
+
+/*!
+    @defined NARA_ARROW_DEFAULT_BATCH_ROWS
+
+    The number of rows in a record batch if the output specifier does not
+    say.
+ */
+#define NARA_ARROW_DEFAULT_BATCH_ROWS   65536
+
+/*!
+    @function nara_arrow_export_init
+
+    Create an Arrow export context from the arguments of an output specifier,
+    <directory>{:<batch-rows>}; the directory is created if necessary.  The
+    files are created when the context is bound to a format.  Returns NULL
+    (after reporting why) on error.
+ */
+nara_export_context_t nara_arrow_export_init(const char *exportArgs);
+
+/*!
+    @function nara_arrow_export_bind
+
+    Bind the context to a format (see nara_export_bind()):  the first time,
+    create the files and write their schemas; afterwards the format must have
+    the same columns.  Returns zero on success.
+ */
+int nara_arrow_export_bind(nara_export_context_t exportContext, nara_format_t format);
+
+/*!
+    @function nara_arrow_export
+
+    Add a record of the given type as a row of its file.
+ */
+void nara_arrow_export(nara_export_context_t exportContext, uint32_t recordType, const nara_record_t *theRecord);
+
+/*!
+    @function nara_arrow_export_fork
+
+    Create a copy of the context whose rows are kept in memory (see
+    nara_export_fork()).
+ */
+nara_export_context_t nara_arrow_export_fork(nara_export_context_t exportContext);
+
+/*!
+    @function nara_arrow_export_join
+
+    Append the rows of a forked context to the context's files (if shouldWrite
+    is non-zero) and dispose of the fork.
+ */
+void nara_arrow_export_join(nara_export_context_t exportContext, nara_export_context_t forkedContext, int shouldWrite);
+
+/*!
+    @function nara_arrow_export_destroy
+
+    Write the last record batch, the dictionaries, and the footer of each
+    file, then dispose of the context.  Returns zero if every file was
+    written completely.
+ */
+int nara_arrow_export_destroy(nara_export_context_t exportContext);
+
+#endif /* __NARA_ARROW_H__ */
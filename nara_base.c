@@ -7,6 +7,11 @@
 
 #include "nara_base.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define NARA_HAVE_X86_SIMD
+#   include <immintrin.h>
+#endif
+
 uint16_t
 __nara_be_to_le_16(
     uint16_t    value
@@ -35,6 +40,99 @@ __nara_be_to_le_float(
     return *((float*)&VALUE);
 }
 
+void
+__nara_be_to_le_32_array(
+    uint32_t    *words,
+    size_t      count
+)
+{
+    while ( count-- ) {
+        *words = __builtin_bswap32(*words);
+        words++;
+    }
+}
+
+#ifdef NARA_HAVE_X86_SIMD
+
+/*
+ * The vector variants reverse the bytes of each 32-bit lane with a byte
+ * shuffle (pshufb); whatever is left at the tail is done by the scalar loop
+ * (or a masked load/store with AVX-512).
+ */
+
+__attribute__((target("ssse3")))
+void
+__nara_be_to_le_32_array_ssse3(
+    uint32_t    *words,
+    size_t      count
+)
+{
+    const __m128i   shuffle = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    
+    while ( count >= 4 ) {
+        __m128i     v = _mm_loadu_si128((const __m128i*)words);
+        
+        _mm_storeu_si128((__m128i*)words, _mm_shuffle_epi8(v, shuffle));
+        words += 4;
+        count -= 4;
+    }
+    __nara_be_to_le_32_array(words, count);
+}
+
+__attribute__((target("avx2")))
+void
+__nara_be_to_le_32_array_avx2(
+    uint32_t    *words,
+    size_t      count
+)
+{
+    const __m256i   shuffle = _mm256_broadcastsi128_si256(_mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3));
+    
+    while ( count >= 16 ) {
+        __m256i     v0 = _mm256_loadu_si256((const __m256i*)words);
+        __m256i     v1 = _mm256_loadu_si256((const __m256i*)(words + 8));
+        
+        _mm256_storeu_si256((__m256i*)words, _mm256_shuffle_epi8(v0, shuffle));
+        _mm256_storeu_si256((__m256i*)(words + 8), _mm256_shuffle_epi8(v1, shuffle));
+        words += 16;
+        count -= 16;
+    }
+    if ( count >= 8 ) {
+        __m256i     v = _mm256_loadu_si256((const __m256i*)words);
+        
+        _mm256_storeu_si256((__m256i*)words, _mm256_shuffle_epi8(v, shuffle));
+        words += 8;
+        count -= 8;
+    }
+    __nara_be_to_le_32_array(words, count);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+void
+__nara_be_to_le_32_array_avx512(
+    uint32_t    *words,
+    size_t      count
+)
+{
+    const __m512i   shuffle = _mm512_broadcast_i32x4(_mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3));
+    
+    while ( count >= 16 ) {
+        __m512i     v = _mm512_loadu_si512((const void*)words);
+        
+        _mm512_storeu_si512((void*)words, _mm512_shuffle_epi8(v, shuffle));
+        words += 16;
+        count -= 16;
+    }
+    if ( count ) {
+        __mmask16   tail = (__mmask16)((1u << count) - 1);
+        __m512i     v = _mm512_maskz_loadu_epi32(tail, (const void*)words);
+        
+        _mm512_mask_storeu_epi32((void*)words, tail, _mm512_shuffle_epi8(v, shuffle));
+    }
+}
+
+#endif /* NARA_HAVE_X86_SIMD */
+
 /**/
 
 uint16_t
@@ -61,11 +159,34 @@ __nara_be_to_be_float(
     return value;
 }
 
+void
+__nara_be_to_be_32_array(
+    uint32_t    *words,
+    size_t      count
+)
+{
+    /* Big-endian words are already in host order: */
+    (void)words;
+    (void)count;
+}
+
 /**/
 
+/*
+ * The host byte order is known at compile time, so the pointers start out
+ * correct even before nara_endian_init() is called:
+ */
+#ifdef NARA_HOST_BIG_ENDIAN
 nara_be_to_host_16_fn nara_be_to_host_16 = __nara_be_to_be_16;
 nara_be_to_host_32_fn nara_be_to_host_32 = __nara_be_to_be_32;
 nara_be_to_host_float_fn nara_be_to_host_float = __nara_be_to_be_float;
+nara_be_to_host_32_array_fn nara_be_to_host_32_array = __nara_be_to_be_32_array;
+#else
+nara_be_to_host_16_fn nara_be_to_host_16 = __nara_be_to_le_16;
+nara_be_to_host_32_fn nara_be_to_host_32 = __nara_be_to_le_32;
+nara_be_to_host_float_fn nara_be_to_host_float = __nara_be_to_le_float;
+nara_be_to_host_32_array_fn nara_be_to_host_32_array = __nara_be_to_le_32_array;
+#endif
 
 /**/
 
@@ -78,9 +199,17 @@ nara_endian_init(void)
         nara_be_to_host_16 = __nara_be_to_le_16;
         nara_be_to_host_32 = __nara_be_to_le_32;
         nara_be_to_host_float = __nara_be_to_le_float;
+        nara_be_to_host_32_array = __nara_be_to_le_32_array;
+#ifdef NARA_HAVE_X86_SIMD
+        __builtin_cpu_init();
+        if ( __builtin_cpu_supports("avx512bw") ) nara_be_to_host_32_array = __nara_be_to_le_32_array_avx512;
+        else if ( __builtin_cpu_supports("avx2") ) nara_be_to_host_32_array = __nara_be_to_le_32_array_avx2;
+        else if ( __builtin_cpu_supports("ssse3") ) nara_be_to_host_32_array = __nara_be_to_le_32_array_ssse3;
+#endif
     } else {
         nara_be_to_host_16 = __nara_be_to_be_16;
         nara_be_to_host_32 = __nara_be_to_be_32;
         nara_be_to_host_float = __nara_be_to_be_float;
+        nara_be_to_host_32_array = __nara_be_to_be_32_array;
     }
 }
\ No newline at end of file
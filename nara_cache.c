@@ -0,0 +1,621 @@
+/*
+ * nara_cache
+ *
+ * Decoded caches of NARA data archives.
+ *
+ * A cache is built by converting its source to an export context of its own
+ * (nara_export_format_cache) that appends each processed record to the file
+ * and notes its offset under its type, so the usual drivers -- threads
+ * included -- build it.  The file is written under a temporary name and the
+ * header is filled in last, then it is renamed into place:  an interrupted
+ * build never leaves a cache that looks complete.
+ *
+ * Exporting from a cache merges the offset lists of the wanted types, which
+ * yields the records in their original order.  For threads the records are
+ * split into ranges of the record data (see nara_convert_units_parallel()).
+ *
+ */
+
+#include "nara_cache.h"
+#include "nara_archive.h"
+#include "nara_columns.h"
+#include "nara_convert.h"
+#include "nara_record_impl.h"
+#include "nara_emitter.h"
+#include "nara_stats.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef HAVE_SYS_MMAN_H
+#   include <sys/mman.h>
+#endif
+
+#if defined(__APPLE__)
+#   define NARA_CACHE_MTIME_NSEC(S)     ((S).st_mtimespec.tv_nsec)
+#   define NARA_CACHE_CTIME_NSEC(S)     ((S).st_ctimespec.tv_nsec)
+#else
+#   define NARA_CACHE_MTIME_NSEC(S)     ((S).st_mtim.tv_nsec)
+#   define NARA_CACHE_CTIME_NSEC(S)     ((S).st_ctim.tv_nsec)
+#endif
+
+/*
+ * The records start on a page boundary after the header:
+ */
+#define NARA_CACHE_DATA_OFFSET      4096
+
+/*
+ * Records are stored at offsets that are multiples of this:
+ */
+#define NARA_CACHE_RECORD_ALIGN     8
+
+/*
+ * Threads export ranges of this many bytes of record data:
+ */
+#define NARA_CACHE_UNIT_BYTES       (1024 * 1024)
+
+static const char __nara_cache_magic[8] = { 'N', 'A', 'R', 'A', 'C', 'A', 'C', 'H' };
+
+/*
+ * The header of a cache file.  Everything before dataOffset identifies the
+ * cache and its source and must match exactly:
+ */
+typedef struct {
+    char            magic[8];
+    uint32_t        version;
+    uint32_t        byteOrder;
+    uint32_t        layout;
+    uint32_t        isEBCDIC;
+    uint64_t        sourceDevice;
+    uint64_t        sourceInode;
+    uint64_t        sourceSize;
+    int64_t         sourceMTime;
+    int64_t         sourceMTimeNSec;
+    int64_t         sourceCTime;
+    int64_t         sourceCTimeNSec;
+    uint64_t        sourceHash;
+    uint64_t        dataOffset;
+    uint64_t        dataLength;
+    uint64_t        indexOffset;
+    uint64_t        nRecords[nara_record_type_max];
+} nara_cache_header_t;
+
+/*
+ * A cache being built:  the length of the record data so far and, per type,
+ * the offsets of its records (relative to the start of the record data).  A
+ * fork has no path of its own.
+ */
+typedef struct {
+    nara_export_context_base_t  base;
+    nara_emitter_t              out;
+    char                        *path;
+    uint64_t                    length;
+    nara_columns_buffer_t       index[nara_record_type_max];
+} nara_export_context_cache_t;
+
+/*
+ * A mapped cache and the format its records are exported in:
+ */
+typedef struct {
+    uint8_t                     *mapBase;
+    uint64_t                    mapLength;
+    const nara_cache_header_t   *header;
+    const uint64_t              *index[nara_record_type_max];
+    nara_format_t               format;
+    int                         shouldCount;
+} nara_cache_t;
+
+/**/
+
+/*
+ * FNV-1a over a range of bytes, taken a word at a time (the trailing few a
+ * byte at a time) so that hashing an entire source runs at memory speed:
+ */
+static uint64_t
+__nara_cache_hash(
+    const uint8_t   *bytes,
+    size_t          nBytes
+)
+{
+    uint64_t        hash = 0xcbf29ce484222325ULL;
+    
+    while ( nBytes >= sizeof(uint64_t) ) {
+        uint64_t    word;
+        
+        memcpy(&word, bytes, sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3ULL;
+        bytes += sizeof(word);
+        nBytes -= sizeof(word);
+    }
+    while ( nBytes-- ) hash = (hash ^ *bytes++) * 0x100000001b3ULL;
+    return hash;
+}
+
+/**/
+
+char*
+nara_cache_path(
+    const char      *cachePath,
+    const char      *sourcePath
+)
+{
+    struct stat     finfo;
+    
+    if ( (stat(cachePath, &finfo) == 0) && S_ISDIR(finfo.st_mode) ) {
+        const char  *baseName = strrchr(sourcePath, '/');
+        const char  *member = NULL;
+        char        *key, *path;
+        size_t      keyLen, pathLen;
+        uint64_t    hash;
+        
+        /*
+         * Files of the same name in different directories get caches of their own:
+         * the name also carries a hash of the file's device and inode (for an
+         * archive member, those of the archive and the member's path in it):
+         */
+        if ( stat(sourcePath, &finfo) != 0 ) {
+            if ( nara_archive_stat(sourcePath, &finfo) == 0 ) member = strchr(sourcePath, '#');
+            else memset(&finfo, 0, sizeof(finfo));
+        }
+        keyLen = 48 + (member ? strlen(member) : 0);
+        if ( ! (key = (char*)malloc(keyLen)) ) return NULL;
+        keyLen = (size_t)snprintf(key, keyLen, "%llx:%llx%s", (unsigned long long)finfo.st_dev, (unsigned long long)finfo.st_ino, member ? member : "");
+        hash = __nara_cache_hash((const uint8_t*)key, keyLen);
+        free((void*)key);
+        
+        baseName = baseName ? (baseName + 1) : sourcePath;
+        pathLen = strlen(cachePath) + strlen(baseName) + 29;
+        if ( (path = (char*)malloc(pathLen)) ) snprintf(path, pathLen, "%s/%s.%016llx.naracache", cachePath, baseName, (unsigned long long)hash);
+        return path;
+    }
+    return strdup(cachePath);
+}
+
+/**/
+
+int
+nara_cache_can_export(
+    nara_format_t   format
+)
+{
+    uint32_t        t;
+    
+    if ( format->filterFn ) return 0;
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        if ( format->recordTypes[t].byteSize && ! (format->skippedTypes & (1u << t)) && (format->processFns[t] == format->processTypeFn) ) return 0;
+    }
+    return 1;
+}
+
+/**/
+
+/*
+ * Fill in the identifying part of a header for the source file read by reader.
+ * The file's device, inode, and change time catch an in-place rewrite even if
+ * its modification time was put back; the hash covers every byte of it, so it
+ * is this hash that a cache being built records:
+ */
+static int
+__nara_cache_identify(
+    nara_reader_t       reader,
+    const char          *sourcePath,
+    nara_cache_header_t *identity
+)
+{
+    nara_format_t       format = nara_reader_format(reader);
+    uint64_t            length = nara_reader_length(reader);
+    const uint8_t       *bytes = (const uint8_t*)nara_reader_bytes(reader, 0, (size_t)length);
+    struct stat         finfo;
+    
+    if ( ! bytes ) return 0;
+    if ( stat(sourcePath, &finfo) == 0 ) {
+        if ( ! S_ISREG(finfo.st_mode) || ((uint64_t)finfo.st_size != length) ) return 0;
+    } else {
+        /* An archive member is identified by the archive's file (and its own size and hash): */
+        if ( (nara_archive_stat(sourcePath, &finfo) != 0) || ! S_ISREG(finfo.st_mode) || ((uint64_t)finfo.st_size < length) ) return 0;
+    }
+    
+    memset(identity, 0, sizeof(*identity));
+    memcpy(identity->magic, __nara_cache_magic, sizeof(identity->magic));
+    identity->version = NARA_CACHE_VERSION;
+    identity->byteOrder = 0x01020304;
+    identity->layout = nara_format_layout(format);
+    identity->isEBCDIC = (uint32_t)nara_format_is_ebcdic(format);
+    identity->sourceDevice = (uint64_t)finfo.st_dev;
+    identity->sourceInode = (uint64_t)finfo.st_ino;
+    identity->sourceSize = length;
+    identity->sourceMTime = (int64_t)finfo.st_mtime;
+    identity->sourceMTimeNSec = (int64_t)NARA_CACHE_MTIME_NSEC(finfo);
+    identity->sourceCTime = (int64_t)finfo.st_ctime;
+    identity->sourceCTimeNSec = (int64_t)NARA_CACHE_CTIME_NSEC(finfo);
+    identity->sourceHash = __nara_cache_hash(bytes, (size_t)length);
+    return 1;
+}
+
+/**/
+
+#ifdef HAVE_SYS_MMAN_H
+
+/*
+ * Map the cache at path if it exists and matches identity:
+ */
+static int
+__nara_cache_map(
+    nara_cache_t                *cache,
+    const char                  *path,
+    const nara_cache_header_t   *identity
+)
+{
+    const nara_cache_header_t   *header;
+    struct stat                 finfo;
+    uint64_t                    nRecords = 0;
+    void                        *mapBase;
+    uint32_t                    t;
+    int                         fd = open(path, O_RDONLY);
+    
+    if ( fd < 0 ) return 0;
+    if ( (fstat(fd, &finfo) != 0) || ! S_ISREG(finfo.st_mode) || ((uint64_t)finfo.st_size < NARA_CACHE_DATA_OFFSET) ) {
+        close(fd);
+        return 0;
+    }
+    
+    /* Private + writable, like a mapped input:  exporters are free to scribble on a record: */
+    mapBase = mmap(NULL, (size_t)finfo.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if ( mapBase == MAP_FAILED ) return 0;
+    
+    /* The cache must be of this source and this decoder, and hang together: */
+    header = (const nara_cache_header_t*)mapBase;
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        if ( header->nRecords[t] > (uint64_t)finfo.st_size / sizeof(uint64_t) ) break;
+        nRecords += header->nRecords[t];
+    }
+    if ( (t < nara_record_type_max) || (memcmp(header, identity, offsetof(nara_cache_header_t, dataOffset)) != 0) ||
+         (header->dataOffset != NARA_CACHE_DATA_OFFSET) || (header->dataLength > (uint64_t)finfo.st_size) ||
+         (header->indexOffset != header->dataOffset + header->dataLength) || (header->indexOffset % sizeof(uint64_t)) ||
+         (nRecords > ((uint64_t)finfo.st_size - header->indexOffset) / sizeof(uint64_t)) ||
+         (header->indexOffset + nRecords * sizeof(uint64_t) != (uint64_t)finfo.st_size) ) {
+        munmap(mapBase, (size_t)finfo.st_size);
+        return 0;
+    }
+
+#ifdef MADV_SEQUENTIAL
+    madvise(mapBase, (size_t)finfo.st_size, MADV_SEQUENTIAL);
+#endif
+    cache->mapBase = (uint8_t*)mapBase;
+    cache->mapLength = (uint64_t)finfo.st_size;
+    cache->header = header;
+    cache->index[1] = (const uint64_t*)(cache->mapBase + header->indexOffset);
+    for ( t = 2; t < nara_record_type_max; t++ ) cache->index[t] = cache->index[t - 1] + header->nRecords[t - 1];
+    return 1;
+}
+
+#endif /* HAVE_SYS_MMAN_H */
+
+/**/
+
+/*
+ * The position of the first of nOffsets sorted offsets that is not less than
+ * offset:
+ */
+static const uint64_t*
+__nara_cache_lower_bound(
+    const uint64_t  *offsets,
+    uint64_t        nOffsets,
+    uint64_t        offset
+)
+{
+    while ( nOffsets ) {
+        uint64_t    half = nOffsets / 2;
+        
+        if ( offsets[half] < offset ) {
+            offsets += half + 1;
+            nOffsets -= half + 1;
+        } else {
+            nOffsets = half;
+        }
+    }
+    return offsets;
+}
+
+/**/
+
+/*
+ * Export the records that start in [offset, offset + length) of the record
+ * data, in order:
+ */
+static int
+__nara_cache_convert_unit(
+    void                    *context,
+    uint64_t                offset,
+    uint64_t                length,
+    nara_export_context_t   exportContext
+)
+{
+    nara_cache_t            *cache = (nara_cache_t*)context;
+    nara_format_t           format = cache->format;
+    const uint8_t           *data = cache->mapBase + cache->header->dataOffset;
+    uint64_t                dataLength = cache->header->dataLength;
+    const uint64_t          *next[nara_record_type_max], *end[nara_record_type_max];
+    uint32_t                t;
+    
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        uint64_t            nRecords = cache->header->nRecords[t];
+        
+        if ( ! nRecords || (format->skippedTypes & (1u << t)) || ! format->recordTypes[t].byteSize ) {
+            next[t] = end[t] = NULL;
+            continue;
+        }
+        next[t] = __nara_cache_lower_bound(cache->index[t], nRecords, offset);
+        end[t] = __nara_cache_lower_bound(next[t], nRecords - (next[t] - cache->index[t]), offset + length);
+    }
+    while ( 1 ) {
+        uint32_t            recordType = 0;
+        uint64_t            recordOffset;
+        size_t              byteSize;
+        
+        for ( t = 1; t < nara_record_type_max; t++ ) {
+            if ( (next[t] < end[t]) && (! recordType || (*next[t] < *next[recordType])) ) recordType = t;
+        }
+        if ( ! recordType ) break;
+        recordOffset = *next[recordType]++;
+        byteSize = format->recordTypes[recordType].byteSize;
+        if ( (byteSize > dataLength) || (recordOffset > dataLength - byteSize) ) {
+            fprintf(stderr, "ERROR:  cache record at %lld extends beyond the record data\n", (long long int)recordOffset);
+            return EINVAL;
+        }
+        if ( cache->shouldCount ) {
+            nara_stats_add_bytes(byteSize);
+            nara_stats_add_record(format->recordTypes[recordType].statsCounter);
+        }
+        nara_record_export(exportContext, (nara_record_t*)(data + recordOffset));
+    }
+    return 0;
+}
+
+/**/
+
+/*
+ * Complete a cache:  the index after the records, then the header at the
+ * start, then the final name.
+ */
+static int
+__nara_cache_finish(
+    nara_export_context_cache_t *context,
+    const char                  *cachePath,
+    const nara_cache_header_t   *identity
+)
+{
+    nara_cache_header_t         header = *identity;
+    uint32_t                    t;
+    int                         fd, rc = 0;
+    
+    header.dataOffset = NARA_CACHE_DATA_OFFSET;
+    header.dataLength = context->length;
+    header.indexOffset = header.dataOffset + header.dataLength;
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        if ( context->index[t].didFail ) {
+            fprintf(stderr, "ERROR:  unable to allocate cache index\n");
+            return ENOMEM;
+        }
+        header.nRecords[t] = context->index[t].length / sizeof(uint64_t);
+        nara_emitter_append(context->out, context->index[t].bytes, context->index[t].length);
+    }
+    if ( nara_emitter_flush(context->out) != 0 ) return EIO;
+    rc = nara_emitter_close(context->out);
+    context->out = NULL;
+    if ( rc ) return rc;
+    
+    if ( (fd = open(context->path, O_WRONLY)) < 0 ) {
+        rc = errno;
+    } else {
+        if ( pwrite(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ) rc = errno ? errno : EIO;
+        if ( (close(fd) != 0) && ! rc ) rc = errno;
+    }
+    if ( ! rc && (rename(context->path, cachePath) != 0) ) rc = errno;
+    if ( rc ) {
+        fprintf(stderr, "ERROR:  unable to write cache %s (errno = %d)\n", cachePath, rc);
+        return rc;
+    }
+    free((void*)context->path);
+    context->path = NULL;
+    return 0;
+}
+
+/**/
+
+/*
+ * Decode the source into a new cache at cachePath:
+ */
+static int
+__nara_cache_build(
+    const char                  *cachePath,
+    nara_reader_t               reader,
+    const nara_cache_header_t   *identity,
+    unsigned int                nThreads
+)
+{
+    nara_export_context_cache_t *context = (nara_export_context_cache_t*)calloc(1, sizeof(nara_export_context_cache_t));
+    size_t                      pathLen = strlen(cachePath) + 32;
+    static const uint8_t        header[NARA_CACHE_DATA_OFFSET];
+    int                         rc;
+    
+    if ( ! context || ! (context->path = (char*)malloc(pathLen)) ) {
+        fprintf(stderr, "ERROR:  unable to allocate cache context\n");
+        if ( context ) free((void*)context);
+        return ENOMEM;
+    }
+    snprintf(context->path, pathLen, "%s.%ld.tmp", cachePath, (long)getpid());
+    if ( ! (context->out = nara_emitter_open(context->path)) ) {
+        fprintf(stderr, "ERROR:  unable to open cache %s for output (errno = %d)\n", context->path, errno);
+        free((void*)context->path);
+        free((void*)context);
+        return EIO;
+    }
+    context->base.format = nara_export_format_cache;
+    
+    /* Room for the header, which is written once the records are: */
+    nara_emitter_append(context->out, header, sizeof(header));
+    rc = nara_convert(reader, context, nThreads);
+    if ( rc == 0 ) rc = __nara_cache_finish(context, cachePath, identity);
+    nara_export_destroy(context);
+    return rc;
+}
+
+/**/
+
+int
+nara_cache_convert(
+    const char              *cachePath,
+    nara_reader_t           reader,
+    const char              *sourcePath,
+    nara_format_t           format,
+    nara_export_context_t   exportContext,
+    unsigned int            nThreads
+)
+{
+#ifdef HAVE_SYS_MMAN_H
+    nara_cache_header_t     identity;
+    nara_cache_t            cache;
+    uint32_t                t;
+    int                     rc, didBuild = 0;
+    
+    /* Only files that can be mapped (and so hashed) have caches: */
+    if ( nara_reader_is_mapped(reader) && __nara_cache_identify(reader, sourcePath, &identity) ) {
+        memset(&cache, 0, sizeof(cache));
+        if ( ! __nara_cache_map(&cache, cachePath, &identity) ) {
+            if ( (rc = __nara_cache_build(cachePath, reader, &identity, nThreads)) != 0 ) return rc;
+            if ( ! __nara_cache_map(&cache, cachePath, &identity) ) {
+                fprintf(stderr, "ERROR:  unable to map cache %s\n", cachePath);
+                return EIO;
+            }
+            didBuild = 1;
+        }
+        
+        /* The records were counted as they were decoded, unless they came from an existing cache: */
+        cache.format = format;
+        cache.shouldCount = ! didBuild;
+        rc = nara_export_bind(exportContext, format);
+        if ( rc == 0 ) {
+            for ( t = 1; t < nara_record_type_max; t++ ) {
+                if ( cache.shouldCount && (format->skippedTypes & (1u << t)) ) nara_stats_add_records(format->recordTypes[t].statsCounter, cache.header->nRecords[t]);
+            }
+            rc = nara_convert_units_parallel(&cache, cache.header->dataLength, NARA_CACHE_UNIT_BYTES, __nara_cache_convert_unit, exportContext, nThreads);
+        }
+        munmap(cache.mapBase, (size_t)cache.mapLength);
+        return rc;
+    }
+#endif
+    nara_reader_set_format(reader, format);
+    return nara_convert(reader, exportContext, nThreads);
+}
+
+/**/
+
+int
+nara_cache_export_bind(
+    nara_export_context_t       exportContext,
+    nara_format_t               format
+)
+{
+    nara_export_context_cache_t *context = (nara_export_context_cache_t*)exportContext;
+    
+    if ( context->base.recordFormat && (context->base.recordFormat != format) ) {
+        fprintf(stderr, "ERROR:  cannot add %s records to a cache of %s records\n", format->name, context->base.recordFormat->name);
+        return EINVAL;
+    }
+    context->base.recordFormat = format;
+    return 0;
+}
+
+/**/
+
+void
+nara_cache_export(
+    nara_export_context_t       exportContext,
+    uint32_t                    recordType,
+    const nara_record_t         *theRecord
+)
+{
+    nara_export_context_cache_t *context = (nara_export_context_cache_t*)exportContext;
+    static const uint8_t        padding[NARA_CACHE_RECORD_ALIGN];
+    size_t                      byteSize = context->base.recordFormat->recordTypes[recordType].byteSize;
+    size_t                      nPadding = (NARA_CACHE_RECORD_ALIGN - byteSize % NARA_CACHE_RECORD_ALIGN) % NARA_CACHE_RECORD_ALIGN;
+    
+    nara_columns_buffer_append(&context->index[recordType], &context->length, sizeof(context->length));
+    nara_emitter_append(context->out, theRecord, byteSize);
+    nara_emitter_append(context->out, padding, nPadding);
+    context->length += byteSize + nPadding;
+}
+
+/**/
+
+nara_export_context_t
+nara_cache_export_fork(
+    nara_export_context_t       exportContext
+)
+{
+    nara_export_context_cache_t *context = (nara_export_context_cache_t*)exportContext;
+    nara_export_context_cache_t *fork = (nara_export_context_cache_t*)calloc(1, sizeof(nara_export_context_cache_t));
+    
+    if ( ! fork ) return NULL;
+    fork->base = context->base;
+    if ( ! (fork->out = nara_emitter_open_memory()) ) {
+        free((void*)fork);
+        return NULL;
+    }
+    return fork;
+}
+
+/**/
+
+void
+nara_cache_export_join(
+    nara_export_context_t       exportContext,
+    nara_export_context_t       forkedContext,
+    int                         shouldWrite
+)
+{
+    nara_export_context_cache_t *context = (nara_export_context_cache_t*)exportContext;
+    nara_export_context_cache_t *fork = (nara_export_context_cache_t*)forkedContext;
+    uint32_t                    t;
+    
+    if ( shouldWrite ) {
+        /* The fork's offsets are relative to its own records: */
+        for ( t = 1; t < nara_record_type_max; t++ ) {
+            const uint64_t      *offsets = (const uint64_t*)fork->index[t].bytes;
+            size_t              i, nOffsets = fork->index[t].length / sizeof(uint64_t);
+            
+            for ( i = 0; i < nOffsets; i++ ) {
+                uint64_t        offset = context->length + offsets[i];
+                
+                nara_columns_buffer_append(&context->index[t], &offset, sizeof(offset));
+            }
+            if ( fork->index[t].didFail ) context->index[t].didFail = 1;
+        }
+        nara_emitter_splice(context->out, fork->out);
+        context->length += fork->length;
+    }
+    nara_cache_export_destroy(forkedContext);
+}
+
+/**/
+
+void
+nara_cache_export_destroy(
+    nara_export_context_t       exportContext
+)
+{
+    nara_export_context_cache_t *context = (nara_export_context_cache_t*)exportContext;
+    uint32_t                    t;
+    
+    if ( context->out ) nara_emitter_close(context->out);
+    if ( context->path ) {
+        unlink(context->path);
+        free((void*)context->path);
+    }
+    for ( t = 1; t < nara_record_type_max; t++ ) nara_columns_buffer_free(&context->index[t]);
+    free((void*)context);
+}
@@ -0,0 +1,115 @@
+/*
+ * nara_cache
+ *
+ * Decoded caches of NARA data archives.  A cache holds the records of one
+ * file as nara_record_next() leaves them -- byte-swapped to host order and
+ * transcoded -- so a later conversion of the same file maps the cache and
+ * exports its records directly, with no framing, swapping, or transcoding.
+ *
+ * A cache file is, in host byte order:
+ *
+ *     <header> <records> <index>
+ *
+ * The header identifies the cache format (version and byte order), the
+ * decoder that produced the records, and the source file (its size,
+ * modification time, and a hash of its leading and trailing bytes).  The
+ * records follow in their original order, each at an 8-byte aligned offset,
+ * and the index lists the offsets of the records of each type in turn, so
+ * records of unwanted types are passed over without their pages being
+ * touched.  A cache that does not match its source in every respect is
+ * rebuilt.
+ *
+ */
+
+#ifndef __NARA_CACHE_H__
+#define __NARA_CACHE_H__
+
+#include "nara_base.h"
+#include "nara_record.h"
+#include "nara_reader.h"
+
+/*!
+    @defined NARA_CACHE_VERSION
+
+    The version of the cache file format (and of the decoded records in it);
+    caches of any other version are rebuilt.
+ */
+#define NARA_CACHE_VERSION      2
+
+/*!
+    @function nara_cache_path
+
+    Returns the cache file for the input file at sourcePath given the path of
+    a --cache option:  if cachePath is a directory, a file in it named for
+    the input (<basename>.<hash>.naracache, where the hash is of the input's
+    device and inode, so that inputs of the same name in different
+    directories do not share a cache), otherwise cachePath itself.  Returns
+    NULL if memory could not be allocated; the result is to be disposed of
+    with free().
+ */
+char* nara_cache_path(const char *cachePath, const char *sourcePath);
+
+/*!
+    @function nara_cache_can_export
+
+    Returns non-zero if records of format can be exported from a cache:  its
+    records are processed in full and not filtered (formats projected with
+    --fields or --where work on the file's raw bytes), though types may be
+    skipped.
+ */
+int nara_cache_can_export(nara_format_t format);
+
+/*!
+    @function nara_cache_convert
+
+    Convert the input file read by reader (at sourcePath, in the reader's
+    format) to exportContext by way of the cache file at cachePath:  if the
+    cache is missing or does not match the file it is built first, with the
+    records decoded on nThreads threads.  The records are exported in format
+    (the reader's format or a projection of it that nara_cache_can_export()
+    accepts) from the memory-mapped cache, by nThreads threads where
+    possible.  An input that is not memory-mapped is converted directly.
+    Returns zero on success.
+ */
+int nara_cache_convert(const char *cachePath, nara_reader_t reader, const char *sourcePath, nara_format_t format, nara_export_context_t exportContext, unsigned int nThreads);
+
+/*!
+    @function nara_cache_export_bind
+
+    Bind a cache-building export context to a format (see nara_export_bind());
+    a cache holds records of a single format.  Returns zero on success.
+ */
+int nara_cache_export_bind(nara_export_context_t exportContext, nara_format_t format);
+
+/*!
+    @function nara_cache_export
+
+    Add a processed record of the given type to the cache being built.
+ */
+void nara_cache_export(nara_export_context_t exportContext, uint32_t recordType, const nara_record_t *theRecord);
+
+/*!
+    @function nara_cache_export_fork
+
+    Create a copy of a cache-building context whose records are kept in
+    memory (see nara_export_fork()).
+ */
+nara_export_context_t nara_cache_export_fork(nara_export_context_t exportContext);
+
+/*!
+    @function nara_cache_export_join
+
+    Append the records of a forked context to the cache (if shouldWrite is
+    non-zero) and dispose of the fork.
+ */
+void nara_cache_export_join(nara_export_context_t exportContext, nara_export_context_t forkedContext, int shouldWrite);
+
+/*!
+    @function nara_cache_export_destroy
+
+    Dispose of a cache-building context; a cache that was not completed is
+    removed.
+ */
+void nara_cache_export_destroy(nara_export_context_t exportContext);
+
+#endif /* __NARA_CACHE_H__ */
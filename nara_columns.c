@@ -0,0 +1,409 @@
+/*
+ * nara_columns
+ *
+ * Column buffers for the columnar exporters.
+ *
+ */
+
+#include "nara_columns.h"
+#include "nara_record_impl.h"
+#include "nara_ebcdic.h"
+
+/*
+ * The longest string field (cf. NARA_FIELDS_MAX_STRING); as UTF-8 a string may
+ * take twice as many bytes:
+ */
+#define NARA_COLUMNS_MAX_STRING     255
+
+/**/
+
+size_t
+nara_columns_buffer_reserve(
+    nara_columns_buffer_t   *buffer,
+    size_t                  nBytes
+)
+{
+    size_t                  position = buffer->length;
+    
+    if ( buffer->didFail ) return 0;
+    if ( buffer->capacity - buffer->length < nBytes ) {
+        size_t              newCapacity = buffer->capacity ? buffer->capacity : 4096;
+        uint8_t             *newBytes;
+        
+        while ( newCapacity - buffer->length < nBytes ) newCapacity *= 2;
+        if ( ! (newBytes = (uint8_t*)realloc(buffer->bytes, newCapacity)) ) {
+            fprintf(stderr, "ERROR:  unable to allocate column buffer\n");
+            buffer->didFail = 1;
+            return 0;
+        }
+        buffer->bytes = newBytes;
+        buffer->capacity = newCapacity;
+    }
+    memset(buffer->bytes + position, 0, nBytes);
+    buffer->length += nBytes;
+    return position;
+}
+
+/**/
+
+void
+nara_columns_buffer_free(
+    nara_columns_buffer_t   *buffer
+)
+{
+    free((void*)buffer->bytes);
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+/**/
+
+static uint32_t
+__nara_columns_hash(
+    const uint8_t   *bytes,
+    size_t          nBytes
+)
+{
+    uint32_t        hash = 2166136261u;
+    
+    while ( nBytes-- ) hash = (hash ^ *bytes++) * 16777619u;
+    return hash;
+}
+
+/**/
+
+uint32_t
+nara_columns_dictionary_index(
+    nara_columns_dictionary_t   *dictionary,
+    const uint8_t               *bytes,
+    size_t                      nBytes
+)
+{
+    uint32_t                    hash = __nara_columns_hash(bytes, nBytes), i, index;
+    uint32_t                    offset;
+    size_t                      entryBytes;
+    
+    /* Grow the hash table when it is half full: */
+    if ( 2 * (dictionary->nEntries + 1) > dictionary->nSlots ) {
+        uint32_t                newNSlots = dictionary->nSlots ? 2 * dictionary->nSlots : 1024;
+        uint32_t                *newSlots = (uint32_t*)calloc(newNSlots, sizeof(uint32_t));
+        
+        if ( ! newSlots ) {
+            fprintf(stderr, "ERROR:  unable to allocate column dictionary\n");
+            dictionary->data.didFail = 1;
+            return 0;
+        }
+        for ( index = 0; index < dictionary->nEntries; index++ ) {
+            const uint8_t       *entry = nara_columns_dictionary_entry(dictionary, index, &entryBytes);
+            
+            i = __nara_columns_hash(entry, entryBytes) & (newNSlots - 1);
+            while ( newSlots[i] ) i = (i + 1) & (newNSlots - 1);
+            newSlots[i] = index + 1;
+        }
+        free((void*)dictionary->slots);
+        dictionary->slots = newSlots;
+        dictionary->nSlots = newNSlots;
+    }
+    
+    for ( i = hash & (dictionary->nSlots - 1); dictionary->slots[i]; i = (i + 1) & (dictionary->nSlots - 1) ) {
+        const uint8_t           *entry = nara_columns_dictionary_entry(dictionary, index = dictionary->slots[i] - 1, &entryBytes);
+        
+        if ( (entryBytes == nBytes) && (memcmp(entry, bytes, nBytes) == 0) ) return index;
+    }
+    
+    /* A new string: */
+    if ( dictionary->nEntries == 0 ) {
+        dictionary->offsets.length = 0;
+        offset = 0;
+        nara_columns_buffer_append(&dictionary->offsets, &offset, sizeof(offset));
+    }
+    nara_columns_buffer_append(&dictionary->data, bytes, nBytes);
+    offset = (uint32_t)dictionary->data.length;
+    nara_columns_buffer_append(&dictionary->offsets, &offset, sizeof(offset));
+    if ( dictionary->data.didFail || dictionary->offsets.didFail ) {
+        dictionary->data.didFail = 1;
+        return 0;
+    }
+    dictionary->slots[i] = ++dictionary->nEntries;
+    return dictionary->nEntries - 1;
+}
+
+/**/
+
+void
+nara_columns_dictionary_clear(
+    nara_columns_dictionary_t   *dictionary
+)
+{
+    dictionary->data.length = 0;
+    dictionary->offsets.length = 0;
+    if ( dictionary->slots ) memset(dictionary->slots, 0, dictionary->nSlots * sizeof(uint32_t));
+    dictionary->nEntries = 0;
+}
+
+/**/
+
+void
+nara_columns_dictionary_free(
+    nara_columns_dictionary_t   *dictionary
+)
+{
+    nara_columns_buffer_free(&dictionary->data);
+    nara_columns_buffer_free(&dictionary->offsets);
+    free((void*)dictionary->slots);
+    memset(dictionary, 0, sizeof(*dictionary));
+}
+
+/**/
+
+int
+nara_columns_table_bind(
+    nara_columns_table_t        *table,
+    nara_format_t               format,
+    uint32_t                    recordType,
+    const char                  *exporterName
+)
+{
+    nara_fields_column_info_t   *infos = NULL;
+    unsigned int                nColumns, c;
+    int                         isRaw;
+    
+    if ( ! (nColumns = nara_fields_columns(format, recordType, &infos, &isRaw)) ) return EINVAL;
+    
+    if ( ! table->columns ) {
+        if ( ! (table->columns = (nara_columns_column_t*)calloc(nColumns, sizeof(nara_columns_column_t))) ) {
+            fprintf(stderr, "ERROR:  unable to allocate %s table\n", exporterName);
+            nara_fields_columns_destroy(infos, nColumns);
+            return ENOMEM;
+        }
+        table->nColumns = nColumns;
+    } else {
+        /* Another encoding of the layout must fill the same columns: */
+        for ( c = 0; (c < nColumns) && (nColumns == table->nColumns); c++ ) {
+            if ( strcmp(infos[c].name, table->infos[c].name) || (infos[c].kind != table->infos[c].kind) ) break;
+        }
+        if ( (nColumns != table->nColumns) || (c < nColumns) ) {
+            fprintf(stderr, "ERROR:  cannot write %s %s records to %s files with other columns\n", format->name, format->recordTypes[recordType].name, exporterName);
+            nara_fields_columns_destroy(infos, nColumns);
+            return EINVAL;
+        }
+        nara_fields_columns_destroy(table->infos, table->nColumns);
+    }
+    table->infos = infos;
+    table->ownsInfos = 1;
+    table->isRaw = isRaw;
+    table->isEBCDIC = format->isEBCDIC;
+    return 0;
+}
+
+/**/
+
+/*
+ * The dictionary index of a string field, which is decoded and trimmed as the
+ * other exporters would write it (see LOCAL_STR_FILL()) and stored as UTF-8:
+ */
+static uint32_t
+__nara_columns_string_index(
+    const nara_columns_table_t      *table,
+    nara_columns_column_t           *column,
+    const nara_fields_column_info_t *info,
+    const uint8_t                   *record
+)
+{
+    char                            field[NARA_COLUMNS_MAX_STRING];
+    uint8_t                         utf8[2 * NARA_COLUMNS_MAX_STRING];
+    size_t                          nBytes = 0, i;
+    
+    LOCAL_STR_DECL(value, NARA_COLUMNS_MAX_STRING);
+    
+    memcpy(field, record + info->offset, info->length);
+    if ( table->isRaw && table->isEBCDIC ) nara_ebcdic_to_ascii_field(field, info->length);
+    LOCAL_STR_FILL(value, info->length, field);
+    for ( i = 0; value[i]; i++ ) {
+        uint8_t                     c = (uint8_t)value[i];
+        
+        /* Bytes outside ASCII are taken to be Latin-1: */
+        if ( c < 0x80 ) {
+            utf8[nBytes++] = c;
+        } else {
+            utf8[nBytes++] = 0xC0 | (c >> 6);
+            utf8[nBytes++] = 0x80 | (c & 0x3F);
+        }
+    }
+    return nara_columns_dictionary_index(&column->dictionary, utf8, nBytes);
+}
+
+/**/
+
+/*
+ * Count a row just added, flushing the table if it is full:
+ */
+static void
+__nara_columns_table_end_row(
+    nara_columns_table_t    *table
+)
+{
+    if ( (++table->nRows == table->flushRows) && table->flushFn ) table->flushFn(table, table->flushContext);
+}
+
+/**/
+
+void
+nara_columns_table_add(
+    nara_columns_table_t        *table,
+    const nara_record_t         *theRecord
+)
+{
+    const uint8_t               *record = (const uint8_t*)theRecord;
+    unsigned int                c;
+    
+    if ( ! table->columns || table->didFail ) return;
+    for ( c = 0; c < table->nColumns; c++ ) {
+        const nara_fields_column_info_t *info = &table->infos[c];
+        nara_columns_column_t   *column = &table->columns[c];
+        
+        switch ( info->kind ) {
+            
+            case nara_fields_column_u32: {
+                uint32_t        word;
+                
+                memcpy(&word, record + info->offset, sizeof(word));
+                if ( table->isRaw ) word = nara_be_to_host_u32(word);
+                nara_columns_buffer_append(&column->values, &word, sizeof(word));
+                break;
+            }
+            
+            case nara_fields_column_float: {
+                float           value;
+                
+                memcpy(&value, record + info->offset, sizeof(value));
+                if ( table->isRaw ) value = nara_be_to_host_f32(value);
+                nara_columns_buffer_append(&column->values, &value, sizeof(value));
+                break;
+            }
+            
+            default: {
+                uint32_t        index = __nara_columns_string_index(table, column, info, record);
+                
+                nara_columns_buffer_append(&column->values, &index, sizeof(index));
+                if ( column->dictionary.data.didFail ) table->didFail = 1;
+                break;
+            }
+            
+        }
+        if ( column->values.didFail ) table->didFail = 1;
+    }
+    if ( ! table->didFail ) __nara_columns_table_end_row(table);
+}
+
+/**/
+
+int
+nara_columns_table_fork(
+    nara_columns_table_t        *forked,
+    const nara_columns_table_t  *table
+)
+{
+    memset(forked, 0, sizeof(*forked));
+    if ( ! table->columns ) return 0;
+    if ( ! (forked->columns = (nara_columns_column_t*)calloc(table->nColumns, sizeof(nara_columns_column_t))) ) return ENOMEM;
+    forked->infos = table->infos;
+    forked->nColumns = table->nColumns;
+    forked->isRaw = table->isRaw;
+    forked->isEBCDIC = table->isEBCDIC;
+    return 0;
+}
+
+/**/
+
+void
+nara_columns_table_join(
+    nara_columns_table_t        *table,
+    const nara_columns_table_t  *forked
+)
+{
+    uint32_t                    **remaps, r;
+    unsigned int                c;
+    
+    if ( ! forked->columns || ! table->columns || table->didFail ) return;
+    if ( forked->didFail ) {
+        table->didFail = 1;
+        return;
+    }
+    
+    /*
+     * The fork's dictionary indices are mapped (as they are met) to the table's;
+     * each entry holds the table's index plus one, or zero if not yet mapped:
+     */
+    if ( ! (remaps = (uint32_t**)calloc(table->nColumns, sizeof(uint32_t*))) ) {
+        table->didFail = 1;
+        return;
+    }
+    for ( c = 0; c < table->nColumns; c++ ) {
+        if ( table->infos[c].kind != nara_fields_column_string ) continue;
+        if ( ! (remaps[c] = (uint32_t*)calloc(forked->columns[c].dictionary.nEntries + 1, sizeof(uint32_t))) ) table->didFail = 1;
+    }
+    
+    for ( r = 0; (r < forked->nRows) && ! table->didFail; r++ ) {
+        for ( c = 0; c < table->nColumns; c++ ) {
+            uint32_t            value;
+            
+            memcpy(&value, forked->columns[c].values.bytes + r * sizeof(value), sizeof(value));
+            if ( remaps[c] ) {
+                if ( ! remaps[c][value] ) {
+                    size_t      nBytes;
+                    const uint8_t *bytes = nara_columns_dictionary_entry(&forked->columns[c].dictionary, value, &nBytes);
+                    
+                    remaps[c][value] = nara_columns_dictionary_index(&table->columns[c].dictionary, bytes, nBytes) + 1;
+                    if ( table->columns[c].dictionary.data.didFail ) table->didFail = 1;
+                }
+                value = remaps[c][value] - 1;
+            }
+            nara_columns_buffer_append(&table->columns[c].values, &value, sizeof(value));
+            if ( table->columns[c].values.didFail ) table->didFail = 1;
+        }
+        if ( table->didFail ) break;
+        __nara_columns_table_end_row(table);
+        
+        /* A flush may have emptied the dictionaries: */
+        for ( c = 0; c < table->nColumns; c++ ) {
+            if ( remaps[c] && ! table->columns[c].dictionary.nEntries ) memset(remaps[c], 0, (forked->columns[c].dictionary.nEntries + 1) * sizeof(uint32_t));
+        }
+    }
+    for ( c = 0; c < table->nColumns; c++ ) free((void*)remaps[c]);
+    free((void*)remaps);
+}
+
+/**/
+
+void
+nara_columns_table_clear(
+    nara_columns_table_t        *table,
+    int                         shouldClearDictionaries
+)
+{
+    unsigned int                c;
+    
+    for ( c = 0; c < table->nColumns; c++ ) {
+        table->columns[c].values.length = 0;
+        if ( shouldClearDictionaries ) nara_columns_dictionary_clear(&table->columns[c].dictionary);
+    }
+    table->nRows = 0;
+}
+
+/**/
+
+void
+nara_columns_table_destroy(
+    nara_columns_table_t        *table
+)
+{
+    unsigned int                c;
+    
+    for ( c = 0; c < table->nColumns; c++ ) {
+        nara_columns_buffer_free(&table->columns[c].values);
+        nara_columns_dictionary_free(&table->columns[c].dictionary);
+    }
+    free((void*)table->columns);
+    if ( table->ownsInfos ) nara_fields_columns_destroy(table->infos, table->nColumns);
+    memset(table, 0, sizeof(*table));
+}
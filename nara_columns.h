@@ -0,0 +1,215 @@
+/*
+ * nara_columns
+ *
+ * Column buffers for the columnar exporters (nara_arrow, nara_parquet).  A
+ * table gathers the records of one type column by column:  integers and
+ * floating-point fields as host-order 32-bit values, strings as indices into
+ * the column's dictionary of distinct values (decoded and trimmed as the other
+ * exporters write them, and stored as UTF-8).
+ *
+ * When a table holds as many rows as it should, its flush function writes them
+ * out and clears the table.
+ *
+ */
+
+#ifndef __NARA_COLUMNS_H__
+#define __NARA_COLUMNS_H__
+
+#include "nara_base.h"
+#include "nara_record.h"
+#include "nara_fields.h"
+
+/*!
+    @typedef nara_columns_buffer_t
+
+    A growable byte buffer; once an allocation has failed, didFail is set and
+    the buffer no longer grows.
+ */
+typedef struct {
+    uint8_t         *bytes;
+    size_t          length;
+    size_t          capacity;
+    int             didFail;
+} nara_columns_buffer_t;
+
+/*!
+    @function nara_columns_buffer_reserve
+
+    Extend the buffer by nBytes zero bytes; returns the position of the first
+    of them (zero if the buffer could not grow).
+ */
+size_t nara_columns_buffer_reserve(nara_columns_buffer_t *buffer, size_t nBytes);
+
+/*!
+    @function nara_columns_buffer_append
+
+    Append nBytes bytes to the buffer.
+ */
+static inline void
+nara_columns_buffer_append(
+    nara_columns_buffer_t   *buffer,
+    const void              *bytes,
+    size_t                  nBytes
+)
+{
+    if ( buffer->capacity - buffer->length >= nBytes ) {
+        memcpy(buffer->bytes + buffer->length, bytes, nBytes);
+        buffer->length += nBytes;
+    } else {
+        size_t              position = nara_columns_buffer_reserve(buffer, nBytes);
+        
+        if ( ! buffer->didFail ) memcpy(buffer->bytes + position, bytes, nBytes);
+    }
+}
+
+/*!
+    @function nara_columns_buffer_free
+
+    Release the buffer's memory and empty it.
+ */
+void nara_columns_buffer_free(nara_columns_buffer_t *buffer);
+
+/*!
+    @typedef nara_columns_dictionary_t
+
+    Distinct byte strings:  the strings end-to-end in data, the offset of each
+    (and of the end of the last) in offsets, and a hash table of (index + 1)
+    for finding them.
+ */
+typedef struct {
+    nara_columns_buffer_t   data;
+    nara_columns_buffer_t   offsets;
+    uint32_t                *slots;
+    uint32_t                nSlots;
+    uint32_t                nEntries;
+} nara_columns_dictionary_t;
+
+/*!
+    @function nara_columns_dictionary_index
+
+    Returns the index of a byte string in the dictionary, adding it if it is
+    not there yet.  On allocation failure the dictionary's data.didFail is set.
+ */
+uint32_t nara_columns_dictionary_index(nara_columns_dictionary_t *dictionary, const uint8_t *bytes, size_t nBytes);
+
+/*!
+    @function nara_columns_dictionary_entry
+
+    Returns the bytes of the string at index in the dictionary, and their
+    number in *nBytes.
+ */
+static inline const uint8_t*
+nara_columns_dictionary_entry(
+    const nara_columns_dictionary_t *dictionary,
+    uint32_t                        index,
+    size_t                          *nBytes
+)
+{
+    const uint32_t                  *offsets = (const uint32_t*)dictionary->offsets.bytes;
+    
+    *nBytes = offsets[index + 1] - offsets[index];
+    return dictionary->data.bytes + offsets[index];
+}
+
+/*!
+    @function nara_columns_dictionary_clear
+
+    Remove every string from the dictionary (keeping its memory).
+ */
+void nara_columns_dictionary_clear(nara_columns_dictionary_t *dictionary);
+
+/*!
+    @function nara_columns_dictionary_free
+
+    Release the dictionary's memory and empty it.
+ */
+void nara_columns_dictionary_free(nara_columns_dictionary_t *dictionary);
+
+/*!
+    @typedef nara_columns_column_t
+
+    The values of a column (4 bytes per row) and, for a string column, the
+    dictionary its values index.
+ */
+typedef struct {
+    nara_columns_buffer_t       values;
+    nara_columns_dictionary_t   dictionary;
+} nara_columns_column_t;
+
+typedef struct nara_columns_table nara_columns_table_t;
+
+/*!
+    @typedef nara_columns_flush_fn
+
+    Callback that writes the rows of a full table and clears it.
+ */
+typedef void (*nara_columns_flush_fn)(nara_columns_table_t *table, void *context);
+
+/*!
+    @typedef nara_columns_table_t
+
+    The rows of one record type.  The columns are described by infos, which
+    the table owns unless it is a fork.  If flushFn is set it is called each
+    time the table reaches flushRows rows.
+ */
+struct nara_columns_table {
+    nara_fields_column_info_t   *infos;
+    int                         ownsInfos;
+    nara_columns_column_t       *columns;
+    unsigned int                nColumns;
+    int                         isRaw;
+    int                         isEBCDIC;
+    uint32_t                    nRows;
+    uint32_t                    flushRows;
+    nara_columns_flush_fn       flushFn;
+    void                        *flushContext;
+    int                         didFail;
+};
+
+/*!
+    @function nara_columns_table_bind
+
+    Bind the table to a record type of a format:  the first time, take on the
+    type's columns; afterwards the format must have the same columns.
+    exporterName is used in error messages.  Returns zero on success.
+ */
+int nara_columns_table_bind(nara_columns_table_t *table, nara_format_t format, uint32_t recordType, const char *exporterName);
+
+/*!
+    @function nara_columns_table_add
+
+    Add a record (as processed by the bound format) as a row of the table.
+ */
+void nara_columns_table_add(nara_columns_table_t *table, const nara_record_t *theRecord);
+
+/*!
+    @function nara_columns_table_fork
+
+    Set up forked as an empty table with the columns of table (which it shares)
+    and no flush function.  Returns zero on success.
+ */
+int nara_columns_table_fork(nara_columns_table_t *forked, const nara_columns_table_t *table);
+
+/*!
+    @function nara_columns_table_join
+
+    Add the rows of forked to the table (flushing it as it fills).
+ */
+void nara_columns_table_join(nara_columns_table_t *table, const nara_columns_table_t *forked);
+
+/*!
+    @function nara_columns_table_clear
+
+    Remove the table's rows, and also the strings in its dictionaries if
+    shouldClearDictionaries is non-zero.
+ */
+void nara_columns_table_clear(nara_columns_table_t *table, int shouldClearDictionaries);
+
+/*!
+    @function nara_columns_table_destroy
+
+    Release the table's memory and empty it.
+ */
+void nara_columns_table_destroy(nara_columns_table_t *table);
+
+#endif /* __NARA_COLUMNS_H__ */
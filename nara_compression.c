@@ -0,0 +1,1076 @@
+/*
+ * nara_compression
+ *
+ * Compressed input and output.  An archive compressed with gzip, zstd, or xz
+ * is recognized by its leading (magic) bytes and decompressed as it is read,
+ * so it never has to be expanded to a temporary file; output can likewise be
+ * compressed (with gzip or zstd) as it is written.  Which of the formats are
+ * available depends on the libraries found at build time (HAVE_ZLIB,
+ * HAVE_ZSTD, HAVE_LZMA).
+ *
+ * With pthreads a decompressor runs on a thread of its own, filling a ring of
+ * large buffers that the reader drains, so decompression overlaps decoding;
+ * otherwise each buffer is filled when the reader reaches it.
+ *
+ * A compressor cuts its output into blocks that are compressed independently
+ * (each a complete gzip member or zstd frame, which decompressors read as a
+ * single stream) by a pool of threads, and written in order by the thread
+ * that writes to the compressor.
+ *
+ */
+
+#include "nara_compression.h"
+
+#include <unistd.h>
+
+#ifdef HAVE_PTHREADS
+#   include <pthread.h>
+#endif
+#ifdef HAVE_ZLIB
+#   include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#   include <zstd.h>
+#endif
+#ifdef HAVE_LZMA
+#   include <lzma.h>
+#endif
+
+/*
+ * Compressed bytes are read from a stream (and handed to zlib, whose counts
+ * are 32-bit) at most this many at a time:
+ */
+#define NARA_DECOMPRESSOR_INPUT_BYTES   (1024 * 1024)
+
+static const char *__nara_compression_names[nara_compression_max] = { "none", "gzip", "zstd", "xz", "deflate" };
+
+/*
+ * Default compression levels (those of the gzip and zstd tools):
+ */
+#define NARA_COMPRESSOR_GZIP_LEVEL      6
+#define NARA_COMPRESSOR_ZSTD_LEVEL      3
+
+struct nara_decompressor {
+    nara_compression_t  compression;
+    
+    /* Compressed input:  in-place bytes, or a buffer refilled from a stream or another decompressor: */
+    FILE                *fptr;
+    struct nara_decompressor    *source;
+    unsigned char       *inBuffer;
+    const unsigned char *inNext;
+    size_t              inAvail;
+    int                 inFrame;
+    
+    int                 isReady;
+    union {
+#ifdef HAVE_ZLIB
+        z_stream        gzip;
+#endif
+#ifdef HAVE_ZSTD
+        ZSTD_DStream    *zstd;
+#endif
+#ifdef HAVE_LZMA
+        lzma_stream     xz;
+#endif
+        int             none;
+    } backend;
+    
+    /*
+     * The ring:  nFull buffers starting at head hold decompressed data (the
+     * one at head is being read); status is set once the last has been
+     * filled (1) or decompression has failed (-1):
+     */
+    unsigned char       *buffers[NARA_DECOMPRESSOR_BUFFERS];
+    size_t              lengths[NARA_DECOMPRESSOR_BUFFERS];
+    unsigned int        nBuffers, head, nFull;
+    int                 status;
+    
+    /* The buffer being read: */
+    const unsigned char *current;
+    size_t              currentLength, currentOffset;
+    int                 hasCurrent;
+
+#ifdef HAVE_PTHREADS
+    pthread_t           thread;
+    int                 hasThread;
+    int                 shouldStop;
+    pthread_mutex_t     lock;
+    pthread_cond_t      bufferFull;
+    pthread_cond_t      bufferFree;
+#endif
+};
+
+/**/
+
+nara_compression_t
+nara_compression_detect(
+    const void  *bytes,
+    size_t      nBytes
+)
+{
+    static const unsigned char  gzipMagic[] = { 0x1F, 0x8B };
+    static const unsigned char  zstdMagic[] = { 0x28, 0xB5, 0x2F, 0xFD };
+    static const unsigned char  xzMagic[] = { 0xFD, '7', 'z', 'X', 'Z', 0x00 };
+    
+    if ( ! bytes ) return nara_compression_none;
+    if ( (nBytes >= sizeof(gzipMagic)) && (memcmp(bytes, gzipMagic, sizeof(gzipMagic)) == 0) ) return nara_compression_gzip;
+    if ( (nBytes >= sizeof(zstdMagic)) && (memcmp(bytes, zstdMagic, sizeof(zstdMagic)) == 0) ) return nara_compression_zstd;
+    if ( (nBytes >= sizeof(xzMagic)) && (memcmp(bytes, xzMagic, sizeof(xzMagic)) == 0) ) return nara_compression_xz;
+    return nara_compression_none;
+}
+
+/**/
+
+const char*
+nara_compression_name(
+    nara_compression_t  compression
+)
+{
+    return ( compression < nara_compression_max ) ? __nara_compression_names[compression] : "unknown";
+}
+
+/**/
+
+nara_compression_t
+nara_compression_parse(
+    const char  *name
+)
+{
+    if ( (strcasecmp(name, "gzip") == 0) || (strcasecmp(name, "gz") == 0) ) return nara_compression_gzip;
+    if ( (strcasecmp(name, "zstd") == 0) || (strcasecmp(name, "zst") == 0) ) return nara_compression_zstd;
+    if ( strcasecmp(name, "xz") == 0 ) return nara_compression_xz;
+    if ( strcasecmp(name, "none") == 0 ) return nara_compression_none;
+    return nara_compression_max;
+}
+
+/**/
+
+nara_compression_t
+nara_compression_from_path(
+    const char  *path
+)
+{
+    size_t      pathLen = strlen(path);
+    
+    if ( (pathLen > 3) && (strcasecmp(path + pathLen - 3, ".gz") == 0) ) return nara_compression_gzip;
+    if ( (pathLen > 4) && (strcasecmp(path + pathLen - 4, ".zst") == 0) ) return nara_compression_zstd;
+    return nara_compression_none;
+}
+
+/**/
+
+int
+nara_compression_is_available(
+    nara_compression_t  compression
+)
+{
+    switch ( compression ) {
+        case nara_compression_none:
+            return 1;
+#ifdef HAVE_ZLIB
+        case nara_compression_gzip:
+        case nara_compression_deflate:
+            return 1;
+#endif
+#ifdef HAVE_ZSTD
+        case nara_compression_zstd:
+            return 1;
+#endif
+#ifdef HAVE_LZMA
+        case nara_compression_xz:
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+/**/
+
+int
+nara_compression_can_compress(
+    nara_compression_t  compression
+)
+{
+    return ( ((compression == nara_compression_gzip) || (compression == nara_compression_zstd)) && nara_compression_is_available(compression) );
+}
+
+/**/
+
+/*
+ * Make sure some compressed input is at hand:  returns 1 if there is, 0 at the
+ * end of the input, -1 if the stream could not be read:
+ */
+static int
+__nara_decompressor_refill(
+    struct nara_decompressor    *decompressor
+)
+{
+    if ( decompressor->inAvail ) return 1;
+    if ( decompressor->source ) {
+        /* The source has reported its own failure: */
+        decompressor->inNext = decompressor->inBuffer;
+        decompressor->inAvail = nara_decompressor_read(decompressor->source, decompressor->inBuffer, NARA_DECOMPRESSOR_INPUT_BYTES);
+        if ( decompressor->inAvail ) return 1;
+        return nara_decompressor_eof(decompressor->source) ? 0 : -1;
+    }
+    if ( ! decompressor->fptr || feof(decompressor->fptr) ) return 0;
+    decompressor->inNext = decompressor->inBuffer;
+    decompressor->inAvail = fread(decompressor->inBuffer, 1, NARA_DECOMPRESSOR_INPUT_BYTES, decompressor->fptr);
+    if ( decompressor->inAvail ) return 1;
+    if ( ferror(decompressor->fptr) ) {
+        fprintf(stderr, "ERROR:  unable to read compressed input (errno = %d)\n", errno);
+        return -1;
+    }
+    return 0;
+}
+
+/**/
+
+/*
+ * Decompress into the outLength bytes at out; *nOut is set to the number of
+ * bytes produced, which is less than outLength only if the data has ended
+ * (returns 1) or could not be decompressed (returns -1).  Otherwise returns 0:
+ */
+static int
+__nara_decompressor_decode(
+    struct nara_decompressor    *decompressor,
+    unsigned char               *out,
+    size_t                      outLength,
+    size_t                      *nOut
+)
+{
+    *nOut = 0;
+    while ( *nOut < outLength ) {
+        int             hasInput = __nara_decompressor_refill(decompressor);
+        size_t          nOutBefore = *nOut;
+        
+        if ( hasInput < 0 ) return -1;
+        
+        /* Input may only run out between gzip members or zstd frames: */
+        if ( ! hasInput && ! decompressor->inFrame ) return 1;
+        
+        switch ( decompressor->compression ) {
+#ifdef HAVE_ZLIB
+            case nara_compression_gzip:
+            case nara_compression_deflate: {
+                z_stream        *z = &decompressor->backend.gzip;
+                uInt            inChunk = ( decompressor->inAvail > NARA_DECOMPRESSOR_INPUT_BYTES ) ? NARA_DECOMPRESSOR_INPUT_BYTES : (uInt)decompressor->inAvail;
+                int             zrc;
+                
+                z->next_in = (Bytef*)decompressor->inNext;
+                z->avail_in = inChunk;
+                z->next_out = (Bytef*)(out + *nOut);
+                z->avail_out = (uInt)(outLength - *nOut);
+                zrc = inflate(z, Z_NO_FLUSH);
+                decompressor->inNext += inChunk - z->avail_in;
+                decompressor->inAvail -= inChunk - z->avail_in;
+                *nOut = outLength - z->avail_out;
+                if ( zrc == Z_STREAM_END ) {
+                    /* Another member may follow (e.g. files concatenated or written by pigz): */
+                    inflateReset(z);
+                    decompressor->inFrame = 0;
+                } else if ( (zrc == Z_OK) || (zrc == Z_BUF_ERROR) ) {
+                    decompressor->inFrame = 1;
+                } else {
+                    fprintf(stderr, "ERROR:  unable to decompress %s input (%s)\n", __nara_compression_names[decompressor->compression], z->msg ? z->msg : "zlib error");
+                    return -1;
+                }
+                break;
+            }
+#endif
+#ifdef HAVE_ZSTD
+            case nara_compression_zstd: {
+                ZSTD_inBuffer   in = { decompressor->inNext, decompressor->inAvail, 0 };
+                ZSTD_outBuffer  output = { out, outLength, *nOut };
+                size_t          zrc = ZSTD_decompressStream(decompressor->backend.zstd, &output, &in);
+                
+                if ( ZSTD_isError(zrc) ) {
+                    fprintf(stderr, "ERROR:  unable to decompress zstd input (%s)\n", ZSTD_getErrorName(zrc));
+                    return -1;
+                }
+                decompressor->inNext += in.pos;
+                decompressor->inAvail -= in.pos;
+                *nOut = output.pos;
+                
+                /* Zero once a frame is complete and all of it has been written out: */
+                decompressor->inFrame = ( zrc != 0 );
+                break;
+            }
+#endif
+#ifdef HAVE_LZMA
+            case nara_compression_xz: {
+                lzma_stream     *x = &decompressor->backend.xz;
+                lzma_ret        xrc;
+                
+                /* Concatenated streams end only when told the input is finished: */
+                x->next_in = decompressor->inNext;
+                x->avail_in = decompressor->inAvail;
+                x->next_out = out + *nOut;
+                x->avail_out = outLength - *nOut;
+                xrc = lzma_code(x, hasInput ? LZMA_RUN : LZMA_FINISH);
+                decompressor->inNext = x->next_in;
+                decompressor->inAvail = x->avail_in;
+                *nOut = outLength - x->avail_out;
+                if ( xrc == LZMA_STREAM_END ) {
+                    decompressor->inFrame = 0;
+                    return 1;
+                }
+                if ( (xrc != LZMA_OK) && (xrc != LZMA_BUF_ERROR) ) {
+                    fprintf(stderr, "ERROR:  unable to decompress xz input (lzma error %d)\n", (int)xrc);
+                    return -1;
+                }
+                break;
+            }
+#endif
+            default:
+                return -1;
+        }
+        
+        /* With no input left, a decoder that cannot make progress is missing the rest: */
+        if ( ! hasInput && (*nOut == nOutBefore) ) {
+            fprintf(stderr, "ERROR:  %s input is truncated\n", __nara_compression_names[decompressor->compression]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**/
+
+#ifdef HAVE_PTHREADS
+
+static void*
+__nara_decompressor_worker(
+    void        *context
+)
+{
+    struct nara_decompressor    *decompressor = (struct nara_decompressor*)context;
+    int                         status = 0;
+    
+    while ( status == 0 ) {
+        unsigned int            slot;
+        size_t                  length = 0;
+        
+        /* Wait for a free buffer: */
+        pthread_mutex_lock(&decompressor->lock);
+        while ( (decompressor->nFull == decompressor->nBuffers) && ! decompressor->shouldStop ) pthread_cond_wait(&decompressor->bufferFree, &decompressor->lock);
+        if ( decompressor->shouldStop ) {
+            pthread_mutex_unlock(&decompressor->lock);
+            break;
+        }
+        slot = (decompressor->head + decompressor->nFull) % decompressor->nBuffers;
+        pthread_mutex_unlock(&decompressor->lock);
+        
+        status = __nara_decompressor_decode(decompressor, decompressor->buffers[slot], NARA_DECOMPRESSOR_BUFFER_BYTES, &length);
+        
+        pthread_mutex_lock(&decompressor->lock);
+        if ( length ) {
+            decompressor->lengths[slot] = length;
+            decompressor->nFull++;
+        }
+        decompressor->status = status;
+        pthread_cond_broadcast(&decompressor->bufferFull);
+        pthread_mutex_unlock(&decompressor->lock);
+    }
+    return NULL;
+}
+
+#endif
+
+/**/
+
+/*
+ * Make sure the buffer being read has bytes left, moving on to the next one if
+ * need be; returns zero if there are none:
+ */
+static int
+__nara_decompressor_acquire(
+    struct nara_decompressor    *decompressor
+)
+{
+    if ( decompressor->currentOffset < decompressor->currentLength ) return 1;
+
+#ifdef HAVE_PTHREADS
+    if ( decompressor->hasThread ) {
+        pthread_mutex_lock(&decompressor->lock);
+        if ( decompressor->hasCurrent ) {
+            /* Hand the finished buffer back to the worker: */
+            decompressor->head = (decompressor->head + 1) % decompressor->nBuffers;
+            decompressor->nFull--;
+            decompressor->hasCurrent = 0;
+            pthread_cond_signal(&decompressor->bufferFree);
+        }
+        while ( (decompressor->nFull == 0) && (decompressor->status == 0) ) pthread_cond_wait(&decompressor->bufferFull, &decompressor->lock);
+        if ( decompressor->nFull ) {
+            decompressor->current = decompressor->buffers[decompressor->head];
+            decompressor->currentLength = decompressor->lengths[decompressor->head];
+            decompressor->currentOffset = 0;
+            decompressor->hasCurrent = 1;
+        }
+        pthread_mutex_unlock(&decompressor->lock);
+        return decompressor->hasCurrent;
+    }
+#endif
+    
+    /* Without a worker the (single) buffer is refilled on demand: */
+    if ( decompressor->status != 0 ) return 0;
+    decompressor->status = __nara_decompressor_decode(decompressor, decompressor->buffers[0], NARA_DECOMPRESSOR_BUFFER_BYTES, &decompressor->currentLength);
+    decompressor->current = decompressor->buffers[0];
+    decompressor->currentOffset = 0;
+    return ( decompressor->currentLength > 0 );
+}
+
+/**/
+
+static void
+__nara_decompressor_free(
+    struct nara_decompressor    *decompressor
+)
+{
+    unsigned int                i;
+    
+    if ( decompressor->isReady ) {
+        switch ( decompressor->compression ) {
+#ifdef HAVE_ZLIB
+            case nara_compression_gzip:
+            case nara_compression_deflate:
+                inflateEnd(&decompressor->backend.gzip);
+                break;
+#endif
+#ifdef HAVE_ZSTD
+            case nara_compression_zstd:
+                ZSTD_freeDStream(decompressor->backend.zstd);
+                break;
+#endif
+#ifdef HAVE_LZMA
+            case nara_compression_xz:
+                lzma_end(&decompressor->backend.xz);
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+    for ( i = 0; i < decompressor->nBuffers; i++ ) if ( decompressor->buffers[i] ) free((void*)decompressor->buffers[i]);
+    if ( decompressor->inBuffer ) free((void*)decompressor->inBuffer);
+    free((void*)decompressor);
+}
+
+/**/
+
+static nara_decompressor_t
+__nara_decompressor_open(
+    nara_compression_t  compression,
+    const void          *bytes,
+    size_t              nBytes,
+    FILE                *fptr,
+    nara_decompressor_t source
+)
+{
+    struct nara_decompressor    *decompressor;
+    unsigned int                i;
+    
+    if ( (compression == nara_compression_none) || ! nara_compression_is_available(compression) ) {
+        fprintf(stderr, "ERROR:  %s-compressed input is not supported by this build\n", nara_compression_name(compression));
+        errno = ENOTSUP;
+        return NULL;
+    }
+    
+    decompressor = (struct nara_decompressor*)malloc(sizeof(struct nara_decompressor));
+    if ( ! decompressor ) {
+        fprintf(stderr, "ERROR:  unable to allocate decompressor\n");
+        errno = ENOMEM;
+        return NULL;
+    }
+    memset(decompressor, 0, sizeof(*decompressor));
+    decompressor->compression = compression;
+    decompressor->fptr = fptr;
+    decompressor->source = source;
+    decompressor->inAvail = nBytes;
+    if ( fptr || source ) {
+        /* The bytes already read from the stream (e.g. the magic) go first: */
+        decompressor->inBuffer = (unsigned char*)malloc(( nBytes > NARA_DECOMPRESSOR_INPUT_BYTES ) ? nBytes : NARA_DECOMPRESSOR_INPUT_BYTES);
+        if ( decompressor->inBuffer ) {
+            if ( nBytes ) memcpy(decompressor->inBuffer, bytes, nBytes);
+            decompressor->inNext = decompressor->inBuffer;
+        }
+    } else {
+        decompressor->inNext = (const unsigned char*)bytes;
+    }
+
+#ifdef HAVE_PTHREADS
+    decompressor->nBuffers = NARA_DECOMPRESSOR_BUFFERS;
+#else
+    decompressor->nBuffers = 1;
+#endif
+    for ( i = 0; i < decompressor->nBuffers; i++ ) {
+        if ( ! (decompressor->buffers[i] = (unsigned char*)malloc(NARA_DECOMPRESSOR_BUFFER_BYTES)) ) break;
+    }
+    if ( (i < decompressor->nBuffers) || ((fptr || source) && ! decompressor->inBuffer) ) {
+        fprintf(stderr, "ERROR:  unable to allocate decompression buffers\n");
+        __nara_decompressor_free(decompressor);
+        errno = ENOMEM;
+        return NULL;
+    }
+    
+    switch ( compression ) {
+#ifdef HAVE_ZLIB
+        case nara_compression_gzip:
+            /* A window of 15 bits plus 16 accepts only the gzip wrapper: */
+            decompressor->isReady = ( inflateInit2(&decompressor->backend.gzip, 15 + 16) == Z_OK );
+            break;
+        case nara_compression_deflate:
+            /* A negative window is raw deflate data, with no wrapper at all: */
+            decompressor->isReady = ( inflateInit2(&decompressor->backend.gzip, -15) == Z_OK );
+            break;
+#endif
+#ifdef HAVE_ZSTD
+        case nara_compression_zstd:
+            decompressor->backend.zstd = ZSTD_createDStream();
+            decompressor->isReady = ( decompressor->backend.zstd && ! ZSTD_isError(ZSTD_initDStream(decompressor->backend.zstd)) );
+            if ( ! decompressor->isReady && decompressor->backend.zstd ) ZSTD_freeDStream(decompressor->backend.zstd);
+            break;
+#endif
+#ifdef HAVE_LZMA
+        case nara_compression_xz: {
+            lzma_stream     xzInit = LZMA_STREAM_INIT;
+            
+            decompressor->backend.xz = xzInit;
+            decompressor->isReady = ( lzma_stream_decoder(&decompressor->backend.xz, UINT64_MAX, LZMA_CONCATENATED) == LZMA_OK );
+            decompressor->inFrame = 1;
+            break;
+        }
+#endif
+        default:
+            break;
+    }
+    if ( ! decompressor->isReady ) {
+        fprintf(stderr, "ERROR:  unable to initialize %s decompression\n", nara_compression_name(compression));
+        __nara_decompressor_free(decompressor);
+        errno = ENOMEM;
+        return NULL;
+    }
+
+#ifdef HAVE_PTHREADS
+    pthread_mutex_init(&decompressor->lock, NULL);
+    pthread_cond_init(&decompressor->bufferFull, NULL);
+    pthread_cond_init(&decompressor->bufferFree, NULL);
+    
+    /* If the worker cannot be started, buffers are filled on demand: */
+    decompressor->hasThread = ( pthread_create(&decompressor->thread, NULL, __nara_decompressor_worker, decompressor) == 0 );
+#endif
+    return decompressor;
+}
+
+/**/
+
+nara_decompressor_t
+nara_decompressor_open(
+    nara_compression_t  compression,
+    const void          *bytes,
+    size_t              nBytes,
+    FILE                *fptr
+)
+{
+    return __nara_decompressor_open(compression, bytes, nBytes, fptr, NULL);
+}
+
+/**/
+
+nara_decompressor_t
+nara_decompressor_open_nested(
+    nara_compression_t  compression,
+    const void          *bytes,
+    size_t              nBytes,
+    nara_decompressor_t source
+)
+{
+    return __nara_decompressor_open(compression, bytes, nBytes, NULL, source);
+}
+
+/**/
+
+void
+nara_decompressor_close(
+    nara_decompressor_t decompressor
+)
+{
+    if ( decompressor ) {
+#ifdef HAVE_PTHREADS
+        if ( decompressor->hasThread ) {
+            pthread_mutex_lock(&decompressor->lock);
+            decompressor->shouldStop = 1;
+            pthread_cond_broadcast(&decompressor->bufferFree);
+            pthread_mutex_unlock(&decompressor->lock);
+            pthread_join(decompressor->thread, NULL);
+        }
+        pthread_cond_destroy(&decompressor->bufferFree);
+        pthread_cond_destroy(&decompressor->bufferFull);
+        pthread_mutex_destroy(&decompressor->lock);
+#endif
+        /* Only once the worker is done reading it: */
+        if ( decompressor->source ) nara_decompressor_close(decompressor->source);
+        __nara_decompressor_free(decompressor);
+    }
+}
+
+/**/
+
+size_t
+nara_decompressor_read(
+    nara_decompressor_t decompressor,
+    void                *buffer,
+    size_t              nBytes
+)
+{
+    size_t              nCopied = 0;
+    
+    while ( (nCopied < nBytes) && __nara_decompressor_acquire(decompressor) ) {
+        size_t          nAvail = decompressor->currentLength - decompressor->currentOffset;
+        
+        if ( nAvail > nBytes - nCopied ) nAvail = nBytes - nCopied;
+        memcpy((unsigned char*)buffer + nCopied, decompressor->current + decompressor->currentOffset, nAvail);
+        decompressor->currentOffset += nAvail;
+        nCopied += nAvail;
+    }
+    return nCopied;
+}
+
+/**/
+
+int
+nara_decompressor_eof(
+    nara_decompressor_t decompressor
+)
+{
+    /* Once nothing is left the worker is done, so its status is final: */
+    return ( ! __nara_decompressor_acquire(decompressor) && (decompressor->status > 0) );
+}
+
+/**/
+
+typedef struct {
+    unsigned char           *in;
+    size_t                  inLength;
+    unsigned char           *out;
+    size_t                  outLength, outCapacity;
+    int                     status;
+} nara_compressor_block_t;
+
+/*
+ * The state of the library for one compressing thread:
+ */
+typedef struct {
+#ifdef HAVE_ZLIB
+    z_stream                gzip;
+    int                     hasGzip;
+#endif
+#ifdef HAVE_ZSTD
+    ZSTD_CCtx               *zstd;
+#endif
+    int                     none;
+} nara_compressor_codec_t;
+
+struct nara_compressor {
+    nara_compression_t      compression;
+    int                     level;
+    nara_compressor_output_fn   outputFn;
+    void                    *outputContext;
+    int                     didFail;
+    
+    /*
+     * Block n (counting from zero) is kept in blocks[n % nBlocks]:  blocks
+     * nWritten up to nSubmitted have been handed to the pool (those before
+     * nClaimed have been taken up by a thread), and block nSubmitted is being
+     * filled.  A block's status is set once it has been compressed (1) or has
+     * failed to be (-1):
+     */
+    nara_compressor_block_t *blocks;
+    unsigned int            nBlocks;
+    uint64_t                nWritten, nClaimed, nSubmitted;
+    
+    /* Without a pool, blocks are compressed as they are submitted: */
+    nara_compressor_codec_t codec;
+
+#ifdef HAVE_PTHREADS
+    pthread_t               *threads;
+    unsigned int            nThreads;
+    int                     shouldStop;
+    pthread_mutex_t         lock;
+    pthread_cond_t          blockSubmitted;
+    pthread_cond_t          blockCompressed;
+#endif
+};
+
+/**/
+
+static void
+__nara_compressor_codec_free(
+    nara_compressor_codec_t *codec
+)
+{
+#ifdef HAVE_ZLIB
+    if ( codec->hasGzip ) deflateEnd(&codec->gzip);
+#endif
+#ifdef HAVE_ZSTD
+    if ( codec->zstd ) ZSTD_freeCCtx(codec->zstd);
+#endif
+    memset(codec, 0, sizeof(*codec));
+}
+
+/**/
+
+/*
+ * Make room for nBytes of compressed output in block:
+ */
+static int
+__nara_compressor_reserve(
+    nara_compressor_block_t *block,
+    size_t                  nBytes
+)
+{
+    if ( nBytes > block->outCapacity ) {
+        unsigned char       *newOut = (unsigned char*)realloc(block->out, nBytes);
+        
+        if ( ! newOut ) {
+            fprintf(stderr, "ERROR:  unable to allocate compression buffer\n");
+            return 0;
+        }
+        block->out = newOut;
+        block->outCapacity = nBytes;
+    }
+    return 1;
+}
+
+/**/
+
+/*
+ * Compress a block as a gzip member or zstd frame of its own; returns its
+ * status:
+ */
+static int
+__nara_compressor_compress(
+    struct nara_compressor  *compressor,
+    nara_compressor_codec_t *codec,
+    nara_compressor_block_t *block
+)
+{
+    switch ( compressor->compression ) {
+#ifdef HAVE_ZLIB
+        case nara_compression_gzip: {
+            z_stream        *z = &codec->gzip;
+            size_t          outBound;
+            
+            if ( ! codec->hasGzip ) {
+                /* A window of 15 bits plus 16 writes the gzip wrapper: */
+                if ( deflateInit2(z, compressor->level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK ) {
+                    fprintf(stderr, "ERROR:  unable to initialize gzip compression\n");
+                    return -1;
+                }
+                codec->hasGzip = 1;
+            } else {
+                deflateReset(z);
+            }
+            outBound = deflateBound(z, (uLong)block->inLength);
+            if ( ! __nara_compressor_reserve(block, outBound) ) return -1;
+            z->next_in = (Bytef*)block->in;
+            z->avail_in = (uInt)block->inLength;
+            z->next_out = (Bytef*)block->out;
+            z->avail_out = (uInt)outBound;
+            if ( deflate(z, Z_FINISH) != Z_STREAM_END ) {
+                fprintf(stderr, "ERROR:  unable to compress gzip output (%s)\n", z->msg ? z->msg : "zlib error");
+                return -1;
+            }
+            block->outLength = outBound - z->avail_out;
+            return 1;
+        }
+#endif
+#ifdef HAVE_ZSTD
+        case nara_compression_zstd: {
+            size_t          outBound = ZSTD_compressBound(block->inLength), zrc;
+            
+            if ( ! codec->zstd && ! (codec->zstd = ZSTD_createCCtx()) ) {
+                fprintf(stderr, "ERROR:  unable to initialize zstd compression\n");
+                return -1;
+            }
+            if ( ! __nara_compressor_reserve(block, outBound) ) return -1;
+            zrc = ZSTD_compressCCtx(codec->zstd, block->out, outBound, block->in, block->inLength, compressor->level);
+            if ( ZSTD_isError(zrc) ) {
+                fprintf(stderr, "ERROR:  unable to compress zstd output (%s)\n", ZSTD_getErrorName(zrc));
+                return -1;
+            }
+            block->outLength = zrc;
+            return 1;
+        }
+#endif
+        default:
+            return -1;
+    }
+}
+
+/**/
+
+#ifdef HAVE_PTHREADS
+
+static void*
+__nara_compressor_worker(
+    void        *context
+)
+{
+    struct nara_compressor  *compressor = (struct nara_compressor*)context;
+    nara_compressor_codec_t codec;
+    
+    memset(&codec, 0, sizeof(codec));
+    pthread_mutex_lock(&compressor->lock);
+    while ( 1 ) {
+        nara_compressor_block_t *block;
+        int                     status;
+        
+        while ( (compressor->nClaimed == compressor->nSubmitted) && ! compressor->shouldStop ) pthread_cond_wait(&compressor->blockSubmitted, &compressor->lock);
+        if ( compressor->nClaimed == compressor->nSubmitted ) break;
+        block = &compressor->blocks[compressor->nClaimed++ % compressor->nBlocks];
+        pthread_mutex_unlock(&compressor->lock);
+        
+        status = __nara_compressor_compress(compressor, &codec, block);
+        
+        pthread_mutex_lock(&compressor->lock);
+        block->status = status;
+        pthread_cond_broadcast(&compressor->blockCompressed);
+    }
+    pthread_mutex_unlock(&compressor->lock);
+    __nara_compressor_codec_free(&codec);
+    return NULL;
+}
+
+#endif
+
+/**/
+
+/*
+ * Hand the block being filled to the pool (or compress it now):
+ */
+static void
+__nara_compressor_submit(
+    struct nara_compressor  *compressor
+)
+{
+    nara_compressor_block_t *block = &compressor->blocks[compressor->nSubmitted % compressor->nBlocks];
+
+#ifdef HAVE_PTHREADS
+    if ( compressor->threads ) {
+        pthread_mutex_lock(&compressor->lock);
+        compressor->nSubmitted++;
+        pthread_cond_signal(&compressor->blockSubmitted);
+        pthread_mutex_unlock(&compressor->lock);
+        return;
+    }
+#endif
+    block->status = __nara_compressor_compress(compressor, &compressor->codec, block);
+    compressor->nSubmitted++;
+}
+
+/**/
+
+/*
+ * Output the oldest block once it has been compressed (waiting for that if
+ * shouldWait is non-zero); returns zero if there was none to output:
+ */
+static int
+__nara_compressor_output(
+    struct nara_compressor  *compressor,
+    int                     shouldWait
+)
+{
+    nara_compressor_block_t *block = &compressor->blocks[compressor->nWritten % compressor->nBlocks];
+    int                     status;
+    
+    if ( compressor->nWritten == compressor->nSubmitted ) return 0;
+#ifdef HAVE_PTHREADS
+    if ( compressor->threads ) {
+        pthread_mutex_lock(&compressor->lock);
+        while ( shouldWait && ! block->status ) pthread_cond_wait(&compressor->blockCompressed, &compressor->lock);
+        status = block->status;
+        pthread_mutex_unlock(&compressor->lock);
+        if ( ! status ) return 0;
+    } else
+#endif
+    status = block->status;
+    if ( status < 0 ) {
+        compressor->didFail = 1;
+    } else if ( ! compressor->didFail && compressor->outputFn(compressor->outputContext, block->out, block->outLength) ) {
+        compressor->didFail = 1;
+    }
+    block->inLength = 0;
+    block->status = 0;
+    compressor->nWritten++;
+    return 1;
+}
+
+/**/
+
+nara_compressor_t
+nara_compressor_open(
+    nara_compression_t          compression,
+    int                         level,
+    unsigned int                nThreads,
+    nara_compressor_output_fn   outputFn,
+    void                        *outputContext
+)
+{
+    struct nara_compressor      *compressor;
+    int                         maxLevel = 0;
+    
+    switch ( compression ) {
+        case nara_compression_gzip:
+            if ( level < 0 ) level = NARA_COMPRESSOR_GZIP_LEVEL;
+            maxLevel = 9;
+            break;
+        case nara_compression_zstd:
+            if ( level < 0 ) level = NARA_COMPRESSOR_ZSTD_LEVEL;
+            maxLevel = 22;
+            break;
+        default:
+            break;
+    }
+    if ( ! nara_compression_can_compress(compression) || (compression == nara_compression_none) ) {
+        fprintf(stderr, "ERROR:  %s-compressed output is not supported by this build\n", nara_compression_name(compression));
+        errno = ENOTSUP;
+        return NULL;
+    }
+    if ( level > maxLevel ) {
+        fprintf(stderr, "ERROR:  invalid %s compression level: %d\n", nara_compression_name(compression), level);
+        errno = EINVAL;
+        return NULL;
+    }
+    
+    compressor = (struct nara_compressor*)malloc(sizeof(struct nara_compressor));
+    if ( ! compressor ) {
+        fprintf(stderr, "ERROR:  unable to allocate compressor\n");
+        errno = ENOMEM;
+        return NULL;
+    }
+    memset(compressor, 0, sizeof(*compressor));
+    compressor->compression = compression;
+    compressor->level = level;
+    compressor->outputFn = outputFn;
+    compressor->outputContext = outputContext;
+
+#ifdef HAVE_PTHREADS
+    if ( nThreads == 0 ) {
+        long        nCPUs = sysconf(_SC_NPROCESSORS_ONLN);
+        
+        nThreads = ( nCPUs < 1 ) ? 1 : (( nCPUs > NARA_COMPRESSOR_MAX_THREADS ) ? NARA_COMPRESSOR_MAX_THREADS : (unsigned int)nCPUs);
+    }
+#else
+    nThreads = 1;
+#endif
+    
+    /* Each thread can have one block in hand and another waiting: */
+    compressor->nBlocks = 2 * nThreads;
+    compressor->blocks = (nara_compressor_block_t*)calloc(compressor->nBlocks, sizeof(nara_compressor_block_t));
+    if ( ! compressor->blocks ) {
+        fprintf(stderr, "ERROR:  unable to allocate compressor\n");
+        free((void*)compressor);
+        errno = ENOMEM;
+        return NULL;
+    }
+
+#ifdef HAVE_PTHREADS
+    compressor->threads = (pthread_t*)malloc(nThreads * sizeof(pthread_t));
+    pthread_mutex_init(&compressor->lock, NULL);
+    pthread_cond_init(&compressor->blockSubmitted, NULL);
+    pthread_cond_init(&compressor->blockCompressed, NULL);
+    if ( compressor->threads ) {
+        while ( (compressor->nThreads < nThreads) && (pthread_create(&compressor->threads[compressor->nThreads], NULL, __nara_compressor_worker, compressor) == 0) ) compressor->nThreads++;
+        
+        /* If no thread could be started, blocks are compressed as they are submitted: */
+        if ( compressor->nThreads == 0 ) {
+            free((void*)compressor->threads);
+            compressor->threads = NULL;
+        }
+    }
+#endif
+    return compressor;
+}
+
+/**/
+
+int
+nara_compressor_write(
+    nara_compressor_t   compressor,
+    const void          *bytes,
+    size_t              nBytes
+)
+{
+    const unsigned char *BYTES = (const unsigned char*)bytes;
+    
+    while ( nBytes && ! compressor->didFail ) {
+        nara_compressor_block_t *block;
+        size_t                  nCopy;
+        
+        /* With every block in use, the oldest has to be output first: */
+        if ( compressor->nSubmitted - compressor->nWritten == compressor->nBlocks ) __nara_compressor_output(compressor, 1);
+        
+        block = &compressor->blocks[compressor->nSubmitted % compressor->nBlocks];
+        if ( ! block->in && ! (block->in = (unsigned char*)malloc(NARA_COMPRESSOR_BLOCK_BYTES)) ) {
+            fprintf(stderr, "ERROR:  unable to allocate compression buffer\n");
+            compressor->didFail = 1;
+            break;
+        }
+        nCopy = NARA_COMPRESSOR_BLOCK_BYTES - block->inLength;
+        if ( nCopy > nBytes ) nCopy = nBytes;
+        memcpy(block->in + block->inLength, BYTES, nCopy);
+        block->inLength += nCopy;
+        BYTES += nCopy;
+        nBytes -= nCopy;
+        if ( block->inLength == NARA_COMPRESSOR_BLOCK_BYTES ) {
+            __nara_compressor_submit(compressor);
+            
+            /* Whatever is ready goes out now: */
+            while ( __nara_compressor_output(compressor, 0) );
+        }
+    }
+    return compressor->didFail;
+}
+
+/**/
+
+int
+nara_compressor_close(
+    nara_compressor_t   compressor
+)
+{
+    int                 rc = 0;
+    
+    if ( compressor ) {
+        unsigned int    i;
+        
+        /* The last (partial) block; even empty output is written as a valid member/frame: */
+        if ( compressor->blocks[compressor->nSubmitted % compressor->nBlocks].inLength || (compressor->nSubmitted == 0) ) __nara_compressor_submit(compressor);
+        while ( __nara_compressor_output(compressor, 1) );
+
+#ifdef HAVE_PTHREADS
+        if ( compressor->threads ) {
+            pthread_mutex_lock(&compressor->lock);
+            compressor->shouldStop = 1;
+            pthread_cond_broadcast(&compressor->blockSubmitted);
+            pthread_mutex_unlock(&compressor->lock);
+            for ( i = 0; i < compressor->nThreads; i++ ) pthread_join(compressor->threads[i], NULL);
+            free((void*)compressor->threads);
+        }
+        pthread_cond_destroy(&compressor->blockCompressed);
+        pthread_cond_destroy(&compressor->blockSubmitted);
+        pthread_mutex_destroy(&compressor->lock);
+#endif
+        __nara_compressor_codec_free(&compressor->codec);
+        for ( i = 0; i < compressor->nBlocks; i++ ) {
+            if ( compressor->blocks[i].in ) free((void*)compressor->blocks[i].in);
+            if ( compressor->blocks[i].out ) free((void*)compressor->blocks[i].out);
+        }
+        free((void*)compressor->blocks);
+        rc = compressor->didFail;
+        free((void*)compressor);
+    }
+    return rc;
+}
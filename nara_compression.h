@@ -0,0 +1,229 @@
+/*
+ * nara_compression
+ *
+ * Compressed input and output.  An archive compressed with gzip, zstd, or xz
+ * is recognized by its leading (magic) bytes and decompressed as it is read,
+ * so it never has to be expanded to a temporary file; output can likewise be
+ * compressed (with gzip or zstd) as it is written.  Which of the formats are
+ * available depends on the libraries found at build time (HAVE_ZLIB,
+ * HAVE_ZSTD, HAVE_LZMA).
+ *
+ * With pthreads a decompressor runs on a thread of its own, filling a ring of
+ * large buffers that the reader drains, so decompression overlaps decoding;
+ * otherwise each buffer is filled when the reader reaches it.
+ *
+ * A compressor cuts its output into blocks that are compressed independently
+ * (each a complete gzip member or zstd frame, which decompressors read as a
+ * single stream) by a pool of threads, and written in order by the thread
+ * that writes to the compressor.
+ *
+ * Neither is thread-safe (beyond their own worker threads).
+ *
+ */
+
+#ifndef __NARA_COMPRESSION_H__
+#define __NARA_COMPRESSION_H__
+
+#include "nara_base.h"
+
+/*!
+    @enum nara_compression_t
+
+    The compression formats that are recognized.  Raw deflate data (as in a
+    zip archive) has no magic bytes and is only ever decompressed on request.
+ */
+typedef enum {
+    nara_compression_none = 0,
+    nara_compression_gzip,
+    nara_compression_zstd,
+    nara_compression_xz,
+    nara_compression_deflate,
+    nara_compression_max
+} nara_compression_t;
+
+/*!
+    @defined NARA_COMPRESSION_MAGIC_BYTES
+
+    The number of leading bytes nara_compression_detect() needs to see.
+ */
+#define NARA_COMPRESSION_MAGIC_BYTES    6
+
+/*!
+    @defined NARA_DECOMPRESSOR_BUFFERS
+
+    The number of buffers in a decompressor's ring.
+ */
+#define NARA_DECOMPRESSOR_BUFFERS       4
+
+/*!
+    @defined NARA_DECOMPRESSOR_BUFFER_BYTES
+
+    The size of each buffer in a decompressor's ring.
+ */
+#define NARA_DECOMPRESSOR_BUFFER_BYTES  (4 * 1024 * 1024)
+
+/*!
+    @defined NARA_COMPRESSOR_BLOCK_BYTES
+
+    The amount of data a compressor compresses as a block.
+ */
+#define NARA_COMPRESSOR_BLOCK_BYTES     (1024 * 1024)
+
+/*!
+    @defined NARA_COMPRESSOR_MAX_THREADS
+
+    The most threads a compressor's pool has by default (it has one per CPU up
+    to this many).
+ */
+#define NARA_COMPRESSOR_MAX_THREADS     16
+
+/*!
+    @function nara_compression_detect
+
+    Returns the compression format whose magic bytes begin the nBytes at
+    bytes, or nara_compression_none.
+ */
+nara_compression_t nara_compression_detect(const void *bytes, size_t nBytes);
+
+/*!
+    @function nara_compression_name
+
+    Returns the name of a compression format ("gzip", "zstd", "xz",
+    "deflate").
+ */
+const char* nara_compression_name(nara_compression_t compression);
+
+/*!
+    @function nara_compression_parse
+
+    Returns the compression format named by name ("gzip" or "gz", "zstd" or
+    "zst", "xz", or "none"), or nara_compression_max if there is none such.
+ */
+nara_compression_t nara_compression_parse(const char *name);
+
+/*!
+    @function nara_compression_from_path
+
+    Returns the compression format implied by the suffix of a filename for
+    output (".gz" or ".zst"), or nara_compression_none.
+ */
+nara_compression_t nara_compression_from_path(const char *path);
+
+/*!
+    @function nara_compression_is_available
+
+    Returns non-zero if this build can decompress the compression format.
+ */
+int nara_compression_is_available(nara_compression_t compression);
+
+/*!
+    @function nara_compression_can_compress
+
+    Returns non-zero if this build can compress to the compression format
+    (gzip and zstd are written, when available).
+ */
+int nara_compression_can_compress(nara_compression_t compression);
+
+/*!
+    @typedef nara_decompressor_t
+
+    Opaque reference to a decompressor.
+ */
+typedef struct nara_decompressor * nara_decompressor_t;
+
+/*!
+    @function nara_decompressor_open
+
+    Start decompressing the nBytes at bytes followed, if fptr is non-NULL, by
+    the rest of the stdio stream fptr.  With no stream the bytes (e.g. a
+    memory-mapped file) are used in-place and must remain valid until the
+    decompressor is closed; otherwise they are copied.  Returns NULL (after
+    reporting why) if the format is not available or the decompressor could
+    not be created.
+ */
+nara_decompressor_t nara_decompressor_open(nara_compression_t compression, const void *bytes, size_t nBytes, FILE *fptr);
+
+/*!
+    @function nara_decompressor_open_nested
+
+    Start decompressing the nBytes at bytes (which are copied) followed by
+    the rest of the output of the decompressor source, for compressed data
+    inside compressed data (e.g. a gzip file deflated in a zip archive).  The
+    new decompressor takes over source and closes it when it is closed.
+    Returns NULL (after reporting why, and leaving source open) if the format
+    is not available or the decompressor could not be created.
+ */
+nara_decompressor_t nara_decompressor_open_nested(nara_compression_t compression, const void *bytes, size_t nBytes, nara_decompressor_t source);
+
+/*!
+    @function nara_decompressor_close
+
+    Stop decompressing and dispose of the decompressor; the stream is not
+    closed.
+ */
+void nara_decompressor_close(nara_decompressor_t decompressor);
+
+/*!
+    @function nara_decompressor_read
+
+    Copy up to nBytes of decompressed data into buffer.  Returns the number
+    of bytes copied, which is less than nBytes only at the end of the data or
+    if it could not be decompressed (see nara_decompressor_eof()).
+ */
+size_t nara_decompressor_read(nara_decompressor_t decompressor, void *buffer, size_t nBytes);
+
+/*!
+    @function nara_decompressor_eof
+
+    Returns non-zero once all of the decompressed data has been read (waiting
+    for the next buffer if need be).  Returns zero if decompression failed,
+    even though nothing more can be read.
+ */
+int nara_decompressor_eof(nara_decompressor_t decompressor);
+
+/*!
+    @typedef nara_compressor_t
+
+    Opaque reference to a compressor.
+ */
+typedef struct nara_compressor * nara_compressor_t;
+
+/*!
+    @typedef nara_compressor_output_fn
+
+    Type of the function to which a compressor hands its compressed blocks,
+    in order; it returns non-zero if they could not be written.
+ */
+typedef int (*nara_compressor_output_fn)(void *outputContext, const void *bytes, size_t nBytes);
+
+/*!
+    @function nara_compressor_open
+
+    Returns a compressor to the compression format at the given level (a
+    negative level means the format's default) that hands its output to
+    outputFn.  The blocks are compressed by nThreads threads (zero chooses
+    one per CPU, up to NARA_COMPRESSOR_MAX_THREADS).  Returns NULL (after
+    reporting why) if the format is not available or the compressor could
+    not be created.
+ */
+nara_compressor_t nara_compressor_open(nara_compression_t compression, int level, unsigned int nThreads, nara_compressor_output_fn outputFn, void *outputContext);
+
+/*!
+    @function nara_compressor_write
+
+    Add nBytes at bytes to the data being compressed.  Complete blocks are
+    handed to the pool, and those that have been compressed are output (if a
+    block cannot be started until the oldest is output, waiting for it).
+    Returns non-zero once compression or output has failed.
+ */
+int nara_compressor_write(nara_compressor_t compressor, const void *bytes, size_t nBytes);
+
+/*!
+    @function nara_compressor_close
+
+    Compress and output the rest of the data, then dispose of the compressor.
+    Returns non-zero if compression or output failed at any point.
+ */
+int nara_compressor_close(nara_compressor_t compressor);
+
+#endif /* __NARA_COMPRESSION_H__ */
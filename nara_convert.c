@@ -0,0 +1,524 @@
+/*
+ * nara_convert
+ *
+ * Drivers that walk an input source record-by-record and export each record.
+ * The pre-1976 layout is read as state chunks of length-prefixed records; the
+ * later layouts are a flat sequence of fixed-size records.  Records are read in
+ * the reader's format (see nara_reader_format()).  A memory-mapped input is
+ * classified ahead of decoding -- a state chunk or a block of fixed-size records
+ * at a time -- so each record is processed directly as its type.
+ *
+ * The parallel drivers split a memory-mapped input into work units, convert
+ * the units on a pool of threads into private buffers, and write the buffers
+ * out in their original order so the output is identical to a serial run.
+ *
+ */
+
+#include "nara_convert.h"
+#include "nara_state_header.h"
+#include "nara_record_header.h"
+#include "nara_stats.h"
+
+#ifdef HAVE_PTHREADS
+#   include <pthread.h>
+#endif
+
+/*
+ * Every record in a state chunk is at least a record header and a type word, so a
+ * chunk (at most 64 KiB) holds no more than this many records:
+ */
+#define NARA_CONVERT_CHUNK_RECORDS  (65536 / (sizeof(nara_record_header_t) + sizeof(uint32_t)))
+
+/*
+ * Fixed-size records are classified this many at a time:
+ */
+#define NARA_CONVERT_CLASSIFY_RECORDS   256
+
+/*
+ * Work units are made of whole state chunks totalling at least this many bytes:
+ */
+#define NARA_CONVERT_UNIT_BYTES     (1024 * 1024)
+
+/*
+ * Each worker thread may run at most this many units ahead of the unit being
+ * written, which bounds the memory held in formatted-but-unwritten output:
+ */
+#define NARA_CONVERT_UNITS_AHEAD    2
+
+/**/
+
+int
+nara_convert_chunks(
+    nara_reader_t           reader,
+    nara_export_context_t   exportContext
+)
+{
+    nara_state_header_t     stateHeader;
+    uint64_t                stateRecordCount = 0, totalRecordCount = 0, nextStateRecordOffset = 0;
+    size_t                  bytesRead;
+    uint8_t                 recordTypes[NARA_CONVERT_CHUNK_RECORDS];
+    int                     isMapped = nara_reader_is_mapped(reader);
+    int                     rc = 0;
+    
+    /* Loop over variable-length state records in the file: */
+    while ( (rc == 0) && ((bytesRead = nara_reader_read(reader, &stateHeader, sizeof(stateHeader))) == sizeof(stateHeader)) ) {
+        nara_record_header_t    recordHeader;
+        uint64_t                nextRecordOffset, chunkRecordCount = totalRecordCount;
+        unsigned int            nRecordTypes = 0, iRecordType = 0;
+        
+        /* Process the header (endian swap, etc.): */
+        nara_state_header_process(&stateHeader);
+        
+        /*
+         * With the whole chunk mapped, its records are classified up front from
+         * their headers; otherwise (or if the chunk is malformed) each record is
+         * classified as it is read:
+         */
+        if ( isMapped && (stateHeader.recordLength > sizeof(stateHeader)) ) {
+            nRecordTypes = nara_record_classify_chunk(reader, stateHeader.recordLength - sizeof(stateHeader), recordTypes, NARA_CONVERT_CHUNK_RECORDS);
+        }
+        
+        /*
+         * Calculate offset of the first record for the state and the next state in the file:
+         */
+        ++stateRecordCount;
+        nextRecordOffset = nextStateRecordOffset + sizeof(stateHeader);
+        nextStateRecordOffset += stateHeader.recordLength;
+        
+        /* Now handle each one of this state's records: */
+        while ( (bytesRead = nara_reader_read(reader, &recordHeader, sizeof(recordHeader))) == sizeof(recordHeader) ) {
+            nara_record_t       *nextRecord;
+            size_t              wantToRead;
+            
+            /* Process the header (endian swap, etc.): */
+            nara_record_header_process(&recordHeader);
+            
+            /*
+             * Increase the total record count and calculate how large this record is and
+             * where the next record will occur:
+             */
+            ++totalRecordCount;
+            wantToRead = recordHeader.recordLength - sizeof(recordHeader);
+            nextRecordOffset += recordHeader.recordLength;
+            
+            /* Read the record: */
+            if ( iRecordType < nRecordTypes ) nextRecord = nara_record_next_typed(reader, wantToRead, recordTypes[iRecordType++]);
+            else nextRecord = nara_record_next(reader, wantToRead);
+            
+            /* Read the record type: */
+            if ( nextRecord == nara_record_filtered ) {
+                /* Dropped by the filter */
+            } else if ( nextRecord ) {
+                nara_record_export(exportContext, nextRecord);
+                nextRecord = nara_record_release(reader, nextRecord);
+            } else {
+                fprintf(stderr, "ERROR:  unable to read record\n");
+                rc = 5;
+            }
+            
+            /*
+             * If we're now past the end of the current chunk move on to the
+             * next one:
+             */
+            if ( nextRecordOffset >= nextStateRecordOffset ) break;
+        }
+        if ( nextRecordOffset != nextStateRecordOffset ) {
+            fprintf(stderr, "ERROR:  end of secondary records extends beyond primary record bounds\n");
+            rc = 2;
+        }
+        nara_stats_add_chunk(totalRecordCount - chunkRecordCount);
+        
+        /* All records in the chunk are done, let the reader drop them: */
+        nara_reader_discard(reader, nextStateRecordOffset);
+    }
+    
+    /* A stream that stopped short of its end (e.g. failed to decompress) is an error: */
+    if ( (rc == 0) && (bytesRead == 0) && ! nara_reader_eof(reader) ) rc = 5;
+    return rc;
+}
+
+/**/
+
+int
+nara_convert_records(
+    nara_reader_t           reader,
+    nara_export_context_t   exportContext
+)
+{
+    nara_record_t           *nextRecord;
+    uint8_t                 recordTypes[NARA_CONVERT_CLASSIFY_RECORDS];
+    unsigned int            nRecordTypes = 0, iRecordType = 0;
+    int                     isMapped = nara_reader_is_mapped(reader);
+    
+    while ( ! nara_reader_eof(reader) ) {
+        /*
+         * Mapped records are classified a block at a time; a record of unknown type
+         * ends the block and is read by nara_record_next(), which reports it:
+         */
+        if ( isMapped && (iRecordType == nRecordTypes) ) {
+            nRecordTypes = nara_record_classify_records(reader, recordTypes, NARA_CONVERT_CLASSIFY_RECORDS);
+            iRecordType = 0;
+        }
+        if ( iRecordType < nRecordTypes ) nextRecord = nara_record_next_typed(reader, 0, recordTypes[iRecordType++]);
+        else nextRecord = nara_record_next(reader, 0);
+        if ( ! nextRecord ) break;
+        if ( nextRecord != nara_record_filtered ) {
+            nara_record_export(exportContext, nextRecord);
+            nextRecord = nara_record_release(reader, nextRecord);
+        }
+        nara_reader_discard(reader, nara_reader_offset(reader));
+    }
+    return nara_reader_eof(reader) ? 0 : 5;
+}
+
+/**/
+
+#ifdef HAVE_PTHREADS
+
+typedef struct {
+    uint64_t                offset;
+    uint64_t                length;
+    nara_export_context_t   output;
+    int                     rc;
+    int                     isDone;
+} nara_convert_unit_t;
+
+typedef int (*nara_convert_fn)(nara_reader_t reader, nara_export_context_t exportContext);
+
+/*
+ * Units are either slices of a reader, converted by convertFn, or ranges that
+ * unitFn converts itself (see nara_convert_units_parallel()):
+ */
+typedef struct {
+    nara_reader_t           reader;
+    nara_export_context_t   exportContext;
+    nara_convert_fn         convertFn;
+    nara_convert_unit_fn    unitFn;
+    void                    *unitContext;
+    
+    nara_convert_unit_t     *units;
+    unsigned int            nUnits;
+    unsigned int            nUnitsAhead;
+    
+    pthread_mutex_t         lock;
+    pthread_cond_t          unitDone;
+    pthread_cond_t          unitWritten;
+    unsigned int            nextUnit;
+    unsigned int            nextToWrite;
+    int                     shouldAbort;
+} nara_convert_parallel_t;
+
+/**/
+
+static int
+__nara_convert_add_unit(
+    nara_convert_parallel_t *parallel,
+    uint64_t                offset,
+    uint64_t                length
+)
+{
+    nara_convert_unit_t     *unit;
+    
+    if ( (parallel->nUnits % 256) == 0 ) {
+        nara_convert_unit_t *newUnits = (nara_convert_unit_t*)realloc(parallel->units, (parallel->nUnits + 256) * sizeof(nara_convert_unit_t));
+        
+        if ( ! newUnits ) return 0;
+        parallel->units = newUnits;
+    }
+    unit = &parallel->units[parallel->nUnits++];
+    memset(unit, 0, sizeof(*unit));
+    unit->offset = offset;
+    unit->length = length;
+    return 1;
+}
+
+/**/
+
+static int
+__nara_convert_index_chunks(
+    nara_convert_parallel_t *parallel
+)
+{
+    uint64_t                offset = 0, unitOffset = 0, fileLength = nara_reader_length(parallel->reader);
+    
+    /*
+     * Walk the state headers only.  Scanning stops at the first header that doesn't
+     * describe a sane chunk; everything from there on is left as a final unit that
+     * is converted exactly as the serial loop would (error reporting included).
+     */
+    while ( offset < fileLength ) {
+        const void              *headerPtr = nara_reader_bytes(parallel->reader, offset, sizeof(nara_state_header_t));
+        nara_state_header_t     stateHeader;
+        
+        if ( ! headerPtr ) break;
+        memcpy(&stateHeader, headerPtr, sizeof(stateHeader));
+        nara_state_header_process(&stateHeader);
+        if ( (stateHeader.recordLength <= sizeof(stateHeader)) || (stateHeader.recordLength > fileLength - offset) ) break;
+        offset += stateHeader.recordLength;
+        
+        if ( offset - unitOffset >= NARA_CONVERT_UNIT_BYTES ) {
+            if ( ! __nara_convert_add_unit(parallel, unitOffset, offset - unitOffset) ) return 0;
+            unitOffset = offset;
+        }
+    }
+    if ( unitOffset < fileLength ) return __nara_convert_add_unit(parallel, unitOffset, fileLength - unitOffset);
+    return 1;
+}
+
+/**/
+
+static int
+__nara_convert_index_records(
+    nara_convert_parallel_t *parallel,
+    size_t                  recordSize
+)
+{
+    uint64_t                offset = 0, fileLength = nara_reader_length(parallel->reader);
+    uint64_t                unitLength = (NARA_CONVERT_UNIT_BYTES / recordSize) * recordSize;
+    
+    /*
+     * Record i starts at i * recordSize, so units are simply record-aligned ranges.
+     * A trailing partial record lands in the last unit and is reported just as the
+     * serial loop would.
+     */
+    if ( unitLength == 0 ) unitLength = recordSize;
+    while ( offset < fileLength ) {
+        uint64_t            length = ( fileLength - offset < unitLength ) ? (fileLength - offset) : unitLength;
+        
+        if ( ! __nara_convert_add_unit(parallel, offset, length) ) return 0;
+        offset += length;
+    }
+    return 1;
+}
+
+/**/
+
+static void*
+__nara_convert_worker(
+    void                    *context
+)
+{
+    nara_convert_parallel_t *parallel = (nara_convert_parallel_t*)context;
+    
+    pthread_mutex_lock(&parallel->lock);
+    while ( 1 ) {
+        nara_convert_unit_t *unit;
+        nara_reader_t       slice;
+        
+        /* Wait until the next unit is within the window ahead of the writer: */
+        while ( ! parallel->shouldAbort && (parallel->nextUnit < parallel->nUnits) && (parallel->nextUnit >= parallel->nextToWrite + parallel->nUnitsAhead) )
+            pthread_cond_wait(&parallel->unitWritten, &parallel->lock);
+        if ( parallel->shouldAbort || (parallel->nextUnit >= parallel->nUnits) ) break;
+        unit = &parallel->units[parallel->nextUnit++];
+        pthread_mutex_unlock(&parallel->lock);
+        
+        /* Convert the unit into a private copy of the export context: */
+        unit->output = nara_export_fork(parallel->exportContext);
+        slice = parallel->unitFn ? NULL : nara_reader_slice(parallel->reader, unit->offset, unit->length);
+        if ( unit->output && parallel->unitFn ) {
+            unit->rc = parallel->unitFn(parallel->unitContext, unit->offset, unit->length, unit->output);
+        } else if ( unit->output && slice ) {
+            unit->rc = parallel->convertFn(slice, unit->output);
+        } else {
+            fprintf(stderr, "ERROR:  unable to allocate work unit\n");
+            unit->rc = ENOMEM;
+        }
+        if ( slice ) nara_reader_close(slice);
+        
+        pthread_mutex_lock(&parallel->lock);
+        unit->isDone = 1;
+        pthread_cond_broadcast(&parallel->unitDone);
+    }
+    pthread_mutex_unlock(&parallel->lock);
+    return NULL;
+}
+
+/**/
+
+static int
+__nara_convert_parallel(
+    nara_convert_parallel_t *parallel,
+    unsigned int            nThreads
+)
+{
+    nara_reader_t           reader = parallel->reader;
+    nara_export_context_t   exportContext = parallel->exportContext;
+    pthread_t               *threads;
+    unsigned int            i, nThreadsStarted = 0;
+    int                     rc = 0;
+    
+    if ( parallel->nUnits < 2 ) {
+        if ( parallel->unitFn ) rc = ( parallel->nUnits ) ? parallel->unitFn(parallel->unitContext, parallel->units[0].offset, parallel->units[0].length, exportContext) : 0;
+        else rc = parallel->convertFn(reader, exportContext);
+        if ( parallel->units ) free((void*)parallel->units);
+        return rc;
+    }
+    if ( nThreads > parallel->nUnits ) nThreads = parallel->nUnits;
+    parallel->nUnitsAhead = NARA_CONVERT_UNITS_AHEAD * nThreads;
+    
+    threads = (pthread_t*)malloc(nThreads * sizeof(pthread_t));
+    if ( ! threads ) {
+        free((void*)parallel->units);
+        fprintf(stderr, "ERROR:  unable to allocate worker threads\n");
+        return ENOMEM;
+    }
+    pthread_mutex_init(&parallel->lock, NULL);
+    pthread_cond_init(&parallel->unitDone, NULL);
+    pthread_cond_init(&parallel->unitWritten, NULL);
+    for ( i = 0; i < nThreads; i++ ) {
+        if ( pthread_create(&threads[nThreadsStarted], NULL, __nara_convert_worker, parallel) == 0 ) nThreadsStarted++;
+    }
+    if ( nThreadsStarted == 0 ) {
+        fprintf(stderr, "ERROR:  unable to start worker threads\n");
+        rc = EAGAIN;
+        parallel->shouldAbort = 1;
+    }
+    
+    /*
+     * This thread is the sequencer:  write each unit's output in order as soon as
+     * it is finished.  After an error the remaining units are discarded, just as the
+     * serial loop would have stopped reading.
+     */
+    for ( i = 0; i < parallel->nUnits; i++ ) {
+        nara_convert_unit_t *unit = &parallel->units[i];
+        
+        pthread_mutex_lock(&parallel->lock);
+        if ( parallel->shouldAbort && (i >= parallel->nextUnit) ) {
+            pthread_mutex_unlock(&parallel->lock);
+            break;
+        }
+        while ( ! unit->isDone ) pthread_cond_wait(&parallel->unitDone, &parallel->lock);
+        pthread_mutex_unlock(&parallel->lock);
+        
+        if ( unit->output ) nara_export_join(exportContext, unit->output, (rc == 0));
+        if ( rc == 0 ) rc = unit->rc;
+        if ( reader ) nara_reader_discard(reader, unit->offset + unit->length);
+        
+        pthread_mutex_lock(&parallel->lock);
+        parallel->nextToWrite = i + 1;
+        if ( rc != 0 ) parallel->shouldAbort = 1;
+        pthread_cond_broadcast(&parallel->unitWritten);
+        pthread_mutex_unlock(&parallel->lock);
+    }
+    
+    for ( i = 0; i < nThreadsStarted; i++ ) pthread_join(threads[i], NULL);
+    pthread_cond_destroy(&parallel->unitWritten);
+    pthread_cond_destroy(&parallel->unitDone);
+    pthread_mutex_destroy(&parallel->lock);
+    free((void*)threads);
+    free((void*)parallel->units);
+    return rc;
+}
+
+#endif /* HAVE_PTHREADS */
+
+/**/
+
+int
+nara_convert_chunks_parallel(
+    nara_reader_t           reader,
+    nara_export_context_t   exportContext,
+    unsigned int            nThreads
+)
+{
+#ifdef HAVE_PTHREADS
+    nara_convert_parallel_t parallel;
+    
+    if ( (nThreads < 2) || ! nara_reader_is_mapped(reader) ) return nara_convert_chunks(reader, exportContext);
+    
+    memset(&parallel, 0, sizeof(parallel));
+    parallel.reader = reader;
+    parallel.exportContext = exportContext;
+    parallel.convertFn = nara_convert_chunks;
+    if ( ! __nara_convert_index_chunks(&parallel) ) {
+        fprintf(stderr, "ERROR:  unable to allocate chunk index\n");
+        if ( parallel.units ) free((void*)parallel.units);
+        return ENOMEM;
+    }
+    return __nara_convert_parallel(&parallel, nThreads);
+#else
+    return nara_convert_chunks(reader, exportContext);
+#endif
+}
+
+/**/
+
+int
+nara_convert_records_parallel(
+    nara_reader_t           reader,
+    nara_export_context_t   exportContext,
+    unsigned int            nThreads
+)
+{
+#ifdef HAVE_PTHREADS
+    nara_convert_parallel_t parallel;
+    size_t                  recordSize = nara_format_fixed_size(nara_reader_format(reader));
+    
+    if ( (nThreads < 2) || (recordSize == 0) || ! nara_reader_is_mapped(reader) ) return nara_convert_records(reader, exportContext);
+    
+    memset(&parallel, 0, sizeof(parallel));
+    parallel.reader = reader;
+    parallel.exportContext = exportContext;
+    parallel.convertFn = nara_convert_records;
+    if ( ! __nara_convert_index_records(&parallel, recordSize) ) {
+        fprintf(stderr, "ERROR:  unable to allocate record index\n");
+        if ( parallel.units ) free((void*)parallel.units);
+        return ENOMEM;
+    }
+    return __nara_convert_parallel(&parallel, nThreads);
+#else
+    return nara_convert_records(reader, exportContext);
+#endif
+}
+
+/**/
+
+int
+nara_convert_units_parallel(
+    void                    *context,
+    uint64_t                length,
+    uint64_t                unitLength,
+    nara_convert_unit_fn    unitFn,
+    nara_export_context_t   exportContext,
+    unsigned int            nThreads
+)
+{
+#ifdef HAVE_PTHREADS
+    nara_convert_parallel_t parallel;
+    uint64_t                offset;
+    
+    if ( (nThreads < 2) || (unitLength == 0) || (length <= unitLength) ) return unitFn(context, 0, length, exportContext);
+    
+    memset(&parallel, 0, sizeof(parallel));
+    parallel.exportContext = exportContext;
+    parallel.unitFn = unitFn;
+    parallel.unitContext = context;
+    for ( offset = 0; offset < length; offset += unitLength ) {
+        if ( ! __nara_convert_add_unit(&parallel, offset, ( length - offset < unitLength ) ? (length - offset) : unitLength) ) {
+            fprintf(stderr, "ERROR:  unable to allocate unit index\n");
+            if ( parallel.units ) free((void*)parallel.units);
+            return ENOMEM;
+        }
+    }
+    return __nara_convert_parallel(&parallel, nThreads);
+#else
+    return unitFn(context, 0, length, exportContext);
+#endif
+}
+
+/**/
+
+int
+nara_convert(
+    nara_reader_t           reader,
+    nara_export_context_t   exportContext,
+    unsigned int            nThreads
+)
+{
+    nara_format_t           format = nara_reader_format(reader);
+    int                     rc = nara_export_bind(exportContext, format);
+    
+    if ( rc != 0 ) return rc;
+    if ( nara_format_fixed_size(format) ) return nara_convert_records_parallel(reader, exportContext, nThreads);
+    return nara_convert_chunks_parallel(reader, exportContext, nThreads);
+}
@@ -0,0 +1,86 @@
+/*
+ * nara_convert
+ *
+ * Drivers that walk an input source record-by-record and export each record.
+ * The pre-1976 layout is read as state chunks of length-prefixed records; the
+ * later layouts are a flat sequence of fixed-size records.  Records are read in
+ * the reader's format (see nara_reader_format()).
+ *
+ * The parallel drivers split a memory-mapped input into work units, convert
+ * the units on a pool of threads into private buffers, and write the buffers
+ * out in their original order so the output is identical to a serial run.
+ *
+ */
+
+#ifndef __NARA_CONVERT_H__
+#define __NARA_CONVERT_H__
+
+#include "nara_record.h"
+#include "nara_reader.h"
+
+/*!
+    @function nara_convert_chunks
+
+    Read all state chunks (and the records therein) from reader and export
+    them to exportContext.  Returns zero on success or non-zero if the
+    framing or a record could not be read.
+ */
+int nara_convert_chunks(nara_reader_t reader, nara_export_context_t exportContext);
+
+/*!
+    @function nara_convert_chunks_parallel
+
+    Same as nara_convert_chunks() but the state chunks are converted by nThreads
+    worker threads.  Falls back to nara_convert_chunks() if the input source is
+    not memory-mapped, nThreads is less than 2, or threads are not available.
+ */
+int nara_convert_chunks_parallel(nara_reader_t reader, nara_export_context_t exportContext, unsigned int nThreads);
+
+/*!
+    @function nara_convert_records
+
+    Read all fixed-size records from reader and export them to exportContext.
+    Returns zero on success or non-zero if the input ended prematurely.
+ */
+int nara_convert_records(nara_reader_t reader, nara_export_context_t exportContext);
+
+/*!
+    @function nara_convert_records_parallel
+
+    Same as nara_convert_records() but the file is split into record-aligned
+    ranges that are converted by nThreads worker threads.  Falls back to
+    nara_convert_records() if the input source is not memory-mapped, nThreads
+    is less than 2, or threads are not available.
+ */
+int nara_convert_records_parallel(nara_reader_t reader, nara_export_context_t exportContext, unsigned int nThreads);
+
+/*!
+    @typedef nara_convert_unit_fn
+
+    Callback that converts the part of an input in [offset, offset + length)
+    -- in whatever terms the input is measured -- to exportContext.  Returns
+    zero on success.
+ */
+typedef int (*nara_convert_unit_fn)(void *context, uint64_t offset, uint64_t length, nara_export_context_t exportContext);
+
+/*!
+    @function nara_convert_units_parallel
+
+    Convert an input of the given length by calling unitFn on consecutive
+    ranges of unitLength.  With nThreads of 2 or more the ranges are converted
+    by worker threads into forks of exportContext and written in their
+    original order, as by nara_convert_records_parallel(); otherwise (or
+    without threads) unitFn is called once for the whole input.
+ */
+int nara_convert_units_parallel(void *context, uint64_t length, uint64_t unitLength, nara_convert_unit_fn unitFn, nara_export_context_t exportContext, unsigned int nThreads);
+
+/*!
+    @function nara_convert
+
+    Bind exportContext to the reader's format (see nara_export_bind()) and
+    convert the whole input source with the driver for the format's layout,
+    using nThreads worker threads where possible.  Returns zero on success.
+ */
+int nara_convert(nara_reader_t reader, nara_export_context_t exportContext, unsigned int nThreads);
+
+#endif /* __NARA_CONVERT_H__ */
@@ -10,7 +10,16 @@
 #include <string.h>
 #include <stdint.h>
 
-static const uint32_t __nara_ebcdic_to_ucs4[256] = {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define NARA_HAVE_X86_SIMD
+#   include <immintrin.h>
+#endif
+
+/*
+ * Every EBCDIC code point maps into ISO-8859-1, so a byte-wide table suffices.
+ * It is 64-byte aligned so the vector variants can load it in whole registers.
+ */
+static const uint8_t __nara_ebcdic_to_latin1[256] __attribute__((aligned(64))) = {
   [0x01] = 0x0001,
   [0x02] = 0x0002,
   [0x03] = 0x0003,
@@ -174,12 +183,236 @@ static const uint32_t __nara_ebcdic_to_ucs4[256] = {
 
 /**/
 
+static void
+__nara_ebcdic_to_ascii_field_scalar(
+    unsigned char   *s,
+    size_t          sLen
+)
+{
+    while ( sLen-- ) {
+        *s = __nara_ebcdic_to_latin1[*s];
+        s++;
+    }
+}
+
+#ifdef NARA_HAVE_X86_SIMD
+
+/*
+ * Letters, digits, space, and NUL -- nearly everything in a string field --
+ * translate as a base chosen by the high nibble plus the low nibble, for low
+ * nibbles in a range also chosen by the high nibble (e.g. 0xC1-0xC9 are 'A'-'I'
+ * and 0xF0-0xF9 are '0'-'9').  An empty range (minimum 0x10) marks high
+ * nibbles with no such run.
+ */
+static const uint8_t __nara_ebcdic_nibble_base[16] __attribute__((aligned(16))) = {
+    0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x60, 0x69, 0x71, 0x00, 0x40, 0x49, 0x51, 0x30
+};
+static const uint8_t __nara_ebcdic_nibble_min[16] __attribute__((aligned(16))) = {
+    0x00, 0x10, 0x10, 0x10, 0x00, 0x10, 0x10, 0x10, 0x01, 0x01, 0x02, 0x10, 0x01, 0x01, 0x02, 0x00
+};
+static const uint8_t __nara_ebcdic_nibble_max[16] __attribute__((aligned(16))) = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x09, 0x09, 0x00, 0x09, 0x09, 0x09, 0x09
+};
+
+/*
+ * SSSE3:  the byte is split into nibbles and pshufb looks the high nibble up in
+ * the tables above; when all sixteen bytes fall in their runs the result is the
+ * base plus the low nibble, otherwise (punctuation, say) the vector goes through
+ * the table byte by byte.  A partial vector at the tail is done byte by byte.
+ */
+__attribute__((target("ssse3")))
+static void
+__nara_ebcdic_to_ascii_field_ssse3(
+    unsigned char   *s,
+    size_t          sLen
+)
+{
+    const __m128i   loMask = _mm_set1_epi8(0x0f);
+    const __m128i   base = _mm_load_si128((const __m128i*)__nara_ebcdic_nibble_base);
+    const __m128i   loMin = _mm_load_si128((const __m128i*)__nara_ebcdic_nibble_min);
+    const __m128i   loMax = _mm_load_si128((const __m128i*)__nara_ebcdic_nibble_max);
+    
+    while ( sLen >= 16 ) {
+        __m128i     v = _mm_loadu_si128((const __m128i*)s);
+        __m128i     lo = _mm_and_si128(v, loMask);
+        __m128i     hi = _mm_and_si128(_mm_srli_epi16(v, 4), loMask);
+        __m128i     inRun = _mm_and_si128(
+                            _mm_cmpeq_epi8(_mm_max_epu8(lo, _mm_shuffle_epi8(loMin, hi)), lo),
+                            _mm_cmpeq_epi8(_mm_min_epu8(lo, _mm_shuffle_epi8(loMax, hi)), lo)
+                        );
+        
+        if ( _mm_movemask_epi8(inRun) == 0xFFFF ) _mm_storeu_si128((__m128i*)s, _mm_add_epi8(_mm_shuffle_epi8(base, hi), lo));
+        else __nara_ebcdic_to_ascii_field_scalar(s, 16);
+        s += 16;
+        sLen -= 16;
+    }
+    __nara_ebcdic_to_ascii_field_scalar(s, sLen);
+}
+
+/*
+ * AVX-512 VBMI:  two vpermi2b lookups cover the low and high halves of the table
+ * (each uses the low seven bits of the byte) and the byte's top bit picks between
+ * them.  Masked loads/stores handle any field of up to 64 bytes in one pass.
+ */
+__attribute__((target("avx512f,avx512bw,avx512vbmi")))
+static void
+__nara_ebcdic_to_ascii_field_vbmi(
+    unsigned char   *s,
+    size_t          sLen
+)
+{
+    const __m512i   t0 = _mm512_load_si512((const void*)&__nara_ebcdic_to_latin1[0]);
+    const __m512i   t1 = _mm512_load_si512((const void*)&__nara_ebcdic_to_latin1[64]);
+    const __m512i   t2 = _mm512_load_si512((const void*)&__nara_ebcdic_to_latin1[128]);
+    const __m512i   t3 = _mm512_load_si512((const void*)&__nara_ebcdic_to_latin1[192]);
+    
+    while ( sLen ) {
+        size_t      n = ( sLen < 64 ) ? sLen : 64;
+        __mmask64   mask = ( n == 64 ) ? ~(__mmask64)0 : (((__mmask64)1 << n) - 1);
+        __m512i     v = _mm512_maskz_loadu_epi8(mask, (const void*)s);
+        __m512i     lo = _mm512_permutex2var_epi8(t0, v, t1);
+        __m512i     hi = _mm512_permutex2var_epi8(t2, v, t3);
+        
+        _mm512_mask_storeu_epi8((void*)s, mask, _mm512_mask_blend_epi8(_mm512_movepi8_mask(v), lo, hi));
+        s += n;
+        sLen -= n;
+    }
+}
+
+#endif /* NARA_HAVE_X86_SIMD */
+
+/**/
+
+typedef void (*nara_ebcdic_field_fn)(unsigned char *s, size_t sLen);
+
+/*
+ * The kernels, the shortest field nara_ebcdic_to_ascii_field() uses each for,
+ * and the kernel it uses for shorter fields instead.  The lengths come from
+ * nara-microbench's width sweep:  below 16 bytes the SSSE3 kernel has no whole
+ * vector to work on, and the VBMI kernel's fixed cost (table loads, masked
+ * load/store) only pays off against SSSE3 from 64 bytes.
+ */
+static const struct {
+    const char              *name;
+    nara_ebcdic_field_fn    fn;
+    size_t                  minLength;
+    nara_ebcdic_kernel_t    shorter;
+} __nara_ebcdic_kernels[nara_ebcdic_kernel_max] = {
+        [nara_ebcdic_kernel_auto]   = { "auto", NULL, 0, nara_ebcdic_kernel_auto },
+        [nara_ebcdic_kernel_scalar] = { "scalar", __nara_ebcdic_to_ascii_field_scalar, 0, nara_ebcdic_kernel_scalar },
+#ifdef NARA_HAVE_X86_SIMD
+        [nara_ebcdic_kernel_ssse3]  = { "ssse3", __nara_ebcdic_to_ascii_field_ssse3, 16, nara_ebcdic_kernel_scalar },
+        [nara_ebcdic_kernel_vbmi]   = { "vbmi", __nara_ebcdic_to_ascii_field_vbmi, 64, nara_ebcdic_kernel_ssse3 },
+#else
+        [nara_ebcdic_kernel_ssse3]  = { "ssse3", NULL, 0, nara_ebcdic_kernel_scalar },
+        [nara_ebcdic_kernel_vbmi]   = { "vbmi", NULL, 0, nara_ebcdic_kernel_scalar },
+#endif
+    };
+
+/*
+ * The kernel nara_ebcdic_to_ascii_field() uses for the longest fields, chosen
+ * on first use according to what the CPU supports.  Threads may race to choose
+ * it, but all of them choose the same one, and the atomic accesses keep the
+ * choice itself from being torn:
+ */
+static nara_ebcdic_kernel_t __nara_ebcdic_field_kernel = nara_ebcdic_kernel_auto;
+
+static nara_ebcdic_kernel_t
+__nara_ebcdic_field_kernel_resolve(void)
+{
+    nara_ebcdic_kernel_t    kernel = (nara_ebcdic_kernel_t)__atomic_load_n(&__nara_ebcdic_field_kernel, __ATOMIC_RELAXED);
+    
+    if ( kernel == nara_ebcdic_kernel_auto ) {
+        kernel = nara_ebcdic_kernel_scalar;
+        if ( nara_ebcdic_kernel_is_available(nara_ebcdic_kernel_vbmi) ) kernel = nara_ebcdic_kernel_vbmi;
+        else if ( nara_ebcdic_kernel_is_available(nara_ebcdic_kernel_ssse3) ) kernel = nara_ebcdic_kernel_ssse3;
+        __atomic_store_n(&__nara_ebcdic_field_kernel, kernel, __ATOMIC_RELAXED);
+    }
+    return kernel;
+}
+
+/*
+ * Transcode a field with the chosen kernel, or the first kernel down the line
+ * that pays off for a field this short:
+ */
+static inline void
+__nara_ebcdic_to_ascii_field(
+    unsigned char           *s,
+    size_t                  sLen
+)
+{
+    nara_ebcdic_kernel_t    kernel = __nara_ebcdic_field_kernel_resolve();
+    
+    while ( sLen < __nara_ebcdic_kernels[kernel].minLength ) kernel = __nara_ebcdic_kernels[kernel].shorter;
+    __nara_ebcdic_kernels[kernel].fn(s, sLen);
+}
+
+/**/
+
+const char*
+nara_ebcdic_kernel_name(
+    nara_ebcdic_kernel_t    kernel
+)
+{
+    return ( kernel < nara_ebcdic_kernel_max ) ? __nara_ebcdic_kernels[kernel].name : "unknown";
+}
+
+/**/
+
+int
+nara_ebcdic_kernel_is_available(
+    nara_ebcdic_kernel_t    kernel
+)
+{
+    switch ( kernel ) {
+        case nara_ebcdic_kernel_auto:
+        case nara_ebcdic_kernel_scalar:
+            return 1;
+#ifdef NARA_HAVE_X86_SIMD
+        case nara_ebcdic_kernel_ssse3:
+            __builtin_cpu_init();
+            return ( __builtin_cpu_supports("ssse3") != 0 );
+        case nara_ebcdic_kernel_vbmi:
+            __builtin_cpu_init();
+            return ( __builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("avx512bw") );
+#endif
+        default:
+            return 0;
+    }
+}
+
+/**/
+
+void
+nara_ebcdic_to_ascii_field_kernel(
+    nara_ebcdic_kernel_t    kernel,
+    char                    *s,
+    size_t                  sLen
+)
+{
+    if ( kernel == nara_ebcdic_kernel_auto ) __nara_ebcdic_to_ascii_field((unsigned char*)s, sLen);
+    else __nara_ebcdic_kernels[kernel].fn((unsigned char*)s, sLen);
+}
+
+/**/
+
 char
 nara_ebcdic_to_ascii(
     char            c
 )
 {
-    return (char)__nara_ebcdic_to_ucs4[(unsigned char)c];
+    return (char)__nara_ebcdic_to_latin1[(unsigned char)c];
+}
+
+/**/
+
+void
+nara_ebcdic_to_ascii_field(
+    char            *s,
+    size_t          sLen
+)
+{
+    __nara_ebcdic_to_ascii_field((unsigned char*)s, sLen);
 }
 
 /**/
@@ -190,15 +423,9 @@ nara_ebcdic_to_ascii_inplace(
     size_t          sLen
 )
 {
-    unsigned char   *S = (unsigned char*)s;
-    size_t          outLen = 0;
+    size_t          outLen = ( sLen == 0 ) ? strlen(s) : strnlen(s, sLen);
     
-    if ( sLen == 0 ) sLen = strlen(s);
-    while ( sLen-- && *S ) {
-        *S = __nara_ebcdic_to_ucs4[*S];
-        S++;
-        outLen++;
-    }
+    __nara_ebcdic_to_ascii_field((unsigned char*)s, outLen);
     return outLen;
 }
 
@@ -212,14 +439,13 @@ nara_ebcdic_to_ascii_copy(
     size_t          toLen
 )
 {
-    const unsigned char *FROM = (const unsigned char*)from;
-    unsigned char       *TO = (unsigned char*)to;
-    size_t              convLen, outLen = 0;
+    size_t          outLen;
     
     if ( fromLen == 0 ) fromLen = strlen(from);
     if ( toLen == 0 ) toLen = strlen(to);
-    convLen = ( fromLen > toLen ) ? toLen : fromLen;
-    while ( convLen-- && *FROM ) outLen++, *TO++ = __nara_ebcdic_to_ucs4[*FROM++];
+    outLen = strnlen(from, ( fromLen > toLen ) ? toLen : fromLen);
+    memcpy(to, from, outLen);
+    __nara_ebcdic_to_ascii_field((unsigned char*)to, outLen);
     return outLen;
 }
 
@@ -14,4 +14,51 @@ char nara_ebcdic_to_ascii(char c);
 size_t nara_ebcdic_to_ascii_inplace(char *s, size_t sLen);
 size_t nara_ebcdic_to_ascii_copy(const char *from, size_t fromLen, char *to, size_t toLen);
 
+/*!
+    @function nara_ebcdic_to_ascii_field
+
+    Transcode exactly sLen bytes at s in-place, e.g. a fixed-width string
+    field inside a record.  Unlike nara_ebcdic_to_ascii_inplace() a NUL
+    byte does not end the conversion (NUL maps to NUL).  SIMD kernels are
+    used for longer fields when the CPU supports them.
+ */
+void nara_ebcdic_to_ascii_field(char *s, size_t sLen);
+
+/*!
+    @enum nara_ebcdic_kernel_t
+
+    The implementations behind nara_ebcdic_to_ascii_field():  auto picks the
+    best one the CPU supports (and the plain table for short fields), the
+    rest name a specific kernel.
+ */
+typedef enum {
+    nara_ebcdic_kernel_auto = 0,
+    nara_ebcdic_kernel_scalar,
+    nara_ebcdic_kernel_ssse3,
+    nara_ebcdic_kernel_vbmi,
+    nara_ebcdic_kernel_max
+} nara_ebcdic_kernel_t;
+
+/*!
+    @function nara_ebcdic_kernel_name
+
+    Returns a short name for kernel, e.g. "ssse3".
+ */
+const char* nara_ebcdic_kernel_name(nara_ebcdic_kernel_t kernel);
+
+/*!
+    @function nara_ebcdic_kernel_is_available
+
+    Returns non-zero if kernel was built in and the CPU supports it.
+ */
+int nara_ebcdic_kernel_is_available(nara_ebcdic_kernel_t kernel);
+
+/*!
+    @function nara_ebcdic_to_ascii_field_kernel
+
+    nara_ebcdic_to_ascii_field() using a specific kernel, regardless of the
+    field's length; kernel must be available.  For benchmarking.
+ */
+void nara_ebcdic_to_ascii_field_kernel(nara_ebcdic_kernel_t kernel, char *s, size_t sLen);
+
 #endif /* __NARA_EBCDIC_H__ */
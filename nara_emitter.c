@@ -0,0 +1,418 @@
+/*
+ * nara_emitter
+ *
+ * Buffered text output for the exporters.  Literals, integers, floats, and
+ * strings are appended to a large per-output buffer that is handed to write(2)
+ * whenever it fills (and when the emitter is flushed or closed), so formatting
+ * a record involves neither format-string parsing nor stdio locking.
+ *
+ * A memory emitter has no file descriptor; its buffer simply grows and its
+ * contents can later be spliced into another emitter.
+ *
+ * A compressed emitter hands its buffer to a compressor (see nara_compression)
+ * rather than to write(2); the compressed blocks are written in order.
+ *
+ * An emitter is not thread-safe.
+ *
+ */
+
+#include "nara_emitter.h"
+#include "nara_stats.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ * Size of the buffer for an emitter that writes to a file:
+ */
+#define NARA_EMITTER_FILE_BUFFER    (256 * 1024)
+
+/*
+ * Initial size of the buffer for a memory emitter (it doubles as needed):
+ */
+#define NARA_EMITTER_MEMORY_BUFFER  (64 * 1024)
+
+/*
+ * Every output to stdout goes through the same emitter so that they interleave
+ * exactly as they would have through the stdout FILE stream:
+ */
+static struct nara_emitter  __nara_emitter_stdout = { NULL, 0, 0, STDOUT_FILENO, 0, 0, 0, NULL };
+
+/*
+ * Pairs of decimal digits for 00 through 99:
+ */
+static const char __nara_emitter_digit_pairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+/**/
+
+static nara_emitter_t
+__nara_emitter_alloc(
+    int             fd,
+    size_t          capacity
+)
+{
+    nara_emitter_t  emitter = (nara_emitter_t)malloc(sizeof(struct nara_emitter));
+    
+    if ( emitter ) {
+        memset(emitter, 0, sizeof(*emitter));
+        emitter->buffer = (char*)malloc(capacity);
+        if ( ! emitter->buffer ) {
+            free((void*)emitter);
+            return NULL;
+        }
+        emitter->capacity = capacity;
+        emitter->fd = fd;
+        emitter->refCount = 1;
+    }
+    return emitter;
+}
+
+/**/
+
+nara_emitter_t
+nara_emitter_open(
+    const char      *path
+)
+{
+    nara_emitter_t  emitter;
+    int             fd;
+    
+    if ( strcmp(path, "-") == 0 ) {
+        if ( ! __nara_emitter_stdout.buffer ) {
+            __nara_emitter_stdout.buffer = (char*)malloc(NARA_EMITTER_FILE_BUFFER);
+            if ( ! __nara_emitter_stdout.buffer ) return NULL;
+            __nara_emitter_stdout.capacity = NARA_EMITTER_FILE_BUFFER;
+        }
+        __nara_emitter_stdout.refCount++;
+        return &__nara_emitter_stdout;
+    }
+    
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if ( fd < 0 ) return NULL;
+    emitter = __nara_emitter_alloc(fd, NARA_EMITTER_FILE_BUFFER);
+    if ( ! emitter ) {
+        close(fd);
+        errno = ENOMEM;
+        return NULL;
+    }
+    emitter->shouldClose = 1;
+    return emitter;
+}
+
+/**/
+
+static int __nara_emitter_write_fd(nara_emitter_t emitter, const char *bytes, size_t nBytes);
+
+/*
+ * The compressor's output goes to the file:
+ */
+static int
+__nara_emitter_write_compressed(
+    void            *outputContext,
+    const void      *bytes,
+    size_t          nBytes
+)
+{
+    return __nara_emitter_write_fd((nara_emitter_t)outputContext, (const char*)bytes, nBytes);
+}
+
+/**/
+
+nara_emitter_t
+nara_emitter_open_compressed(
+    const char          *path,
+    nara_compression_t  compression,
+    int                 level
+)
+{
+    nara_emitter_t      emitter;
+    int                 fd = STDOUT_FILENO;
+    
+    if ( compression == nara_compression_none ) return nara_emitter_open(path);
+    
+    if ( strcmp(path, "-") != 0 ) {
+        fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if ( fd < 0 ) return NULL;
+    }
+    emitter = __nara_emitter_alloc(fd, NARA_EMITTER_FILE_BUFFER);
+    if ( emitter ) {
+        emitter->shouldClose = ( fd != STDOUT_FILENO );
+        emitter->compressor = nara_compressor_open(compression, level, 0, __nara_emitter_write_compressed, emitter);
+        if ( ! emitter->compressor ) {
+            int     savedErrno = errno;
+            
+            free((void*)emitter->buffer);
+            free((void*)emitter);
+            emitter = NULL;
+            errno = savedErrno;
+        }
+    } else {
+        errno = ENOMEM;
+    }
+    if ( ! emitter && (fd != STDOUT_FILENO) ) {
+        int         savedErrno = errno;
+        
+        close(fd);
+        unlink(path);
+        errno = savedErrno;
+    }
+    return emitter;
+}
+
+/**/
+
+nara_emitter_t
+nara_emitter_open_memory(void)
+{
+    return __nara_emitter_alloc(-1, NARA_EMITTER_MEMORY_BUFFER);
+}
+
+/**/
+
+int
+nara_emitter_close(
+    nara_emitter_t  emitter
+)
+{
+    int             rc = 0;
+    
+    if ( ! emitter ) return 0;
+    if ( --emitter->refCount == 0 ) {
+        nara_emitter_flush(emitter);
+        if ( emitter == &__nara_emitter_stdout ) return emitter->didFail ? EIO : 0;
+        
+        /* The rest of the compressed output is written as the compressor finishes: */
+        if ( emitter->compressor && nara_compressor_close(emitter->compressor) ) emitter->didFail = 1;
+        if ( emitter->shouldClose && (close(emitter->fd) != 0) ) {
+            if ( ! emitter->didFail ) fprintf(stderr, "ERROR:  unable to close output file (errno = %d)\n", errno);
+            emitter->didFail = 1;
+        }
+        rc = emitter->didFail ? EIO : 0;
+        free((void*)emitter->buffer);
+        free((void*)emitter);
+    } else if ( emitter->didFail ) {
+        rc = EIO;
+    }
+    return rc;
+}
+
+/**/
+
+int
+nara_emitter_is_stdout(
+    nara_emitter_t  emitter
+)
+{
+    return ( (emitter == &__nara_emitter_stdout) || (emitter->compressor && (emitter->fd == STDOUT_FILENO)) );
+}
+
+/**/
+
+static int
+__nara_emitter_write_fd(
+    nara_emitter_t  emitter,
+    const char      *bytes,
+    size_t          nBytes
+)
+{
+    int             previousStage = nara_stats_enter(nara_stats_stage_write);
+    
+    while ( nBytes && ! emitter->didFail ) {
+        ssize_t     nWritten = write(emitter->fd, bytes, nBytes);
+        
+        if ( nWritten < 0 ) {
+            if ( errno == EINTR ) continue;
+            fprintf(stderr, "ERROR:  unable to write output (errno = %d)\n", errno);
+            emitter->didFail = 1;
+            break;
+        }
+        bytes += nWritten;
+        nBytes -= nWritten;
+    }
+    nara_stats_leave(previousStage);
+    return emitter->didFail;
+}
+
+/**/
+
+/*
+ * Write to the file, or to the compressor if there is one:
+ */
+static int
+__nara_emitter_write_out(
+    nara_emitter_t  emitter,
+    const char      *bytes,
+    size_t          nBytes
+)
+{
+    if ( emitter->compressor ) {
+        int         previousStage = nara_stats_enter(nara_stats_stage_write);
+        
+        if ( nara_compressor_write(emitter->compressor, bytes, nBytes) ) emitter->didFail = 1;
+        nara_stats_leave(previousStage);
+        return emitter->didFail;
+    }
+    return __nara_emitter_write_fd(emitter, bytes, nBytes);
+}
+
+/**/
+
+int
+nara_emitter_flush(
+    nara_emitter_t  emitter
+)
+{
+    int             rc = 0;
+    
+    if ( (emitter->fd >= 0) && emitter->length ) {
+        rc = __nara_emitter_write_out(emitter, emitter->buffer, emitter->length);
+        emitter->length = 0;
+    }
+    return rc;
+}
+
+/**/
+
+void
+nara_emitter_write(
+    nara_emitter_t  emitter,
+    const void      *bytes,
+    size_t          nBytes
+)
+{
+    if ( emitter->fd >= 0 ) {
+        nara_emitter_flush(emitter);
+        
+        /* Anything at least as large as the buffer goes straight to the file: */
+        if ( nBytes >= emitter->capacity ) {
+            __nara_emitter_write_out(emitter, (const char*)bytes, nBytes);
+            return;
+        }
+    } else if ( nBytes > emitter->capacity - emitter->length ) {
+        size_t      newCapacity = emitter->capacity * 2;
+        char        *newBuffer;
+        
+        while ( newCapacity - emitter->length < nBytes ) newCapacity *= 2;
+        newBuffer = (char*)realloc(emitter->buffer, newCapacity);
+        if ( ! newBuffer ) {
+            if ( ! emitter->didFail ) fprintf(stderr, "ERROR:  unable to grow output buffer\n");
+            emitter->didFail = 1;
+            return;
+        }
+        emitter->buffer = newBuffer;
+        emitter->capacity = newCapacity;
+    }
+    memcpy(emitter->buffer + emitter->length, bytes, nBytes);
+    emitter->length += nBytes;
+}
+
+/**/
+
+const void*
+nara_emitter_bytes(
+    nara_emitter_t  emitter,
+    size_t          *nBytes
+)
+{
+    *nBytes = emitter->length;
+    return emitter->buffer;
+}
+
+/**/
+
+void
+nara_emitter_splice(
+    nara_emitter_t  emitter,
+    nara_emitter_t  from
+)
+{
+    if ( from->length ) nara_emitter_append(emitter, from->buffer, from->length);
+    from->length = 0;
+}
+
+/**/
+
+void
+nara_emitter_append_u32(
+    nara_emitter_t  emitter,
+    uint32_t        value
+)
+{
+    char            digits[10];
+    char            *D = digits + sizeof(digits);
+    
+    /* Two digits at a time, least significant first: */
+    while ( value >= 100 ) {
+        const char  *PAIR = &__nara_emitter_digit_pairs[2 * (value % 100)];
+        
+        value /= 100;
+        *--D = PAIR[1];
+        *--D = PAIR[0];
+    }
+    if ( value >= 10 ) {
+        *--D = __nara_emitter_digit_pairs[2 * value + 1];
+        *--D = __nara_emitter_digit_pairs[2 * value];
+    } else {
+        *--D = '0' + value;
+    }
+    nara_emitter_append(emitter, D, (digits + sizeof(digits)) - D);
+}
+
+/**/
+
+void
+nara_emitter_append_float(
+    nara_emitter_t  emitter,
+    double          value
+)
+{
+    char            digits[32];
+    int             nDigits = snprintf(digits, sizeof(digits), "%g", value);
+    
+    if ( nDigits > 0 ) nara_emitter_append(emitter, digits, nDigits);
+}
+
+/**/
+
+void
+nara_emitter_append_string(
+    nara_emitter_t  emitter,
+    const char      *s
+)
+{
+    nara_emitter_append(emitter, s, strlen(s));
+}
+
+/**/
+
+void
+nara_emitter_append_quoted(
+    nara_emitter_t  emitter,
+    const char      *s
+)
+{
+    size_t          sLen = strlen(s);
+    
+    if ( sLen + 2 <= emitter->capacity - emitter->length ) {
+        char        *B = emitter->buffer + emitter->length;
+        
+        *B++ = '"';
+        memcpy(B, s, sLen);
+        B[sLen] = '"';
+        emitter->length += sLen + 2;
+    } else {
+        nara_emitter_append(emitter, "\"", 1);
+        nara_emitter_append(emitter, s, sLen);
+        nara_emitter_append(emitter, "\"", 1);
+    }
+}
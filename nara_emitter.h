@@ -0,0 +1,182 @@
+/*
+ * nara_emitter
+ *
+ * Buffered text output for the exporters.  Literals, integers, floats, and
+ * strings are appended to a large per-output buffer that is handed to write(2)
+ * whenever it fills (and when the emitter is flushed or closed), so formatting
+ * a record involves neither format-string parsing nor stdio locking.
+ *
+ * A memory emitter has no file descriptor; its buffer simply grows and its
+ * contents can later be spliced into another emitter.
+ *
+ * A compressed emitter hands its buffer to a compressor (see nara_compression)
+ * rather than to write(2); the compressed blocks are written in order.
+ *
+ * An emitter is not thread-safe.
+ *
+ */
+
+#ifndef __NARA_EMITTER_H__
+#define __NARA_EMITTER_H__
+
+#include "nara_base.h"
+#include "nara_compression.h"
+
+/*!
+    @typedef nara_emitter_t
+
+    Reference to an emitter.  The structure is public only so that appending
+    can be inlined; its fields should not be used directly.
+ */
+typedef struct nara_emitter * nara_emitter_t;
+
+struct nara_emitter {
+    char            *buffer;
+    size_t          length;
+    size_t          capacity;
+    int             fd;
+    int             shouldClose;
+    unsigned int    refCount;
+    int             didFail;
+    nara_compressor_t   compressor;
+};
+
+/*!
+    @function nara_emitter_open
+
+    Create (or truncate) the file at path and return an emitter that writes
+    to it.  A path of "-" returns the (shared) emitter for stdout.
+
+    Returns NULL if the file could not be opened.
+ */
+nara_emitter_t nara_emitter_open(const char *path);
+
+/*!
+    @function nara_emitter_open_compressed
+
+    Create (or truncate) the file at path and return an emitter that writes
+    to it compressed to the given format at the given level (a negative
+    level meaning the format's default), the compression done by a pool of
+    threads.  A path of "-" writes to stdout, but not through the shared
+    stdout emitter (so it should be the only output to stdout).  A
+    compression of nara_compression_none is the same as nara_emitter_open().
+
+    Returns NULL if the file could not be opened or the compression is not
+    available.
+ */
+nara_emitter_t nara_emitter_open_compressed(const char *path, nara_compression_t compression, int level);
+
+/*!
+    @function nara_emitter_open_memory
+
+    Returns an emitter that accumulates its output in memory.
+ */
+nara_emitter_t nara_emitter_open_memory(void);
+
+/*!
+    @function nara_emitter_close
+
+    Flush any buffered output and dispose of the emitter (the stdout emitter
+    is disposed of once every reference to it has been closed).  Returns zero
+    if all of its output was written, EIO if any of it could not be (the
+    error having been reported when it happened).
+ */
+int nara_emitter_close(nara_emitter_t emitter);
+
+/*!
+    @function nara_emitter_is_stdout
+
+    Returns non-zero if the emitter writes to stdout (compressed or not).
+ */
+int nara_emitter_is_stdout(nara_emitter_t emitter);
+
+/*!
+    @function nara_emitter_flush
+
+    Write all buffered output to the emitter's file descriptor (for a
+    compressed emitter, hand it to the compressor).  Returns zero on success.
+    Does nothing for a memory emitter.
+ */
+int nara_emitter_flush(nara_emitter_t emitter);
+
+/*!
+    @function nara_emitter_bytes
+
+    Returns the bytes buffered by the emitter (for a memory emitter, all of
+    its output so far) and sets *nBytes to their count.  The pointer is
+    valid until the next append to the emitter.
+ */
+const void* nara_emitter_bytes(nara_emitter_t emitter, size_t *nBytes);
+
+/*!
+    @function nara_emitter_splice
+
+    Append the contents of the memory emitter from to emitter and empty
+    from.
+ */
+void nara_emitter_splice(nara_emitter_t emitter, nara_emitter_t from);
+
+/*!
+    @function nara_emitter_write
+
+    Append nBytes at bytes to the emitter, flushing or growing the buffer as
+    necessary.  nara_emitter_append() is the usual entry point.
+ */
+void nara_emitter_write(nara_emitter_t emitter, const void *bytes, size_t nBytes);
+
+/*!
+    @function nara_emitter_append
+
+    Append nBytes at bytes to the emitter.
+ */
+static inline void
+nara_emitter_append(
+    nara_emitter_t  emitter,
+    const void      *bytes,
+    size_t          nBytes
+)
+{
+    if ( nBytes <= emitter->capacity - emitter->length ) {
+        memcpy(emitter->buffer + emitter->length, bytes, nBytes);
+        emitter->length += nBytes;
+    } else {
+        nara_emitter_write(emitter, bytes, nBytes);
+    }
+}
+
+/*!
+    @defined nara_emitter_append_literal
+
+    Append a string literal; its length is known at compile time.
+ */
+#define nara_emitter_append_literal(E, S)   nara_emitter_append((E), (S), sizeof(S) - 1)
+
+/*!
+    @function nara_emitter_append_u32
+
+    Append the decimal representation of value (as printf("%u") would).
+ */
+void nara_emitter_append_u32(nara_emitter_t emitter, uint32_t value);
+
+/*!
+    @function nara_emitter_append_float
+
+    Append value as printf("%g") would.
+ */
+void nara_emitter_append_float(nara_emitter_t emitter, double value);
+
+/*!
+    @function nara_emitter_append_string
+
+    Append the C string s.
+ */
+void nara_emitter_append_string(nara_emitter_t emitter, const char *s);
+
+/*!
+    @function nara_emitter_append_quoted
+
+    Append the C string s enclosed in double quotes.
+ */
+void nara_emitter_append_quoted(nara_emitter_t emitter, const char *s);
+
+#endif /* __NARA_EMITTER_H__ */
@@ -0,0 +1,863 @@
+/*
+ * nara_fields
+ *
+ * Projection of records onto a selection of their columns.  The columns of a
+ * record type are the ones in its CSV export; a selection names them (or glob
+ * patterns over them) per record type, e.g. "school:systemName,pupils_*".
+ *
+ * For each decoder the selection is compiled once into a plan:  the offset,
+ * width, and kind (integer, floating-point, or string) of every selected column
+ * within the record as read from the file.  A projected decoder then leaves the
+ * records of the selected types as read -- no byte-swapping or transcoding of
+ * the whole record -- and its exporters convert and write only the planned
+ * columns, so the cost per record follows the number of columns selected
+ * rather than the width of the record.
+ *
+ * Each record type's columns function (beside its exporters) describes the
+ * columns:  the header and the offset, width, and kind of the field behind each
+ * one, taken with offsetof() from the record structure, as the decoder's string
+ * and floating-point field tables are.
+ *
+ * The same offsets let filters (see nara_filter.h) be evaluated on the records
+ * as read from the file, so rejected records are never processed or formatted.
+ *
+ */
+
+#include "nara_fields.h"
+#include "nara_filter.h"
+#include "nara_record_impl.h"
+#include "nara_ebcdic.h"
+
+#include <fnmatch.h>
+#include <stdarg.h>
+
+/*
+ * The longest string field that can be selected:
+ */
+#define NARA_FIELDS_MAX_STRING      255
+
+/*
+ * The longest column header:
+ */
+#define NARA_FIELDS_MAX_HEADER      256
+
+typedef struct {
+    unsigned int            kind;
+    size_t                  offset;
+    size_t                  length;
+    char                    *name;
+    char                    *header;
+    size_t                  headerLen;
+    char                    *yamlPrefix;
+    size_t                  yamlPrefixLen;
+} nara_fields_column_t;
+
+/*
+ * The plan for a record type:  copies of the selected columns of its map (which
+ * owns their strings):
+ */
+typedef struct {
+    nara_fields_column_t    *columns;
+    unsigned int            nColumns;
+} nara_fields_plan_t;
+
+/*
+ * A projected decoder:  a copy of the decoder it was made from (first, so that it
+ * is used in place of it) with the column map, plan, and filters for each record
+ * type:
+ */
+typedef struct {
+    struct nara_format      format;
+    nara_fields_plan_t      maps[nara_record_type_max];
+    nara_fields_plan_t      plans[nara_record_type_max];
+    nara_filter_t           *filters[nara_record_type_max];
+    unsigned int            nFilters[nara_record_type_max];
+} nara_fields_format_t;
+
+typedef struct {
+    char                    **patterns;
+    unsigned int            nPatterns;
+} nara_fields_selection_t;
+
+/*
+ * Filter expressions are kept by record type; those at index zero apply to every
+ * record type that has the columns they name.  If any types are wanted (a bit
+ * per record type) the others are skipped:
+ */
+struct nara_fields {
+    nara_fields_selection_t selections[nara_record_type_max];
+    nara_fields_selection_t filters[nara_record_type_max];
+    unsigned int            wantedTypes;
+    nara_fields_format_t    *projected[nara_layout_max][2];
+};
+
+/**/
+
+nara_fields_t
+nara_fields_create(void)
+{
+    nara_fields_t       fields = (nara_fields_t)calloc(1, sizeof(struct nara_fields));
+    
+    if ( ! fields ) fprintf(stderr, "ERROR:  unable to allocate field selection\n");
+    return fields;
+}
+
+/**/
+
+static void
+__nara_fields_map_destroy(
+    nara_fields_plan_t      *map
+)
+{
+    unsigned int            i;
+    
+    for ( i = 0; i < map->nColumns; i++ ) {
+        free((void*)map->columns[i].name);
+        free((void*)map->columns[i].header);
+        free((void*)map->columns[i].yamlPrefix);
+    }
+    free((void*)map->columns);
+}
+
+/**/
+
+static void
+__nara_fields_format_destroy(
+    nara_fields_format_t    *projected
+)
+{
+    unsigned int            t, i;
+    
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        __nara_fields_map_destroy(&projected->maps[t]);
+        free((void*)projected->plans[t].columns);
+        for ( i = 0; i < projected->nFilters[t]; i++ ) nara_filter_destroy(projected->filters[t][i]);
+        free((void*)projected->filters[t]);
+    }
+    free((void*)projected);
+}
+
+/**/
+
+void
+nara_fields_destroy(
+    nara_fields_t   fields
+)
+{
+    unsigned int    t, i;
+    
+    if ( ! fields ) return;
+    for ( t = 0; t < nara_record_type_max; t++ ) {
+        for ( i = 0; i < fields->selections[t].nPatterns; i++ ) free((void*)fields->selections[t].patterns[i]);
+        free((void*)fields->selections[t].patterns);
+        for ( i = 0; i < fields->filters[t].nPatterns; i++ ) free((void*)fields->filters[t].patterns[i]);
+        free((void*)fields->filters[t].patterns);
+    }
+    for ( t = 0; t < nara_layout_max; t++ ) {
+        if ( fields->projected[t][0] ) __nara_fields_format_destroy(fields->projected[t][0]);
+        if ( fields->projected[t][1] ) __nara_fields_format_destroy(fields->projected[t][1]);
+    }
+    free((void*)fields);
+}
+
+/**/
+
+/*
+ * The record type named by the typeLen characters at spec, or zero:
+ */
+static uint32_t
+__nara_fields_record_type(
+    const char              *spec,
+    size_t                  typeLen
+)
+{
+    if ( (typeLen == 8) && (strncasecmp(spec, "district", typeLen) == 0) ) return nara_record_type_district;
+    if ( (typeLen == 6) && (strncasecmp(spec, "school", typeLen) == 0) ) return nara_record_type_school;
+    if ( (typeLen == 9) && (strncasecmp(spec, "classroom", typeLen) == 0) ) return nara_record_type_classroom;
+    if ( (typeLen == 7) && (strncasecmp(spec, "summary", typeLen) == 0) ) return nara_record_type_classroom;
+    return 0;
+}
+
+/**/
+
+static int
+__nara_fields_append(
+    nara_fields_selection_t *selection,
+    const char              *pattern,
+    size_t                  patternLen
+)
+{
+    char                    **newPatterns = (char**)realloc(selection->patterns, (selection->nPatterns + 1) * sizeof(char*));
+    
+    if ( ! newPatterns ) {
+        fprintf(stderr, "ERROR:  unable to allocate field selection\n");
+        return ENOMEM;
+    }
+    selection->patterns = newPatterns;
+    if ( ! (selection->patterns[selection->nPatterns] = strndup(pattern, patternLen)) ) {
+        fprintf(stderr, "ERROR:  unable to allocate field selection\n");
+        return ENOMEM;
+    }
+    selection->nPatterns++;
+    return 0;
+}
+
+/**/
+
+int
+nara_fields_add(
+    nara_fields_t           fields,
+    const char              *spec
+)
+{
+    const char              *colon = strchr(spec, ':');
+    const char              *pattern, *patternEnd;
+    uint32_t                recordType;
+    int                     rc;
+    
+    if ( ! colon ) {
+        fprintf(stderr, "ERROR:  invalid field selection (expected <type>:<pattern>{,<pattern>..}): %s\n", spec);
+        return EINVAL;
+    }
+    if ( ! (recordType = __nara_fields_record_type(spec, colon - spec)) ) {
+        fprintf(stderr, "ERROR:  invalid record type in field selection: %s\n", spec);
+        return EINVAL;
+    }
+    
+    pattern = colon + 1;
+    do {
+        patternEnd = strchr(pattern, ',');
+        if ( ! patternEnd ) patternEnd = pattern + strlen(pattern);
+        if ( patternEnd == pattern ) {
+            fprintf(stderr, "ERROR:  empty pattern in field selection: %s\n", spec);
+            return EINVAL;
+        }
+        if ( (rc = __nara_fields_append(&fields->selections[recordType], pattern, patternEnd - pattern)) != 0 ) return rc;
+        pattern = patternEnd + 1;
+    } while ( *patternEnd );
+    return 0;
+}
+
+/**/
+
+int
+nara_fields_add_filter(
+    nara_fields_t           fields,
+    const char              *spec
+)
+{
+    const char              *colon = strchr(spec, ':');
+    uint32_t                recordType = 0;
+    int                     rc;
+    
+    /* A leading <type>: limits the expression to that record type: */
+    if ( colon && (recordType = __nara_fields_record_type(spec, colon - spec)) ) spec = colon + 1;
+    if ( (rc = nara_filter_check(spec)) != 0 ) return rc;
+    return __nara_fields_append(&fields->filters[recordType], spec, strlen(spec));
+}
+
+/**/
+
+int
+nara_fields_add_types(
+    nara_fields_t           fields,
+    const char              *spec
+)
+{
+    const char              *type = spec, *typeEnd;
+    uint32_t                recordType;
+    
+    do {
+        typeEnd = strchr(type, ',');
+        if ( ! typeEnd ) typeEnd = type + strlen(type);
+        if ( ! (recordType = __nara_fields_record_type(type, typeEnd - type)) ) {
+            fprintf(stderr, "ERROR:  invalid record type list (expected <type>{,<type>..}): %s\n", spec);
+            return EINVAL;
+        }
+        fields->wantedTypes |= (1u << recordType);
+        type = typeEnd + 1;
+    } while ( *typeEnd );
+    return 0;
+}
+
+/**/
+
+static nara_emitter_t*
+__nara_fields_csv_out(
+    nara_export_context_csv_t   *context,
+    uint32_t                    recordType
+)
+{
+    switch ( recordType ) {
+        case nara_record_type_district:
+            return &context->districtOut;
+        case nara_record_type_school:
+            return &context->schoolOut;
+    }
+    return &context->classroomOut;
+}
+
+/**/
+
+/*
+ * Fill-in the header and YAML key of a column named by a CSV header field:
+ */
+static int
+__nara_fields_name_column(
+    const char              *header,
+    const char              *name,
+    size_t                  nameLen,
+    nara_fields_column_t    *column
+)
+{
+    int                     shouldQuote = 0;
+    size_t                  i;
+    
+    for ( i = 0; i < nameLen; i++ ) if ( ! isalnum(name[i]) && (name[i] != '_') ) shouldQuote = 1;
+    if ( ! (column->name = strndup(name, nameLen)) ) return ENOMEM;
+    if ( ! (column->header = strdup(header)) ) return ENOMEM;
+    column->headerLen = strlen(header);
+    if ( ! (column->yamlPrefix = (char*)malloc(nameLen + 7)) ) return ENOMEM;
+    column->yamlPrefixLen = snprintf(column->yamlPrefix, nameLen + 7, shouldQuote ? "  \"%.*s\": " : "  %.*s: ", (int)nameLen, name);
+    return 0;
+}
+
+/**/
+
+/*
+ * The column map being built by a record type's columns function:
+ */
+struct nara_record_columns {
+    nara_fields_plan_t      *map;
+    unsigned int            capacity;
+    int                     rc;
+};
+
+void
+nara_record_columns_add(
+    nara_record_columns_t   columns,
+    unsigned int            kind,
+    size_t                  offset,
+    size_t                  length,
+    const char              *headerFormat,
+    ...
+)
+{
+    nara_fields_column_t    *column;
+    char                    header[NARA_FIELDS_MAX_HEADER];
+    const char              *name = header;
+    size_t                  nameLen;
+    va_list                 argv;
+    int                     headerLen;
+    
+    if ( columns->rc ) return;
+    va_start(argv, headerFormat);
+    headerLen = vsnprintf(header, sizeof(header), headerFormat, argv);
+    va_end(argv);
+    if ( (headerLen < 0) || ((size_t)headerLen >= sizeof(header)) || ((kind == nara_fields_column_string) && (length > NARA_FIELDS_MAX_STRING)) ) {
+        fprintf(stderr, "ERROR:  column %s cannot be selected\n", header);
+        columns->rc = EINVAL;
+        return;
+    }
+    if ( columns->map->nColumns == columns->capacity ) {
+        unsigned int        newCapacity = columns->capacity ? 2 * columns->capacity : 64;
+        
+        column = (nara_fields_column_t*)realloc(columns->map->columns, newCapacity * sizeof(nara_fields_column_t));
+        if ( ! column ) {
+            columns->rc = ENOMEM;
+            return;
+        }
+        columns->map->columns = column;
+        columns->capacity = newCapacity;
+    }
+    column = &columns->map->columns[columns->map->nColumns];
+    memset(column, 0, sizeof(*column));
+    column->kind = kind;
+    column->offset = offset;
+    column->length = length;
+    
+    /* A quoted header names the column without its quotes: */
+    nameLen = headerLen;
+    if ( (nameLen >= 2) && (header[0] == '"') && (header[nameLen - 1] == '"') ) {
+        name++;
+        nameLen -= 2;
+    }
+    columns->map->nColumns++;
+    columns->rc = __nara_fields_name_column(header, name, nameLen, column);
+}
+
+/**/
+
+/*
+ * Build the column map for a record type of the format:  every column the CSV
+ * exporter writes, in order, as described by the record type's columns function.
+ */
+static int
+__nara_fields_map_columns(
+    nara_format_t                   format,
+    uint32_t                        recordType,
+    nara_fields_plan_t              *map
+)
+{
+    struct nara_record_columns      columns = { map, 0, 0 };
+    
+    format->columnsFns[recordType](&columns);
+    if ( columns.rc == ENOMEM ) fprintf(stderr, "ERROR:  unable to allocate field selection\n");
+    return columns.rc;
+}
+
+/**/
+
+/*
+ * Compile the plan for a record type of the format:  the selected columns in the
+ * order the CSV exporter writes them.
+ */
+static int
+__nara_fields_compile_plan(
+    nara_format_t                   format,
+    uint32_t                        recordType,
+    const nara_fields_plan_t        *map,
+    const nara_fields_selection_t   *selection,
+    nara_fields_plan_t              *plan
+)
+{
+    const char                      *typeName = format->recordTypes[recordType].name;
+    unsigned char                   *didMatch = (unsigned char*)calloc(selection->nPatterns + 1, 1);
+    unsigned int                    i, j;
+    int                             rc = EINVAL;
+    
+    plan->columns = (nara_fields_column_t*)calloc(map->nColumns + 1, sizeof(nara_fields_column_t));
+    if ( ! didMatch || ! plan->columns ) {
+        fprintf(stderr, "ERROR:  unable to allocate field selection\n");
+        rc = ENOMEM;
+        goto early_exit;
+    }
+    for ( i = 0; i < map->nColumns; i++ ) {
+        int                         isSelected = 0;
+        
+        for ( j = 0; j < selection->nPatterns; j++ ) {
+            if ( fnmatch(selection->patterns[j], map->columns[i].name, 0) == 0 ) didMatch[j] = isSelected = 1;
+        }
+        if ( ! isSelected ) continue;
+        plan->columns[plan->nColumns++] = map->columns[i];
+    }
+    for ( j = 0; j < selection->nPatterns; j++ ) {
+        if ( ! didMatch[j] ) {
+            fprintf(stderr, "ERROR:  no column of %s %s records matches %s\n", format->name, typeName, selection->patterns[j]);
+            goto early_exit;
+        }
+    }
+    rc = 0;
+
+early_exit:
+    free((void*)didMatch);
+    return rc;
+}
+
+/**/
+
+/*
+ * Filter column resolver over a column map:
+ */
+static int
+__nara_fields_resolve(
+    void                            *context,
+    const char                      *name,
+    nara_filter_field_t             *field
+)
+{
+    const nara_fields_plan_t        *map = (const nara_fields_plan_t*)context;
+    unsigned int                    i;
+    
+    for ( i = 0; i < map->nColumns; i++ ) {
+        if ( strcmp(map->columns[i].name, name) == 0 ) {
+            switch ( map->columns[i].kind ) {
+                case nara_fields_column_u32:
+                    field->kind = nara_filter_field_u32;
+                    break;
+                case nara_fields_column_float:
+                    field->kind = nara_filter_field_float;
+                    break;
+                default:
+                    field->kind = nara_filter_field_string;
+                    break;
+            }
+            field->offset = map->columns[i].offset;
+            field->length = map->columns[i].length;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**/
+
+/*
+ * Compile a filter expression for a record type of the projected format and add
+ * it to the type's filters; returns ENOENT if the expression names a column the
+ * type does not have.
+ */
+static int
+__nara_fields_compile_filter(
+    nara_fields_format_t            *projected,
+    uint32_t                        recordType,
+    const char                      *expression
+)
+{
+    nara_filter_t                   filter, *newFilters;
+    int                             rc = nara_filter_compile(expression, projected->format.isEBCDIC, __nara_fields_resolve, &projected->maps[recordType], &filter);
+    
+    if ( rc != 0 ) return rc;
+    newFilters = (nara_filter_t*)realloc(projected->filters[recordType], (projected->nFilters[recordType] + 1) * sizeof(nara_filter_t));
+    if ( ! newFilters ) {
+        fprintf(stderr, "ERROR:  unable to allocate filter\n");
+        nara_filter_destroy(filter);
+        return ENOMEM;
+    }
+    projected->filters[recordType] = newFilters;
+    projected->filters[recordType][projected->nFilters[recordType]++] = filter;
+    return 0;
+}
+
+/**/
+
+static int
+__nara_fields_filter(
+    nara_format_t                   format,
+    uint32_t                        recordType,
+    const nara_record_t             *theRecord
+)
+{
+    const nara_fields_format_t      *projected = (const nara_fields_format_t*)format;
+    unsigned int                    i;
+    
+    for ( i = 0; i < projected->nFilters[recordType]; i++ ) {
+        if ( ! nara_filter_eval(projected->filters[recordType][i], theRecord) ) return 0;
+    }
+    return 1;
+}
+
+/**/
+
+static void
+__nara_fields_export_init(
+    nara_export_context_t       exportContext,
+    uint32_t                    recordType
+)
+{
+    nara_export_context_base_t  *BASE_CONTEXT = (nara_export_context_base_t*)exportContext;
+    const nara_fields_plan_t    *plan = &((const nara_fields_format_t*)BASE_CONTEXT->recordFormat)->plans[recordType];
+    nara_emitter_t              out;
+    unsigned int                i;
+    
+    if ( BASE_CONTEXT->format != nara_export_format_csv ) return;
+    
+    /*
+     * Write column headers to the file:
+     */
+    if ( (out = *__nara_fields_csv_out((nara_export_context_csv_t*)exportContext, recordType)) ) {
+        for ( i = 0; i < plan->nColumns; i++ ) {
+            if ( i ) EMIT_LITERAL(out, ",");
+            nara_emitter_append(out, plan->columns[i].header, plan->columns[i].headerLen);
+        }
+        EMIT_LITERAL(out, "\n");
+    }
+}
+
+/**/
+
+static void
+__nara_fields_export(
+    nara_export_context_t       exportContext,
+    nara_record_t               *theRecord,
+    uint32_t                    recordType
+)
+{
+    nara_export_context_base_t  *BASE_CONTEXT = (nara_export_context_base_t*)exportContext;
+    const nara_fields_format_t  *projected = (const nara_fields_format_t*)BASE_CONTEXT->recordFormat;
+    const nara_fields_plan_t    *plan = &projected->plans[recordType];
+    const uint8_t               *record = (const uint8_t*)theRecord;
+    int                         isYAML = (BASE_CONTEXT->format == nara_export_format_yaml);
+    nara_emitter_t              out;
+    unsigned int                i;
+    
+    if ( isYAML ) {
+        if ( ! (out = ((nara_export_context_yaml_t*)exportContext)->out) ) return;
+        EMIT_STR(out, "- recordType: ", projected->format.recordTypes[recordType].name, "\n");
+    } else if ( BASE_CONTEXT->format == nara_export_format_csv ) {
+        if ( ! (out = *__nara_fields_csv_out((nara_export_context_csv_t*)exportContext, recordType)) ) return;
+    } else {
+        return;
+    }
+    
+    for ( i = 0; i < plan->nColumns; i++ ) {
+        const nara_fields_column_t  *column = &plan->columns[i];
+        
+        if ( isYAML ) nara_emitter_append(out, column->yamlPrefix, column->yamlPrefixLen);
+        else if ( i ) EMIT_LITERAL(out, ",");
+        
+        switch ( column->kind ) {
+            
+            case nara_fields_column_u32: {
+                uint32_t        word;
+                
+                memcpy(&word, record + column->offset, sizeof(word));
+                nara_emitter_append_u32(out, nara_be_to_host_u32(word));
+                break;
+            }
+            
+            case nara_fields_column_float: {
+                float           value;
+                
+                memcpy(&value, record + column->offset, sizeof(value));
+                nara_emitter_append_float(out, nara_be_to_host_f32(value));
+                break;
+            }
+            
+            case nara_fields_column_string: {
+                char            field[NARA_FIELDS_MAX_STRING];
+                
+                LOCAL_STR_DECL(value, NARA_FIELDS_MAX_STRING);
+                
+                memcpy(field, record + column->offset, column->length);
+                if ( projected->format.isEBCDIC ) nara_ebcdic_to_ascii_field(field, column->length);
+                LOCAL_STR_FILL(value, column->length, field);
+                if ( isYAML ) nara_emitter_append_string(out, value);
+                else nara_emitter_append_quoted(out, value);
+                break;
+            }
+            
+        }
+        if ( isYAML ) EMIT_LITERAL(out, "\n");
+    }
+    if ( ! isYAML ) EMIT_LITERAL(out, "\n");
+}
+
+/**/
+
+static void
+__nara_fields_export_init_district(
+    nara_export_context_t   exportContext
+)
+{
+    __nara_fields_export_init(exportContext, nara_record_type_district);
+}
+
+/**/
+
+static void
+__nara_fields_export_init_school(
+    nara_export_context_t   exportContext
+)
+{
+    __nara_fields_export_init(exportContext, nara_record_type_school);
+}
+
+/**/
+
+static void
+__nara_fields_export_init_classroom(
+    nara_export_context_t   exportContext
+)
+{
+    __nara_fields_export_init(exportContext, nara_record_type_classroom);
+}
+
+static const nara_export_init_fn __nara_fields_export_init_fns[nara_record_type_max] = {
+                                    NULL,
+                                    __nara_fields_export_init_district,
+                                    __nara_fields_export_init_school,
+                                    __nara_fields_export_init_classroom
+                                };
+
+/**/
+
+static void
+__nara_fields_export_district(
+    nara_export_context_t   exportContext,
+    nara_record_t           *theRecord
+)
+{
+    __nara_fields_export(exportContext, theRecord, nara_record_type_district);
+}
+
+/**/
+
+static void
+__nara_fields_export_school(
+    nara_export_context_t   exportContext,
+    nara_record_t           *theRecord
+)
+{
+    __nara_fields_export(exportContext, theRecord, nara_record_type_school);
+}
+
+/**/
+
+static void
+__nara_fields_export_classroom(
+    nara_export_context_t   exportContext,
+    nara_record_t           *theRecord
+)
+{
+    __nara_fields_export(exportContext, theRecord, nara_record_type_classroom);
+}
+
+static const nara_record_export_fn __nara_fields_export_fns[nara_record_type_max] = {
+                                    NULL,
+                                    __nara_fields_export_district,
+                                    __nara_fields_export_school,
+                                    __nara_fields_export_classroom
+                                };
+
+/**/
+
+nara_format_t
+nara_fields_project(
+    nara_fields_t           fields,
+    nara_format_t           format
+)
+{
+    nara_fields_format_t    **cached = &fields->projected[format->layout][format->isEBCDIC ? 1 : 0];
+    nara_fields_format_t    *projected;
+    unsigned int            t, i, nSelected = 0, nFilters = 0;
+    
+    if ( *cached ) return &(*cached)->format;
+    
+    for ( t = 0; t < nara_record_type_max; t++ ) {
+        nSelected += fields->selections[t].nPatterns;
+        nFilters += fields->filters[t].nPatterns;
+    }
+    if ( (nSelected == 0) && (nFilters == 0) && ! fields->wantedTypes ) return format;
+    
+    if ( ! (projected = (nara_fields_format_t*)calloc(1, sizeof(nara_fields_format_t))) ) {
+        fprintf(stderr, "ERROR:  unable to allocate field selection\n");
+        return NULL;
+    }
+    projected->format = *format;
+    if ( fields->wantedTypes ) {
+        for ( t = 1; t < nara_record_type_max; t++ ) {
+            if ( format->recordTypes[t].byteSize && ! (fields->wantedTypes & (1u << t)) ) projected->format.skippedTypes |= (1u << t);
+        }
+        for ( t = 1; t < nara_record_type_max; t++ ) if ( format->recordTypes[t].byteSize && (fields->wantedTypes & (1u << t)) ) break;
+        if ( t == nara_record_type_max ) {
+            fprintf(stderr, "ERROR:  %s files have no records of the selected types\n", format->name);
+            goto error_exit;
+        }
+    }
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        /* Types the layout does not have (1976 classrooms) or that are skipped are passed over: */
+        if ( ! format->recordTypes[t].byteSize || (projected->format.skippedTypes & (1u << t)) ) continue;
+        if ( ! fields->selections[t].nPatterns && ! fields->filters[t].nPatterns && ! fields->filters[0].nPatterns ) continue;
+        if ( __nara_fields_map_columns(format, t, &projected->maps[t]) != 0 ) goto error_exit;
+        
+        for ( i = 0; i < fields->filters[t].nPatterns; i++ ) {
+            int             rc = __nara_fields_compile_filter(projected, t, fields->filters[t].patterns[i]);
+            
+            if ( rc == ENOENT ) fprintf(stderr, "ERROR:  filter names a column %s %s records do not have: %s\n", format->name, format->recordTypes[t].name, fields->filters[t].patterns[i]);
+            if ( rc != 0 ) goto error_exit;
+        }
+        if ( ! fields->selections[t].nPatterns ) continue;
+        if ( __nara_fields_compile_plan(format, t, &projected->maps[t], &fields->selections[t], &projected->plans[t]) != 0 ) goto error_exit;
+        projected->format.processFns[t] = format->processTypeFn;
+        projected->format.exportInitFns[t] = __nara_fields_export_init_fns[t];
+        projected->format.exportFns[t] = __nara_fields_export_fns[t];
+    }
+    
+    /* Filters without a record type apply to every type with all their columns: */
+    for ( i = 0; i < fields->filters[0].nPatterns; i++ ) {
+        unsigned int        nApplied = 0;
+        
+        for ( t = 1; t < nara_record_type_max; t++ ) {
+            int             rc;
+            
+            if ( ! format->recordTypes[t].byteSize || (projected->format.skippedTypes & (1u << t)) ) continue;
+            rc = __nara_fields_compile_filter(projected, t, fields->filters[0].patterns[i]);
+            if ( rc == 0 ) nApplied++;
+            else if ( rc != ENOENT ) goto error_exit;
+        }
+        if ( ! nApplied ) {
+            fprintf(stderr, "ERROR:  no %s record type has all the columns in filter: %s\n", format->name, fields->filters[0].patterns[i]);
+            goto error_exit;
+        }
+    }
+    if ( nFilters ) projected->format.filterFn = __nara_fields_filter;
+    *cached = projected;
+    return &projected->format;
+
+error_exit:
+    __nara_fields_format_destroy(projected);
+    return NULL;
+}
+
+/**/
+
+unsigned int
+nara_fields_columns(
+    nara_format_t               format,
+    uint32_t                    recordType,
+    nara_fields_column_info_t   **columns,
+    int                         *isRaw
+)
+{
+    nara_fields_plan_t          map;
+    unsigned int                nColumns = 0, i;
+    
+    memset(&map, 0, sizeof(map));
+    
+    /* A projected type has its plan: */
+    if ( format->exportFns[recordType] == __nara_fields_export_fns[recordType] ) {
+        const nara_fields_plan_t    *plan = &((const nara_fields_format_t*)format)->plans[recordType];
+        
+        if ( (map.columns = (nara_fields_column_t*)calloc(plan->nColumns + 1, sizeof(nara_fields_column_t))) ) {
+            for ( i = 0; i < plan->nColumns; i++ ) {
+                map.columns[i].kind = plan->columns[i].kind;
+                map.columns[i].offset = plan->columns[i].offset;
+                map.columns[i].length = plan->columns[i].length;
+                if ( ! (map.columns[map.nColumns++].name = strdup(plan->columns[i].name)) ) break;
+            }
+        }
+        if ( ! map.columns || (i < plan->nColumns) ) {
+            fprintf(stderr, "ERROR:  unable to allocate field selection\n");
+            goto early_exit;
+        }
+    } else if ( __nara_fields_map_columns(format, recordType, &map) != 0 ) {
+        goto early_exit;
+    }
+    if ( ! (*columns = (nara_fields_column_info_t*)calloc(map.nColumns + 1, sizeof(nara_fields_column_info_t))) ) {
+        fprintf(stderr, "ERROR:  unable to allocate field selection\n");
+        goto early_exit;
+    }
+    
+    /* The names are taken over from the map: */
+    for ( i = 0; i < map.nColumns; i++ ) {
+        (*columns)[i].kind = map.columns[i].kind;
+        (*columns)[i].offset = map.columns[i].offset;
+        (*columns)[i].length = map.columns[i].length;
+        (*columns)[i].name = map.columns[i].name;
+        map.columns[i].name = NULL;
+    }
+    nColumns = map.nColumns;
+    
+    /* Only a projected decoder leaves its records as read: */
+    *isRaw = ( format->processFns[recordType] == format->processTypeFn );
+
+early_exit:
+    __nara_fields_map_destroy(&map);
+    return nColumns;
+}
+
+/**/
+
+void
+nara_fields_columns_destroy(
+    nara_fields_column_info_t   *columns,
+    unsigned int                nColumns
+)
+{
+    unsigned int                i;
+    
+    if ( ! columns ) return;
+    for ( i = 0; i < nColumns; i++ ) free((void*)columns[i].name);
+    free((void*)columns);
+}
@@ -0,0 +1,142 @@
+/*
+ * nara_fields
+ *
+ * Projection of records onto a selection of their columns.  The columns of a
+ * record type are the ones in its CSV export; a selection names them (or glob
+ * patterns over them) per record type, e.g. "school:systemName,pupils_*".
+ *
+ * For each decoder the selection is compiled once into a plan:  the offset,
+ * width, and kind (integer, floating-point, or string) of every selected column
+ * within the record as read from the file.  A projected decoder then leaves the
+ * records of the selected types as read -- no byte-swapping or transcoding of
+ * the whole record -- and its exporters convert and write only the planned
+ * columns, so the cost per record follows the number of columns selected
+ * rather than the width of the record.
+ *
+ * Each record type's columns function (beside its exporters) describes the
+ * columns:  the header and the offset, width, and kind of the field behind each
+ * one, taken with offsetof() from the record structure, as the decoder's string
+ * and floating-point field tables are.
+ *
+ */
+
+#ifndef __NARA_FIELDS_H__
+#define __NARA_FIELDS_H__
+
+#include "nara_base.h"
+#include "nara_format.h"
+
+/*!
+    @enum nara_fields_column_kind
+
+    The kinds of field behind a column.
+ */
+enum {
+    nara_fields_column_u32 = 0,
+    nara_fields_column_float,
+    nara_fields_column_string
+};
+
+/*!
+    @typedef nara_fields_column_info_t
+
+    A column of a record type's CSV export:  its name, and the kind, offset,
+    and width of the field behind it within the record.
+ */
+typedef struct {
+    unsigned int    kind;
+    size_t          offset;
+    size_t          length;
+    char            *name;
+} nara_fields_column_info_t;
+
+/*!
+    @typedef nara_fields_t
+
+    Opaque reference to a column selection.
+ */
+typedef struct nara_fields * nara_fields_t;
+
+/*!
+    @function nara_fields_create
+
+    Allocate a new, empty selection.  Record types with no columns selected
+    are exported in full.
+ */
+nara_fields_t nara_fields_create(void);
+
+/*!
+    @function nara_fields_destroy
+
+    Dispose of the selection and the projected decoders made from it; an
+    export context must not be used with them afterwards.
+ */
+void nara_fields_destroy(nara_fields_t fields);
+
+/*!
+    @function nara_fields_add
+
+    Add the columns in spec to the selection.  The spec has the form
+    <type>:<pattern>{,<pattern>..}, where <type> is district, school, or
+    classroom (summary is a synonym for the 1986 layout) and each <pattern>
+    is a column name or an fnmatch(3) glob pattern over the column names.
+    Returns zero on success.
+ */
+int nara_fields_add(nara_fields_t fields, const char *spec);
+
+/*!
+    @function nara_fields_add_filter
+
+    Add a filter expression (see nara_filter.h) in spec, of the form
+    {<type>:}<expression>:  records of that type (or, without a type, of every
+    type that has all the columns the expression names) are dropped as they
+    are read unless the expression holds for them.  Several filters on a
+    type must all hold.  Returns zero on success.
+ */
+int nara_fields_add_filter(nara_fields_t fields, const char *spec);
+
+/*!
+    @function nara_fields_add_types
+
+    Add the record types in spec, of the form <type>{,<type>..}, to those
+    wanted; once any are, records of the other types are skipped without
+    being processed (or, for a memory-mapped file, even read).  Returns zero
+    on success.
+ */
+int nara_fields_add_types(nara_fields_t fields, const char *spec);
+
+/*!
+    @function nara_fields_project
+
+    Returns a decoder that reads records like format but exports only the
+    selected columns (in the order of the full CSV export); the selected
+    record types are written as flat YAML mappings or as CSV files with just
+    those columns.  The plan for each format is compiled the first time it
+    is asked for.  Records rejected by the filters or of unwanted types are
+    dropped.  Returns NULL (after reporting why) if a pattern matches no
+    column of the format's layout, a filter does not apply to it, or it has
+    none of the wanted types.
+ */
+nara_format_t nara_fields_project(nara_fields_t fields, nara_format_t format);
+
+/*!
+    @function nara_fields_columns
+
+    Describe the columns format exports for records of recordType (every
+    column of a decoder, the selected ones of a projected decoder), in the
+    order of its CSV export.  Sets *columns to an array to be disposed of
+    with nara_fields_columns_destroy() and *isRaw non-zero if the records
+    are exported as read from the file (big-endian, strings not transcoded)
+    rather than processed.  Returns the number of columns, or zero (after
+    reporting why) if they cannot be described.
+ */
+unsigned int nara_fields_columns(nara_format_t format, uint32_t recordType, nara_fields_column_info_t **columns, int *isRaw);
+
+/*!
+    @function nara_fields_columns_destroy
+
+    Dispose of the columns returned by nara_fields_columns().
+ */
+void nara_fields_columns_destroy(nara_fields_column_info_t *columns, unsigned int nColumns);
+
+#endif /* __NARA_FIELDS_H__ */
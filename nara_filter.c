@@ -0,0 +1,604 @@
+/*
+ * nara_filter
+ *
+ * Record filters:  boolean expressions over the columns of a record, compiled
+ * into a short bytecode program that is run on the record as read from the
+ * file (big-endian integers and floats, strings in the file's encoding), before
+ * the record is processed or formatted.
+ *
+ * The program is a list of instructions acting on a single truth value:  a test
+ * compares two operands (a column at a fixed offset, or a constant) and sets the
+ * value; && and || compile to jumps past their right-hand side when the value
+ * already decides the result, and ! negates the value.
+ *
+ */
+
+#include "nara_filter.h"
+#include "nara_ebcdic.h"
+
+/*
+ * The longest string column that can be compared:
+ */
+#define NARA_FILTER_MAX_STRING      255
+
+enum {
+    nara_filter_operand_number = 0,
+    nara_filter_operand_string,
+    nara_filter_operand_u32,
+    nara_filter_operand_float,
+    nara_filter_operand_string_field
+};
+
+typedef struct {
+    unsigned int    kind;
+    size_t          offset;
+    size_t          length;
+    double          number;
+    char            *string;
+} nara_filter_operand_t;
+
+enum {
+    nara_filter_op_test = 0,
+    nara_filter_op_jump_if_false,
+    nara_filter_op_jump_if_true,
+    nara_filter_op_not
+};
+
+enum {
+    nara_filter_cmp_eq = 0,
+    nara_filter_cmp_ne,
+    nara_filter_cmp_lt,
+    nara_filter_cmp_le,
+    nara_filter_cmp_gt,
+    nara_filter_cmp_ge,
+    nara_filter_cmp_true
+};
+
+typedef struct {
+    unsigned int            opcode;
+    unsigned int            comparison;
+    unsigned int            target;
+    nara_filter_operand_t   lhs;
+    nara_filter_operand_t   rhs;
+} nara_filter_insn_t;
+
+struct nara_filter {
+    nara_filter_insn_t      *program;
+    unsigned int            nInsns;
+    unsigned int            capacity;
+    char                    decode[256];
+};
+
+/*
+ * State of the parser; without a resolveFn (or filter) only the syntax is checked:
+ */
+typedef struct {
+    const char              *expression;
+    const char              *p;
+    nara_filter_resolve_fn  resolveFn;
+    void                    *context;
+    struct nara_filter      *filter;
+} nara_filter_parser_t;
+
+/**/
+
+static int
+__nara_filter_syntax_error(
+    nara_filter_parser_t    *parser,
+    const char              *problem
+)
+{
+    fprintf(stderr, "ERROR:  invalid filter expression (%s at column %u): %s\n", problem, (unsigned int)(parser->p - parser->expression) + 1, parser->expression);
+    return EINVAL;
+}
+
+/**/
+
+static void
+__nara_filter_skip_space(
+    nara_filter_parser_t    *parser
+)
+{
+    while ( isspace((unsigned char)*parser->p) ) parser->p++;
+}
+
+/**/
+
+static int
+__nara_filter_emit(
+    nara_filter_parser_t    *parser,
+    unsigned int            opcode,
+    unsigned int            *index
+)
+{
+    struct nara_filter      *filter = parser->filter;
+    
+    if ( ! filter ) return 0;
+    if ( filter->nInsns == filter->capacity ) {
+        unsigned int        newCapacity = filter->capacity ? 2 * filter->capacity : 8;
+        nara_filter_insn_t  *newProgram = (nara_filter_insn_t*)realloc(filter->program, newCapacity * sizeof(nara_filter_insn_t));
+        
+        if ( ! newProgram ) {
+            fprintf(stderr, "ERROR:  unable to allocate filter\n");
+            return ENOMEM;
+        }
+        filter->program = newProgram;
+        filter->capacity = newCapacity;
+    }
+    memset(&filter->program[filter->nInsns], 0, sizeof(nara_filter_insn_t));
+    filter->program[filter->nInsns].opcode = opcode;
+    if ( index ) *index = filter->nInsns;
+    filter->nInsns++;
+    return 0;
+}
+
+/**/
+
+/*
+ * Parse a column name, number, or string into operand:
+ */
+static int
+__nara_filter_parse_operand(
+    nara_filter_parser_t    *parser,
+    nara_filter_operand_t   *operand
+)
+{
+    const char              *start;
+    char                    name[256];
+    size_t                  nameLen;
+    nara_filter_field_t     field;
+    
+    memset(operand, 0, sizeof(*operand));
+    __nara_filter_skip_space(parser);
+    start = parser->p;
+    
+    if ( *start == '"' ) {
+        char                *s;
+        
+        /* The string as it would be written (double quotes become single quotes): */
+        if ( ! (s = operand->string = (char*)malloc(strlen(start) + 1)) ) {
+            fprintf(stderr, "ERROR:  unable to allocate filter\n");
+            return ENOMEM;
+        }
+        operand->kind = nara_filter_operand_string;
+        parser->p++;
+        while ( *parser->p && (*parser->p != '"') ) {
+            if ( (*parser->p == '\\') && parser->p[1] ) parser->p++;
+            *s++ = ( *parser->p == '"' ) ? '\'' : *parser->p;
+            parser->p++;
+        }
+        *s = '\0';
+        operand->length = s - operand->string;
+        if ( *parser->p != '"' ) return __nara_filter_syntax_error(parser, "unterminated string");
+        parser->p++;
+        return 0;
+    }
+    
+    if ( isdigit((unsigned char)*start) || (((*start == '-') || (*start == '+') || (*start == '.')) && (isdigit((unsigned char)start[1]) || (start[1] == '.'))) ) {
+        char                *end;
+        
+        operand->kind = nara_filter_operand_number;
+        operand->number = strtod(start, &end);
+        if ( end == start ) return __nara_filter_syntax_error(parser, "invalid number");
+        parser->p = end;
+        return 0;
+    }
+    
+    if ( *start == '`' ) {
+        const char          *end = strchr(start + 1, '`');
+        
+        if ( ! end ) return __nara_filter_syntax_error(parser, "unterminated column name");
+        nameLen = end - (start + 1);
+        start++;
+        parser->p = end + 1;
+    } else if ( isalpha((unsigned char)*start) || (*start == '_') ) {
+        while ( isalnum((unsigned char)*parser->p) || (*parser->p == '_') || (*parser->p == '.') ) parser->p++;
+        nameLen = parser->p - start;
+    } else {
+        return __nara_filter_syntax_error(parser, *start ? "expected a column, number, or string" : "unexpected end");
+    }
+    if ( (nameLen == 0) || (nameLen >= sizeof(name)) ) return __nara_filter_syntax_error(parser, "invalid column name");
+    memcpy(name, start, nameLen);
+    name[nameLen] = '\0';
+    if ( ! parser->resolveFn ) return 0;
+    
+    /* A '.' may stand for an '_': */
+    if ( ! parser->resolveFn(parser->context, name, &field) ) {
+        char                *dot = strchr(name, '.');
+        
+        if ( ! dot ) return ENOENT;
+        do *dot = '_'; while ( (dot = strchr(dot, '.')) );
+        if ( ! parser->resolveFn(parser->context, name, &field) ) return ENOENT;
+    }
+    switch ( field.kind ) {
+        case nara_filter_field_u32:
+            operand->kind = nara_filter_operand_u32;
+            break;
+        case nara_filter_field_float:
+            operand->kind = nara_filter_operand_float;
+            break;
+        default:
+            if ( field.length > NARA_FILTER_MAX_STRING ) {
+                fprintf(stderr, "ERROR:  column %s is too long to be compared\n", name);
+                return EINVAL;
+            }
+            operand->kind = nara_filter_operand_string_field;
+            break;
+    }
+    operand->offset = field.offset;
+    operand->length = field.length;
+    return 0;
+}
+
+/**/
+
+static int
+__nara_filter_is_string(
+    const nara_filter_operand_t *operand
+)
+{
+    return ( operand->kind == nara_filter_operand_string ) || ( operand->kind == nara_filter_operand_string_field );
+}
+
+/**/
+
+/*
+ * <operand> {<comparison> <operand>}
+ */
+static int
+__nara_filter_parse_comparison(
+    nara_filter_parser_t    *parser
+)
+{
+    static const struct {
+        const char          *token;
+        unsigned int        comparison;
+    } comparisons[] = {
+            { "==", nara_filter_cmp_eq }, { "!=", nara_filter_cmp_ne },
+            { "<=", nara_filter_cmp_le }, { ">=", nara_filter_cmp_ge },
+            { "<", nara_filter_cmp_lt }, { ">", nara_filter_cmp_gt }
+        };
+    nara_filter_operand_t   lhs, rhs;
+    unsigned int            comparison = nara_filter_cmp_true, i, index;
+    int                     rc;
+    
+    memset(&rhs, 0, sizeof(rhs));
+    if ( (rc = __nara_filter_parse_operand(parser, &lhs)) != 0 ) goto early_exit;
+    __nara_filter_skip_space(parser);
+    for ( i = 0; i < sizeof(comparisons) / sizeof(comparisons[0]); i++ ) {
+        size_t              tokenLen = strlen(comparisons[i].token);
+        
+        if ( strncmp(parser->p, comparisons[i].token, tokenLen) == 0 ) {
+            comparison = comparisons[i].comparison;
+            parser->p += tokenLen;
+            if ( (rc = __nara_filter_parse_operand(parser, &rhs)) != 0 ) goto early_exit;
+            break;
+        }
+    }
+    if ( ! parser->filter ) goto early_exit;
+    
+    if ( comparison != nara_filter_cmp_true ) {
+        if ( __nara_filter_is_string(&lhs) != __nara_filter_is_string(&rhs) ) {
+            fprintf(stderr, "ERROR:  cannot compare a string with a number: %s\n", parser->expression);
+            rc = EINVAL;
+            goto early_exit;
+        }
+        if ( __nara_filter_is_string(&lhs) && (comparison != nara_filter_cmp_eq) && (comparison != nara_filter_cmp_ne) ) {
+            fprintf(stderr, "ERROR:  strings can only be compared with == and !=: %s\n", parser->expression);
+            rc = EINVAL;
+            goto early_exit;
+        }
+    }
+    if ( (rc = __nara_filter_emit(parser, nara_filter_op_test, &index)) != 0 ) goto early_exit;
+    parser->filter->program[index].comparison = comparison;
+    parser->filter->program[index].lhs = lhs;
+    parser->filter->program[index].rhs = rhs;
+    return 0;
+
+early_exit:
+    free((void*)lhs.string);
+    free((void*)rhs.string);
+    return rc;
+}
+
+static int __nara_filter_parse_or(nara_filter_parser_t *parser);
+
+/**/
+
+/*
+ * !<unary> | ( <or> ) | <comparison>
+ */
+static int
+__nara_filter_parse_unary(
+    nara_filter_parser_t    *parser
+)
+{
+    int                     rc;
+    
+    __nara_filter_skip_space(parser);
+    if ( (*parser->p == '!') && (parser->p[1] != '=') ) {
+        parser->p++;
+        if ( (rc = __nara_filter_parse_unary(parser)) != 0 ) return rc;
+        return __nara_filter_emit(parser, nara_filter_op_not, NULL);
+    }
+    if ( *parser->p == '(' ) {
+        parser->p++;
+        if ( (rc = __nara_filter_parse_or(parser)) != 0 ) return rc;
+        __nara_filter_skip_space(parser);
+        if ( *parser->p != ')' ) return __nara_filter_syntax_error(parser, "expected )");
+        parser->p++;
+        return 0;
+    }
+    return __nara_filter_parse_comparison(parser);
+}
+
+/**/
+
+/*
+ * <unary> {&& <unary> ..} or <and> {|| <and> ..}:  the right-hand side is skipped
+ * if the left-hand side decides the result.
+ */
+static int
+__nara_filter_parse_chain(
+    nara_filter_parser_t    *parser,
+    const char              *token,
+    unsigned int            jumpOpcode,
+    int                     (*parseFn)(nara_filter_parser_t *parser)
+)
+{
+    unsigned int            jump;
+    int                     rc;
+    
+    if ( (rc = parseFn(parser)) != 0 ) return rc;
+    while ( 1 ) {
+        __nara_filter_skip_space(parser);
+        if ( strncmp(parser->p, token, 2) != 0 ) return 0;
+        parser->p += 2;
+        if ( (rc = __nara_filter_emit(parser, jumpOpcode, &jump)) != 0 ) return rc;
+        if ( (rc = parseFn(parser)) != 0 ) return rc;
+        if ( parser->filter ) parser->filter->program[jump].target = parser->filter->nInsns;
+    }
+}
+
+/**/
+
+static int
+__nara_filter_parse_and(
+    nara_filter_parser_t    *parser
+)
+{
+    return __nara_filter_parse_chain(parser, "&&", nara_filter_op_jump_if_false, __nara_filter_parse_unary);
+}
+
+/**/
+
+static int
+__nara_filter_parse_or(
+    nara_filter_parser_t    *parser
+)
+{
+    return __nara_filter_parse_chain(parser, "||", nara_filter_op_jump_if_true, __nara_filter_parse_and);
+}
+
+/**/
+
+static int
+__nara_filter_parse(
+    nara_filter_parser_t    *parser
+)
+{
+    int                     rc = __nara_filter_parse_or(parser);
+    
+    if ( rc != 0 ) return rc;
+    __nara_filter_skip_space(parser);
+    if ( *parser->p ) return __nara_filter_syntax_error(parser, "unexpected text");
+    return 0;
+}
+
+/**/
+
+int
+nara_filter_check(
+    const char              *expression
+)
+{
+    nara_filter_parser_t    parser;
+    
+    memset(&parser, 0, sizeof(parser));
+    parser.expression = parser.p = expression;
+    return __nara_filter_parse(&parser);
+}
+
+/**/
+
+int
+nara_filter_compile(
+    const char              *expression,
+    int                     isEBCDIC,
+    nara_filter_resolve_fn  resolveFn,
+    void                    *context,
+    nara_filter_t           *filter
+)
+{
+    nara_filter_parser_t    parser;
+    unsigned int            i;
+    int                     rc;
+    
+    memset(&parser, 0, sizeof(parser));
+    parser.expression = parser.p = expression;
+    parser.resolveFn = resolveFn;
+    parser.context = context;
+    if ( ! (parser.filter = (struct nara_filter*)calloc(1, sizeof(struct nara_filter))) ) {
+        fprintf(stderr, "ERROR:  unable to allocate filter\n");
+        return ENOMEM;
+    }
+    
+    /* Strings are compared as they would be written, so the columns are decoded alike: */
+    for ( i = 0; i < 256; i++ ) parser.filter->decode[i] = (char)i;
+    if ( isEBCDIC ) nara_ebcdic_to_ascii_field(parser.filter->decode, sizeof(parser.filter->decode));
+    
+    if ( (rc = __nara_filter_parse(&parser)) != 0 ) {
+        nara_filter_destroy(parser.filter);
+        return rc;
+    }
+    *filter = parser.filter;
+    return 0;
+}
+
+/**/
+
+void
+nara_filter_destroy(
+    nara_filter_t       filter
+)
+{
+    unsigned int        i;
+    
+    if ( ! filter ) return;
+    for ( i = 0; i < filter->nInsns; i++ ) {
+        free((void*)filter->program[i].lhs.string);
+        free((void*)filter->program[i].rhs.string);
+    }
+    free((void*)filter->program);
+    free((void*)filter);
+}
+
+/**/
+
+static double
+__nara_filter_number(
+    const nara_filter_operand_t *operand,
+    const uint8_t               *record
+)
+{
+    switch ( operand->kind ) {
+        
+        case nara_filter_operand_u32: {
+            uint32_t            word;
+            
+            memcpy(&word, record + operand->offset, sizeof(word));
+            return (double)nara_be_to_host_u32(word);
+        }
+        
+        case nara_filter_operand_float: {
+            float               value;
+            
+            memcpy(&value, record + operand->offset, sizeof(value));
+            return (double)nara_be_to_host_f32(value);
+        }
+        
+    }
+    return operand->number;
+}
+
+/**/
+
+/*
+ * The string an operand would be written as (cf. LOCAL_STR_FILL()):  decoded,
+ * trailing whitespace and NULs removed, double quotes turned into single quotes,
+ * and cut short at any remaining NUL:
+ */
+static const char*
+__nara_filter_string(
+    nara_filter_t               filter,
+    const nara_filter_operand_t *operand,
+    const uint8_t               *record,
+    char                        *buffer,
+    size_t                      *length
+)
+{
+    const uint8_t               *field = record + operand->offset;
+    size_t                      n = operand->length, i;
+    
+    if ( operand->kind == nara_filter_operand_string ) {
+        *length = operand->length;
+        return operand->string;
+    }
+    for ( i = 0; i < n; i++ ) buffer[i] = filter->decode[field[i]];
+    while ( (n > 0) && (! buffer[n - 1] || isspace((unsigned char)buffer[n - 1])) ) n--;
+    for ( i = 0; i < n; i++ ) {
+        if ( ! buffer[i] ) break;
+        if ( buffer[i] == '"' ) buffer[i] = '\'';
+    }
+    *length = i;
+    return buffer;
+}
+
+/**/
+
+static int
+__nara_filter_test(
+    nara_filter_t               filter,
+    const nara_filter_insn_t    *insn,
+    const uint8_t               *record
+)
+{
+    double                      lhs, rhs;
+    
+    if ( __nara_filter_is_string(&insn->lhs) ) {
+        char                    lhsBuffer[NARA_FILTER_MAX_STRING], rhsBuffer[NARA_FILTER_MAX_STRING];
+        size_t                  lhsLen, rhsLen;
+        const char              *lhsStr = __nara_filter_string(filter, &insn->lhs, record, lhsBuffer, &lhsLen);
+        const char              *rhsStr;
+        int                     isEqual;
+        
+        if ( insn->comparison == nara_filter_cmp_true ) return ( lhsLen > 0 );
+        rhsStr = __nara_filter_string(filter, &insn->rhs, record, rhsBuffer, &rhsLen);
+        isEqual = ( lhsLen == rhsLen ) && ( memcmp(lhsStr, rhsStr, lhsLen) == 0 );
+        return ( insn->comparison == nara_filter_cmp_eq ) ? isEqual : ! isEqual;
+    }
+    
+    lhs = __nara_filter_number(&insn->lhs, record);
+    if ( insn->comparison == nara_filter_cmp_true ) return ( lhs != 0.0 );
+    rhs = __nara_filter_number(&insn->rhs, record);
+    switch ( insn->comparison ) {
+        case nara_filter_cmp_eq:
+            return ( lhs == rhs );
+        case nara_filter_cmp_ne:
+            return ( lhs != rhs );
+        case nara_filter_cmp_lt:
+            return ( lhs < rhs );
+        case nara_filter_cmp_le:
+            return ( lhs <= rhs );
+        case nara_filter_cmp_gt:
+            return ( lhs > rhs );
+    }
+    return ( lhs >= rhs );
+}
+
+/**/
+
+int
+nara_filter_eval(
+    nara_filter_t               filter,
+    const void                  *theRecord
+)
+{
+    const nara_filter_insn_t    *insn = filter->program, *end = filter->program + filter->nInsns;
+    int                         value = 1;
+    
+    while ( insn < end ) {
+        switch ( insn->opcode ) {
+            
+            case nara_filter_op_test:
+                value = __nara_filter_test(filter, insn, (const uint8_t*)theRecord);
+                insn++;
+                break;
+            
+            case nara_filter_op_jump_if_false:
+                insn = value ? insn + 1 : filter->program + insn->target;
+                break;
+            
+            case nara_filter_op_jump_if_true:
+                insn = value ? filter->program + insn->target : insn + 1;
+                break;
+            
+            default:
+                value = ! value;
+                insn++;
+                break;
+            
+        }
+    }
+    return value;
+}
@@ -0,0 +1,98 @@
+/*
+ * nara_filter
+ *
+ * Record filters:  boolean expressions over the columns of a record, compiled
+ * into a short bytecode program that is run on the record as read from the
+ * file (big-endian integers and floats, strings in the file's encoding), before
+ * the record is processed or formatted.
+ *
+ * An expression compares columns with each other or with constants and
+ * combines the comparisons:
+ *
+ *     systemState == "ALA" && (pupils_Total > 1000 || !isESAADistrict)
+ *
+ * Columns are named as in the CSV output; a name containing spaces or other
+ * punctuation is enclosed in backquotes (`pupils_Male_Black (not Hispanic)`),
+ * and a '.' may stand for an '_' (pupils.Total).  Numeric columns and constants
+ * are compared with ==, !=, <, <=, >, and >=; string columns with == and != to
+ * a double-quoted string, as the string would be written (trailing spaces
+ * removed).  A column on its own is true if it is non-zero (or non-empty).
+ *
+ */
+
+#ifndef __NARA_FILTER_H__
+#define __NARA_FILTER_H__
+
+#include "nara_base.h"
+
+/*!
+    @enum nara_filter_field_kind
+
+    The kinds of column a filter can refer to.
+ */
+enum {
+    nara_filter_field_u32 = 0,
+    nara_filter_field_float,
+    nara_filter_field_string
+};
+
+/*!
+    @typedef nara_filter_field_t
+
+    The location and kind of a column within a record as read from the file.
+ */
+typedef struct {
+    unsigned int    kind;
+    size_t          offset;
+    size_t          length;
+} nara_filter_field_t;
+
+/*!
+    @typedef nara_filter_resolve_fn
+
+    Callback that locates the column called name; returns non-zero if there
+    is such a column.
+ */
+typedef int (*nara_filter_resolve_fn)(void *context, const char *name, nara_filter_field_t *field);
+
+/*!
+    @typedef nara_filter_t
+
+    Opaque reference to a compiled filter.
+ */
+typedef struct nara_filter * nara_filter_t;
+
+/*!
+    @function nara_filter_check
+
+    Check the syntax of an expression; returns zero if it is valid, otherwise
+    reports the problem and returns EINVAL.
+ */
+int nara_filter_check(const char *expression);
+
+/*!
+    @function nara_filter_compile
+
+    Compile an expression for records whose columns are found by resolveFn
+    and whose strings are EBCDIC-encoded if isEBCDIC is non-zero.  Returns
+    zero and sets *filter on success; ENOENT (without reporting it) if the
+    expression names a column that resolveFn does not know; or EINVAL (after
+    reporting why) if the expression is invalid for those columns.
+ */
+int nara_filter_compile(const char *expression, int isEBCDIC, nara_filter_resolve_fn resolveFn, void *context, nara_filter_t *filter);
+
+/*!
+    @function nara_filter_destroy
+
+    Dispose of a compiled filter.
+ */
+void nara_filter_destroy(nara_filter_t filter);
+
+/*!
+    @function nara_filter_eval
+
+    Returns non-zero if the record (as read from the file) passes the filter.
+ */
+int nara_filter_eval(nara_filter_t filter, const void *theRecord);
+
+#endif /* __NARA_FILTER_H__ */
@@ -0,0 +1,370 @@
+/*
+ * nara_format
+ *
+ * The NARA archives come in three record layouts -- pre-1976 (state chunks of
+ * length-prefixed records), 1976 (fixed 3488-byte records), and 1986 (fixed
+ * 2801-byte records) -- with their strings in either EBCDIC or ASCII.  A
+ * decoder for every combination of layout and encoding is compiled in, and
+ * the one to use is chosen per input file:  given explicitly, or sniffed from
+ * the file's leading bytes.
+ *
+ */
+
+#include "nara_format.h"
+#include "nara_record_impl.h"
+#include "nara_state_header.h"
+#include "nara_record_header.h"
+
+/*
+ * The decoders, compiled from nara_record_decoder.c:
+ */
+extern const struct nara_format __nara_format_pre_1976_ascii;
+extern const struct nara_format __nara_format_pre_1976_ebcdic;
+extern const struct nara_format __nara_format_1976_ascii;
+extern const struct nara_format __nara_format_1976_ebcdic;
+extern const struct nara_format __nara_format_1986_ascii;
+extern const struct nara_format __nara_format_1986_ebcdic;
+
+static const nara_format_t  __nara_formats[nara_layout_max][2] = {
+                                { &__nara_format_pre_1976_ascii, &__nara_format_pre_1976_ebcdic },
+                                { &__nara_format_1976_ascii, &__nara_format_1976_ebcdic },
+                                { &__nara_format_1986_ascii, &__nara_format_1986_ebcdic }
+                            };
+
+static const char           *__nara_format_layout_names[nara_layout_max] = {
+                                "pre-1976", "1976", "1986"
+                            };
+
+/**/
+
+nara_format_t
+nara_format_get(
+    unsigned int    layout,
+    int             isEBCDIC
+)
+{
+    return ( layout < nara_layout_max ) ? __nara_formats[layout][isEBCDIC ? 1 : 0] : NULL;
+}
+
+/**/
+
+nara_format_t
+nara_format_default(void)
+{
+    int             layout, isEBCDIC;
+    
+    if ( ! nara_format_parse(NARA_DEFAULT_FORMAT, &layout, &isEBCDIC) ) return __nara_formats[nara_layout_pre_1976][1];
+    return nara_format_get(( layout < 0 ) ? nara_layout_pre_1976 : (unsigned int)layout, ( isEBCDIC < 0 ) ? 1 : isEBCDIC);
+}
+
+/**/
+
+static int
+__nara_format_parse_part(
+    const char      *s,
+    size_t          sLen,
+    int             *layout,
+    int             *isEBCDIC
+)
+{
+    unsigned int    i;
+    
+    if ( (sLen == 4) && (strncasecmp(s, "auto", sLen) == 0) ) return 1;
+    if ( (sLen == 6) && (strncasecmp(s, "ebcdic", sLen) == 0) ) {
+        *isEBCDIC = 1;
+        return 1;
+    }
+    if ( (sLen == 5) && (strncasecmp(s, "ascii", sLen) == 0) ) {
+        *isEBCDIC = 0;
+        return 1;
+    }
+    for ( i = 0; i < nara_layout_max; i++ ) {
+        if ( (sLen == strlen(__nara_format_layout_names[i])) && (strncasecmp(s, __nara_format_layout_names[i], sLen) == 0) ) {
+            *layout = (int)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**/
+
+int
+nara_format_parse(
+    const char      *s,
+    int             *layout,
+    int             *isEBCDIC
+)
+{
+    const char      *colon = strchr(s, ':');
+    int             encodingLayout = -1;
+    
+    *layout = *isEBCDIC = -1;
+    if ( ! colon ) return __nara_format_parse_part(s, strlen(s), layout, isEBCDIC);
+    
+    /* <layout>:<encoding> -- each part must be of the right kind (or auto): */
+    if ( ! __nara_format_parse_part(s, colon - s, layout, isEBCDIC) || (*isEBCDIC != -1) ) return 0;
+    if ( ! __nara_format_parse_part(colon + 1, strlen(colon + 1), &encodingLayout, isEBCDIC) ) return 0;
+    return ( encodingLayout == -1 );
+}
+
+/**/
+
+typedef void (*nara_format_record_fn)(void *context, nara_format_t format, uint32_t recordType, const uint8_t *record);
+
+/*
+ * Walk the whole records in the nBytes at bytes as the given format's layout,
+ * calling recordFn (if not NULL) for each.  Returns the number of records, or
+ * -1 as soon as anything is inconsistent with the layout.
+ */
+static int64_t
+__nara_format_walk(
+    nara_format_t           format,
+    const uint8_t           *bytes,
+    size_t                  nBytes,
+    nara_format_record_fn   recordFn,
+    void                    *context
+)
+{
+    int64_t                 nRecords = 0;
+    size_t                  offset = 0;
+    
+    if ( format->fixedSize ) {
+        while ( nBytes - offset >= format->fixedSize ) {
+            uint32_t        recordType = __nara_format_classify(format, bytes + offset, format->fixedSize);
+            
+            if ( ! recordType ) return -1;
+            if ( recordFn ) recordFn(context, format, recordType, bytes + offset);
+            offset += format->fixedSize;
+            nRecords++;
+        }
+        return nRecords;
+    }
+    
+    while ( nBytes - offset >= sizeof(nara_state_header_t) ) {
+        size_t              chunkLength = ((size_t)bytes[offset] << 8) | bytes[offset + 1];
+        size_t              chunkEnd = offset + chunkLength;
+        
+        if ( chunkLength <= sizeof(nara_state_header_t) ) return -1;
+        offset += sizeof(nara_state_header_t);
+        
+        /* The last chunk in the sample is likely cut short: */
+        while ( offset < chunkEnd ) {
+            size_t          recordLength;
+            uint32_t        recordType;
+            
+            if ( nBytes - offset < sizeof(nara_record_header_t) + sizeof(uint32_t) ) return nRecords;
+            recordLength = ((size_t)bytes[offset] << 8) | bytes[offset + 1];
+            if ( recordLength <= sizeof(nara_record_header_t) ) return -1;
+            recordType = __nara_format_classify(format, bytes + offset + sizeof(nara_record_header_t), recordLength - sizeof(nara_record_header_t));
+            if ( ! recordType ) return -1;
+            if ( offset + recordLength > chunkEnd ) return -1;
+            if ( nBytes - offset < recordLength ) return nRecords;
+            if ( recordFn ) recordFn(context, format, recordType, bytes + offset + sizeof(nara_record_header_t));
+            offset += recordLength;
+            nRecords++;
+        }
+    }
+    return nRecords;
+}
+
+/**/
+
+typedef struct {
+    uint64_t        nEBCDIC;
+    uint64_t        nASCII;
+} nara_format_encoding_votes_t;
+
+static void
+__nara_format_vote_encoding(
+    void                            *context,
+    nara_format_t                   format,
+    uint32_t                        recordType,
+    const uint8_t                   *record
+)
+{
+    nara_format_encoding_votes_t    *votes = (nara_format_encoding_votes_t*)context;
+    const nara_format_record_type_t *type = &format->recordTypes[recordType];
+    unsigned int                    i;
+    
+    for ( i = 0; i < type->nStrings; i++ ) {
+        const uint8_t               *s = record + type->strings[i].offset;
+        size_t                      sLen = type->strings[i].length;
+        
+        while ( sLen-- ) {
+            uint8_t                 c = *s++;
+            
+            /* Space, digits, and letters in each encoding (the two sets are disjoint): */
+            if ( (c == 0x40) || ((c >= 0x81) && (c <= 0x89)) || ((c >= 0x91) && (c <= 0x99)) || ((c >= 0xA2) && (c <= 0xA9)) ||
+                 ((c >= 0xC1) && (c <= 0xC9)) || ((c >= 0xD1) && (c <= 0xD9)) || ((c >= 0xE2) && (c <= 0xE9)) || (c >= 0xF0 && c <= 0xF9) ) votes->nEBCDIC++;
+            else if ( (c == 0x20) || ((c >= 0x30) && (c <= 0x39)) || ((c >= 0x41) && (c <= 0x5A)) || ((c >= 0x61) && (c <= 0x7A)) ) votes->nASCII++;
+        }
+    }
+}
+
+/**/
+
+nara_format_t
+nara_format_detect(
+    const void                      *bytes,
+    size_t                          nBytes,
+    uint64_t                        totalBytes,
+    int                             layout,
+    int                             isEBCDIC
+)
+{
+    nara_format_t                   defaultFormat = nara_format_default();
+    nara_format_encoding_votes_t    votes;
+    
+    if ( nBytes == 0 ) {
+        return nara_format_get(( layout < 0 ) ? defaultFormat->layout : (unsigned int)layout, ( isEBCDIC < 0 ) ? defaultFormat->isEBCDIC : isEBCDIC);
+    }
+    
+    if ( layout < 0 ) {
+        int64_t                     bestCount = 0;
+        unsigned int                i;
+        int                         checkSize;
+        
+        /*
+         * The layout that accounts for the most records wins; on a tie the default
+         * layout is preferred.  A fixed-size layout the archive is not a multiple
+         * of is only considered if nothing else fits (the archive may have been cut
+         * short), and if nothing fits at all the default layout is used, just as
+         * it would be without detection:
+         */
+        for ( checkSize = 1; (checkSize >= 0) && (layout < 0); checkSize-- ) {
+            for ( i = 0; i < nara_layout_max; i++ ) {
+                nara_format_t       candidate = __nara_formats[i][0];
+                int64_t             count;
+                
+                if ( checkSize && candidate->fixedSize && totalBytes && ((totalBytes % candidate->fixedSize) != 0) ) continue;
+                count = __nara_format_walk(candidate, (const uint8_t*)bytes, nBytes, NULL, NULL);
+                if ( (count > bestCount) || ((count == bestCount) && (count > 0) && (i == defaultFormat->layout)) ) {
+                    bestCount = count;
+                    layout = (int)i;
+                }
+            }
+        }
+        if ( layout < 0 ) layout = (int)defaultFormat->layout;
+    }
+    
+    if ( isEBCDIC < 0 ) {
+        memset(&votes, 0, sizeof(votes));
+        __nara_format_walk(__nara_formats[layout][0], (const uint8_t*)bytes, nBytes, __nara_format_vote_encoding, &votes);
+        if ( votes.nEBCDIC > votes.nASCII ) isEBCDIC = 1;
+        else if ( votes.nASCII > votes.nEBCDIC ) isEBCDIC = 0;
+        else isEBCDIC = defaultFormat->isEBCDIC;
+    }
+    return nara_format_get((unsigned int)layout, isEBCDIC);
+}
+
+/**/
+
+const char*
+nara_format_name(
+    nara_format_t   format
+)
+{
+    return format->name;
+}
+
+/**/
+
+unsigned int
+nara_format_layout(
+    nara_format_t   format
+)
+{
+    return format->layout;
+}
+
+/**/
+
+int
+nara_format_is_ebcdic(
+    nara_format_t   format
+)
+{
+    return format->isEBCDIC;
+}
+
+/**/
+
+size_t
+nara_format_fixed_size(
+    nara_format_t   format
+)
+{
+    return format->fixedSize;
+}
+
+/**/
+
+size_t
+nara_format_record_type_offset(
+    nara_format_t   format
+)
+{
+    return format->recordTypeOffset;
+}
+
+/**/
+
+size_t
+nara_format_record_size(
+    nara_format_t   format,
+    uint32_t        recordType
+)
+{
+    return ( recordType < nara_record_type_max ) ? format->recordTypes[recordType].byteSize : 0;
+}
+
+/**/
+
+const char*
+nara_format_record_type_name(
+    nara_format_t   format,
+    uint32_t        recordType
+)
+{
+    return ( recordType < nara_record_type_max ) ? format->recordTypes[recordType].name : NULL;
+}
+
+/**/
+
+size_t
+nara_format_system_code_offset(
+    nara_format_t   format,
+    uint32_t        recordType
+)
+{
+    return ( recordType < nara_record_type_max ) ? format->recordTypes[recordType].systemCodeOffset : 0;
+}
+
+/**/
+
+unsigned int
+nara_format_string_fields(
+    nara_format_t               format,
+    uint32_t                    recordType,
+    const nara_format_field_t   **fields
+)
+{
+    if ( (recordType >= nara_record_type_max) || ! format->recordTypes[recordType].byteSize ) return 0;
+    *fields = format->recordTypes[recordType].strings;
+    return format->recordTypes[recordType].nStrings;
+}
+
+/**/
+
+unsigned int
+nara_format_float_fields(
+    nara_format_t   format,
+    uint32_t        recordType,
+    const size_t    **offsets
+)
+{
+    if ( (recordType >= nara_record_type_max) || ! format->recordTypes[recordType].byteSize ) return 0;
+    *offsets = format->recordTypes[recordType].floats;
+    return format->recordTypes[recordType].nFloats;
+}
@@ -0,0 +1,178 @@
+/*
+ * nara_format
+ *
+ * The NARA archives come in three record layouts -- pre-1976 (state chunks of
+ * length-prefixed records), 1976 (fixed 3488-byte records), and 1986 (fixed
+ * 2801-byte records) -- with their strings in either EBCDIC or ASCII.  A
+ * decoder for every combination of layout and encoding is compiled in, and
+ * the one to use is chosen per input file:  given explicitly, or sniffed from
+ * the file's leading bytes.
+ *
+ */
+
+#ifndef __NARA_FORMAT_H__
+#define __NARA_FORMAT_H__
+
+#include "nara_base.h"
+
+/*!
+    @enum nara_layout
+
+    The record layouts.
+ */
+enum {
+    nara_layout_pre_1976 = 0,
+    nara_layout_1976,
+    nara_layout_1986,
+    nara_layout_max
+};
+
+/*!
+    @enum nara_format_string_kind
+
+    String fields hold either free text or digits (e.g. zip codes).
+ */
+enum {
+    nara_format_string_text = 0,
+    nara_format_string_digits
+};
+
+/*!
+    @typedef nara_format_field_t
+
+    Location of a fixed-width string field within a record.
+ */
+typedef struct {
+    size_t          offset;
+    size_t          length;
+    int             kind;
+} nara_format_field_t;
+
+/*!
+    @typedef nara_format_t
+
+    Opaque reference to a decoder for one layout and string encoding.
+ */
+typedef const struct nara_format* nara_format_t;
+
+/*!
+    @function nara_format_get
+
+    Returns the decoder for the given layout and encoding, or NULL if layout
+    is out of range.
+ */
+nara_format_t nara_format_get(unsigned int layout, int isEBCDIC);
+
+/*!
+    @function nara_format_default
+
+    Returns the decoder for the format chosen when the program was built
+    (NARA_DEFAULT_FORMAT).  It is used where there is nothing to detect the
+    format from (e.g. an empty input).
+ */
+nara_format_t nara_format_default(void);
+
+/*!
+    @function nara_format_parse
+
+    Parse a format specifier of the form <layout>, <encoding>,
+    <layout>:<encoding>, or "auto", where <layout> is pre-1976, 1976, or 1986
+    and <encoding> is ebcdic or ascii.  *layout and *isEBCDIC are set to -1
+    for the parts to be detected from the input.  Returns non-zero on
+    success.
+ */
+int nara_format_parse(const char *s, int *layout, int *isEBCDIC);
+
+/*!
+    @function nara_format_detect
+
+    Determine the format of an archive from its leading nBytes bytes.  The
+    layout is the one whose framing (pre-1976) or record type codes (1976,
+    1986) are consistent over the most records; totalBytes, if non-zero, is
+    the size of the whole archive, and a fixed-size layout it is not a
+    multiple of is only chosen if no other layout fits (e.g. for a truncated
+    archive).  If no layout fits at all the default format's layout is
+    used.  The encoding is whichever of EBCDIC and ASCII accounts for more
+    of the bytes in the records' string fields.  Pass a layout or isEBCDIC
+    other than -1 to fix that part.
+ */
+nara_format_t nara_format_detect(const void *bytes, size_t nBytes, uint64_t totalBytes, int layout, int isEBCDIC);
+
+/*!
+    @function nara_format_name
+
+    Returns the name of the format's layout:  "pre-1976", "1976", or "1986".
+ */
+const char* nara_format_name(nara_format_t format);
+
+/*!
+    @function nara_format_layout
+
+    Returns the format's layout (nara_layout_pre_1976 etc.).
+ */
+unsigned int nara_format_layout(nara_format_t format);
+
+/*!
+    @function nara_format_is_ebcdic
+
+    Returns non-zero if the format's strings are EBCDIC-encoded.
+ */
+int nara_format_is_ebcdic(nara_format_t format);
+
+/*!
+    @function nara_format_fixed_size
+
+    Returns the size of every record for the fixed-size layouts (1976,
+    1986) or zero for the pre-1976 layout, where each record carries its
+    own length.
+ */
+size_t nara_format_fixed_size(nara_format_t format);
+
+/*!
+    @function nara_format_record_type_offset
+
+    Returns the offset of the 32-bit record type code within a record.
+ */
+size_t nara_format_record_type_offset(nara_format_t format);
+
+/*!
+    @function nara_format_record_size
+
+    Returns the size in bytes of a record of the given type, or zero if the
+    format has no such record type.
+ */
+size_t nara_format_record_size(nara_format_t format, uint32_t recordType);
+
+/*!
+    @function nara_format_record_type_name
+
+    Returns the name of a record type in the format ("district", "school",
+    "classroom", or "summary"), or NULL if the format has no such type.
+ */
+const char* nara_format_record_type_name(nara_format_t format, uint32_t recordType);
+
+/*!
+    @function nara_format_system_code_offset
+
+    Returns the offset of the 32-bit school system code within a record of
+    the given type.
+ */
+size_t nara_format_system_code_offset(nara_format_t format, uint32_t recordType);
+
+/*!
+    @function nara_format_string_fields
+
+    Sets *fields to the string fields of a record of the given type and
+    returns their count.
+ */
+unsigned int nara_format_string_fields(nara_format_t format, uint32_t recordType, const nara_format_field_t **fields);
+
+/*!
+    @function nara_format_float_fields
+
+    Sets *offsets to the offsets of the 32-bit floating-point fields of a
+    record of the given type and returns their count.
+ */
+unsigned int nara_format_float_fields(nara_format_t format, uint32_t recordType, const size_t **offsets);
+
+#endif /* __NARA_FORMAT_H__ */
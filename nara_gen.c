@@ -0,0 +1,358 @@
+/*
+ * nara_gen
+ *
+ * Synthetic NARA data archives in any of the formats.
+ *
+ */
+
+#include "nara_gen.h"
+
+#include <stddef.h>
+
+#include "nara_state_header.h"
+#include "nara_record_header.h"
+#include "nara_ebcdic.h"
+
+/*
+ * Pre-1976 state chunks are sized randomly within this range (the length
+ * field is 16 bits):
+ */
+#define NARA_GEN_CHUNK_MIN          8192
+#define NARA_GEN_CHUNK_MAX          65532
+
+/*
+ * Words from which the text fields are assembled:
+ */
+static const char* __nara_gen_words[] = {
+        "ADAMS", "BALDWIN", "CENTRAL", "CLAY", "COUNTY", "DISTRICT", "EAST",
+        "ELEMENTARY", "FRANKLIN", "GREENE", "HIGH", "INDEPENDENT", "JACKSON",
+        "JEFFERSON", "JUNIOR", "LAKE", "LINCOLN", "MADISON", "MARION", "MIDDLE",
+        "MONROE", "NORTH", "O'BRIEN", "PARK", "PUBLIC", "RIVER", "SCHOOL",
+        "SOUTH", "ST. MARY'S", "UNIFIED", "UNION", "VALLEY", "WASHINGTON", "WEST"
+    };
+
+/**/
+
+/*
+ * SplitMix64:  small, fast, and the same sequence on every platform.
+ */
+static inline uint64_t
+__nara_gen_random(
+    uint64_t        *state
+)
+{
+    uint64_t        z = (*state += 0x9E3779B97F4A7C15ULL);
+    
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**/
+
+static inline uint32_t
+__nara_gen_random_below(
+    uint64_t        *state,
+    uint32_t        limit
+)
+{
+    return (uint32_t)(((__nara_gen_random(state) >> 32) * limit) >> 32);
+}
+
+/**/
+
+int
+nara_gen_parse_size(
+    const char      *s,
+    uint64_t        *value
+)
+{
+    char            *endPtr;
+    unsigned long long  n = strtoull(s, &endPtr, 10);
+    unsigned int    shift = 0;
+    
+    if ( endPtr == s ) return 0;
+    switch ( *endPtr ) {
+        case 'k': case 'K': shift = 10; endPtr++; break;
+        case 'm': case 'M': shift = 20; endPtr++; break;
+        case 'g': case 'G': shift = 30; endPtr++; break;
+        case 't': case 'T': shift = 40; endPtr++; break;
+    }
+    if ( *endPtr || (n > (UINT64_MAX >> shift)) ) return 0;
+    *value = (uint64_t)n << shift;
+    return 1;
+}
+
+/**/
+
+int
+nara_gen_parse_mix(
+    const char      *s,
+    nara_format_t   format,
+    uint32_t        weights[nara_record_type_max]
+)
+{
+    uint32_t        recordType, total = 0;
+    
+    weights[0] = 0;
+    for ( recordType = nara_record_type_district; recordType < nara_record_type_max; recordType++ ) {
+        char            *endPtr;
+        unsigned long   n = strtoul(s, &endPtr, 10);
+        
+        if ( (endPtr == s) || (n > 1000000) ) return 0;
+        if ( *endPtr != ((recordType + 1 < nara_record_type_max) ? ':' : '\0') ) return 0;
+        if ( n && ! nara_format_record_size(format, recordType) ) {
+            fprintf(stderr, "ERROR:  the %s format has no record type %u\n", nara_format_name(format), recordType);
+            return 0;
+        }
+        weights[recordType] = (uint32_t)n;
+        total += (uint32_t)n;
+        s = endPtr + 1;
+    }
+    return ( total > 0 );
+}
+
+/**/
+
+static uint32_t
+__nara_gen_pick_type(
+    uint64_t        *rng,
+    const uint32_t  weights[nara_record_type_max],
+    uint32_t        totalWeight
+)
+{
+    uint32_t        pick = __nara_gen_random_below(rng, totalWeight), recordType = nara_record_type_district;
+    
+    while ( pick >= weights[recordType] ) pick -= weights[recordType++];
+    return recordType;
+}
+
+/**/
+
+static inline void
+__nara_gen_put_u32(
+    uint8_t         *bytes,
+    uint32_t        value
+)
+{
+    value = nara_be_to_host_u32(value);
+    memcpy(bytes, &value, sizeof(value));
+}
+
+/**/
+
+static void
+__nara_gen_fill_string(
+    uint64_t        *rng,
+    char            *s,
+    size_t          sLen,
+    int             kind
+)
+{
+    size_t          i = 0;
+    
+    if ( kind == nara_format_string_digits ) {
+        size_t      nDigits = ( sLen > 5 ) ? 5 : sLen;
+        
+        while ( i < nDigits ) s[i++] = '0' + __nara_gen_random_below(rng, 10);
+    } else {
+        unsigned int    nWords = 1 + __nara_gen_random_below(rng, 3);
+        
+        while ( nWords-- && (i < sLen) ) {
+            const char  *word = __nara_gen_words[__nara_gen_random_below(rng, sizeof(__nara_gen_words) / sizeof(__nara_gen_words[0]))];
+            size_t      wordLen = strlen(word);
+            
+            if ( i ) s[i++] = ' ';
+            if ( wordLen > sLen - i ) wordLen = sLen - i;
+            memcpy(s + i, word, wordLen);
+            i += wordLen;
+        }
+    }
+    memset(s + i, ' ', sLen - i);
+}
+
+/**/
+
+static void
+__nara_gen_fill_record(
+    uint64_t                    *rng,
+    uint8_t                     *record,
+    nara_format_t               format,
+    uint32_t                    recordType,
+    uint32_t                    systemCode,
+    const uint8_t               *encoding
+)
+{
+    size_t                      byteSize = nara_format_record_size(format, recordType);
+    const nara_format_field_t   *strings;
+    const size_t                *floats;
+    unsigned int                nStrings = nara_format_string_fields(format, recordType, &strings);
+    unsigned int                nFloats = nara_format_float_fields(format, recordType, &floats);
+    size_t                      i;
+    
+    /*
+     * Every word gets a small count (a quarter of them zero); the fields with
+     * other meanings are then filled in over the top:
+     */
+    memset(record, 0, byteSize);
+    for ( i = 0; i + sizeof(uint32_t) <= byteSize; i += sizeof(uint32_t) ) {
+        uint64_t                r = __nara_gen_random(rng);
+        
+        if ( r & 3 ) __nara_gen_put_u32(record + i, (uint32_t)((r >> 32) % 500));
+    }
+    __nara_gen_put_u32(record + nara_format_record_type_offset(format), recordType);
+    __nara_gen_put_u32(record + nara_format_system_code_offset(format, recordType), systemCode);
+    for ( i = 0; i < nFloats; i++ ) {
+        float                   weight = 1.0f + (float)__nara_gen_random_below(rng, 4000) / 100.0f;
+        uint32_t                bits;
+        
+        memcpy(&bits, &weight, sizeof(bits));
+        __nara_gen_put_u32(record + floats[i], bits);
+    }
+    for ( i = 0; i < nStrings; i++ ) {
+        char                    *s = (char*)record + strings[i].offset;
+        size_t                  sLen = strings[i].length;
+        
+        __nara_gen_fill_string(rng, s, sLen, strings[i].kind);
+        if ( encoding ) {
+            while ( sLen-- ) {
+                *s = (char)encoding[(uint8_t)*s];
+                s++;
+            }
+        }
+    }
+}
+
+/**/
+
+/*
+ * The inverse of the EBCDIC-to-ASCII transcoder, built by transcoding every
+ * EBCDIC code point:
+ */
+static const uint8_t*
+__nara_gen_ebcdic_encoding(void)
+{
+    static uint8_t  encoding[256];
+    char            decoded[256];
+    unsigned int    i;
+    
+    for ( i = 0; i < 256; i++ ) decoded[i] = (char)i;
+    nara_ebcdic_to_ascii_field(decoded, sizeof(decoded));
+    
+    /* Walk backwards so that the lowest EBCDIC code wins for any duplicate: */
+    i = 256;
+    while ( i-- ) encoding[(uint8_t)decoded[i]] = (uint8_t)i;
+    return encoding;
+}
+
+/**/
+
+const char*
+nara_gen_default_mix(
+    nara_format_t           format
+)
+{
+    switch ( nara_format_layout(format) ) {
+        case nara_layout_1976:
+            return "1:20:0";
+        case nara_layout_1986:
+            return "1:20:1";
+    }
+    return "1:10:40";
+}
+
+/**/
+
+void
+nara_gen_options_init(
+    nara_gen_options_t      *options
+)
+{
+    memset(options, 0, sizeof(*options));
+    options->targetBytes = (uint64_t)64 << 20;
+    options->format = nara_format_default();
+    options->seed = 1;
+    nara_gen_parse_mix(nara_gen_default_mix(options->format), options->format, options->weights);
+}
+
+/**/
+
+int
+nara_gen_write(
+    nara_emitter_t              out,
+    const nara_gen_options_t    *options,
+    uint64_t                    *outRecords
+)
+{
+    uint64_t                    nBytes = 0, nRecords = 0;
+    uint64_t                    rng = options->seed;
+    uint32_t                    totalWeight = 0, recordType, systemCode = 0;
+    nara_format_t               format = options->format;
+    size_t                      fixedSize = nara_format_fixed_size(format);
+    const uint8_t               *encoding = NULL;
+    uint8_t                     *record;
+    int                         rc = 0;
+    
+    for ( recordType = nara_record_type_district; recordType < nara_record_type_max; recordType++ ) {
+        if ( options->weights[recordType] && ! nara_format_record_size(format, recordType) ) return EINVAL;
+        totalWeight += options->weights[recordType];
+    }
+    if ( totalWeight == 0 ) return EINVAL;
+    if ( nara_format_is_ebcdic(format) ) encoding = __nara_gen_ebcdic_encoding();
+    
+    record = (uint8_t*)malloc(fixedSize ? fixedSize : NARA_GEN_CHUNK_MAX);
+    if ( ! record ) {
+        fprintf(stderr, "ERROR:  unable to allocate record buffer\n");
+        return ENOMEM;
+    }
+    
+    if ( fixedSize ) {
+        /* A flat sequence of fixed-size records: */
+        while ( options->targetRecords ? (nRecords < options->targetRecords) : (nBytes < options->targetBytes) ) {
+            recordType = __nara_gen_pick_type(&rng, options->weights, totalWeight);
+            if ( recordType == nara_record_type_district ) systemCode++;
+            __nara_gen_fill_record(&rng, record, format, recordType, systemCode, encoding);
+            nara_emitter_append(out, record, fixedSize);
+            nBytes += fixedSize;
+            nRecords++;
+        }
+    } else {
+        /*
+         * State chunks, each opening with a district record (if there are any) and
+         * filled with length-prefixed records until the next record would overflow
+         * the chunk's randomly-chosen size:
+         */
+        recordType = __nara_gen_pick_type(&rng, options->weights, totalWeight);
+        while ( options->targetRecords ? (nRecords < options->targetRecords) : (nBytes < options->targetBytes) ) {
+            size_t              chunkLimit = NARA_GEN_CHUNK_MIN + __nara_gen_random_below(&rng, NARA_GEN_CHUNK_MAX - NARA_GEN_CHUNK_MIN + 1);
+            size_t              chunkLength = sizeof(nara_state_header_t);
+            
+            if ( options->weights[nara_record_type_district] ) recordType = nara_record_type_district;
+            do {
+                uint8_t         *recordHeader = record + chunkLength;
+                size_t          recordLength = sizeof(nara_record_header_t) + nara_format_record_size(format, recordType);
+                
+                if ( recordType == nara_record_type_district ) systemCode++;
+                memset(recordHeader, 0, sizeof(nara_record_header_t));
+                recordHeader[0] = (uint8_t)(recordLength >> 8);
+                recordHeader[1] = (uint8_t)recordLength;
+                __nara_gen_fill_record(&rng, recordHeader + sizeof(nara_record_header_t), format, recordType, systemCode, encoding);
+                chunkLength += recordLength;
+                nRecords++;
+                if ( options->targetRecords && (nRecords == options->targetRecords) ) break;
+                recordType = __nara_gen_pick_type(&rng, options->weights, totalWeight);
+            } while ( chunkLength + sizeof(nara_record_header_t) + nara_format_record_size(format, recordType) <= chunkLimit );
+            
+            memset(record, 0, sizeof(nara_state_header_t));
+            record[0] = (uint8_t)(chunkLength >> 8);
+            record[1] = (uint8_t)chunkLength;
+            nara_emitter_append(out, record, chunkLength);
+            nBytes += chunkLength;
+        }
+    }
+    free((void*)record);
+    
+    if ( nara_emitter_flush(out) != 0 ) rc = EIO;
+    if ( outRecords ) *outRecords = nRecords;
+    return rc;
+}
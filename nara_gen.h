@@ -0,0 +1,76 @@
+/*
+ * nara_gen
+ *
+ * Synthetic NARA data archives in any of the formats, for testing and
+ * benchmarking.  Records are framed exactly as in the real archives, numeric
+ * fields hold small big-endian counts, and string fields hold space-padded
+ * text that is EBCDIC-encoded when the format has EBCDIC strings.  The same
+ * options always produce the same bytes.
+ *
+ */
+
+#ifndef __NARA_GEN_H__
+#define __NARA_GEN_H__
+
+#include "nara_record.h"
+#include "nara_emitter.h"
+
+/*!
+    @typedef nara_gen_options_t
+
+    What to generate:  records in the given format are written until
+    targetRecords have been written or, if targetRecords is zero, until at
+    least targetBytes have been written.  Record types are chosen at random
+    in proportion to weights (indexed by record type).
+ */
+typedef struct {
+    nara_format_t   format;
+    uint64_t        targetBytes;
+    uint64_t        targetRecords;
+    uint64_t        seed;
+    uint32_t        weights[nara_record_type_max];
+} nara_gen_options_t;
+
+/*!
+    @function nara_gen_default_mix
+
+    Returns the default record-type mix for the format, in the form
+    accepted by nara_gen_parse_mix().
+ */
+const char* nara_gen_default_mix(nara_format_t format);
+
+/*!
+    @function nara_gen_options_init
+
+    Fill-in options with the defaults:  the default format (see
+    nara_format_default()), 64 MiB, seed 1, and the format's default mix.
+ */
+void nara_gen_options_init(nara_gen_options_t *options);
+
+/*!
+    @function nara_gen_parse_size
+
+    Parse a count with an optional K, M, G, or T (binary) suffix into
+    *value.  Returns non-zero on success.
+ */
+int nara_gen_parse_size(const char *s, uint64_t *value);
+
+/*!
+    @function nara_gen_parse_mix
+
+    Parse a record-type mix of the form <district>:<school>:<classroom>
+    into weights.  Returns non-zero on success; a non-zero weight for a
+    record type the format does not have is an error.
+ */
+int nara_gen_parse_mix(const char *s, nara_format_t format, uint32_t weights[nara_record_type_max]);
+
+/*!
+    @function nara_gen_write
+
+    Write a synthetic archive described by options to out.  If nRecords is
+    not NULL it is set to the number of records written.  Returns zero on
+    success.
+ */
+int nara_gen_write(nara_emitter_t out, const nara_gen_options_t *options, uint64_t *nRecords);
+
+#endif /* __NARA_GEN_H__ */
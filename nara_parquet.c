@@ -0,0 +1,1005 @@
+/*
+ * nara_parquet
+ *
+ * Apache Parquet export.
+ *
+ * A file is the magic "PAR1", the column chunks of each row group in turn, the
+ * file metadata, its length, and "PAR1" again.  A column chunk is a dictionary
+ * page (if the column is dictionary-encoded) followed by data pages:
+ *
+ *     <page> = <PageHeader> <values>
+ *
+ * The dictionary page holds the distinct values of the chunk (PLAIN); the data
+ * pages hold their indices (RLE_DICTIONARY:  a byte giving the bit width, then
+ * RLE/bit-packed hybrid runs) or, if the dictionary grew too large, the values
+ * themselves (PLAIN).  The columns are required, so there are no repetition or
+ * definition levels.  The headers and the file metadata are Thrift structures
+ * in the compact protocol; all values are little-endian.
+ *
+ */
+
+#include "nara_parquet.h"
+#include "nara_columns.h"
+#include "nara_record_impl.h"
+#include "nara_emitter.h"
+#include "nara_gen.h"
+
+#include <sys/stat.h>
+
+/*
+ * Constants from the Parquet format's parquet.thrift:
+ */
+enum {
+    nara_parquet_type_int32 = 1,
+    nara_parquet_type_float = 4,
+    nara_parquet_type_byte_array = 6,
+    nara_parquet_repetition_required = 0,
+    nara_parquet_converted_utf8 = 0,
+    nara_parquet_converted_uint_32 = 13,
+    nara_parquet_encoding_plain = 0,
+    nara_parquet_encoding_rle = 3,
+    nara_parquet_encoding_rle_dictionary = 8,
+    nara_parquet_codec_uncompressed = 0,
+    nara_parquet_page_data = 0,
+    nara_parquet_page_dictionary = 2
+};
+
+/*
+ * Thrift compact protocol field types:
+ */
+enum {
+    nara_parquet_thrift_true = 1,
+    nara_parquet_thrift_false = 2,
+    nara_parquet_thrift_byte = 3,
+    nara_parquet_thrift_i32 = 5,
+    nara_parquet_thrift_i64 = 6,
+    nara_parquet_thrift_binary = 8,
+    nara_parquet_thrift_list = 9,
+    nara_parquet_thrift_struct = 12
+};
+
+static const uint8_t __nara_parquet_magic[4] = { 'P', 'A', 'R', '1' };
+
+/*
+ * A column falls back to PLAIN encoding in a row group if its dictionary page
+ * would be larger than this:
+ */
+#define NARA_PARQUET_MAX_DICTIONARY_BYTES   (1 << 20)
+
+/*
+ * Data pages hold about this many bytes of values (before encoding):
+ */
+#define NARA_PARQUET_PAGE_BYTES             (1 << 20)
+
+/**/
+
+/*
+ * The file of one record type (its rows first, so the table can stand in for
+ * them in a flush).  The RowGroup structures for the file metadata are written
+ * as each row group is:
+ */
+typedef struct {
+    nara_columns_table_t    base;
+    nara_emitter_t          out;
+    uint64_t                fileOffset;
+    uint64_t                nRowsWritten;
+    nara_columns_buffer_t   rowGroups;
+    unsigned int            nRowGroups;
+} nara_parquet_table_t;
+
+/*
+ * The context, with scratch space for writing row groups:  the dictionary of a
+ * numeric column, its values' indices, a page, and a page header.
+ */
+typedef struct {
+    nara_export_context_base_t  base;
+    char                        *directory;
+    uint64_t                    rowGroupBytes;
+    nara_parquet_table_t        tables[nara_record_type_max];
+    nara_columns_dictionary_t   dictionary;
+    nara_columns_buffer_t       indices;
+    nara_columns_buffer_t       page;
+    nara_columns_buffer_t       header;
+} nara_export_context_parquet_t;
+
+/**/
+
+static void
+__nara_parquet_byte(
+    nara_columns_buffer_t   *t,
+    uint8_t                 value
+)
+{
+    nara_columns_buffer_append(t, &value, sizeof(value));
+}
+
+/**/
+
+static void
+__nara_parquet_varint(
+    nara_columns_buffer_t   *t,
+    uint64_t                value
+)
+{
+    uint8_t                 bytes[10];
+    unsigned int            nBytes = 0;
+    
+    while ( value >= 0x80 ) {
+        bytes[nBytes++] = (uint8_t)value | 0x80;
+        value >>= 7;
+    }
+    bytes[nBytes++] = (uint8_t)value;
+    nara_columns_buffer_append(t, bytes, nBytes);
+}
+
+/**/
+
+static void
+__nara_parquet_zigzag(
+    nara_columns_buffer_t   *t,
+    int64_t                 value
+)
+{
+    __nara_parquet_varint(t, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+/**/
+
+/*
+ * Thrift structures:  each field is preceded by its type and the difference
+ * between its id and the previous field's (*lastId), and a structure ends with
+ * a zero byte (__nara_parquet_stop()).  A nested structure starts over with a
+ * lastId of zero.
+ */
+static void
+__nara_parquet_field(
+    nara_columns_buffer_t   *t,
+    int16_t                 *lastId,
+    int16_t                 id,
+    uint8_t                 type
+)
+{
+    if ( (id > *lastId) && (id - *lastId <= 15) ) {
+        __nara_parquet_byte(t, (uint8_t)((id - *lastId) << 4) | type);
+    } else {
+        __nara_parquet_byte(t, type);
+        __nara_parquet_zigzag(t, id);
+    }
+    *lastId = id;
+}
+
+/**/
+
+static void
+__nara_parquet_i32(
+    nara_columns_buffer_t   *t,
+    int16_t                 *lastId,
+    int16_t                 id,
+    int32_t                 value
+)
+{
+    __nara_parquet_field(t, lastId, id, nara_parquet_thrift_i32);
+    __nara_parquet_zigzag(t, value);
+}
+
+/**/
+
+static void
+__nara_parquet_i64(
+    nara_columns_buffer_t   *t,
+    int16_t                 *lastId,
+    int16_t                 id,
+    int64_t                 value
+)
+{
+    __nara_parquet_field(t, lastId, id, nara_parquet_thrift_i64);
+    __nara_parquet_zigzag(t, value);
+}
+
+/**/
+
+static void
+__nara_parquet_binary(
+    nara_columns_buffer_t   *t,
+    int16_t                 *lastId,
+    int16_t                 id,
+    const void              *bytes,
+    size_t                  nBytes
+)
+{
+    __nara_parquet_field(t, lastId, id, nara_parquet_thrift_binary);
+    __nara_parquet_varint(t, nBytes);
+    nara_columns_buffer_append(t, bytes, nBytes);
+}
+
+/**/
+
+/*
+ * A list field of nElements elements of elementType, which the caller writes:
+ */
+static void
+__nara_parquet_list(
+    nara_columns_buffer_t   *t,
+    int16_t                 *lastId,
+    int16_t                 id,
+    uint8_t                 elementType,
+    uint32_t                nElements
+)
+{
+    __nara_parquet_field(t, lastId, id, nara_parquet_thrift_list);
+    if ( nElements < 15 ) {
+        __nara_parquet_byte(t, (uint8_t)(nElements << 4) | elementType);
+    } else {
+        __nara_parquet_byte(t, 0xF0 | elementType);
+        __nara_parquet_varint(t, nElements);
+    }
+}
+
+/**/
+
+static void
+__nara_parquet_stop(
+    nara_columns_buffer_t   *t
+)
+{
+    __nara_parquet_byte(t, 0);
+}
+
+/**/
+
+static void
+__nara_parquet_write(
+    nara_parquet_table_t    *table,
+    const void              *bytes,
+    size_t                  nBytes
+)
+{
+    if ( ! nBytes ) return;
+    nara_emitter_append(table->out, bytes, nBytes);
+    table->fileOffset += nBytes;
+}
+
+/**/
+
+/*
+ * Write a page:  its header, then the values in the context's page buffer.
+ * numValues is the number of values (or dictionary entries) in the page.
+ */
+static void
+__nara_parquet_write_page(
+    nara_export_context_parquet_t   *context,
+    nara_parquet_table_t            *table,
+    unsigned int                    pageType,
+    uint32_t                        numValues,
+    unsigned int                    encoding
+)
+{
+    nara_columns_buffer_t           *t = &context->header;
+    int16_t                         lastId = 0, nestedId = 0;
+    
+    /* PageHeader:  type, uncompressed_page_size, compressed_page_size, data_page_header or dictionary_page_header */
+    t->length = 0;
+    __nara_parquet_i32(t, &lastId, 1, pageType);
+    __nara_parquet_i32(t, &lastId, 2, (int32_t)context->page.length);
+    __nara_parquet_i32(t, &lastId, 3, (int32_t)context->page.length);
+    if ( pageType == nara_parquet_page_data ) {
+        /* DataPageHeader:  num_values, encoding, definition_level_encoding, repetition_level_encoding */
+        __nara_parquet_field(t, &lastId, 5, nara_parquet_thrift_struct);
+        __nara_parquet_i32(t, &nestedId, 1, numValues);
+        __nara_parquet_i32(t, &nestedId, 2, encoding);
+        __nara_parquet_i32(t, &nestedId, 3, nara_parquet_encoding_rle);
+        __nara_parquet_i32(t, &nestedId, 4, nara_parquet_encoding_rle);
+    } else {
+        /* DictionaryPageHeader:  num_values, encoding */
+        __nara_parquet_field(t, &lastId, 7, nara_parquet_thrift_struct);
+        __nara_parquet_i32(t, &nestedId, 1, numValues);
+        __nara_parquet_i32(t, &nestedId, 2, encoding);
+    }
+    __nara_parquet_stop(t);
+    __nara_parquet_stop(t);
+    if ( t->didFail || context->page.didFail || (context->page.length > INT32_MAX) ) {
+        table->base.didFail = 1;
+        return;
+    }
+    __nara_parquet_write(table, t->bytes, t->length);
+    __nara_parquet_write(table, context->page.bytes, context->page.length);
+}
+
+/**/
+
+/*
+ * PLAIN encoding of 32-bit values (in host order):
+ */
+static void
+__nara_parquet_plain_32(
+    nara_columns_buffer_t   *page,
+    const uint32_t          *values,
+    uint32_t                nValues
+)
+{
+#ifdef NARA_HOST_BIG_ENDIAN
+    while ( nValues-- ) {
+        uint32_t            value = __builtin_bswap32(*values++);
+        
+        nara_columns_buffer_append(page, &value, sizeof(value));
+    }
+#else
+    nara_columns_buffer_append(page, values, nValues * sizeof(uint32_t));
+#endif
+}
+
+/**/
+
+/*
+ * PLAIN encoding of a string:  its length (little-endian) and its bytes:
+ */
+static void
+__nara_parquet_plain_string(
+    nara_columns_buffer_t   *page,
+    const uint8_t           *bytes,
+    size_t                  nBytes
+)
+{
+    uint8_t                 length[4] = { (uint8_t)nBytes, (uint8_t)(nBytes >> 8), (uint8_t)(nBytes >> 16), (uint8_t)(nBytes >> 24) };
+    
+    nara_columns_buffer_append(page, length, sizeof(length));
+    nara_columns_buffer_append(page, bytes, nBytes);
+}
+
+/**/
+
+/*
+ * A bit-packed run of indices; unless it is the last run of the page, nValues
+ * is a multiple of 8:
+ */
+static void
+__nara_parquet_bit_packed_run(
+    nara_columns_buffer_t   *page,
+    const uint32_t          *indices,
+    uint32_t                nValues,
+    unsigned int            bitWidth
+)
+{
+    uint32_t                nGroups = (nValues + 7) / 8, i;
+    uint64_t                bits = 0;
+    unsigned int            nBits = 0;
+    
+    __nara_parquet_varint(page, ((uint64_t)nGroups << 1) | 1);
+    for ( i = 0; i < 8 * nGroups; i++ ) {
+        bits |= (uint64_t)(( i < nValues ) ? indices[i] : 0) << nBits;
+        nBits += bitWidth;
+        while ( nBits >= 8 ) {
+            __nara_parquet_byte(page, (uint8_t)bits);
+            bits >>= 8;
+            nBits -= 8;
+        }
+    }
+}
+
+/**/
+
+/*
+ * RLE_DICTIONARY encoding of indices:  the bit width, then runs of at least 8
+ * repeated indices as RLE runs and everything between them bit-packed.
+ */
+static void
+__nara_parquet_rle_dictionary(
+    nara_columns_buffer_t   *page,
+    const uint32_t          *indices,
+    uint32_t                nValues,
+    unsigned int            bitWidth
+)
+{
+    uint32_t                i = 0, literalStart = 0;
+    
+    __nara_parquet_byte(page, (uint8_t)bitWidth);
+    while ( i < nValues ) {
+        uint32_t            runEnd = i + 1, padding;
+        
+        while ( (runEnd < nValues) && (indices[runEnd] == indices[i]) ) runEnd++;
+        
+        /* The bit-packed values before a run must fill whole groups of 8, so the run lends them some: */
+        padding = (8 - (i - literalStart) % 8) % 8;
+        if ( runEnd - i >= padding + 8 ) {
+            uint32_t        index;
+            unsigned int    b;
+            
+            i += padding;
+            if ( i > literalStart ) __nara_parquet_bit_packed_run(page, indices + literalStart, i - literalStart, bitWidth);
+            __nara_parquet_varint(page, (uint64_t)(runEnd - i) << 1);
+            for ( index = indices[i], b = 0; b < bitWidth; b += 8, index >>= 8 ) __nara_parquet_byte(page, (uint8_t)index);
+            literalStart = runEnd;
+        }
+        i = runEnd;
+    }
+    if ( nValues > literalStart ) __nara_parquet_bit_packed_run(page, indices + literalStart, nValues - literalStart, bitWidth);
+}
+
+/**/
+
+/*
+ * Float statistics ignore NaNs, and a zero minimum (maximum) is written as -0.0
+ * (+0.0):
+ */
+static int
+__nara_parquet_float_bounds(
+    const float     *values,
+    uint32_t        nValues,
+    float           *minValue,
+    float           *maxValue
+)
+{
+    int             hasBounds = 0;
+    uint32_t        i;
+    
+    for ( i = 0; i < nValues; i++ ) {
+        if ( values[i] != values[i] ) continue;
+        if ( ! hasBounds || (values[i] < *minValue) ) *minValue = values[i];
+        if ( ! hasBounds || (values[i] > *maxValue) ) *maxValue = values[i];
+        hasBounds = 1;
+    }
+    if ( hasBounds && (*minValue == 0.0f) ) *minValue = -0.0f;
+    if ( hasBounds && (*maxValue == 0.0f) ) *maxValue = 0.0f;
+    return hasBounds;
+}
+
+/**/
+
+/*
+ * A 32-bit minimum or maximum (in host order) as a binary field:
+ */
+static void
+__nara_parquet_bound(
+    nara_columns_buffer_t   *t,
+    int16_t                 *lastId,
+    int16_t                 id,
+    uint32_t                value
+)
+{
+    uint8_t                 bytes[4] = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+    
+    __nara_parquet_binary(t, lastId, id, bytes, sizeof(bytes));
+}
+
+/**/
+
+/*
+ * Statistics for a column chunk:  null_count, max_value, and min_value:
+ */
+static void
+__nara_parquet_statistics(
+    nara_columns_buffer_t           *t,
+    const nara_fields_column_info_t *info,
+    const nara_columns_column_t     *column,
+    const nara_columns_dictionary_t *dictionary,
+    uint32_t                        nRows
+)
+{
+    const uint32_t                  *values = (const uint32_t*)column->values.bytes;
+    int16_t                         lastId = 0;
+    uint32_t                        i;
+    
+    __nara_parquet_i64(t, &lastId, 3, 0);
+    switch ( info->kind ) {
+        
+        case nara_fields_column_u32: {
+            uint32_t                minValue = values[0], maxValue = values[0];
+            
+            for ( i = 1; i < nRows; i++ ) {
+                if ( values[i] < minValue ) minValue = values[i];
+                if ( values[i] > maxValue ) maxValue = values[i];
+            }
+            __nara_parquet_bound(t, &lastId, 5, maxValue);
+            __nara_parquet_bound(t, &lastId, 6, minValue);
+            break;
+        }
+        
+        case nara_fields_column_float: {
+            union { float f; uint32_t u; } minValue, maxValue;
+            
+            if ( __nara_parquet_float_bounds((const float*)values, nRows, &minValue.f, &maxValue.f) ) {
+                __nara_parquet_bound(t, &lastId, 5, maxValue.u);
+                __nara_parquet_bound(t, &lastId, 6, minValue.u);
+            }
+            break;
+        }
+        
+        default: {
+            const uint8_t           *minBytes, *maxBytes;
+            size_t                  minLength, maxLength;
+            
+            /* Every string in the dictionary is in the chunk; they compare as unsigned bytes: */
+            minBytes = maxBytes = nara_columns_dictionary_entry(dictionary, 0, &minLength);
+            maxLength = minLength;
+            for ( i = 1; i < dictionary->nEntries; i++ ) {
+                size_t              length;
+                const uint8_t       *bytes = nara_columns_dictionary_entry(dictionary, i, &length);
+                int                 order = memcmp(bytes, minBytes, ( length < minLength ) ? length : minLength);
+                
+                if ( (order < 0) || ((order == 0) && (length < minLength)) ) {
+                    minBytes = bytes;
+                    minLength = length;
+                }
+                order = memcmp(bytes, maxBytes, ( length < maxLength ) ? length : maxLength);
+                if ( (order > 0) || ((order == 0) && (length > maxLength)) ) {
+                    maxBytes = bytes;
+                    maxLength = length;
+                }
+            }
+            __nara_parquet_binary(t, &lastId, 5, maxBytes, maxLength);
+            __nara_parquet_binary(t, &lastId, 6, minBytes, minLength);
+            break;
+        }
+        
+    }
+    __nara_parquet_stop(t);
+}
+
+/**/
+
+/*
+ * Write the chunk of a column in the current row group and add its ColumnChunk
+ * to the file metadata; returns its size.
+ */
+static uint64_t
+__nara_parquet_write_column(
+    nara_export_context_parquet_t   *context,
+    nara_parquet_table_t            *table,
+    unsigned int                    c
+)
+{
+    const nara_fields_column_info_t *info = &table->base.infos[c];
+    const nara_columns_column_t     *column = &table->base.columns[c];
+    const uint32_t                  *values = (const uint32_t*)column->values.bytes;
+    const uint32_t                  *indices = values;
+    const nara_columns_dictionary_t *dictionary = &column->dictionary;
+    nara_columns_buffer_t           *t = &table->rowGroups;
+    uint32_t                        nRows = table->base.nRows, pageValues, first, i;
+    uint64_t                        chunkStart = table->fileOffset, dictionaryPageOffset = 0, dataPageOffset;
+    size_t                          plainWidth = sizeof(uint32_t);
+    unsigned int                    bitWidth = 0;
+    int                             isDictionary = 1;
+    int16_t                         lastId = 0, metaId = 0;
+    
+    if ( info->kind == nara_fields_column_string ) {
+        /* The table's dictionary holds just this row group's strings: */
+        plainWidth += info->length;
+        if ( dictionary->data.length + dictionary->nEntries * sizeof(uint32_t) > NARA_PARQUET_MAX_DICTIONARY_BYTES ) isDictionary = 0;
+    } else {
+        /* Numeric values are indexed here, until there are too many distinct ones: */
+        nara_columns_dictionary_clear(&context->dictionary);
+        context->indices.length = 0;
+        for ( i = 0; (i < nRows) && isDictionary; i++ ) {
+            uint32_t                index = nara_columns_dictionary_index(&context->dictionary, (const uint8_t*)&values[i], sizeof(uint32_t));
+            
+            nara_columns_buffer_append(&context->indices, &index, sizeof(index));
+            if ( context->dictionary.data.length > NARA_PARQUET_MAX_DICTIONARY_BYTES ) isDictionary = 0;
+        }
+        if ( context->dictionary.data.didFail || context->indices.didFail ) isDictionary = 0;
+        dictionary = &context->dictionary;
+        indices = (const uint32_t*)context->indices.bytes;
+    }
+    
+    /* The dictionary page:  each distinct value, PLAIN-encoded: */
+    if ( isDictionary ) {
+        dictionaryPageOffset = table->fileOffset;
+        context->page.length = 0;
+        if ( info->kind == nara_fields_column_string ) {
+            for ( i = 0; i < dictionary->nEntries; i++ ) {
+                size_t              nBytes;
+                const uint8_t       *bytes = nara_columns_dictionary_entry(dictionary, i, &nBytes);
+                
+                __nara_parquet_plain_string(&context->page, bytes, nBytes);
+            }
+        } else {
+            __nara_parquet_plain_32(&context->page, (const uint32_t*)dictionary->data.bytes, dictionary->nEntries);
+        }
+        __nara_parquet_write_page(context, table, nara_parquet_page_dictionary, dictionary->nEntries, nara_parquet_encoding_plain);
+        while ( (dictionary->nEntries > 1) && (((dictionary->nEntries - 1) >> bitWidth) != 0) ) bitWidth++;
+    }
+    
+    /* The data pages: */
+    dataPageOffset = table->fileOffset;
+    pageValues = ( plainWidth < NARA_PARQUET_PAGE_BYTES ) ? (uint32_t)(NARA_PARQUET_PAGE_BYTES / plainWidth) : 1;
+    for ( first = 0; first < nRows; first += pageValues ) {
+        uint32_t                    nValues = ( nRows - first < pageValues ) ? nRows - first : pageValues;
+        
+        context->page.length = 0;
+        if ( isDictionary ) {
+            __nara_parquet_rle_dictionary(&context->page, indices + first, nValues, bitWidth);
+        } else if ( info->kind == nara_fields_column_string ) {
+            for ( i = first; i < first + nValues; i++ ) {
+                size_t              nBytes;
+                const uint8_t       *bytes = nara_columns_dictionary_entry(&column->dictionary, values[i], &nBytes);
+                
+                __nara_parquet_plain_string(&context->page, bytes, nBytes);
+            }
+        } else {
+            __nara_parquet_plain_32(&context->page, values + first, nValues);
+        }
+        __nara_parquet_write_page(context, table, nara_parquet_page_data, nValues, isDictionary ? nara_parquet_encoding_rle_dictionary : nara_parquet_encoding_plain);
+    }
+    
+    /* ColumnChunk:  file_offset, meta_data */
+    __nara_parquet_i64(t, &lastId, 2, chunkStart);
+    __nara_parquet_field(t, &lastId, 3, nara_parquet_thrift_struct);
+    
+    /* ColumnMetaData:  type, encodings, path_in_schema, codec, num_values, total_uncompressed_size, total_compressed_size, data_page_offset, dictionary_page_offset, statistics */
+    switch ( info->kind ) {
+        case nara_fields_column_u32:
+            __nara_parquet_i32(t, &metaId, 1, nara_parquet_type_int32);
+            break;
+        case nara_fields_column_float:
+            __nara_parquet_i32(t, &metaId, 1, nara_parquet_type_float);
+            break;
+        default:
+            __nara_parquet_i32(t, &metaId, 1, nara_parquet_type_byte_array);
+            break;
+    }
+    if ( isDictionary ) {
+        __nara_parquet_list(t, &metaId, 2, nara_parquet_thrift_i32, 2);
+        __nara_parquet_zigzag(t, nara_parquet_encoding_plain);
+        __nara_parquet_zigzag(t, nara_parquet_encoding_rle_dictionary);
+    } else {
+        __nara_parquet_list(t, &metaId, 2, nara_parquet_thrift_i32, 1);
+        __nara_parquet_zigzag(t, nara_parquet_encoding_plain);
+    }
+    __nara_parquet_list(t, &metaId, 3, nara_parquet_thrift_binary, 1);
+    __nara_parquet_varint(t, strlen(info->name));
+    nara_columns_buffer_append(t, info->name, strlen(info->name));
+    __nara_parquet_i32(t, &metaId, 4, nara_parquet_codec_uncompressed);
+    __nara_parquet_i64(t, &metaId, 5, nRows);
+    __nara_parquet_i64(t, &metaId, 6, table->fileOffset - chunkStart);
+    __nara_parquet_i64(t, &metaId, 7, table->fileOffset - chunkStart);
+    __nara_parquet_i64(t, &metaId, 9, dataPageOffset);
+    if ( isDictionary ) __nara_parquet_i64(t, &metaId, 11, dictionaryPageOffset);
+    __nara_parquet_field(t, &metaId, 12, nara_parquet_thrift_struct);
+    __nara_parquet_statistics(t, info, column, &column->dictionary, nRows);
+    __nara_parquet_stop(t);
+    __nara_parquet_stop(t);
+    return table->fileOffset - chunkStart;
+}
+
+/**/
+
+/*
+ * The flush function of a table:  write its rows as a row group.
+ */
+static void
+__nara_parquet_flush(
+    nara_columns_table_t            *columns,
+    void                            *exportContext
+)
+{
+    nara_export_context_parquet_t   *context = (nara_export_context_parquet_t*)exportContext;
+    nara_parquet_table_t            *table = (nara_parquet_table_t*)columns;
+    nara_columns_buffer_t           *t = &table->rowGroups;
+    uint64_t                        rowGroupStart = table->fileOffset, totalBytes = 0;
+    unsigned int                    c;
+    int16_t                         lastId = 0;
+    
+    if ( table->base.didFail || ! table->base.nRows ) return;
+    
+    /* RowGroup:  columns, total_byte_size, num_rows, file_offset, total_compressed_size */
+    __nara_parquet_list(t, &lastId, 1, nara_parquet_thrift_struct, table->base.nColumns);
+    for ( c = 0; c < table->base.nColumns; c++ ) totalBytes += __nara_parquet_write_column(context, table, c);
+    __nara_parquet_i64(t, &lastId, 2, totalBytes);
+    __nara_parquet_i64(t, &lastId, 3, table->base.nRows);
+    __nara_parquet_i64(t, &lastId, 5, rowGroupStart);
+    __nara_parquet_i64(t, &lastId, 6, totalBytes);
+    __nara_parquet_stop(t);
+    if ( t->didFail ) table->base.didFail = 1;
+    
+    table->nRowGroups++;
+    table->nRowsWritten += table->base.nRows;
+    nara_columns_table_clear(&table->base, 1);
+}
+
+/**/
+
+/*
+ * Finish a file:  the last row group, then the file metadata.
+ */
+static void
+__nara_parquet_finish_table(
+    nara_export_context_parquet_t   *context,
+    nara_parquet_table_t            *table,
+    const char                      *typeName
+)
+{
+    nara_columns_buffer_t           t;
+    unsigned int                    c;
+    int16_t                         lastId = 0;
+    uint8_t                         metadataLength[4];
+    
+    __nara_parquet_flush(&table->base, context);
+    if ( table->base.didFail ) {
+        fprintf(stderr, "ERROR:  Parquet file for %s records is incomplete\n", typeName);
+        return;
+    }
+    
+    /* FileMetaData:  version, schema, num_rows, row_groups, created_by, column_orders */
+    memset(&t, 0, sizeof(t));
+    __nara_parquet_i32(&t, &lastId, 1, 1);
+    __nara_parquet_list(&t, &lastId, 2, nara_parquet_thrift_struct, table->base.nColumns + 1);
+    {
+        int16_t                     elementId = 0;
+        
+        /* The root SchemaElement:  name, num_children */
+        __nara_parquet_binary(&t, &elementId, 4, "schema", 6);
+        __nara_parquet_i32(&t, &elementId, 5, table->base.nColumns);
+        __nara_parquet_stop(&t);
+    }
+    for ( c = 0; c < table->base.nColumns; c++ ) {
+        const nara_fields_column_info_t *info = &table->base.infos[c];
+        int16_t                     elementId = 0, logicalId = 0, typeId = 0;
+        
+        /* SchemaElement:  type, repetition_type, name, converted_type, logicalType */
+        switch ( info->kind ) {
+            
+            case nara_fields_column_u32:
+                __nara_parquet_i32(&t, &elementId, 1, nara_parquet_type_int32);
+                __nara_parquet_i32(&t, &elementId, 3, nara_parquet_repetition_required);
+                __nara_parquet_binary(&t, &elementId, 4, info->name, strlen(info->name));
+                __nara_parquet_i32(&t, &elementId, 6, nara_parquet_converted_uint_32);
+                /* LogicalType.INTEGER:  bitWidth, isSigned */
+                __nara_parquet_field(&t, &elementId, 10, nara_parquet_thrift_struct);
+                __nara_parquet_field(&t, &logicalId, 10, nara_parquet_thrift_struct);
+                __nara_parquet_field(&t, &typeId, 1, nara_parquet_thrift_byte);
+                __nara_parquet_byte(&t, 32);
+                __nara_parquet_field(&t, &typeId, 2, nara_parquet_thrift_false);
+                __nara_parquet_stop(&t);
+                __nara_parquet_stop(&t);
+                break;
+            
+            case nara_fields_column_float:
+                __nara_parquet_i32(&t, &elementId, 1, nara_parquet_type_float);
+                __nara_parquet_i32(&t, &elementId, 3, nara_parquet_repetition_required);
+                __nara_parquet_binary(&t, &elementId, 4, info->name, strlen(info->name));
+                break;
+            
+            default:
+                __nara_parquet_i32(&t, &elementId, 1, nara_parquet_type_byte_array);
+                __nara_parquet_i32(&t, &elementId, 3, nara_parquet_repetition_required);
+                __nara_parquet_binary(&t, &elementId, 4, info->name, strlen(info->name));
+                __nara_parquet_i32(&t, &elementId, 6, nara_parquet_converted_utf8);
+                /* LogicalType.STRING */
+                __nara_parquet_field(&t, &elementId, 10, nara_parquet_thrift_struct);
+                __nara_parquet_field(&t, &logicalId, 1, nara_parquet_thrift_struct);
+                __nara_parquet_stop(&t);
+                __nara_parquet_stop(&t);
+                break;
+            
+        }
+        __nara_parquet_stop(&t);
+    }
+    __nara_parquet_i64(&t, &lastId, 3, table->nRowsWritten);
+    __nara_parquet_list(&t, &lastId, 4, nara_parquet_thrift_struct, table->nRowGroups);
+    nara_columns_buffer_append(&t, table->rowGroups.bytes, table->rowGroups.length);
+    __nara_parquet_binary(&t, &lastId, 6, "nara-to-yaml", 12);
+    
+    /* Each ColumnOrder is TYPE_ORDER, so the statistics of unsigned integers and strings are usable: */
+    __nara_parquet_list(&t, &lastId, 7, nara_parquet_thrift_struct, table->base.nColumns);
+    for ( c = 0; c < table->base.nColumns; c++ ) {
+        int16_t                     orderId = 0;
+        
+        __nara_parquet_field(&t, &orderId, 1, nara_parquet_thrift_struct);
+        __nara_parquet_stop(&t);
+        __nara_parquet_stop(&t);
+    }
+    __nara_parquet_stop(&t);
+    
+    if ( t.didFail ) {
+        fprintf(stderr, "ERROR:  Parquet file for %s records is incomplete\n", typeName);
+    } else {
+        metadataLength[0] = (uint8_t)t.length;
+        metadataLength[1] = (uint8_t)(t.length >> 8);
+        metadataLength[2] = (uint8_t)(t.length >> 16);
+        metadataLength[3] = (uint8_t)(t.length >> 24);
+        __nara_parquet_write(table, t.bytes, t.length);
+        __nara_parquet_write(table, metadataLength, sizeof(metadataLength));
+        __nara_parquet_write(table, __nara_parquet_magic, sizeof(__nara_parquet_magic));
+    }
+    nara_columns_buffer_free(&t);
+}
+
+/**/
+
+nara_export_context_t
+nara_parquet_export_init(
+    const char                      *exportArgs
+)
+{
+    nara_export_context_parquet_t   *context = (nara_export_context_parquet_t*)calloc(1, sizeof(nara_export_context_parquet_t));
+    const char                      *colon = strrchr(exportArgs, ':');
+    uint64_t                        rowGroupBytes = NARA_PARQUET_DEFAULT_ROW_GROUP_BYTES;
+    
+    if ( ! context ) {
+        fprintf(stderr, "ERROR:  unable to allocate export context\n");
+        return NULL;
+    }
+    
+    /* A trailing :<row-group-size>: */
+    if ( colon && isdigit((unsigned char)colon[1]) ) {
+        if ( ! nara_gen_parse_size(colon + 1, &rowGroupBytes) || (rowGroupBytes == 0) ) {
+            fprintf(stderr, "ERROR:  invalid Parquet row group size: %s\n", colon + 1);
+            free((void*)context);
+            return NULL;
+        }
+    } else {
+        colon = exportArgs + strlen(exportArgs);
+    }
+    if ( (colon == exportArgs) || ! (context->directory = strndup(exportArgs, colon - exportArgs)) ) {
+        fprintf(stderr, ( colon == exportArgs ) ? "ERROR:  no directory in Parquet output specifier\n" : "ERROR:  unable to allocate export context\n");
+        free((void*)context);
+        return NULL;
+    }
+    if ( (mkdir(context->directory, 0777) != 0) && (errno != EEXIST) ) {
+        fprintf(stderr, "ERROR:  unable to create Parquet output directory %s (errno = %d)\n", context->directory, errno);
+        free((void*)context->directory);
+        free((void*)context);
+        return NULL;
+    }
+    context->base.format = nara_export_format_parquet;
+    context->base.recordFormat = NULL;
+    context->rowGroupBytes = rowGroupBytes;
+    return context;
+}
+
+/**/
+
+/*
+ * Create the file for a record type; a row group holds as many rows as fit in
+ * the row group size with every value PLAIN-encoded:
+ */
+static int
+__nara_parquet_open_table(
+    nara_export_context_parquet_t   *context,
+    nara_parquet_table_t            *table,
+    const char                      *typeName
+)
+{
+    size_t                          pathLen = strlen(context->directory) + strlen(typeName) + 10;
+    char                            *path = (char*)malloc(pathLen);
+    uint64_t                        rowBytes = 0, rowGroupRows;
+    unsigned int                    c;
+    
+    if ( ! path ) {
+        fprintf(stderr, "ERROR:  unable to allocate Parquet table\n");
+        return ENOMEM;
+    }
+    snprintf(path, pathLen, "%s/%s.parquet", context->directory, typeName);
+    table->out = nara_emitter_open(path);
+    if ( ! table->out ) {
+        fprintf(stderr, "ERROR:  unable to open Parquet file %s for output (errno = %d)\n", path, errno);
+        free((void*)path);
+        return EIO;
+    }
+    free((void*)path);
+    
+    for ( c = 0; c < table->base.nColumns; c++ ) {
+        rowBytes += sizeof(uint32_t);
+        if ( table->base.infos[c].kind == nara_fields_column_string ) rowBytes += table->base.infos[c].length;
+    }
+    rowGroupRows = context->rowGroupBytes / rowBytes;
+    table->base.flushRows = ( rowGroupRows < 1 ) ? 1 : (( rowGroupRows > INT32_MAX ) ? INT32_MAX : (uint32_t)rowGroupRows);
+    table->base.flushFn = __nara_parquet_flush;
+    table->base.flushContext = context;
+    
+    __nara_parquet_write(table, __nara_parquet_magic, sizeof(__nara_parquet_magic));
+    return 0;
+}
+
+/**/
+
+int
+nara_parquet_export_bind(
+    nara_export_context_t           exportContext,
+    nara_format_t                   format
+)
+{
+    nara_export_context_parquet_t   *context = (nara_export_context_parquet_t*)exportContext;
+    nara_format_t                   oldFormat = context->base.recordFormat;
+    uint32_t                        t;
+    int                             rc;
+    
+    /* The columns are fixed by the first layout seen: */
+    if ( oldFormat && (oldFormat->layout != format->layout) ) {
+        fprintf(stderr, "ERROR:  cannot write %s records to Parquet files that hold %s records\n", format->name, oldFormat->name);
+        return EINVAL;
+    }
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        if ( ! format->recordTypes[t].byteSize || (format->skippedTypes & (1u << t)) ) continue;
+        if ( (rc = nara_columns_table_bind(&context->tables[t].base, format, t, "Parquet")) != 0 ) return rc;
+        if ( ! oldFormat && ((rc = __nara_parquet_open_table(context, &context->tables[t], format->recordTypes[t].name)) != 0) ) return rc;
+    }
+    context->base.recordFormat = format;
+    return 0;
+}
+
+/**/
+
+void
+nara_parquet_export(
+    nara_export_context_t           exportContext,
+    uint32_t                        recordType,
+    const nara_record_t             *theRecord
+)
+{
+    nara_columns_table_add(&((nara_export_context_parquet_t*)exportContext)->tables[recordType].base, theRecord);
+}
+
+/**/
+
+nara_export_context_t
+nara_parquet_export_fork(
+    nara_export_context_t           exportContext
+)
+{
+    nara_export_context_parquet_t   *context = (nara_export_context_parquet_t*)exportContext;
+    nara_export_context_parquet_t   *fork = (nara_export_context_parquet_t*)calloc(1, sizeof(nara_export_context_parquet_t));
+    uint32_t                        t;
+    
+    if ( ! fork ) return NULL;
+    fork->base = context->base;
+    fork->rowGroupBytes = context->rowGroupBytes;
+    
+    /* The forked tables borrow the parent's columns and are never flushed: */
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        if ( nara_columns_table_fork(&fork->tables[t].base, &context->tables[t].base) != 0 ) {
+            nara_parquet_export_join(exportContext, fork, 0);
+            return NULL;
+        }
+    }
+    return fork;
+}
+
+/**/
+
+void
+nara_parquet_export_join(
+    nara_export_context_t           exportContext,
+    nara_export_context_t           forkedContext,
+    int                             shouldWrite
+)
+{
+    nara_export_context_parquet_t   *context = (nara_export_context_parquet_t*)exportContext;
+    nara_export_context_parquet_t   *fork = (nara_export_context_parquet_t*)forkedContext;
+    uint32_t                        t;
+    
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        if ( shouldWrite ) nara_columns_table_join(&context->tables[t].base, &fork->tables[t].base);
+        nara_columns_table_destroy(&fork->tables[t].base);
+    }
+    free((void*)fork);
+}
+
+/**/
+
+int
+nara_parquet_export_destroy(
+    nara_export_context_t           exportContext
+)
+{
+    nara_export_context_parquet_t   *context = (nara_export_context_parquet_t*)exportContext;
+    uint32_t                        t;
+    int                             rc = 0;
+    
+    for ( t = 1; t < nara_record_type_max; t++ ) {
+        nara_parquet_table_t        *table = &context->tables[t];
+        
+        if ( table->out ) {
+            __nara_parquet_finish_table(context, table, context->base.recordFormat->recordTypes[t].name);
+            if ( nara_emitter_close(table->out) || table->base.didFail ) rc = EIO;
+        }
+        nara_columns_table_destroy(&table->base);
+        nara_columns_buffer_free(&table->rowGroups);
+    }
+    nara_columns_dictionary_free(&context->dictionary);
+    nara_columns_buffer_free(&context->indices);
+    nara_columns_buffer_free(&context->page);
+    nara_columns_buffer_free(&context->header);
+    free((void*)context->directory);
+    free((void*)context);
+    return rc;
+}
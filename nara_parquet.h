@@ -0,0 +1,86 @@
+/*
+ * nara_parquet
+ *
+ * Apache Parquet export.  Each record type is written to its own file in an
+ * output directory, named for the type (district.parquet, school.parquet, and
+ * classroom.parquet or summary.parquet).
+ *
+ * A file has a required column per CSV column of its record type:  integers are
+ * INT32 (unsigned 32-bit), floating-point fields FLOAT, and strings BYTE_ARRAY
+ * (UTF-8).  Records are gathered into row groups of about a given size (before
+ * encoding), so a row group can be matched to the block size of a cluster
+ * filesystem.  Within a row group each column is dictionary-encoded -- the
+ * distinct values once, then their indices as RLE/bit-packed runs -- unless its
+ * dictionary would be too large, and carries its minimum and maximum values.
+ * The pages are not compressed.
+ *
+ * The Parquet metadata (Thrift compact protocol) is written directly; no
+ * Parquet library is needed.  The columns are found with nara_fields_columns().
+ *
+ */
+
+#ifndef __NARA_PARQUET_H__
+#define __NARA_PARQUET_H__
+
+#include "nara_base.h"
+#include "nara_record.h"
+
+/*!
+    @defined NARA_PARQUET_DEFAULT_ROW_GROUP_BYTES
+
+    The size of a row group (column data before encoding) if the output
+    specifier does not say.
+ */
+#define NARA_PARQUET_DEFAULT_ROW_GROUP_BYTES    (128 << 20)
+
+/*!
+    @function nara_parquet_export_init
+
+    Create a Parquet export context from the arguments of an output specifier,
+    <directory>{:<row-group-size>} (the size may have a K, M, or G suffix);
+    the directory is created if necessary.  The files are created when the
+    context is bound to a format.  Returns NULL (after reporting why) on error.
+ */
+nara_export_context_t nara_parquet_export_init(const char *exportArgs);
+
+/*!
+    @function nara_parquet_export_bind
+
+    Bind the context to a format (see nara_export_bind()):  the first time,
+    create the files; afterwards the format must have the same columns.
+    Returns zero on success.
+ */
+int nara_parquet_export_bind(nara_export_context_t exportContext, nara_format_t format);
+
+/*!
+    @function nara_parquet_export
+
+    Add a record of the given type as a row of its file.
+ */
+void nara_parquet_export(nara_export_context_t exportContext, uint32_t recordType, const nara_record_t *theRecord);
+
+/*!
+    @function nara_parquet_export_fork
+
+    Create a copy of the context whose rows are kept in memory (see
+    nara_export_fork()).
+ */
+nara_export_context_t nara_parquet_export_fork(nara_export_context_t exportContext);
+
+/*!
+    @function nara_parquet_export_join
+
+    Append the rows of a forked context to the context's files (if shouldWrite
+    is non-zero) and dispose of the fork.
+ */
+void nara_parquet_export_join(nara_export_context_t exportContext, nara_export_context_t forkedContext, int shouldWrite);
+
+/*!
+    @function nara_parquet_export_destroy
+
+    Write the last row group and the footer of each file, then dispose of the
+    context.  Returns zero if every file was written completely.
+ */
+int nara_parquet_export_destroy(nara_export_context_t exportContext);
+
+#endif /* __NARA_PARQUET_H__ */
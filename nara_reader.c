@@ -0,0 +1,674 @@
+/*
+ * nara_reader
+ *
+ * Input source for a NARA data archive.  Regular files are memory-mapped
+ * and the framing and record data are walked directly over the mapped bytes;
+ * anything that cannot be mapped (stdin, pipes, etc.) falls back to reading
+ * through a stdio FILE stream.  Compressed input (see nara_compression) is read
+ * from a decompressor fed by the mapped file or the stream, and a member of an
+ * archive (see nara_archive) from a window on the mapped archive, a
+ * decompressor fed by it, or a stream limited to the member's bytes.
+ *
+ */
+
+#include "nara_reader.h"
+#include "nara_stats.h"
+#include "nara_format.h"
+#include "nara_compression.h"
+#include "nara_archive.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef HAVE_SYS_MMAN_H
+#   include <sys/mman.h>
+#endif
+
+/*
+ * Mapped pages that have been byte-swapped in-place are given back to the
+ * system in batches of at least this many bytes:
+ */
+#define NARA_READER_DISCARD_BATCH   (64 * 1024 * 1024)
+
+/*
+ * The format of an input source is detected from (at most) this many leading
+ * bytes:
+ */
+#define NARA_READER_DETECT_BYTES    (64 * 1024)
+
+struct nara_reader {
+    FILE            *fptr;
+    int             shouldFClose;
+    
+    struct nara_reader  *parent;
+    uint64_t            parentOffset;
+    
+    unsigned char   *mapBase;
+    uint64_t        mapLength;
+    uint64_t        offset;
+    uint64_t        discardOffset;
+    
+    void            *scratch;
+    size_t          scratchLength;
+    
+    nara_record_pool_t  pool;
+    
+    nara_format_t   format;
+    
+    /* Bytes read ahead from a stdio stream by nara_reader_peek(): */
+    unsigned char   *peek;
+    size_t          peekLength;
+    size_t          peekOffset;
+    int             peekHitEOF;
+    
+    /* Compressed input is decompressed from the (mapped) file or the stream: */
+    nara_decompressor_t decompressor;
+    uint64_t            streamOffset;
+    
+    /* A stream limited to an archive member has this many bytes left: */
+    int                 hasLimit;
+    uint64_t            streamRemaining;
+    
+    /* The whole mapped file (the input may be a window on it, or none of it): */
+    unsigned char       *fileBase;
+    uint64_t            fileLength;
+};
+
+/**/
+
+static int
+__nara_reader_map(
+    struct nara_reader  *reader
+)
+{
+#ifdef HAVE_SYS_MMAN_H
+    struct stat         finfo;
+    int                 fd = fileno(reader->fptr);
+    void                *mapBase;
+    
+    if ( (fd < 0) || (fstat(fd, &finfo) != 0) || ! S_ISREG(finfo.st_mode) || (finfo.st_size <= 0) ) return 0;
+    
+    /* Only map a stream that has not been read from yet: */
+    if ( ftello(reader->fptr) != 0 ) return 0;
+    
+    /*
+     * Private + writable:  records are byte-swapped and transcoded in-place
+     * without the changes ever reaching the file.
+     */
+    mapBase = mmap(NULL, (size_t)finfo.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if ( mapBase == MAP_FAILED ) return 0;
+
+#ifdef MADV_SEQUENTIAL
+    madvise(mapBase, (size_t)finfo.st_size, MADV_SEQUENTIAL);
+#endif
+#ifdef MADV_HUGEPAGE
+    madvise(mapBase, (size_t)finfo.st_size, MADV_HUGEPAGE);
+#endif
+    
+    reader->fileBase = reader->mapBase = (unsigned char*)mapBase;
+    reader->fileLength = reader->mapLength = (uint64_t)finfo.st_size;
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/**/
+
+static void
+__nara_reader_discard_range(
+    struct nara_reader  *reader,
+    uint64_t            offset
+)
+{
+#if defined(HAVE_SYS_MMAN_H) && defined(MADV_DONTNEED)
+    uintptr_t           pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t           startAddr = (uintptr_t)(reader->mapBase + reader->discardOffset);
+    uintptr_t           endAddr = (uintptr_t)(reader->mapBase + offset);
+    
+    /*
+     * Only whole pages can be discarded; rounding inward also keeps a slice from
+     * touching pages it shares with its neighbors:
+     */
+    startAddr = ((startAddr + pageSize - 1) / pageSize) * pageSize;
+    endAddr = (endAddr / pageSize) * pageSize;
+    if ( endAddr > startAddr ) {
+        madvise((void*)startAddr, (size_t)(endAddr - startAddr), MADV_DONTNEED);
+        reader->discardOffset = (uint64_t)((unsigned char*)endAddr - reader->mapBase);
+    }
+#endif
+}
+
+/**/
+
+/*
+ * If the input is compressed, read it through a decompressor from now on (a
+ * mapped file stays mapped for the decompressor, but is not the input any
+ * longer, and input already read through a decompressor is decompressed in
+ * turn).  Returns zero if the input cannot be decompressed:
+ */
+static int
+__nara_reader_decompress(
+    struct nara_reader  *reader
+)
+{
+    size_t              nBytes;
+    const void          *bytes = nara_reader_peek(reader, NARA_COMPRESSION_MAGIC_BYTES, &nBytes);
+    nara_compression_t  compression = nara_compression_detect(bytes, nBytes);
+    
+    if ( compression == nara_compression_none ) return 1;
+    if ( reader->mapBase ) {
+        reader->decompressor = nara_decompressor_open(compression, reader->mapBase, (size_t)reader->mapLength, NULL);
+        reader->mapBase = NULL;
+        reader->mapLength = 0;
+    } else if ( reader->decompressor ) {
+        /* The peeked bytes were decompressed, the nested decompressor takes them (and the decompressor) over: */
+        nara_decompressor_t nested = nara_decompressor_open_nested(compression, reader->peek, reader->peekLength, reader->decompressor);
+        
+        if ( ! nested ) return 0;
+        reader->decompressor = nested;
+        reader->peekLength = reader->peekOffset = 0;
+        reader->peekHitEOF = 0;
+        reader->streamOffset = 0;
+    } else {
+        /* The peeked bytes were compressed, the decompressor takes them over: */
+        reader->decompressor = nara_decompressor_open(compression, reader->peek, reader->peekLength, reader->fptr);
+        reader->peekLength = reader->peekOffset = 0;
+        reader->peekHitEOF = 0;
+    }
+    return ( reader->decompressor != NULL );
+}
+
+/**/
+
+/*
+ * Read up to nBytes from the stream (or its decompressor) into buffer, stopping
+ * at the end of a member:
+ */
+static size_t
+__nara_reader_fill(
+    struct nara_reader  *reader,
+    void                *buffer,
+    size_t              nBytes
+)
+{
+    if ( reader->hasLimit && (nBytes > reader->streamRemaining) ) nBytes = (size_t)reader->streamRemaining;
+    if ( reader->decompressor ) nBytes = nara_decompressor_read(reader->decompressor, buffer, nBytes);
+    else nBytes = fread(buffer, 1, nBytes, reader->fptr);
+    reader->streamOffset += nBytes;
+    if ( reader->hasLimit ) reader->streamRemaining -= nBytes;
+    return nBytes;
+}
+
+/**/
+
+nara_reader_t
+nara_reader_open_fptr(
+    FILE        *fptr,
+    int         shouldFClose
+)
+{
+    struct nara_reader  *reader = (struct nara_reader*)malloc(sizeof(struct nara_reader));
+    
+    if ( reader ) {
+        memset(reader, 0, sizeof(*reader));
+        reader->fptr = fptr;
+        reader->shouldFClose = shouldFClose;
+        if ( __nara_reader_map(reader) ) {
+            /* The mapping holds its own reference to the file: */
+            if ( shouldFClose ) fclose(fptr);
+            reader->fptr = NULL;
+        }
+        if ( ! __nara_reader_decompress(reader) ) {
+            nara_reader_close(reader);
+            reader = NULL;
+        }
+    } else {
+        fprintf(stderr, "ERROR:  unable to allocate reader\n");
+        if ( shouldFClose ) fclose(fptr);
+    }
+    return reader;
+}
+
+/**/
+
+nara_reader_t
+nara_reader_open(
+    const char  *path
+)
+{
+    FILE        *fptr;
+    
+    if ( strcmp(path, "-") == 0 ) return nara_reader_open_fptr(stdin, 0);
+    
+    fptr = fopen(path, "r");
+    if ( ! fptr ) {
+        /* A path that does not exist may name an archive member, <archive>#<member>: */
+        if ( (errno == ENOENT) && strchr(path, '#') ) return nara_archive_open(path);
+        return NULL;
+    }
+    return nara_reader_open_fptr(fptr, 1);
+}
+
+/**/
+
+nara_reader_t
+nara_reader_slice(
+    nara_reader_t   reader,
+    uint64_t        offset,
+    uint64_t        length
+)
+{
+    struct nara_reader  *slice;
+    
+    if ( ! reader->mapBase || (offset > reader->mapLength) || (length > reader->mapLength - offset) ) return NULL;
+    
+    slice = (struct nara_reader*)malloc(sizeof(struct nara_reader));
+    if ( slice ) {
+        memset(slice, 0, sizeof(*slice));
+        slice->parent = reader;
+        slice->parentOffset = reader->parentOffset + offset;
+        slice->mapBase = reader->mapBase + offset;
+        slice->mapLength = length;
+        slice->format = reader->format;
+    } else {
+        fprintf(stderr, "ERROR:  unable to allocate reader\n");
+    }
+    return slice;
+}
+
+/**/
+
+void
+nara_reader_close(
+    nara_reader_t   reader
+)
+{
+    if ( reader ) {
+        /* The decompressor may be reading the mapping or the stream: */
+        if ( reader->decompressor ) nara_decompressor_close(reader->decompressor);
+#ifdef HAVE_SYS_MMAN_H
+        if ( reader->parent ) {
+            /* Give the slice's pages back now that it's done: */
+            __nara_reader_discard_range(reader, reader->mapLength);
+        }
+        else if ( reader->fileBase ) munmap((void*)reader->fileBase, (size_t)reader->fileLength);
+#endif
+        if ( reader->fptr && reader->shouldFClose ) fclose(reader->fptr);
+        if ( reader->scratch ) free(reader->scratch);
+        if ( reader->pool ) {
+            nara_record_pool_stats_t    poolStats;
+            
+            nara_record_pool_get_stats(reader->pool, &poolStats);
+            nara_stats_add_record_buffers(poolStats.allocations, poolStats.heapAllocations);
+            nara_record_pool_destroy(reader->pool);
+        }
+        if ( reader->peek ) free((void*)reader->peek);
+        free((void*)reader);
+    }
+}
+
+/**/
+
+int
+nara_reader_is_mapped(
+    nara_reader_t   reader
+)
+{
+    return ( reader->mapBase != NULL );
+}
+
+/**/
+
+FILE*
+nara_reader_fptr(
+    nara_reader_t   reader
+)
+{
+    return ( reader->decompressor || reader->hasLimit ) ? NULL : reader->fptr;
+}
+
+/**/
+
+int
+nara_reader_eof(
+    nara_reader_t   reader
+)
+{
+    if ( reader->mapBase ) return ( reader->offset >= reader->mapLength );
+    if ( reader->peekOffset < reader->peekLength ) return 0;
+    
+    /* A member ends only once all of its bytes have been read (the archive may be cut short): */
+    if ( reader->hasLimit ) return ( reader->streamRemaining == 0 );
+    if ( reader->decompressor ) return nara_decompressor_eof(reader->decompressor);
+    return ( reader->peekHitEOF || feof(reader->fptr) );
+}
+
+/**/
+
+uint64_t
+nara_reader_offset(
+    nara_reader_t   reader
+)
+{
+    if ( reader->mapBase ) return reader->offset;
+    if ( reader->decompressor || reader->hasLimit ) return reader->streamOffset - (reader->peekLength - reader->peekOffset);
+    return (uint64_t)ftello(reader->fptr) - (reader->peekLength - reader->peekOffset);
+}
+
+/**/
+
+uint64_t
+nara_reader_file_offset(
+    nara_reader_t   reader
+)
+{
+    return reader->parentOffset + nara_reader_offset(reader);
+}
+
+/**/
+
+uint64_t
+nara_reader_length(
+    nara_reader_t   reader
+)
+{
+    return reader->mapLength;
+}
+
+/**/
+
+const void*
+nara_reader_peek(
+    nara_reader_t   reader,
+    size_t          nBytes,
+    size_t          *nBytesAvail
+)
+{
+    if ( reader->mapBase ) {
+        uint64_t    remaining = reader->mapLength - reader->offset;
+        
+        *nBytesAvail = ( nBytes > remaining ) ? (size_t)remaining : nBytes;
+        return reader->mapBase + reader->offset;
+    }
+    
+    /* Top up the read-ahead buffer (only ever from the start of the stream, or once it has all been read): */
+    if ( (reader->peekOffset == reader->peekLength) && ! reader->peekHitEOF ) reader->peekOffset = reader->peekLength = 0;
+    if ( (reader->peekOffset == 0) && (reader->peekLength < nBytes) && ! reader->peekHitEOF ) {
+        unsigned char   *newPeek = (unsigned char*)realloc(reader->peek, nBytes);
+        
+        if ( newPeek ) {
+            reader->peek = newPeek;
+            reader->peekLength += __nara_reader_fill(reader, newPeek + reader->peekLength, nBytes - reader->peekLength);
+            if ( reader->peekLength < nBytes ) reader->peekHitEOF = 1;
+        }
+    }
+    *nBytesAvail = reader->peekLength - reader->peekOffset;
+    if ( *nBytesAvail > nBytes ) *nBytesAvail = nBytes;
+    return reader->peek ? (reader->peek + reader->peekOffset) : NULL;
+}
+
+/**/
+
+void
+nara_reader_set_format(
+    nara_reader_t   reader,
+    nara_format_t   format
+)
+{
+    reader->format = format;
+}
+
+/**/
+
+nara_format_t
+nara_reader_format(
+    nara_reader_t   reader
+)
+{
+    return reader->format ? reader->format : nara_format_default();
+}
+
+/**/
+
+nara_format_t
+nara_reader_detect_format(
+    nara_reader_t   reader,
+    int             layout,
+    int             isEBCDIC
+)
+{
+    size_t          nBytes;
+    const void      *bytes = nara_reader_peek(reader, NARA_READER_DETECT_BYTES, &nBytes);
+    uint64_t        totalBytes = 0;
+    
+    /* The whole size is known for a mapped file, or a stream that fit in the sample: */
+    if ( reader->mapBase ) totalBytes = reader->mapLength - reader->offset;
+    else if ( reader->peekHitEOF ) totalBytes = nBytes;
+    
+    reader->format = nara_format_detect(bytes, nBytes, totalBytes, layout, isEBCDIC);
+    return reader->format;
+}
+
+/**/
+
+const void*
+nara_reader_bytes(
+    nara_reader_t   reader,
+    uint64_t        offset,
+    size_t          nBytes
+)
+{
+    if ( ! reader->mapBase || (offset > reader->mapLength) || (nBytes > reader->mapLength - offset) ) return NULL;
+    return reader->mapBase + offset;
+}
+
+/**/
+
+size_t
+nara_reader_read(
+    nara_reader_t   reader,
+    void            *buffer,
+    size_t          nBytes
+)
+{
+    if ( reader->mapBase ) {
+        uint64_t    remaining = reader->mapLength - reader->offset;
+        
+        if ( nBytes > remaining ) nBytes = (size_t)remaining;
+        memcpy(buffer, reader->mapBase + reader->offset, nBytes);
+        reader->offset += nBytes;
+    } else {
+        size_t      nPeeked = reader->peekLength - reader->peekOffset;
+        
+        /* Anything read ahead by nara_reader_peek() comes first: */
+        if ( nPeeked ) {
+            if ( nPeeked > nBytes ) nPeeked = nBytes;
+            memcpy(buffer, reader->peek + reader->peekOffset, nPeeked);
+            reader->peekOffset += nPeeked;
+        }
+        if ( nBytes > nPeeked ) nBytes = nPeeked + __nara_reader_fill(reader, (unsigned char*)buffer + nPeeked, nBytes - nPeeked);
+        else nBytes = nPeeked;
+    }
+    nara_stats_add_bytes(nBytes);
+    return nBytes;
+}
+
+/**/
+
+void*
+nara_reader_next(
+    nara_reader_t   reader,
+    size_t          nBytes,
+    size_t          *nBytesAvail
+)
+{
+    void            *outPtr = NULL;
+    
+    if ( reader->mapBase ) {
+        uint64_t    remaining = reader->mapLength - reader->offset;
+        
+        if ( nBytes > remaining ) {
+            if ( nBytesAvail ) *nBytesAvail = (size_t)remaining;
+            reader->offset = reader->mapLength;
+            nara_stats_add_bytes(remaining);
+        } else {
+            if ( nBytesAvail ) *nBytesAvail = nBytes;
+            outPtr = reader->mapBase + reader->offset;
+            reader->offset += nBytes;
+            nara_stats_add_bytes(nBytes);
+        }
+    } else if ( nBytesAvail ) {
+        *nBytesAvail = 0;
+    }
+    return outPtr;
+}
+
+/**/
+
+int
+nara_reader_owns(
+    nara_reader_t   reader,
+    const void      *ptr
+)
+{
+    const unsigned char *PTR = (const unsigned char*)ptr;
+    
+    if ( reader->mapBase && (PTR >= reader->mapBase) && (PTR < reader->mapBase + reader->mapLength) ) return 1;
+    return ( reader->scratch && (ptr == reader->scratch) );
+}
+
+/**/
+
+void*
+nara_reader_scratch(
+    nara_reader_t   reader,
+    size_t          nBytes
+)
+{
+    if ( nBytes > reader->scratchLength ) {
+        void        *newScratch = realloc(reader->scratch, nBytes);
+        
+        if ( ! newScratch ) return NULL;
+        reader->scratch = newScratch;
+        reader->scratchLength = nBytes;
+    }
+    return reader->scratch;
+}
+
+/**/
+
+nara_record_pool_t
+nara_reader_pool(
+    nara_reader_t   reader
+)
+{
+    if ( ! reader->pool ) reader->pool = nara_record_pool_create();
+    return reader->pool;
+}
+
+/**/
+
+void
+nara_reader_discard(
+    nara_reader_t   reader,
+    uint64_t        offset
+)
+{
+    if ( reader->mapBase && (offset > reader->discardOffset + NARA_READER_DISCARD_BATCH) ) __nara_reader_discard_range(reader, offset);
+}
+
+/**/
+
+uint64_t
+nara_reader_skip(
+    nara_reader_t   reader,
+    uint64_t        nBytes
+)
+{
+    uint64_t        nSkipped = 0;
+    
+    if ( reader->mapBase ) {
+        uint64_t    remaining = reader->mapLength - reader->offset;
+        
+        nSkipped = ( nBytes > remaining ) ? remaining : nBytes;
+        reader->offset += nSkipped;
+        return nSkipped;
+    }
+    
+    /* A stream's bytes are read and dropped: */
+    while ( nSkipped < nBytes ) {
+        size_t      nPeeked = reader->peekLength - reader->peekOffset, nRead;
+        
+        if ( nPeeked ) {
+            if ( nPeeked > nBytes - nSkipped ) nPeeked = (size_t)(nBytes - nSkipped);
+            reader->peekOffset += nPeeked;
+            nSkipped += nPeeked;
+            continue;
+        }
+        if ( ! reader->scratch && ! nara_reader_scratch(reader, NARA_READER_DETECT_BYTES) ) break;
+        nRead = ( nBytes - nSkipped > reader->scratchLength ) ? reader->scratchLength : (size_t)(nBytes - nSkipped);
+        nRead = __nara_reader_fill(reader, reader->scratch, nRead);
+        if ( nRead == 0 ) break;
+        nSkipped += nRead;
+    }
+    return nSkipped;
+}
+
+/**/
+
+int
+nara_reader_limit(
+    nara_reader_t   reader,
+    uint64_t        length
+)
+{
+    size_t          nPeeked = reader->peekLength - reader->peekOffset;
+    
+    if ( reader->mapBase ) {
+        if ( length > reader->mapLength - reader->offset ) return EINVAL;
+        reader->mapBase += reader->offset;
+        reader->mapLength = length;
+        reader->offset = reader->discardOffset = 0;
+        
+        /* The member may itself be compressed: */
+        return __nara_reader_decompress(reader) ? 0 : ENOTSUP;
+    }
+    
+    /*
+     * Whatever had been read ahead is the start of the member (and is kept as if
+     * just peeked, so the member's format can still be detected):
+     */
+    if ( nPeeked > length ) nPeeked = (size_t)length;
+    if ( nPeeked ) memmove(reader->peek, reader->peek + reader->peekOffset, nPeeked);
+    reader->peekLength = nPeeked;
+    reader->peekOffset = 0;
+    reader->peekHitEOF = 0;
+    reader->hasLimit = 1;
+    reader->streamRemaining = length - nPeeked;
+    reader->streamOffset = nPeeked;
+    return 0;
+}
+
+/**/
+
+int
+nara_reader_decompress(
+    nara_reader_t       reader,
+    nara_compression_t  compression,
+    uint64_t            length
+)
+{
+    if ( ! reader->mapBase || (length > reader->mapLength - reader->offset) ) return EINVAL;
+    reader->decompressor = nara_decompressor_open(compression, reader->mapBase + reader->offset, (size_t)length, NULL);
+    if ( ! reader->decompressor ) return errno ? errno : ENOMEM;
+    reader->mapBase = NULL;
+    reader->mapLength = reader->offset = reader->discardOffset = 0;
+    reader->peekLength = reader->peekOffset = 0;
+    reader->peekHitEOF = 0;
+    reader->streamOffset = 0;
+    
+    /* The member may itself be compressed: */
+    return __nara_reader_decompress(reader) ? 0 : ENOTSUP;
+}
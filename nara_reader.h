@@ -0,0 +1,259 @@
+/*
+ * nara_reader
+ *
+ * Input source for a NARA data archive.  Regular files are memory-mapped
+ * and the framing and record data are walked directly over the mapped bytes;
+ * anything that cannot be mapped (stdin, pipes, etc.) falls back to reading
+ * through a stdio FILE stream.  Input compressed with gzip, zstd, or xz is
+ * recognized by its magic bytes and decompressed as it is read (see
+ * nara_compression); it is read like a stream.  A member of a zip or tar
+ * archive is read in place from the mapped archive if it is stored, through
+ * a decompressor if it is not (see nara_archive).
+ *
+ */
+
+#ifndef __NARA_READER_H__
+#define __NARA_READER_H__
+
+#include "nara_base.h"
+#include "nara_record_pool.h"
+#include "nara_format.h"
+#include "nara_compression.h"
+
+/*!
+    @typedef nara_reader_t
+
+    Opaque reference to an input source.
+ */
+typedef struct nara_reader * nara_reader_t;
+
+/*!
+    @function nara_reader_open
+
+    Open the file at path for reading.  A path of "-" reads from stdin.
+    The file is memory-mapped if possible, otherwise the stdio stream
+    is used.  A compressed file is decompressed as it is read.  A path that
+    does not exist but has the form <archive>#<member> opens a member of a
+    zip or tar archive (see nara_archive_open()).
+
+    Returns NULL if the file could not be opened (or is compressed in a
+    format this build cannot decompress).
+ */
+nara_reader_t nara_reader_open(const char *path);
+
+/*!
+    @function nara_reader_open_fptr
+
+    Wrap an already-open stdio stream.  The stream is memory-mapped if
+    it refers to a regular file and is positioned at its start.  If
+    shouldFClose is non-zero the stream is closed by nara_reader_close().
+ */
+nara_reader_t nara_reader_open_fptr(FILE *fptr, int shouldFClose);
+
+/*!
+    @function nara_reader_slice
+
+    For a memory-mapped input source, returns a new reader over the byte
+    range [offset, offset + length) of the parent's mapping with its own
+    read position, pool, and scratch buffer.  Slices of the same parent
+    can be used concurrently from different threads.  The parent must
+    outlive the slice.  Closing the slice discards its pages (see
+    nara_reader_discard()).
+
+    Returns NULL for a stdio input source or an out-of-range request.
+ */
+nara_reader_t nara_reader_slice(nara_reader_t reader, uint64_t offset, uint64_t length);
+
+/*!
+    @function nara_reader_close
+
+    Unmap/close the input source and dispose of the reader.
+ */
+void nara_reader_close(nara_reader_t reader);
+
+/*!
+    @function nara_reader_is_mapped
+
+    Returns non-zero if the input source is memory-mapped.
+ */
+int nara_reader_is_mapped(nara_reader_t reader);
+
+/*!
+    @function nara_reader_fptr
+
+    Returns the stdio stream underlying the reader, or NULL if the
+    input source is memory-mapped, compressed, or an archive member.
+ */
+FILE* nara_reader_fptr(nara_reader_t reader);
+
+/*!
+    @function nara_reader_eof
+
+    Returns non-zero once all bytes of the input source have been
+    consumed (mapped) or the stream has hit end-of-file (stdio).
+ */
+int nara_reader_eof(nara_reader_t reader);
+
+/*!
+    @function nara_reader_offset
+
+    Returns the byte offset of the next read in the input source (for a
+    slice, relative to the start of the slice).
+ */
+uint64_t nara_reader_offset(nara_reader_t reader);
+
+/*!
+    @function nara_reader_file_offset
+
+    Returns the byte offset of the next read relative to the start of the
+    file (e.g. for error messages).
+ */
+uint64_t nara_reader_file_offset(nara_reader_t reader);
+
+/*!
+    @function nara_reader_length
+
+    Returns the size in bytes of a memory-mapped input source (0 for a
+    stdio input source).
+ */
+uint64_t nara_reader_length(nara_reader_t reader);
+
+/*!
+    @function nara_reader_peek
+
+    Returns a pointer to (up to) the next nBytes of the input source without
+    moving the read position; *nBytesAvail is set to the number available,
+    which is less than nBytes only at the end of the input.  For a stdio
+    input source the bytes are read ahead into a buffer that subsequent
+    reads consume first; peeking is only possible before anything has been
+    read, or once everything peeked at has been read.
+ */
+const void* nara_reader_peek(nara_reader_t reader, size_t nBytes, size_t *nBytesAvail);
+
+/*!
+    @function nara_reader_set_format
+
+    Set the format in which the input source's records are read.  Slices
+    take the format of their parent.
+ */
+void nara_reader_set_format(nara_reader_t reader, nara_format_t format);
+
+/*!
+    @function nara_reader_format
+
+    Returns the format in which the input source's records are read:  the
+    one set or detected, else the default format.
+ */
+nara_format_t nara_reader_format(nara_reader_t reader);
+
+/*!
+    @function nara_reader_detect_format
+
+    Detect the format of the input source from its leading bytes (see
+    nara_format_detect(); layout and isEBCDIC of -1 are detected, other
+    values are used as given) and make it the reader's format.  Must be
+    called before anything is read.
+ */
+nara_format_t nara_reader_detect_format(nara_reader_t reader, int layout, int isEBCDIC);
+
+/*!
+    @function nara_reader_bytes
+
+    For a memory-mapped input source, returns a pointer to the nBytes at
+    offset without moving the read position, or NULL if the range extends
+    beyond the end of the mapping.  Always returns NULL for a stdio input
+    source.
+ */
+const void* nara_reader_bytes(nara_reader_t reader, uint64_t offset, size_t nBytes);
+
+/*!
+    @function nara_reader_read
+
+    Copy up to nBytes from the input source into buffer and advance past
+    them.  Returns the number of bytes copied.
+ */
+size_t nara_reader_read(nara_reader_t reader, void *buffer, size_t nBytes);
+
+/*!
+    @function nara_reader_next
+
+    For a memory-mapped input source, returns a pointer to the next nBytes
+    of the mapping and advances past them.  The mapping is private and
+    writable, so the bytes may be modified in-place (e.g. byte-swapped)
+    without affecting the file.  If fewer than nBytes remain, *nBytesAvail
+    is set to the number remaining, the reader is advanced to end-of-file,
+    and NULL is returned.
+
+    Always returns NULL for a stdio input source.
+ */
+void* nara_reader_next(nara_reader_t reader, size_t nBytes, size_t *nBytesAvail);
+
+/*!
+    @function nara_reader_owns
+
+    Returns non-zero if ptr points into the reader's mapping or scratch
+    storage, i.e. memory that is managed by the reader rather than the
+    heap.
+ */
+int nara_reader_owns(nara_reader_t reader, const void *ptr);
+
+/*!
+    @function nara_reader_scratch
+
+    Returns a reader-owned buffer suitably aligned for a record of nBytes.
+    The buffer is reused by the next call.
+ */
+void* nara_reader_scratch(nara_reader_t reader, size_t nBytes);
+
+/*!
+    @function nara_reader_pool
+
+    Returns the record pool owned by the reader, creating it on first use.
+    Records read through a stdio input source are allocated from (and
+    released back to) this pool.
+ */
+nara_record_pool_t nara_reader_pool(nara_reader_t reader);
+
+/*!
+    @function nara_reader_discard
+
+    Hint that the caller is finished with all mapped bytes before offset.
+    Since records are byte-swapped in-place, each page touched becomes a
+    private copy; discarding returns those pages to the system in large
+    batches so memory use does not grow with the size of the file.  No
+    pointers into the discarded range may be used afterwards.
+ */
+void nara_reader_discard(nara_reader_t reader, uint64_t offset);
+
+/*!
+    @function nara_reader_skip
+
+    Advance past (up to) nBytes of the input source without reading them
+    into anything (a stream's bytes are read and dropped); they are not
+    counted by nara_stats.  Returns the number of bytes skipped.
+ */
+uint64_t nara_reader_skip(nara_reader_t reader, uint64_t nBytes);
+
+/*!
+    @function nara_reader_limit
+
+    Restrict the input source to the next length bytes (e.g. the data of an
+    archive member).  A memory-mapped source becomes the window [offset,
+    offset + length) of its mapping, with offsets relative to its start,
+    and is decompressed if its contents are compressed; a stream ends after
+    length more bytes.  Must be called before anything has been peeked at
+    beyond the end of the window.  Returns zero on success.
+ */
+int nara_reader_limit(nara_reader_t reader, uint64_t length);
+
+/*!
+    @function nara_reader_decompress
+
+    For a memory-mapped input source, read the next length bytes (data in
+    the given compression format) through a decompressor from now on, and
+    what they decompress to through another if it is compressed in turn;
+    the reader is then read like a stream.  Returns zero on success.
+ */
+int nara_reader_decompress(nara_reader_t reader, nara_compression_t compression, uint64_t length);
+
+#endif /* __NARA_READER_H__ */
@@ -16,61 +16,97 @@
 
 #include "nara_record.h"
 #include "nara_record_impl.h"
+#include "nara_stats.h"
+#include "nara_record_header.h"
+#include "nara_arrow.h"
+#include "nara_parquet.h"
+#include "nara_cache.h"
 
-#if defined(NARA_1986_FORMAT)
-#   define NARA_1986_RECORD_SLOTS   700
-#   define NARA_1986_RECORD_SIZE    (sizeof(uint32_t) * NARA_1986_RECORD_SLOTS) + 1
-#   include "1986/nara_summary_impl.c"
-#   include "1986/nara_school_impl.c"
-#   include "1986/nara_district_impl.c"
-#elif defined(NARA_1976_FORMAT)
-#   define NARA_1976_RECORD_SLOTS   872
-#   define NARA_1976_RECORD_SIZE    (sizeof(uint32_t) * NARA_1976_RECORD_SLOTS)
-#   include "1976/nara_classroom_impl.c"
-#   include "1976/nara_school_impl.c"
-#   include "1976/nara_district_impl.c"
-#else
-#   include "pre-1976/nara_classroom_impl.c"
-#   include "pre-1976/nara_school_impl.c"
-#   include "pre-1976/nara_district_impl.c"
+#ifdef HAVE_PTHREADS
+#   include <pthread.h>
 #endif
 
-nara_record_is_type_fn      __nara_record_is_type_fns[nara_record_type_max] = {
-                                NULL,
-                                __nara_record_is_type_district,
-                                __nara_record_is_type_school,
-                                __nara_record_is_type_classroom
-                            };
-nara_record_process_fn      __nara_record_process_fns[nara_record_type_max] = {
-                                NULL,
-                                __nara_record_process_district,
-                                __nara_record_process_school,
-                                __nara_record_process_classroom
-                            };
-nara_export_init_fn         __nara_export_init_fns[nara_record_type_max] = {
-                                NULL,
-                                __nara_export_init_district,
-                                __nara_export_init_school,
-                                __nara_export_init_classroom
-                            };
-nara_record_export_fn       __nara_record_export_fns[nara_record_type_max] = {
-                                NULL,
-                                __nara_record_export_district,
-                                __nara_record_export_school,
-                                __nara_record_export_classroom
-                            };
-nara_export_destroy_fn      __nara_export_destroy_fns[nara_record_type_max] = {
-                                NULL,
-                                __nara_export_destroy_district,
-                                __nara_export_destroy_school,
-                                __nara_export_destroy_classroom
-                            };
-nara_record_destroy_fn      __nara_record_destroy_fns[nara_record_type_max] = {
-                                NULL,
-                                __nara_record_destroy_district,
-                                __nara_record_destroy_school,
-                                __nara_record_destroy_classroom
-                            };
+static uint32_t __nara_record_filtered_placeholder;
+
+nara_record_t * const nara_record_filtered = (nara_record_t*)&__nara_record_filtered_placeholder;
+
+/*
+ * Records read by nara_record_read() are recycled through a pool of the reading
+ * thread's own (which lives until the process exits):
+ */
+static __thread nara_record_pool_t __nara_record_read_pool = NULL;
+
+/**/
+
+static nara_record_t*
+__nara_record_process(
+    nara_format_t   format,
+    nara_record_t   *theRecord,
+    uint32_t        recordType
+)
+{
+    int             previousStage = nara_stats_enter(nara_stats_stage_process);
+    
+    nara_stats_add_record(format->recordTypes[recordType].statsCounter);
+    if ( (format->skippedTypes & (1u << recordType)) || (format->filterFn && ! format->filterFn(format, recordType, theRecord)) ) {
+        nara_stats_leave(previousStage);
+        return nara_record_filtered;
+    }
+    theRecord = format->processFns[recordType](theRecord);
+    nara_stats_leave(previousStage);
+    return theRecord;
+}
+
+/**/
+
+static nara_record_t*
+__nara_record_classify(
+    nara_format_t   format,
+    nara_record_t   *theRecord,
+    size_t          recordSize,
+    uint64_t        offset
+)
+{
+    uint32_t        recordType = __nara_format_classify(format, theRecord, recordSize);
+    
+    if ( ! recordType ) {
+        fprintf(stderr, "ERROR:  unknown record type at %lld\n", (long long int)offset);
+        return NULL;
+    }
+    return __nara_record_process(format, theRecord, recordType);
+}
+
+/**/
+
+static size_t
+__nara_record_size(
+    nara_format_t   format,
+    size_t          recordSize
+)
+{
+    return format->fixedSize ? format->fixedSize : recordSize;
+}
+
+/**/
+
+/*
+ * Check that a record of recordSize bytes was read in full (bytesRead of them);
+ * offset is the file offset just past it:
+ */
+static int
+__nara_record_check_read(
+    size_t          recordSize,
+    size_t          bytesRead,
+    uint64_t        offset
+)
+{
+    if ( bytesRead == 0 ) return 0;
+    if ( bytesRead < recordSize ) {
+        fprintf(stderr, "ERROR:  unable to read full record from file at %lld (expected %lld, got %lld, errno = %d)\n", (long long int)offset, (long long int)recordSize, (long long int)bytesRead, errno);
+        return 0;
+    }
+    return 1;
+}
 
 /**/
 
@@ -80,44 +116,314 @@ nara_record_read(
     size_t  recordSize
 )
 {
+    nara_format_t   format = nara_format_default();
     nara_record_t   *newRecord = NULL;
-    size_t          bytesRead;
+    void            *buffer;
     
     if ( feof(fptr) ) return NULL;
+    
+    recordSize = __nara_record_size(format, recordSize);
+    if ( ! __nara_record_read_pool ) __nara_record_read_pool = nara_record_pool_create();
+    buffer = __nara_record_read_pool ? nara_record_pool_alloc(__nara_record_read_pool, recordSize) : NULL;
+    if ( buffer ) {
+        int         previousStage = nara_stats_enter(nara_stats_stage_read);
+        size_t      bytesRead = fread(buffer, 1, recordSize, fptr);
+        uint64_t    offset = (uint64_t)ftell(fptr);
+        
+        nara_stats_add_bytes(bytesRead);
+        nara_stats_leave(previousStage);
+        if ( __nara_record_check_read(recordSize, bytesRead, offset) ) newRecord = __nara_record_classify(format, (nara_record_t*)buffer, recordSize, offset);
+        if ( ! newRecord || (newRecord == nara_record_filtered) ) nara_record_pool_free(__nara_record_read_pool, buffer);
+    } else {
+        fprintf(stderr, "ERROR:  unable to allocate record buffer\n");
+    }
+    return newRecord;
+}
 
-#if defined(NARA_1986_FORMAT)
-    recordSize = NARA_1986_RECORD_SIZE;
-#elif defined(NARA_1976_FORMAT)
-    recordSize = NARA_1976_RECORD_SIZE;
-#endif
-    newRecord = (nara_record_t*)malloc(recordSize);
-    if ( newRecord ) {
-        bytesRead = fread(newRecord, 1, recordSize, fptr);
-        if ( bytesRead == 0 ) {
-            free((void*)newRecord);
-            newRecord = NULL;
+/**/
+
+/*
+ * Read the next recordSize bytes from the reader, without processing them:
+ */
+static nara_record_t*
+__nara_record_fetch(
+    nara_reader_t   reader,
+    size_t          recordSize
+)
+{
+    nara_record_t   *newRecord;
+    size_t          bytesAvail;
+    int             previousStage;
+    
+    if ( ! nara_reader_is_mapped(reader) ) {
+        /*
+         * Records read via stdio are recycled through the reader's pool rather
+         * than being malloc'ed/free'd each time:
+         */
+        nara_record_pool_t  pool = nara_reader_pool(reader);
+        void                *buffer = pool ? nara_record_pool_alloc(pool, recordSize) : NULL;
+        
+        if ( ! buffer ) {
+            fprintf(stderr, "ERROR:  unable to allocate record buffer\n");
+            return NULL;
         }
-        else if ( bytesRead < recordSize ) {
-            fprintf(stderr, "ERROR:  unable to read full record from file at %lld (expected %lld, got %lld, errno = %d)\n", (long long int)ftell(fptr), (long long int)recordSize, (long long int)bytesRead, errno);
-            free((void*)newRecord);
-            newRecord = NULL;
-        } else {
-            uint32_t        recordType = 0;
+        previousStage = nara_stats_enter(nara_stats_stage_read);
+        bytesAvail = nara_reader_read(reader, buffer, recordSize);
+        nara_stats_leave(previousStage);
+        if ( ! __nara_record_check_read(recordSize, bytesAvail, nara_reader_file_offset(reader)) ) {
+            nara_record_pool_free(pool, buffer);
+            return NULL;
+        }
+        return (nara_record_t*)buffer;
+    }
+    
+    previousStage = nara_stats_enter(nara_stats_stage_read);
+    newRecord = (nara_record_t*)nara_reader_next(reader, recordSize, &bytesAvail);
+    if ( ! newRecord ) {
+        nara_stats_leave(previousStage);
+        fprintf(stderr, "ERROR:  unable to read full record from file at %lld (expected %lld, got %lld)\n", (long long int)nara_reader_file_offset(reader), (long long int)recordSize, (long long int)bytesAvail);
+        return NULL;
+    }
+    
+    /*
+     * The record is processed in-place in the (private) mapping.  Records whose
+     * offset does not suit the alignment of their integer fields (e.g. the odd-sized
+     * 1986 records) are first copied to the reader's scratch buffer:
+     */
+    if ( ((uintptr_t)newRecord % sizeof(uint32_t)) != 0 ) {
+        void        *scratch = nara_reader_scratch(reader, recordSize);
+        
+        if ( ! scratch ) {
+            nara_stats_leave(previousStage);
+            fprintf(stderr, "ERROR:  unable to allocate record buffer\n");
+            return NULL;
+        }
+        newRecord = (nara_record_t*)memcpy(scratch, newRecord, recordSize);
+    }
+    nara_stats_leave(previousStage);
+    return newRecord;
+}
+
+/**/
+
+/*
+ * Pass over the next record, of a type the format skips, in a memory-mapped
+ * reader:  nothing of it is copied, processed, or even touched beyond its type:
+ */
+static nara_record_t*
+__nara_record_skip(
+    nara_reader_t   reader,
+    nara_format_t   format,
+    size_t          recordSize,
+    uint32_t        recordType
+)
+{
+    size_t          bytesAvail;
+    
+    if ( ! nara_reader_next(reader, recordSize, &bytesAvail) ) {
+        fprintf(stderr, "ERROR:  unable to read full record from file at %lld (expected %lld, got %lld)\n", (long long int)nara_reader_file_offset(reader), (long long int)recordSize, (long long int)bytesAvail);
+        return NULL;
+    }
+    nara_stats_add_record(format->recordTypes[recordType].statsCounter);
+    return nara_record_filtered;
+}
+
+/**/
+
+nara_record_t*
+nara_record_next(
+    nara_reader_t   reader,
+    size_t          recordSize
+)
+{
+    nara_format_t   format = nara_reader_format(reader);
+    nara_record_t   *rawRecord, *newRecord;
+    
+    if ( nara_reader_eof(reader) ) return NULL;
+    
+    recordSize = __nara_record_size(format, recordSize);
+    if ( format->skippedTypes && nara_reader_is_mapped(reader) ) {
+        const void  *bytes = nara_reader_bytes(reader, nara_reader_offset(reader), recordSize);
+        uint32_t    recordType = bytes ? __nara_format_classify(format, bytes, recordSize) : 0;
+        
+        if ( format->skippedTypes & (1u << recordType) ) return __nara_record_skip(reader, format, recordSize, recordType);
+    }
+    if ( ! (rawRecord = __nara_record_fetch(reader, recordSize)) ) return NULL;
+    newRecord = __nara_record_classify(format, rawRecord, recordSize, nara_reader_file_offset(reader));
+    if ( ! newRecord || (newRecord == nara_record_filtered) ) nara_record_release(reader, rawRecord);
+    return newRecord;
+}
+
+/**/
+
+nara_record_t*
+nara_record_next_typed(
+    nara_reader_t   reader,
+    size_t          recordSize,
+    uint32_t        recordType
+)
+{
+    nara_format_t   format = nara_reader_format(reader);
+    nara_record_t   *rawRecord, *newRecord;
+    
+    if ( nara_reader_eof(reader) ) return NULL;
+    
+    recordSize = __nara_record_size(format, recordSize);
+    if ( (format->skippedTypes & (1u << recordType)) && nara_reader_is_mapped(reader) ) return __nara_record_skip(reader, format, recordSize, recordType);
+    if ( ! (rawRecord = __nara_record_fetch(reader, recordSize)) ) return NULL;
+    if ( (newRecord = __nara_record_process(format, rawRecord, recordType)) == nara_record_filtered ) nara_record_release(reader, rawRecord);
+    return newRecord;
+}
+
+/**/
+
+unsigned int
+nara_record_classify_chunk(
+    nara_reader_t   reader,
+    size_t          chunkLength,
+    uint8_t         *recordTypes,
+    unsigned int    maxRecords
+)
+{
+    nara_format_t   format = nara_reader_format(reader);
+    const uint8_t   *chunk = (const uint8_t*)nara_reader_bytes(reader, nara_reader_offset(reader), chunkLength);
+    size_t          offset = 0;
+    unsigned int    nRecords = 0;
+    int             previousStage;
+    
+    if ( ! chunk || format->fixedSize ) return 0;
+    
+    /*
+     * Walk the record headers; any record that is cut short, overruns the chunk,
+     * or is not of a known type (and size) spoils the whole chunk:
+     */
+    previousStage = nara_stats_enter(nara_stats_stage_process);
+    while ( offset < chunkLength ) {
+        nara_record_header_t    recordHeader;
+        size_t                  recordLength;
+        
+        if ( (nRecords == maxRecords) || (chunkLength - offset < sizeof(recordHeader) + sizeof(uint32_t)) ) break;
+        memcpy(&recordHeader, chunk + offset, sizeof(recordHeader));
+        recordLength = nara_be_to_host_u16(recordHeader.recordLength);
+        if ( (recordLength <= sizeof(recordHeader)) || (recordLength > chunkLength - offset) ) break;
+        if ( ! (recordTypes[nRecords] = (uint8_t)__nara_format_classify(format, chunk + offset + sizeof(recordHeader), recordLength - sizeof(recordHeader))) ) break;
+        offset += recordLength;
+        nRecords++;
+    }
+    nara_stats_leave(previousStage);
+    return ( offset == chunkLength ) ? nRecords : 0;
+}
+
+/**/
+
+unsigned int
+nara_record_classify_records(
+    nara_reader_t   reader,
+    uint8_t         *recordTypes,
+    unsigned int    maxRecords
+)
+{
+    nara_format_t   format = nara_reader_format(reader);
+    size_t          recordSize = format->fixedSize;
+    uint64_t        offset = nara_reader_offset(reader), length = nara_reader_length(reader);
+    const uint8_t   *records;
+    unsigned int    nRecords = 0;
+    int             previousStage;
+    
+    if ( ! recordSize || (offset >= length) ) return 0;
+    if ( (length - offset) / recordSize < maxRecords ) maxRecords = (unsigned int)((length - offset) / recordSize);
+    if ( ! (records = (const uint8_t*)nara_reader_bytes(reader, offset, maxRecords * recordSize)) ) return 0;
+    
+    previousStage = nara_stats_enter(nara_stats_stage_process);
+    while ( nRecords < maxRecords ) {
+        if ( ! (recordTypes[nRecords] = (uint8_t)__nara_format_classify(format, records, recordSize)) ) break;
+        records += recordSize;
+        nRecords++;
+    }
+    nara_stats_leave(previousStage);
+    return nRecords;
+}
+
+/**/
+
+nara_record_t*
+nara_record_release(
+    nara_reader_t   reader,
+    nara_record_t   *theRecord
+)
+{
+    if ( theRecord && ! nara_reader_owns(reader, theRecord) ) nara_record_pool_free(nara_reader_pool(reader), (void*)theRecord);
+    return NULL;
+}
+
+/**/
+
+/*
+ * Options may follow the filename(s) of a YAML or CSV output specifier:
+ *
+ *   :compress=<gzip|zstd|none>     compress every file, whatever its suffix
+ *   :level=<N>                     the compression level
+ *
+ * They are removed from the end of spec; *compression is left at
+ * nara_compression_max (choose by suffix) and *level at -1 (the default) if
+ * not given.  Returns zero if an option is invalid:
+ */
+static int
+__nara_export_parse_options(
+    char                *spec,
+    nara_compression_t  *compression,
+    int                 *level
+)
+{
+    char                *colon;
+    
+    *compression = nara_compression_max;
+    *level = -1;
+    while ( (colon = strrchr(spec, ':')) ) {
+        const char      *option = colon + 1;
+        
+        if ( strncasecmp(option, "compress=", 9) == 0 ) {
+            nara_compression_t  optCompression = nara_compression_parse(option + 9);
             
-            while ( recordType < nara_record_type_max ) {
-                if ( __nara_record_is_type_fns[recordType] && __nara_record_is_type_fns[recordType](newRecord, recordSize) ) break;
-                recordType++;
+            if ( optCompression == nara_compression_max ) {
+                fprintf(stderr, "ERROR:  invalid compression in output specifier: %s\n", option + 9);
+                return 0;
             }
-            if ( recordType == nara_record_type_max ) {
-                fprintf(stderr, "ERROR:  unknown record type at %lld\n", (long long int)ftell(fptr));
-                free((void*)newRecord);
-                newRecord = NULL;
-            } else {
-                newRecord = __nara_record_process_fns[recordType](newRecord);
+            if ( *compression == nara_compression_max ) *compression = optCompression;
+        }
+        else if ( strncasecmp(option, "level=", 6) == 0 ) {
+            char        *end;
+            long        optLevel = strtol(option + 6, &end, 10);
+            
+            if ( (end == option + 6) || *end || (optLevel < 0) || (optLevel > 99) ) {
+                fprintf(stderr, "ERROR:  invalid compression level in output specifier: %s\n", option + 6);
+                return 0;
             }
+            if ( *level < 0 ) *level = (int)optLevel;
         }
+        else {
+            break;
+        }
+        *colon = '\0';
     }
-    return newRecord;
+    return 1;
+}
+
+/**/
+
+/*
+ * Open an output file of a YAML or CSV export context, compressed as the
+ * options say or else as its suffix implies:
+ */
+static nara_emitter_t
+__nara_export_open(
+    const char          *path,
+    nara_compression_t  compression,
+    int                 level
+)
+{
+    if ( compression == nara_compression_max ) compression = nara_compression_from_path(path);
+    return nara_emitter_open_compressed(path, compression, level);
 }
 
 /**/
@@ -139,35 +445,47 @@ nara_export_init(
             /*
              * Specifier format:
              *
-             *   yaml:<filename>
+             *   yaml:<filename>{:<option>..}
              *
-             * where <filename> of "-" implies stdout
+             * where <filename> of "-" implies stdout (see nara_emitter_open())
+             * and the options select compression (see __nara_export_parse_options())
              */
             nara_export_context_yaml_t  *context;
-            FILE            *fptr;
+            nara_emitter_t  out;
+            char            *filename = strdup(p);
+            nara_compression_t  compression;
+            int             level;
             
-            if ( *p == '\0' ) {
-                fptr = NULL;
+            if ( ! filename ) {
+                fprintf(stderr, "ERROR:  unable to duplicate filename in YAML export init\n");
+                goto early_exit;
+            }
+            if ( ! __nara_export_parse_options(filename, &compression, &level) ) {
+                free((void*)filename);
+                goto early_exit;
             }
-            else if ( strcmp(p, "-") == 0 ) {
-                fptr = stdout;
+            if ( *filename == '\0' ) {
+                out = NULL;
             }
             else {
-                fptr = fopen(p, "w");
-                if ( ! fptr ) {
+                out = __nara_export_open(filename, compression, level);
+                if ( ! out ) {
+                    free((void*)filename);
                     fprintf(stderr, "ERROR:  unable to open YAML file for output (errno = %d)\n", errno);
                     goto early_exit;
                 }
             }
+            free((void*)filename);
             context = (nara_export_context_yaml_t*)malloc(sizeof(nara_export_context_yaml_t));
-    
+            
             if ( context ) {
                 context->base.format = nara_export_format_yaml;
-                context->fptr = fptr;
-            
+                context->base.recordFormat = NULL;
+                context->out = out;
+                
                 outContext = context;
             } else {
-                if ( fptr != stdout ) fclose(fptr);
+                nara_emitter_close(out);
                 fprintf(stderr, "ERROR:  unable to allocate export context\n");
             }
         }
@@ -175,21 +493,28 @@ nara_export_init(
             /*
              * Specifier format:
              *
-             *   csv:<district-filename>:<school-filename>:<classroom-filename>
+             *   csv:<district-filename>:<school-filename>:<classroom-filename>{:<option>..}
              *
              * where <XXX-filename> of "-" implies stdout and "" does not output that
-             * type of record
+             * type of record, and the options select compression (see
+             * __nara_export_parse_options())
              */
             nara_export_context_csv_t  *context;
             
-            FILE            *districtFptr, *schoolFptr, *classroomFptr;
+            nara_emitter_t  districtOut, schoolOut, classroomOut;
             char            *filenames = strdup(p), *scanStr;
             char            *token;
+            nara_compression_t  compression;
+            int             level;
             
             if ( ! filenames ) {
                 fprintf(stderr, "ERROR:  unable to duplicate filename list in CSV export init\n");
                 goto early_exit;
             }
+            if ( ! __nara_export_parse_options(filenames, &compression, &level) ) {
+                free((void*)filenames);
+                goto early_exit;
+            }
             
             scanStr = filenames;
             token = strsep(&scanStr, ":");
@@ -199,14 +524,11 @@ nara_export_init(
                 goto early_exit;
             }
             if ( *token == '\0' ) {
-                districtFptr = NULL;
-            }
-            else if ( strcmp(token, "-") == 0 ) {
-                districtFptr = stdout;
+                districtOut = NULL;
             }
             else {
-                districtFptr = fopen(token, "w");
-                if ( ! districtFptr ) {
+                districtOut = __nara_export_open(token, compression, level);
+                if ( ! districtOut ) {
                     free((void*)filenames);
                     fprintf(stderr, "ERROR:  unable to open district CSV file for output (errno = %d)\n", errno);
                     goto early_exit;
@@ -216,21 +538,18 @@ nara_export_init(
             token = strsep(&scanStr, ":");
             if ( token == NULL ) {
                 free((void*)filenames);
-                if ( districtFptr && (districtFptr != stdout) ) fclose(districtFptr);
+                nara_emitter_close(districtOut);
                 fprintf(stderr, "ERROR:  incomplete CSV file specifier (school)\n");
                 goto early_exit;
             }
             if ( *token == '\0' ) {
-                schoolFptr = NULL;
-            }
-            else if ( strcmp(token, "-") == 0 ) {
-                schoolFptr = stdout;
+                schoolOut = NULL;
             }
             else {
-                schoolFptr = fopen(token, "w");
-                if ( ! schoolFptr ) {
+                schoolOut = __nara_export_open(token, compression, level);
+                if ( ! schoolOut ) {
                     free((void*)filenames);
-                    if ( districtFptr && (districtFptr != stdout) ) fclose(districtFptr);
+                    nara_emitter_close(districtOut);
                     fprintf(stderr, "ERROR:  unable to open school CSV file for output (errno = %d)\n", errno);
                     goto early_exit;
                 }
@@ -239,61 +558,424 @@ nara_export_init(
             token = strsep(&scanStr, ":");
             if ( token == NULL ) {
                 free((void*)filenames);
-                if ( districtFptr && (districtFptr != stdout) ) fclose(districtFptr);
-                if ( schoolFptr && (schoolFptr != stdout) ) fclose(schoolFptr);
+                nara_emitter_close(districtOut);
+                nara_emitter_close(schoolOut);
                 fprintf(stderr, "ERROR:  incomplete CSV file specifier (classroom)\n");
                 goto early_exit;
             }
             if ( *token == '\0' ) {
-                classroomFptr = NULL;
-            }
-            else if ( strcmp(token, "-") == 0 ) {
-                classroomFptr = stdout;
+                classroomOut = NULL;
             }
             else {
-                classroomFptr = fopen(token, "w");
-                if ( ! classroomFptr ) {
+                classroomOut = __nara_export_open(token, compression, level);
+                if ( ! classroomOut ) {
                     free((void*)filenames);
-                    if ( districtFptr && (districtFptr != stdout) ) fclose(districtFptr);
-                    if ( schoolFptr && (schoolFptr != stdout) ) fclose(schoolFptr);
+                    nara_emitter_close(districtOut);
+                    nara_emitter_close(schoolOut);
                     fprintf(stderr, "ERROR:  unable to open classroom CSV file for output (errno = %d)\n", errno);
                     goto early_exit;
                 }
             }
+            free((void*)filenames);
             
             /* Go ahead and allocate our context now: */
             context = (nara_export_context_csv_t*)malloc(sizeof(nara_export_context_csv_t));
             if ( context ) {
                 context->base.format = nara_export_format_csv;
-                context->districtFptr = districtFptr;
-                context->schoolFptr = schoolFptr;
-                context->classroomFptr = classroomFptr;
+                context->base.recordFormat = NULL;
+                context->districtOut = districtOut;
+                context->schoolOut = schoolOut;
+                context->classroomOut = classroomOut;
                 
                 outContext = context;
             } else {
-                free((void*)filenames);
-                if ( districtFptr && (districtFptr != stdout) ) fclose(districtFptr);
-                if ( schoolFptr && (schoolFptr != stdout) ) fclose(schoolFptr);
-                if ( classroomFptr && (classroomFptr != stdout) ) fclose(classroomFptr);
+                nara_emitter_close(districtOut);
+                nara_emitter_close(schoolOut);
+                nara_emitter_close(classroomOut);
                 fprintf(stderr, "ERROR:  unable to allocate export context\n");
             }
         }
+        else if ( (pLen == 5) && (strncasecmp(exportArg, "arrow", 5) == 0) ) {
+            /*
+             * Specifier format:
+             *
+             *   arrow:<directory>{:<batch-rows>}
+             *
+             * with one file per record type in <directory> (see nara_arrow.h)
+             */
+            outContext = nara_arrow_export_init(p);
+        }
+        else if ( (pLen == 7) && (strncasecmp(exportArg, "parquet", 7) == 0) ) {
+            /*
+             * Specifier format:
+             *
+             *   parquet:<directory>{:<row-group-size>}
+             *
+             * with one file per record type in <directory> (see nara_parquet.h)
+             */
+            outContext = nara_parquet_export_init(p);
+        }
         else {
             fprintf(stderr, "ERROR:  unhandled format in output specifier: %s\n", exportArg);
         }
     } else {
         fprintf(stderr, "ERROR:  invalid output specifier:  format only\n");
     }
+
+early_exit:
+    return outContext;
+}
+
+/**/
+
+/*
+ * A fan-out export context hands every record to each of several sink contexts.
+ * When it has writer threads, each sink is formatted on its own thread:  records
+ * are copied into a ring of slots and every writer works through the ring at its
+ * own pace, so a slow sink only holds up the others once the ring is full.
+ */
+#define NARA_EXPORT_FANOUT_SLOTS    256
+
+typedef struct nara_export_fanout nara_export_fanout_t;
+
+#ifdef HAVE_PTHREADS
+
+typedef struct {
+    void                    *buffer;
+    size_t                  bufferSize;
+    unsigned int            pending;
+} nara_export_fanout_slot_t;
+
+typedef struct {
+    nara_export_fanout_t    *fanout;
+    nara_export_context_t   sink;
+    pthread_t               thread;
+    uint64_t                consumed;
+} nara_export_fanout_writer_t;
+
+#endif
+
+struct nara_export_fanout {
+    nara_export_context_base_t  base;
+    unsigned int                nSinks;
+    nara_export_context_t       *sinks;
+#ifdef HAVE_PTHREADS
+    nara_export_fanout_writer_t *writers;
+    unsigned int                nWriters;
+    pthread_mutex_t             lock;
+    pthread_cond_t              recordReady;
+    pthread_cond_t              slotFree;
+    uint64_t                    produced;
+    int                         isDone;
+    nara_export_fanout_slot_t   slots[NARA_EXPORT_FANOUT_SLOTS];
+#endif
+};
+
+/**/
+
+static int
+__nara_export_writes_stdout(
+    nara_export_context_t   exportContext
+)
+{
+    nara_export_context_base_t  *BASE_CONTEXT = (nara_export_context_base_t*)exportContext;
     
-    if ( outContext ) {
-        unsigned        i;
+    switch ( BASE_CONTEXT->format ) {
+        
+        case nara_export_format_yaml: {
+            nara_export_context_yaml_t  *CONTEXT = (nara_export_context_yaml_t*)exportContext;
+            
+            return ( CONTEXT->out && nara_emitter_is_stdout(CONTEXT->out) );
+        }
+        
+        case nara_export_format_csv: {
+            nara_export_context_csv_t   *CONTEXT = (nara_export_context_csv_t*)exportContext;
+            
+            return ( (CONTEXT->districtOut && nara_emitter_is_stdout(CONTEXT->districtOut)) ||
+                     (CONTEXT->schoolOut && nara_emitter_is_stdout(CONTEXT->schoolOut)) ||
+                     (CONTEXT->classroomOut && nara_emitter_is_stdout(CONTEXT->classroomOut)) );
+        }
         
-        for ( i = 1; i < nara_record_type_max; i++ )
-            if ( __nara_export_init_fns[i] ) __nara_export_init_fns[i](outContext);
     }
+    return 0;
+}
+
+/**/
+
+static nara_export_fanout_t*
+__nara_export_fanout_alloc(
+    unsigned int            nSinks
+)
+{
+    nara_export_fanout_t    *fanout = (nara_export_fanout_t*)malloc(sizeof(nara_export_fanout_t));
     
-early_exit:
-    return outContext;
+    if ( fanout ) {
+        memset(fanout, 0, sizeof(*fanout));
+        fanout->base.format = nara_export_format_fanout;
+        fanout->sinks = (nara_export_context_t*)calloc(nSinks, sizeof(nara_export_context_t));
+        if ( ! fanout->sinks ) {
+            free((void*)fanout);
+            return NULL;
+        }
+        fanout->nSinks = nSinks;
+    }
+    return fanout;
+}
+
+/**/
+
+#ifdef HAVE_PTHREADS
+
+static void*
+__nara_export_fanout_writer(
+    void                        *context
+)
+{
+    nara_export_fanout_writer_t *writer = (nara_export_fanout_writer_t*)context;
+    nara_export_fanout_t        *fanout = writer->fanout;
+    
+    pthread_mutex_lock(&fanout->lock);
+    while ( 1 ) {
+        uint64_t                i, produced;
+        int                     didFreeSlot = 0;
+        
+        while ( ! fanout->isDone && (writer->consumed == fanout->produced) ) pthread_cond_wait(&fanout->recordReady, &fanout->lock);
+        if ( writer->consumed == fanout->produced ) break;
+        
+        /* Export everything published so far without holding the lock: */
+        produced = fanout->produced;
+        pthread_mutex_unlock(&fanout->lock);
+        for ( i = writer->consumed; i < produced; i++ )
+            nara_record_export(writer->sink, (nara_record_t*)fanout->slots[i % NARA_EXPORT_FANOUT_SLOTS].buffer);
+        
+        pthread_mutex_lock(&fanout->lock);
+        for ( i = writer->consumed; i < produced; i++ )
+            if ( --fanout->slots[i % NARA_EXPORT_FANOUT_SLOTS].pending == 0 ) didFreeSlot = 1;
+        writer->consumed = produced;
+        if ( didFreeSlot ) pthread_cond_broadcast(&fanout->slotFree);
+    }
+    pthread_mutex_unlock(&fanout->lock);
+    return NULL;
+}
+
+/**/
+
+static void
+__nara_export_fanout_drain(
+    nara_export_fanout_t    *fanout
+)
+{
+    unsigned int            i;
+    
+    if ( ! fanout->writers ) return;
+    pthread_mutex_lock(&fanout->lock);
+    for ( i = 0; i < fanout->nSinks; i++ )
+        while ( fanout->writers[i].consumed < fanout->produced ) pthread_cond_wait(&fanout->slotFree, &fanout->lock);
+    pthread_mutex_unlock(&fanout->lock);
+}
+
+/**/
+
+static void
+__nara_export_fanout_stop(
+    nara_export_fanout_t    *fanout
+)
+{
+    unsigned int            i;
+    
+    if ( ! fanout->writers ) return;
+    pthread_mutex_lock(&fanout->lock);
+    fanout->isDone = 1;
+    pthread_cond_broadcast(&fanout->recordReady);
+    pthread_mutex_unlock(&fanout->lock);
+    for ( i = 0; i < fanout->nWriters; i++ ) pthread_join(fanout->writers[i].thread, NULL);
+    pthread_cond_destroy(&fanout->slotFree);
+    pthread_cond_destroy(&fanout->recordReady);
+    pthread_mutex_destroy(&fanout->lock);
+    free((void*)fanout->writers);
+    fanout->writers = NULL;
+    for ( i = 0; i < NARA_EXPORT_FANOUT_SLOTS; i++ ) free(fanout->slots[i].buffer);
+}
+
+/**/
+
+static void
+__nara_export_fanout_start(
+    nara_export_fanout_t    *fanout
+)
+{
+    fanout->writers = (nara_export_fanout_writer_t*)calloc(fanout->nSinks, sizeof(nara_export_fanout_writer_t));
+    if ( ! fanout->writers ) return;
+    pthread_mutex_init(&fanout->lock, NULL);
+    pthread_cond_init(&fanout->recordReady, NULL);
+    pthread_cond_init(&fanout->slotFree, NULL);
+    while ( fanout->nWriters < fanout->nSinks ) {
+        nara_export_fanout_writer_t *writer = &fanout->writers[fanout->nWriters];
+        
+        writer->fanout = fanout;
+        writer->sink = fanout->sinks[fanout->nWriters];
+        if ( pthread_create(&writer->thread, NULL, __nara_export_fanout_writer, writer) != 0 ) break;
+        fanout->nWriters++;
+    }
+    
+    /* Every sink needs a writer; if one could not be started go without: */
+    if ( fanout->nWriters < fanout->nSinks ) __nara_export_fanout_stop(fanout);
+}
+
+#endif /* HAVE_PTHREADS */
+
+/**/
+
+nara_export_context_t
+nara_export_fanout(
+    nara_export_context_t   *exportContexts,
+    unsigned int            nContexts,
+    int                     useWriterThreads
+)
+{
+    nara_export_fanout_t    *fanout = __nara_export_fanout_alloc(nContexts);
+    unsigned int            i, nStdout = 0;
+    
+    if ( ! fanout ) {
+        fprintf(stderr, "ERROR:  unable to allocate export context\n");
+        return NULL;
+    }
+    for ( i = 0; i < nContexts; i++ ) {
+        fanout->sinks[i] = exportContexts[i];
+        if ( __nara_export_writes_stdout(exportContexts[i]) ) nStdout++;
+    }
+    
+    /* Sinks that share stdout must be written in lockstep, i.e. by a single thread: */
+    if ( useWriterThreads && (nContexts > 1) && (nStdout < 2) ) {
+#ifdef HAVE_PTHREADS
+        __nara_export_fanout_start(fanout);
+#endif
+    }
+    return fanout;
+}
+
+/**/
+
+static void
+__nara_export_fanout_record(
+    nara_export_fanout_t    *fanout,
+    nara_record_t           *theRecord
+)
+{
+    unsigned int            i;
+
+#ifdef HAVE_PTHREADS
+    if ( fanout->writers ) {
+        nara_format_t               format = fanout->base.recordFormat;
+        nara_export_fanout_slot_t   *slot;
+        size_t                      byteSize;
+        uint32_t                    recordType = __nara_record_type(format, theRecord);
+        
+        if ( recordType == 0 ) {
+            fprintf(stderr, "ERROR:  unknown record type\n");
+            return;
+        }
+        byteSize = format->recordTypes[recordType].byteSize;
+        
+        /*
+         * The caller releases the record as soon as we return, so the writers
+         * get a copy of it:
+         */
+        pthread_mutex_lock(&fanout->lock);
+        slot = &fanout->slots[fanout->produced % NARA_EXPORT_FANOUT_SLOTS];
+        while ( slot->pending ) pthread_cond_wait(&fanout->slotFree, &fanout->lock);
+        if ( slot->bufferSize < byteSize ) {
+            void    *buffer = realloc(slot->buffer, byteSize);
+            
+            if ( ! buffer ) {
+                pthread_mutex_unlock(&fanout->lock);
+                fprintf(stderr, "ERROR:  unable to allocate record buffer\n");
+                return;
+            }
+            slot->buffer = buffer;
+            slot->bufferSize = byteSize;
+        }
+        memcpy(slot->buffer, theRecord, byteSize);
+        slot->pending = fanout->nSinks;
+        fanout->produced++;
+        pthread_cond_broadcast(&fanout->recordReady);
+        pthread_mutex_unlock(&fanout->lock);
+        return;
+    }
+#endif
+    for ( i = 0; i < fanout->nSinks; i++ ) nara_record_export(fanout->sinks[i], theRecord);
+}
+
+/**/
+
+int
+nara_export_bind(
+    nara_export_context_t   exportContext,
+    nara_format_t           format
+)
+{
+    nara_export_context_base_t  *BASE_CONTEXT = (nara_export_context_base_t*)exportContext;
+    nara_format_t               oldFormat = BASE_CONTEXT->recordFormat;
+    unsigned int                i;
+    
+    if ( oldFormat == format ) return 0;
+    switch ( BASE_CONTEXT->format ) {
+        
+        case nara_export_format_fanout: {
+            nara_export_fanout_t    *FANOUT = (nara_export_fanout_t*)exportContext;
+
+#ifdef HAVE_PTHREADS
+            /* The writers must be done with records in the old format: */
+            __nara_export_fanout_drain(FANOUT);
+#endif
+            for ( i = 0; i < FANOUT->nSinks; i++ ) if ( nara_export_bind(FANOUT->sinks[i], format) != 0 ) return EINVAL;
+            break;
+        }
+        
+        case nara_export_format_csv: {
+            /* The columns are fixed by the first layout seen: */
+            if ( oldFormat && (oldFormat->layout != format->layout) ) {
+                fprintf(stderr, "ERROR:  cannot write %s records to CSV files that hold %s records\n", format->name, oldFormat->name);
+                return EINVAL;
+            }
+            
+            /* The initializers see the context bound to the new format: */
+            BASE_CONTEXT->recordFormat = format;
+            if ( ! oldFormat ) {
+                for ( i = 1; i < nara_record_type_max; i++ ) if ( format->exportInitFns[i] ) format->exportInitFns[i](exportContext);
+            }
+            break;
+        }
+        
+        case nara_export_format_arrow: {
+            if ( nara_arrow_export_bind(exportContext, format) != 0 ) return EINVAL;
+            break;
+        }
+        
+        case nara_export_format_parquet: {
+            if ( nara_parquet_export_bind(exportContext, format) != 0 ) return EINVAL;
+            break;
+        }
+        
+        case nara_export_format_cache: {
+            if ( nara_cache_export_bind(exportContext, format) != 0 ) return EINVAL;
+            break;
+        }
+        
+        default: {
+            if ( oldFormat && (oldFormat->layout != format->layout) ) {
+                for ( i = 1; i < nara_record_type_max; i++ ) if ( oldFormat->exportDestroyFns[i] ) oldFormat->exportDestroyFns[i](exportContext);
+            }
+            BASE_CONTEXT->recordFormat = format;
+            if ( ! oldFormat || (oldFormat->layout != format->layout) ) {
+                for ( i = 1; i < nara_record_type_max; i++ ) if ( format->exportInitFns[i] ) format->exportInitFns[i](exportContext);
+            }
+            break;
+        }
+        
+    }
+    BASE_CONTEXT->recordFormat = format;
+    return 0;
 }
 
 /**/
@@ -305,77 +987,279 @@ nara_record_export(
 )
 {
     if ( exportContext ) {
-        switch ( theRecord->recordType ) {
-            case nara_record_type_district:
-            case nara_record_type_school:
-            case nara_record_type_classroom: {
-                __nara_record_export_fns[theRecord->recordType](exportContext, theRecord);
-                break;
-            }
-            default: {
-                fprintf(stderr, "ERROR:  unknown record type %d\n", theRecord->recordType);
-                break;
+        nara_export_context_base_t  *BASE_CONTEXT = (nara_export_context_base_t*)exportContext;
+        uint32_t                    recordType;
+        
+        if ( ! BASE_CONTEXT->recordFormat && (nara_export_bind(exportContext, nara_format_default()) != 0) ) return;
+        if ( BASE_CONTEXT->format == nara_export_format_fanout ) {
+            __nara_export_fanout_record((nara_export_fanout_t*)exportContext, theRecord);
+            return;
+        }
+        if ( (recordType = __nara_record_type(BASE_CONTEXT->recordFormat, theRecord)) ) {
+            int     previousStage = nara_stats_enter(nara_stats_stage_format);
+            
+            if ( BASE_CONTEXT->format == nara_export_format_arrow ) {
+                nara_arrow_export(exportContext, recordType, theRecord);
+            } else if ( BASE_CONTEXT->format == nara_export_format_parquet ) {
+                nara_parquet_export(exportContext, recordType, theRecord);
+            } else if ( BASE_CONTEXT->format == nara_export_format_cache ) {
+                nara_cache_export(exportContext, recordType, theRecord);
+            } else {
+                BASE_CONTEXT->recordFormat->exportFns[recordType](exportContext, theRecord);
             }
+            nara_stats_leave(previousStage);
+        } else {
+            fprintf(stderr, "ERROR:  unknown record type\n");
         }
     }
 }
 
 /**/
 
-void
+int
 nara_export_destroy(
     nara_export_context_t   exportContext
 )
 {
+    int                     rc = 0;
+    
     if ( exportContext ) {
         nara_export_context_base_t  *BASE_CONTEXT = (nara_export_context_base_t*)exportContext;
         unsigned                    i;
         
-        for ( i = 1; i < nara_record_type_max; i++ )
-            if ( __nara_export_destroy_fns[i] ) __nara_export_destroy_fns[i](exportContext);
-            
-        switch ( BASE_CONTEXT->format ) {
+        if ( BASE_CONTEXT->format == nara_export_format_fanout ) {
+            nara_export_fanout_t    *FANOUT = (nara_export_fanout_t*)exportContext;
+            int                     sinkRc;
+
+#ifdef HAVE_PTHREADS
+            /* Let the writers finish off whatever is still in the ring: */
+            __nara_export_fanout_stop(FANOUT);
+#endif
+            for ( i = 0; i < FANOUT->nSinks; i++ ) {
+                if ( (sinkRc = nara_export_destroy(FANOUT->sinks[i])) && ! rc ) rc = sinkRc;
+            }
+            free((void*)FANOUT->sinks);
+            free((void*)exportContext);
+            return rc;
+        }
+        if ( BASE_CONTEXT->format == nara_export_format_arrow ) return nara_arrow_export_destroy(exportContext);
+        if ( BASE_CONTEXT->format == nara_export_format_parquet ) return nara_parquet_export_destroy(exportContext);
+        if ( BASE_CONTEXT->format == nara_export_format_cache ) {
+            nara_cache_export_destroy(exportContext);
+            return 0;
+        }
+        
+        if ( BASE_CONTEXT->recordFormat ) {
+            for ( i = 1; i < nara_record_type_max; i++ )
+                if ( BASE_CONTEXT->recordFormat->exportDestroyFns[i] ) BASE_CONTEXT->recordFormat->exportDestroyFns[i](exportContext);
+        }
         
+        switch ( BASE_CONTEXT->format ) {
+            
             case nara_export_format_yaml: {
                 nara_export_context_yaml_t  *CONTEXT = (nara_export_context_yaml_t*)exportContext;
                 
-                if ( CONTEXT->fptr && (CONTEXT->fptr != stdout) ) fclose(CONTEXT->fptr);
+                rc = nara_emitter_close(CONTEXT->out);
                 free((void*)exportContext);
                 break;
             }
-        
+            
             case nara_export_format_csv: {
                 nara_export_context_csv_t   *CONTEXT = (nara_export_context_csv_t*)exportContext;
                 
-                if ( CONTEXT->districtFptr && (CONTEXT->districtFptr != stdout) ) fclose(CONTEXT->districtFptr);
-                if ( CONTEXT->schoolFptr && (CONTEXT->schoolFptr != stdout) ) fclose(CONTEXT->schoolFptr);
-                if ( CONTEXT->classroomFptr && (CONTEXT->classroomFptr != stdout) ) fclose(CONTEXT->classroomFptr);
+                if ( nara_emitter_close(CONTEXT->districtOut) ) rc = EIO;
+                if ( nara_emitter_close(CONTEXT->schoolOut) ) rc = EIO;
+                if ( nara_emitter_close(CONTEXT->classroomOut) ) rc = EIO;
                 free((void*)exportContext);
                 break;
             }
-        
+            
         }
     }
+    return rc;
 }
 
 /**/
 
-nara_record_t*
-nara_record_destroy(
-    nara_record_t   *theRecord
+/*
+ * A forked export context:  a copy of the original context whose outputs are
+ * memory emitters.  The context must be the first field so a pointer to this
+ * structure can stand in for the original.
+ */
+typedef struct {
+    union {
+        nara_export_context_base_t  base;
+        nara_export_context_yaml_t  yaml;
+        nara_export_context_csv_t   csv;
+    } context;
+    unsigned int        nStreams;
+    struct {
+        nara_emitter_t  parentOut;
+        nara_emitter_t  out;
+    } streams[3];
+} nara_export_fork_t;
+
+static nara_emitter_t
+__nara_export_fork_stream(
+    nara_export_fork_t  *fork,
+    nara_emitter_t      parentOut
 )
 {
-    switch ( theRecord->recordType ) {
-        case nara_record_type_district:
-        case nara_record_type_school:
-        case nara_record_type_classroom: {
-            theRecord = __nara_record_destroy_fns[theRecord->recordType](theRecord);
+    unsigned int        i;
+    
+    if ( ! parentOut ) return NULL;
+    
+    /* Outputs that share a file in the parent share a buffer in the fork: */
+    for ( i = 0; i < fork->nStreams; i++ ) if ( fork->streams[i].parentOut == parentOut ) return fork->streams[i].out;
+    
+    fork->streams[i].parentOut = parentOut;
+    fork->streams[i].out = nara_emitter_open_memory();
+    if ( fork->streams[i].out ) fork->nStreams++;
+    return fork->streams[i].out;
+}
+
+/**/
+
+/*
+ * A fan-out forks into a fan-out (without writer threads) of forked sinks:
+ */
+static nara_export_context_t
+__nara_export_fanout_fork(
+    nara_export_fanout_t    *fanout
+)
+{
+    nara_export_fanout_t    *forkedFanout = __nara_export_fanout_alloc(fanout->nSinks);
+    unsigned int            i = 0;
+    
+    if ( ! forkedFanout ) return NULL;
+    forkedFanout->base.recordFormat = fanout->base.recordFormat;
+    while ( i < fanout->nSinks ) {
+        if ( ! (forkedFanout->sinks[i] = nara_export_fork(fanout->sinks[i])) ) break;
+        i++;
+    }
+    if ( i < fanout->nSinks ) {
+        while ( i-- ) nara_export_join(fanout->sinks[i], forkedFanout->sinks[i], 0);
+        free((void*)forkedFanout->sinks);
+        free((void*)forkedFanout);
+        return NULL;
+    }
+    return forkedFanout;
+}
+
+/**/
+
+nara_export_context_t
+nara_export_fork(
+    nara_export_context_t   exportContext
+)
+{
+    nara_export_context_base_t  *BASE_CONTEXT = (nara_export_context_base_t*)exportContext;
+    nara_export_fork_t          *fork;
+    int                         isOkay = 0;
+    
+    /* A fork shares its parent's format (and the parent's files get the preamble): */
+    if ( ! BASE_CONTEXT->recordFormat && (nara_export_bind(exportContext, nara_format_default()) != 0) ) return NULL;
+    if ( BASE_CONTEXT->format == nara_export_format_fanout ) return __nara_export_fanout_fork((nara_export_fanout_t*)exportContext);
+    if ( BASE_CONTEXT->format == nara_export_format_arrow ) return nara_arrow_export_fork(exportContext);
+    if ( BASE_CONTEXT->format == nara_export_format_parquet ) return nara_parquet_export_fork(exportContext);
+    if ( BASE_CONTEXT->format == nara_export_format_cache ) return nara_cache_export_fork(exportContext);
+    
+    fork = (nara_export_fork_t*)malloc(sizeof(nara_export_fork_t));
+    if ( ! fork ) return NULL;
+    fork->nStreams = 0;
+    switch ( BASE_CONTEXT->format ) {
+        
+        case nara_export_format_yaml: {
+            nara_export_context_yaml_t  *CONTEXT = (nara_export_context_yaml_t*)exportContext;
+            
+            fork->context.yaml = *CONTEXT;
+            fork->context.yaml.out = __nara_export_fork_stream(fork, CONTEXT->out);
+            isOkay = ( ! CONTEXT->out || fork->context.yaml.out );
             break;
         }
-        default: {
-            fprintf(stderr, "ERROR:  unknown record type %d\n", theRecord->recordType);
+        
+        case nara_export_format_csv: {
+            nara_export_context_csv_t   *CONTEXT = (nara_export_context_csv_t*)exportContext;
+            
+            fork->context.csv = *CONTEXT;
+            fork->context.csv.districtOut = __nara_export_fork_stream(fork, CONTEXT->districtOut);
+            fork->context.csv.schoolOut = __nara_export_fork_stream(fork, CONTEXT->schoolOut);
+            fork->context.csv.classroomOut = __nara_export_fork_stream(fork, CONTEXT->classroomOut);
+            isOkay = ( (! CONTEXT->districtOut || fork->context.csv.districtOut) &&
+                       (! CONTEXT->schoolOut || fork->context.csv.schoolOut) &&
+                       (! CONTEXT->classroomOut || fork->context.csv.classroomOut) );
             break;
         }
+        
+    }
+    if ( ! isOkay ) {
+        nara_export_join(exportContext, fork, 0);
+        fork = NULL;
+    }
+    return fork;
+}
+
+/**/
+
+void
+nara_export_join(
+    nara_export_context_t   exportContext,
+    nara_export_context_t   forkedContext,
+    int                     shouldWrite
+)
+{
+    nara_export_fork_t      *fork = (nara_export_fork_t*)forkedContext;
+    unsigned int            i;
+    
+    if ( fork->context.base.format == nara_export_format_fanout ) {
+        nara_export_fanout_t    *FANOUT = (nara_export_fanout_t*)exportContext;
+        nara_export_fanout_t    *forkedFanout = (nara_export_fanout_t*)forkedContext;
+
+#ifdef HAVE_PTHREADS
+        /* Records queued to the writers precede the forked output: */
+        if ( shouldWrite ) __nara_export_fanout_drain(FANOUT);
+#endif
+        for ( i = 0; i < FANOUT->nSinks; i++ ) nara_export_join(FANOUT->sinks[i], forkedFanout->sinks[i], shouldWrite);
+        free((void*)forkedFanout->sinks);
+        free((void*)forkedFanout);
+        return;
+    }
+    if ( fork->context.base.format == nara_export_format_arrow ) {
+        nara_arrow_export_join(exportContext, forkedContext, shouldWrite);
+        return;
+    }
+    if ( fork->context.base.format == nara_export_format_parquet ) {
+        nara_parquet_export_join(exportContext, forkedContext, shouldWrite);
+        return;
+    }
+    if ( fork->context.base.format == nara_export_format_cache ) {
+        nara_cache_export_join(exportContext, forkedContext, shouldWrite);
+        return;
+    }
+    
+    for ( i = 0; i < fork->nStreams; i++ ) {
+        if ( shouldWrite ) nara_emitter_splice(fork->streams[i].parentOut, fork->streams[i].out);
+        nara_emitter_close(fork->streams[i].out);
+    }
+    free((void*)fork);
+}
+
+/**/
+
+nara_record_t*
+nara_record_destroy(
+    nara_record_t   *theRecord
+)
+{
+    nara_format_t   format = nara_format_default();
+    uint32_t        recordType = __nara_record_type(format, theRecord);
+    
+    /* The buffer goes back to the pool nara_record_read() took it from, whichever thread that was: */
+    if ( recordType ) {
+        nara_record_pool_free(__nara_record_read_pool, (void*)theRecord);
+        theRecord = NULL;
+    } else {
+        fprintf(stderr, "ERROR:  unknown record type\n");
     }
     return theRecord;
 }
@@ -18,6 +18,8 @@
 #define __NARA_RECORD_H__
 
 #include "nara_base.h"
+#include "nara_reader.h"
+#include "nara_format.h"
 
 enum {
     nara_record_type_district = 1,
@@ -26,29 +28,121 @@ enum {
     nara_record_type_max
 };
 
-#if defined(NARA_1976_FORMAT) || defined(NARA_1986_FORMAT)
+/*
+ * The layout of the record base is only known to the decoders (see
+ * nara_record_decoder.c); elsewhere a record is opaque and its type is found
+ * through its format.
+ */
+#if defined(NARA_DECODER)
+
+#   if defined(NARA_1976_FORMAT) || defined(NARA_1986_FORMAT)
 
-    typedef struct {
+    typedef struct nara_record {
         uint32_t    systemOECode;
         uint32_t    recordType;
     } nara_record_t;
 
-#else
+#   else
 
-    typedef struct {
+    typedef struct nara_record {
         uint32_t    recordType;
     } nara_record_t;
 
+#   endif
+
+#else
+
+    typedef struct nara_record nara_record_t;
+
 #endif
 
+/*
+ * Read a record in the default format (nara_format_default()) from a stdio
+ * stream; dispose of it with nara_record_destroy() (on any thread).  The
+ * buffer comes from a record pool of the reading thread's own.
+ */
 nara_record_t* nara_record_read(FILE *fptr, size_t recordSize);
 
+/*
+ * Read the next record from a reader in the reader's format (see
+ * nara_reader_format()).  The record lives in the reader's mapping,
+ * scratch buffer, or record pool and must be handed back with nara_record_release()
+ * (not nara_record_destroy()) before the next call.
+ */
+nara_record_t* nara_record_next(nara_reader_t reader, size_t recordSize);
+nara_record_t* nara_record_release(nara_reader_t reader, nara_record_t *theRecord);
+
+/*
+ * Returned by nara_record_next(), nara_record_next_typed(), and nara_record_read()
+ * in place of a record that was rejected by its format's filter or is of a type
+ * the format skips (see nara_fields_add_filter() and nara_fields_add_types());
+ * it is not to be exported, released, or destroyed.
+ */
+extern nara_record_t * const nara_record_filtered;
+
+/*
+ * Like nara_record_next(), for a record whose type is already known from
+ * nara_record_classify_chunk() or nara_record_classify_records():  the record
+ * is processed as that type without being examined.
+ */
+nara_record_t* nara_record_next_typed(nara_reader_t reader, size_t recordSize, uint32_t recordType);
+
+/*
+ * Classify in bulk the records ahead of a memory-mapped reader, without
+ * consuming them:  each record's type is stored in recordTypes (at most
+ * maxRecords of them).  nara_record_classify_chunk() walks the record headers
+ * of the pre-1976 state chunk whose records fill the next chunkLength bytes
+ * and returns the number of records, or zero if any of them is malformed or
+ * of an unknown type (the chunk must then be read record-by-record so the
+ * problem is reported).  nara_record_classify_records() returns the number of
+ * leading fixed-size records of known types.
+ */
+unsigned int nara_record_classify_chunk(nara_reader_t reader, size_t chunkLength, uint8_t *recordTypes, unsigned int maxRecords);
+unsigned int nara_record_classify_records(nara_reader_t reader, uint8_t *recordTypes, unsigned int maxRecords);
+
 typedef const void* nara_export_context_t;
 
 nara_export_context_t nara_export_init(const char *exportArg);
+
+/*
+ * Set the format of the records an export context will be given; the format's
+ * preamble (e.g. the CSV column headers) is written the first time.  A YAML
+ * context may be switched to any format, but a CSV context only to another
+ * encoding of the same layout, since the columns differ between layouts.
+ * Returns zero on success.  A context that is never bound takes the default
+ * format with its first record.
+ */
+int nara_export_bind(nara_export_context_t exportContext, nara_format_t format);
 void nara_record_export(nara_export_context_t exportContext, nara_record_t *theRecord);
-void nara_export_destroy(nara_export_context_t exportContext);
 
+/*
+ * Finish and close an export context's outputs and dispose of it.  Returns zero
+ * if all of the output was written, non-zero (e.g. EIO) if any of it could not be.
+ */
+int nara_export_destroy(nara_export_context_t exportContext);
+
+/*
+ * Combine nContexts export contexts into one that exports every record to each of
+ * them; the contexts are owned by (and destroyed with) the combined context.  If
+ * useWriterThreads is non-zero each context is written by its own thread so that a
+ * slow output does not hold up the others.  Records still reach every context in
+ * order.
+ */
+nara_export_context_t nara_export_fanout(nara_export_context_t *exportContexts, unsigned int nContexts, int useWriterThreads);
+
+/*
+ * Create a copy of an export context whose output goes to private in-memory
+ * buffers rather than the context's files (no CSV headers are written to them).
+ * nara_export_join() appends the buffered output to the original context's files
+ * (if shouldWrite is non-zero) and disposes of the copy.
+ */
+nara_export_context_t nara_export_fork(nara_export_context_t exportContext);
+void nara_export_join(nara_export_context_t exportContext, nara_export_context_t forkedContext, int shouldWrite);
+
+/*
+ * Dispose of a record returned by nara_record_read() (returning its buffer to
+ * the pool of the thread that read it).
+ */
 nara_record_t* nara_record_destroy(nara_record_t *theRecord);
 
 #endif /* __NARA_RECORD_H__ */
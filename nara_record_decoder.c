@@ -0,0 +1,236 @@
+/*
+ * nara_record_decoder
+ *
+ * A decoder for one record layout and string encoding.  This file is compiled
+ * once for every combination (see CMakeLists.txt):  NARA_DECODER_LAYOUT selects
+ * the layout (a nara_layout_* value), NARA_DECODER_EBCDIC the encoding, and the
+ * decoder is exported as NARA_DECODER_SYMBOL.  The record implementations are
+ * written against the NARA_1986_FORMAT, NARA_1976_FORMAT, and HAVE_EBCDIC_ENCODING
+ * macros, so those are set up here before anything is included.
+ *
+ */
+
+#define NARA_DECODER
+
+#if NARA_DECODER_LAYOUT == 2
+#   define NARA_1986_FORMAT
+#elif NARA_DECODER_LAYOUT == 1
+#   define NARA_1976_FORMAT
+#endif
+
+#if NARA_DECODER_EBCDIC
+#   define HAVE_EBCDIC_ENCODING
+#endif
+
+#include "nara_record.h"
+#include "nara_record_impl.h"
+#include "nara_stats.h"
+
+/*
+ * The implementations that define the shared label arrays (district, then school)
+ * come first:
+ */
+#if defined(NARA_1986_FORMAT)
+#   define NARA_1986_RECORD_SLOTS   700
+#   define NARA_1986_RECORD_SIZE    (sizeof(uint32_t) * NARA_1986_RECORD_SLOTS) + 1
+#   include "1986/nara_district_impl.c"
+#   include "1986/nara_school_impl.c"
+#   include "1986/nara_summary_impl.c"
+#   define NARA_DECODER_NAME        "1986"
+#   define NARA_DECODER_FIXED_SIZE  (NARA_1986_RECORD_SIZE)
+#elif defined(NARA_1976_FORMAT)
+#   define NARA_1976_RECORD_SLOTS   872
+#   define NARA_1976_RECORD_SIZE    (sizeof(uint32_t) * NARA_1976_RECORD_SLOTS)
+#   include "1976/nara_district_impl.c"
+#   include "1976/nara_school_impl.c"
+#   include "1976/nara_classroom_impl.c"
+#   define NARA_DECODER_NAME        "1976"
+#   define NARA_DECODER_FIXED_SIZE  (NARA_1976_RECORD_SIZE)
+#else
+#   include "pre-1976/nara_district_impl.c"
+#   include "pre-1976/nara_school_impl.c"
+#   include "pre-1976/nara_classroom_impl.c"
+#   define NARA_DECODER_NAME        "pre-1976"
+#   define NARA_DECODER_FIXED_SIZE  0
+#endif
+
+/**/
+
+#define NARA_DECODER_FIELD(T, F, K)     { offsetof(T, F), sizeof(((T*)0)->F), (K) }
+#define NARA_DECODER_COUNT(A)           (sizeof(A) / sizeof((A)[0]))
+
+/*
+ * The string and floating-point fields of each record type (for the format
+ * detection, the synthetic archive generator, and the microbenchmarks):
+ */
+#if defined(NARA_1986_FORMAT)
+
+static const nara_format_field_t __nara_decoder_district_strings[] = {
+        NARA_DECODER_FIELD(nara_district_t, systemName, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemStreetAddress, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemCounty, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemCity, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemStateAbbrev, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemZipCode, nara_format_string_digits)
+    };
+static const size_t __nara_decoder_district_floats[] = {
+        offsetof(nara_district_t, sampleWeight),
+        offsetof(nara_district_t, subSampledWeight)
+    };
+static const nara_format_field_t __nara_decoder_school_strings[] = {
+        NARA_DECODER_FIELD(nara_school_t, schoolName, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_school_t, schoolStreetAddress, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_school_t, schoolZipCode, nara_format_string_digits)
+    };
+static const size_t __nara_decoder_school_floats[] = {
+        offsetof(nara_school_t, sampleWeight),
+        offsetof(nara_school_t, subSampledWeight)
+    };
+static const nara_format_field_t __nara_decoder_classroom_strings[] = {
+        NARA_DECODER_FIELD(nara_summary_t, systemName, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_summary_t, systemStreetAddress, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_summary_t, systemCounty, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_summary_t, systemCity, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_summary_t, systemStateAbbrev, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_summary_t, systemZipCode, nara_format_string_digits)
+    };
+static const size_t __nara_decoder_classroom_floats[] = {
+        offsetof(nara_summary_t, sampleWeight),
+        offsetof(nara_summary_t, subSampledWeight)
+    };
+
+#   define NARA_DECODER_RECORD_TYPES \
+        { NULL, 0, 0, NULL, 0, NULL, 0, 0 }, \
+        { "district", NARA_DECODER_FIXED_SIZE, offsetof(nara_district_t, systemOECode), \
+            __nara_decoder_district_strings, NARA_DECODER_COUNT(__nara_decoder_district_strings), \
+            __nara_decoder_district_floats, NARA_DECODER_COUNT(__nara_decoder_district_floats), nara_stats_records_district }, \
+        { "school", NARA_DECODER_FIXED_SIZE, offsetof(nara_school_t, systemOECode), \
+            __nara_decoder_school_strings, NARA_DECODER_COUNT(__nara_decoder_school_strings), \
+            __nara_decoder_school_floats, NARA_DECODER_COUNT(__nara_decoder_school_floats), nara_stats_records_school }, \
+        { "summary", NARA_DECODER_FIXED_SIZE, offsetof(nara_summary_t, systemOECode), \
+            __nara_decoder_classroom_strings, NARA_DECODER_COUNT(__nara_decoder_classroom_strings), \
+            __nara_decoder_classroom_floats, NARA_DECODER_COUNT(__nara_decoder_classroom_floats), nara_stats_records_summary }
+#   define NARA_DECODER_RECORD_TYPE_OFFSET  offsetof(nara_district_t, recordType)
+
+#elif defined(NARA_1976_FORMAT)
+
+static const nara_format_field_t __nara_decoder_district_strings[] = {
+        NARA_DECODER_FIELD(nara_district_t, systemName, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemCounty, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemCity, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemZipCode, nara_format_string_digits)
+    };
+static const size_t __nara_decoder_district_floats[] = {
+        offsetof(nara_district_t, samplingWeight)
+    };
+static const nara_format_field_t __nara_decoder_school_strings[] = {
+        NARA_DECODER_FIELD(nara_school_t, systemName, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_school_t, systemCounty, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_school_t, systemCity, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_school_t, systemZipCode, nara_format_string_digits),
+        NARA_DECODER_FIELD(nara_school_t, schoolName, nara_format_string_text)
+    };
+static const size_t __nara_decoder_school_floats[] = {
+        offsetof(nara_school_t, samplingWeight)
+    };
+
+/* There are no classroom records in the 1976 format: */
+#   define NARA_DECODER_RECORD_TYPES \
+        { NULL, 0, 0, NULL, 0, NULL, 0, 0 }, \
+        { "district", NARA_DECODER_FIXED_SIZE, offsetof(nara_district_t, systemOECode), \
+            __nara_decoder_district_strings, NARA_DECODER_COUNT(__nara_decoder_district_strings), \
+            __nara_decoder_district_floats, NARA_DECODER_COUNT(__nara_decoder_district_floats), nara_stats_records_district }, \
+        { "school", NARA_DECODER_FIXED_SIZE, offsetof(nara_school_t, systemOECode), \
+            __nara_decoder_school_strings, NARA_DECODER_COUNT(__nara_decoder_school_strings), \
+            __nara_decoder_school_floats, NARA_DECODER_COUNT(__nara_decoder_school_floats), nara_stats_records_school }, \
+        { NULL, 0, 0, NULL, 0, NULL, 0, nara_stats_records_classroom }
+#   define NARA_DECODER_RECORD_TYPE_OFFSET  offsetof(nara_district_t, recordType)
+
+#else
+
+static const nara_format_field_t __nara_decoder_district_strings[] = {
+        NARA_DECODER_FIELD(nara_district_t, systemName, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemStreetAddr, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemCity, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemCounty, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemState, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, systemZipCode, nara_format_string_digits),
+        NARA_DECODER_FIELD(nara_district_t, systemAdminOfficer, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_district_t, srgCode, nara_format_string_digits)
+    };
+static const nara_format_field_t __nara_decoder_school_strings[] = {
+        NARA_DECODER_FIELD(nara_school_t, schoolName, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_school_t, filler, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_school_t, schoolStreetAddr, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_school_t, schoolCity, nara_format_string_text),
+        NARA_DECODER_FIELD(nara_school_t, schoolCounty, nara_format_string_text)
+    };
+
+#   define NARA_DECODER_RECORD_TYPES \
+        { NULL, 0, 0, NULL, 0, NULL, 0, 0 }, \
+        { "district", sizeof(nara_district_t), offsetof(nara_district_t, schoolSystemCode), \
+            __nara_decoder_district_strings, NARA_DECODER_COUNT(__nara_decoder_district_strings), \
+            NULL, 0, nara_stats_records_district }, \
+        { "school", sizeof(nara_school_t), offsetof(nara_school_t, schoolSystemCode), \
+            __nara_decoder_school_strings, NARA_DECODER_COUNT(__nara_decoder_school_strings), \
+            NULL, 0, nara_stats_records_school }, \
+        { "classroom", sizeof(nara_classroom_t), offsetof(nara_classroom_t, schoolSystemCode), \
+            NULL, 0, NULL, 0, nara_stats_records_classroom }
+#   define NARA_DECODER_RECORD_TYPE_OFFSET  offsetof(nara_district_t, recordType)
+
+#endif
+
+/**/
+
+static nara_record_t*
+__nara_decoder_process_type(
+    nara_record_t*      theRecord
+)
+{
+    theRecord->recordType = nara_be_to_host_u32(theRecord->recordType);
+    return theRecord;
+}
+
+/**/
+
+const struct nara_format NARA_DECODER_SYMBOL = {
+        .name = NARA_DECODER_NAME,
+        .layout = NARA_DECODER_LAYOUT,
+        .isEBCDIC = NARA_DECODER_EBCDIC,
+        .fixedSize = NARA_DECODER_FIXED_SIZE,
+        .recordTypeOffset = NARA_DECODER_RECORD_TYPE_OFFSET,
+        .recordTypes = {
+                NARA_DECODER_RECORD_TYPES
+            },
+        .processFns = {
+                NULL,
+                __nara_record_process_district,
+                __nara_record_process_school,
+                __nara_record_process_classroom
+            },
+        .processTypeFn = __nara_decoder_process_type,
+        .exportInitFns = {
+                NULL,
+                __nara_export_init_district,
+                __nara_export_init_school,
+                __nara_export_init_classroom
+            },
+        .exportFns = {
+                NULL,
+                __nara_record_export_district,
+                __nara_record_export_school,
+                __nara_record_export_classroom
+            },
+        .exportDestroyFns = {
+                NULL,
+                __nara_export_destroy_district,
+                __nara_export_destroy_school,
+                __nara_export_destroy_classroom
+            },
+        .columnsFns = {
+                NULL,
+                __nara_record_columns_district,
+                __nara_record_columns_school,
+                __nara_record_columns_classroom
+            }
+    };
@@ -13,5 +13,5 @@ nara_record_header_process(
     nara_record_header_t *recordHeader
 )
 {
-    recordHeader->recordLength = nara_be_to_host_16(recordHeader->recordLength);
+    recordHeader->recordLength = nara_be_to_host_u16(recordHeader->recordLength);
 }
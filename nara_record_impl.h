@@ -9,6 +9,10 @@
 #define __NARA_RECORD_IMPL_H__
 
 #include "nara_base.h"
+#include "nara_emitter.h"
+#include "nara_fields.h"
+#include "nara_format.h"
+#include "nara_record.h"
 
 #ifdef HAVE_EBCDIC_ENCODING
 #   include "nara_ebcdic.h"
@@ -36,44 +40,156 @@
 
 /*
  * Generic macro used to drive the EBCDIC-to-ASCII conversion of strings inside the
- * NARA records.
+ * NARA records.  The string fields are fixed-width and not NUL-terminated, so the
+ * full width of the field is converted.
  */
 #ifdef HAVE_EBCDIC_ENCODING
-#   define TRANSCODE(T, N, F) nara_ebcdic_to_ascii_inplace(T->break_out.N, 0)
+#   define TRANSCODE(T, N, F) nara_ebcdic_to_ascii_field(T->break_out.N, sizeof(T->break_out.N))
 #else
 #   define TRANSCODE(T, N, F)
 #endif
 
-typedef int (*nara_record_is_type_fn)(nara_record_t *theRecord, size_t byteSize);
+/*
+ * The EMIT_*() macros write a single value to an export output:  the literal prefix
+ * (P), the value (V), and the literal suffix (S).  EMIT_QUOTED_STR() encloses the
+ * string value in double quotes.  EMIT_LITERAL() writes only a literal string.
+ *
+ * Used in place of fprintf() by the exporters.
+ *
+ */
+#define EMIT_LITERAL(E, L)          nara_emitter_append_literal(E, L)
+#define EMIT_U32(E, P, V, S)        do { nara_emitter_append_literal(E, P); nara_emitter_append_u32(E, V); nara_emitter_append_literal(E, S); } while (0)
+#define EMIT_FLOAT(E, P, V, S)      do { nara_emitter_append_literal(E, P); nara_emitter_append_float(E, V); nara_emitter_append_literal(E, S); } while (0)
+#define EMIT_STR(E, P, V, S)        do { nara_emitter_append_literal(E, P); nara_emitter_append_string(E, V); nara_emitter_append_literal(E, S); } while (0)
+#define EMIT_QUOTED_STR(E, P, V, S) do { nara_emitter_append_literal(E, P); nara_emitter_append_quoted(E, V); nara_emitter_append_literal(E, S); } while (0)
+
+/*
+ * The COLUMN_*() macros describe a single column of a record type's CSV export
+ * to nara_fields:  the field (F) of the record structure (T) behind it, which may
+ * be an element of an array (e.g. pupils[j][i]), and its header (H) as a
+ * printf(3) format plus arguments.  A header in double quotes names the column
+ * without them.
+ *
+ * Used by the columns function of each record type, which describes its columns
+ * in the order the CSV exporter writes them.
+ *
+ */
+#define COLUMN_U32(C, T, F, ...)    nara_record_columns_add(C, nara_fields_column_u32, offsetof(T, F), sizeof(((T*)0)->F), __VA_ARGS__)
+#define COLUMN_FLOAT(C, T, F, ...)  nara_record_columns_add(C, nara_fields_column_float, offsetof(T, F), sizeof(((T*)0)->F), __VA_ARGS__)
+#define COLUMN_STR(C, T, F, ...)    nara_record_columns_add(C, nara_fields_column_string, offsetof(T, F), sizeof(((T*)0)->F), __VA_ARGS__)
+
+typedef struct nara_record_columns * nara_record_columns_t;
+
+void nara_record_columns_add(nara_record_columns_t columns, unsigned int kind, size_t offset, size_t length, const char *headerFormat, ...) __attribute__((format(printf, 5, 6)));
 
 typedef nara_record_t* (*nara_record_process_fn)(nara_record_t *theRecord);
+typedef int (*nara_record_filter_fn)(nara_format_t format, uint32_t recordType, const nara_record_t *theRecord);
 
 enum {
     nara_export_format_yaml = 0,
     nara_export_format_csv = 1,
+    nara_export_format_fanout = 2,
+    nara_export_format_arrow = 3,
+    nara_export_format_parquet = 4,
+    nara_export_format_cache = 5,
     nara_export_format_max
 };
 
 typedef struct {
     unsigned int    format;
+    nara_format_t   recordFormat;
 } nara_export_context_base_t;
 
 typedef struct {
     nara_export_context_base_t  base;
-    FILE                        *fptr;
+    nara_emitter_t              out;
 } nara_export_context_yaml_t;
 
 typedef struct {
     nara_export_context_base_t  base;
-    FILE                        *districtFptr;
-    FILE                        *schoolFptr;
-    FILE                        *classroomFptr;
+    nara_emitter_t              districtOut;
+    nara_emitter_t              schoolOut;
+    nara_emitter_t              classroomOut;
 } nara_export_context_csv_t;
 
 typedef void (*nara_export_init_fn)(nara_export_context_t exportContext);
 typedef void (*nara_record_export_fn)(nara_export_context_t exportContext, nara_record_t *theRecord);
 typedef void (*nara_export_destroy_fn)(nara_export_context_t exportContext);
 
-typedef nara_record_t* (*nara_record_destroy_fn)(nara_record_t *theRecord);
+typedef void (*nara_record_columns_fn)(nara_record_columns_t columns);
+
+/*
+ * A decoder:  the functions for each record type (indexed by record type) of one
+ * record layout and string encoding, plus a description of the layout.  One is
+ * compiled from nara_record_decoder.c for every layout and encoding.  The
+ * processTypeFn puts only a record's type in host byte order, for records whose
+ * fields are exported straight from the file's bytes (see nara_fields.h).  If
+ * there is a filterFn, records it rejects (as read from the file, before they
+ * are processed) are dropped.  Records of the types whose bits (1 << recordType)
+ * are set in skippedTypes are dropped unread where possible.  The columnsFns
+ * describe the columns of each record type's CSV export (see nara_fields.c).
+ */
+typedef struct {
+    const char                  *name;
+    size_t                      byteSize;
+    size_t                      systemCodeOffset;
+    const nara_format_field_t   *strings;
+    unsigned int                nStrings;
+    const size_t                *floats;
+    unsigned int                nFloats;
+    unsigned int                statsCounter;
+} nara_format_record_type_t;
+
+struct nara_format {
+    const char                  *name;
+    unsigned int                layout;
+    int                         isEBCDIC;
+    size_t                      fixedSize;
+    size_t                      recordTypeOffset;
+    nara_format_record_type_t   recordTypes[nara_record_type_max];
+    nara_record_process_fn      processFns[nara_record_type_max];
+    nara_record_process_fn      processTypeFn;
+    nara_record_filter_fn       filterFn;
+    unsigned int                skippedTypes;
+    nara_export_init_fn         exportInitFns[nara_record_type_max];
+    nara_record_export_fn       exportFns[nara_record_type_max];
+    nara_export_destroy_fn      exportDestroyFns[nara_record_type_max];
+    nara_record_columns_fn      columnsFns[nara_record_type_max];
+};
+
+/*
+ * The type of a record of byteSize bytes as read from the file (i.e. still in big-
+ * endian byte order), or zero if the format has no such type or the size is not
+ * that type's size.  The type word is read once and looked up directly:
+ */
+static inline uint32_t
+__nara_format_classify(
+    nara_format_t   format,
+    const void      *theRecord,
+    size_t          byteSize
+)
+{
+    uint32_t        recordType;
+    
+    memcpy(&recordType, (const char*)theRecord + format->recordTypeOffset, sizeof(recordType));
+    recordType = nara_be_to_host_u32(recordType);
+    return ( (recordType < nara_record_type_max) && byteSize && (format->recordTypes[recordType].byteSize == byteSize) ) ? recordType : 0;
+}
+
+/*
+ * The type of a record that has been processed (i.e. is in host byte order), or
+ * zero if it is not one the format knows:
+ */
+static inline uint32_t
+__nara_record_type(
+    nara_format_t   format,
+    nara_record_t   *theRecord
+)
+{
+    uint32_t        recordType;
+    
+    memcpy(&recordType, (const char*)theRecord + format->recordTypeOffset, sizeof(recordType));
+    return ( (recordType < nara_record_type_max) && format->recordTypes[recordType].byteSize ) ? recordType : 0;
+}
 
 #endif /* __NARA_RECORD_IMPL_H__ */
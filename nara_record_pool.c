@@ -0,0 +1,255 @@
+/*
+ * nara_record_pool
+ *
+ * Recycling allocator for record buffers.  Each distinct record size gets its
+ * own size class; buffers are carved out of heap-allocated slabs and returned
+ * to the class's free list on release, so once the pool has warmed up reading
+ * records does not touch the heap at all.
+ *
+ * A pool is used by a single thread (each reader, and each thread reading with
+ * nara_record_read(), owns its own) but a buffer may be returned on any thread:
+ * one that belongs to another thread's pool is pushed onto that pool's list of
+ * remote frees, which its owner reclaims when it next runs short.
+ *
+ */
+
+#include "nara_record_pool.h"
+
+#include <stddef.h>
+
+/*
+ * The record sizes are all fixed by the file format (40/472/716 bytes for pre-1976,
+ * a single size for 1976 and 1986) so only a handful of classes are ever needed:
+ */
+#define NARA_RECORD_POOL_MAX_CLASSES    8
+
+/*
+ * Number of buffers carved out of each slab:
+ */
+#define NARA_RECORD_POOL_SLAB_SLOTS     16
+
+/*
+ * Size classes are numbered from zero; buffers too large for a class (or allocated
+ * when all classes are in use) come straight from the heap:
+ */
+#define NARA_RECORD_POOL_NO_CLASS       ((uint32_t)-1)
+
+/*
+ * Every buffer is preceded by a slot header that records the pool and class it
+ * belongs to and links it into a free list.  The union pads the header so the
+ * buffer that follows keeps the strictest alignment.
+ */
+typedef union nara_record_pool_slot {
+    struct {
+        union nara_record_pool_slot *next;
+        struct nara_record_pool     *pool;
+        uint32_t                    sizeClass;
+    } link;
+    max_align_t                     alignment;
+} nara_record_pool_slot_t;
+
+typedef struct nara_record_pool_slab {
+    struct nara_record_pool_slab    *next;
+    max_align_t                     alignment[];
+} nara_record_pool_slab_t;
+
+typedef struct {
+    size_t                          nBytes;
+    size_t                          slotBytes;
+    nara_record_pool_slot_t         *freeList;
+} nara_record_pool_class_t;
+
+struct nara_record_pool {
+    unsigned int                    nClasses;
+    nara_record_pool_class_t        classes[NARA_RECORD_POOL_MAX_CLASSES];
+    nara_record_pool_slab_t         *slabs;
+    nara_record_pool_stats_t        stats;
+    nara_record_pool_slot_t         *remoteFrees;
+};
+
+/**/
+
+nara_record_pool_t
+nara_record_pool_create(void)
+{
+    struct nara_record_pool     *pool = (struct nara_record_pool*)malloc(sizeof(struct nara_record_pool));
+    
+    if ( pool ) memset(pool, 0, sizeof(*pool));
+    return pool;
+}
+
+/**/
+
+/*
+ * Put a slot of this pool back on its class's free list (or back on the heap):
+ */
+static void
+__nara_record_pool_put(
+    nara_record_pool_t          pool,
+    nara_record_pool_slot_t     *slot
+)
+{
+    if ( slot->link.sizeClass == NARA_RECORD_POOL_NO_CLASS ) {
+        free((void*)slot);
+    } else {
+        nara_record_pool_class_t    *CLASS = &pool->classes[slot->link.sizeClass];
+        
+        slot->link.next = CLASS->freeList;
+        CLASS->freeList = slot;
+    }
+    pool->stats.inUse--;
+}
+
+/**/
+
+/*
+ * Take back the slots that other threads have freed:
+ */
+static void
+__nara_record_pool_reclaim(
+    nara_record_pool_t          pool
+)
+{
+    nara_record_pool_slot_t     *slot = __atomic_exchange_n(&pool->remoteFrees, NULL, __ATOMIC_ACQUIRE);
+    
+    while ( slot ) {
+        nara_record_pool_slot_t *next = slot->link.next;
+        
+        __nara_record_pool_put(pool, slot);
+        slot = next;
+    }
+}
+
+/**/
+
+void
+nara_record_pool_destroy(
+    nara_record_pool_t  pool
+)
+{
+    if ( pool ) {
+        nara_record_pool_slab_t *slab;
+        
+        __nara_record_pool_reclaim(pool);
+        slab = pool->slabs;
+        while ( slab ) {
+            nara_record_pool_slab_t *next = slab->next;
+            
+            free((void*)slab);
+            slab = next;
+        }
+        free((void*)pool);
+    }
+}
+
+/**/
+
+static int
+__nara_record_pool_grow(
+    nara_record_pool_t          pool,
+    uint32_t                    sizeClass
+)
+{
+    nara_record_pool_class_t    *CLASS = &pool->classes[sizeClass];
+    nara_record_pool_slab_t     *slab;
+    unsigned char               *slotPtr;
+    unsigned int                i;
+    
+    slab = (nara_record_pool_slab_t*)malloc(sizeof(nara_record_pool_slab_t) + NARA_RECORD_POOL_SLAB_SLOTS * CLASS->slotBytes);
+    if ( ! slab ) return 0;
+    pool->stats.heapAllocations++;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    
+    /* Thread all of the slab's slots onto the class's free list: */
+    slotPtr = (unsigned char*)slab->alignment;
+    for ( i = 0; i < NARA_RECORD_POOL_SLAB_SLOTS; i++ ) {
+        nara_record_pool_slot_t *slot = (nara_record_pool_slot_t*)slotPtr;
+        
+        slot->link.pool = pool;
+        slot->link.sizeClass = sizeClass;
+        slot->link.next = CLASS->freeList;
+        CLASS->freeList = slot;
+        slotPtr += CLASS->slotBytes;
+    }
+    return 1;
+}
+
+/**/
+
+void*
+nara_record_pool_alloc(
+    nara_record_pool_t          pool,
+    size_t                      nBytes
+)
+{
+    nara_record_pool_slot_t     *slot;
+    uint32_t                    sizeClass = 0;
+    
+    /* Locate the size class, adding one if this is a new record size: */
+    while ( (sizeClass < pool->nClasses) && (pool->classes[sizeClass].nBytes != nBytes) ) sizeClass++;
+    if ( sizeClass == pool->nClasses ) {
+        if ( pool->nClasses < NARA_RECORD_POOL_MAX_CLASSES ) {
+            pool->classes[sizeClass].nBytes = nBytes;
+            pool->classes[sizeClass].slotBytes = sizeof(nara_record_pool_slot_t) + ((nBytes + sizeof(max_align_t) - 1) / sizeof(max_align_t)) * sizeof(max_align_t);
+            pool->classes[sizeClass].freeList = NULL;
+            pool->nClasses++;
+        } else {
+            sizeClass = NARA_RECORD_POOL_NO_CLASS;
+        }
+    }
+    
+    if ( sizeClass == NARA_RECORD_POOL_NO_CLASS ) {
+        slot = (nara_record_pool_slot_t*)malloc(sizeof(nara_record_pool_slot_t) + nBytes);
+        if ( ! slot ) return NULL;
+        pool->stats.heapAllocations++;
+        slot->link.pool = pool;
+        slot->link.sizeClass = NARA_RECORD_POOL_NO_CLASS;
+    } else {
+        nara_record_pool_class_t    *CLASS = &pool->classes[sizeClass];
+        
+        if ( ! CLASS->freeList && __atomic_load_n(&pool->remoteFrees, __ATOMIC_RELAXED) ) __nara_record_pool_reclaim(pool);
+        if ( ! CLASS->freeList && ! __nara_record_pool_grow(pool, sizeClass) ) return NULL;
+        slot = CLASS->freeList;
+        CLASS->freeList = slot->link.next;
+    }
+    pool->stats.allocations++;
+    pool->stats.inUse++;
+    return (void*)(slot + 1);
+}
+
+/**/
+
+void
+nara_record_pool_free(
+    nara_record_pool_t          pool,
+    void                        *buffer
+)
+{
+    if ( buffer ) {
+        nara_record_pool_slot_t *slot = (nara_record_pool_slot_t*)buffer - 1;
+        nara_record_pool_t      owner = slot->link.pool;
+        
+        if ( owner == pool ) {
+            __nara_record_pool_put(pool, slot);
+        } else {
+            /* Another thread's pool:  push it where the owner will reclaim it: */
+            nara_record_pool_slot_t *head = __atomic_load_n(&owner->remoteFrees, __ATOMIC_RELAXED);
+            
+            do {
+                slot->link.next = head;
+            } while ( ! __atomic_compare_exchange_n(&owner->remoteFrees, &head, slot, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED) );
+        }
+    }
+}
+
+/**/
+
+void
+nara_record_pool_get_stats(
+    nara_record_pool_t          pool,
+    nara_record_pool_stats_t    *stats
+)
+{
+    *stats = pool->stats;
+}
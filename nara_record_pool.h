@@ -0,0 +1,86 @@
+/*
+ * nara_record_pool
+ *
+ * Recycling allocator for record buffers.  Each distinct record size gets its
+ * own size class; buffers are carved out of heap-allocated slabs and returned
+ * to the class's free list on release, so once the pool has warmed up reading
+ * records does not touch the heap at all.
+ *
+ * A pool is used by a single thread (each reader, and each thread reading with
+ * nara_record_read(), owns its own) but a buffer may be returned on any thread:
+ * one that belongs to another thread's pool is pushed onto that pool's list of
+ * remote frees, which its owner reclaims when it next runs short.
+ *
+ */
+
+#ifndef __NARA_RECORD_POOL_H__
+#define __NARA_RECORD_POOL_H__
+
+#include "nara_base.h"
+
+/*!
+    @typedef nara_record_pool_t
+
+    Opaque reference to a record pool.
+ */
+typedef struct nara_record_pool * nara_record_pool_t;
+
+/*!
+    @typedef nara_record_pool_stats_t
+
+    Counters maintained by a record pool:
+
+        allocations         number of buffers handed out by the pool
+        heapAllocations     number of times the pool itself called malloc()
+        inUse               number of buffers currently handed out (or
+                            freed on another thread but not yet reclaimed)
+
+    In steady state heapAllocations stops increasing.
+ */
+typedef struct {
+    uint64_t        allocations;
+    uint64_t        heapAllocations;
+    uint64_t        inUse;
+} nara_record_pool_stats_t;
+
+/*!
+    @function nara_record_pool_create
+
+    Allocate a new, empty pool.  No slabs are allocated until the first
+    call to nara_record_pool_alloc().
+ */
+nara_record_pool_t nara_record_pool_create(void);
+
+/*!
+    @function nara_record_pool_destroy
+
+    Dispose of the pool and all of its slabs.  Any buffers still handed
+    out become invalid.
+ */
+void nara_record_pool_destroy(nara_record_pool_t pool);
+
+/*!
+    @function nara_record_pool_alloc
+
+    Returns a buffer of at least nBytes, aligned for any record field.
+ */
+void* nara_record_pool_alloc(nara_record_pool_t pool, size_t nBytes);
+
+/*!
+    @function nara_record_pool_free
+
+    Return a buffer obtained from nara_record_pool_alloc() to the pool it
+    came from.  pool is the calling thread's own pool (or NULL); a buffer
+    from any other pool is handed back to that pool's owner, which must not
+    have destroyed it.
+ */
+void nara_record_pool_free(nara_record_pool_t pool, void *buffer);
+
+/*!
+    @function nara_record_pool_get_stats
+
+    Fill-in stats with the pool's current counters.
+ */
+void nara_record_pool_get_stats(nara_record_pool_t pool, nara_record_pool_stats_t *stats);
+
+#endif /* __NARA_RECORD_POOL_H__ */
@@ -13,5 +13,5 @@ nara_state_header_process(
     nara_state_header_t *stateHeader
 )
 {
-    stateHeader->recordLength = nara_be_to_host_16(stateHeader->recordLength);
+    stateHeader->recordLength = nara_be_to_host_u16(stateHeader->recordLength);
 }
@@ -0,0 +1,342 @@
+/*
+ * nara_stats
+ *
+ * Optional conversion statistics:  bytes read, records per type and per state
+ * chunk, record buffers allocated for stdio input, and the time spent in each
+ * stage of the pipeline (read, process, format, write).
+ *
+ * Each thread accumulates into its own block of counters so the hot paths take
+ * no locks; the blocks are summed when the report is produced.  Stage time is
+ * exclusive (e.g. a write(2) triggered while formatting counts as write, not
+ * format) and is summed over all threads.  Each stage is charged both wall
+ * time and the thread's CPU time (CLOCK_THREAD_CPUTIME_ID), so time spent
+ * blocked -- waiting on I/O or on other threads -- shows as the difference.
+ *
+ */
+
+#include "nara_stats.h"
+
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#ifdef HAVE_PTHREADS
+#   include <pthread.h>
+#endif
+
+typedef struct nara_stats_block {
+    struct nara_stats_block *next;
+    uint64_t                bytes;
+    uint64_t                records[nara_stats_records_max];
+    uint64_t                nChunks;
+    uint64_t                chunkRecordsMin;
+    uint64_t                chunkRecordsMax;
+    uint64_t                recordBuffers;
+    uint64_t                recordBufferHeapAllocations;
+    uint64_t                stageNanos[nara_stats_stage_max];
+    uint64_t                stageCPUNanos[nara_stats_stage_max];
+    uint64_t                stamp;
+    uint64_t                cpuStamp;
+    int                     stage;
+} nara_stats_block_t;
+
+typedef struct {
+    uint64_t                wallNanos;
+    double                  userSeconds;
+    double                  systemSeconds;
+} nara_stats_clock_t;
+
+int nara_stats_is_enabled = 0;
+
+static const char           *__nara_stats_stage_labels[nara_stats_stage_max] = {
+                                NULL, "read", "process", "format", "write"
+                            };
+static const char           *__nara_stats_record_labels[nara_stats_records_max] = {
+                                NULL, "district", "school", "classroom", "summary"
+                            };
+
+static nara_stats_clock_t   __nara_stats_start;
+static nara_stats_block_t   *__nara_stats_blocks = NULL;
+static __thread nara_stats_block_t *__nara_stats_local = NULL;
+#ifdef HAVE_PTHREADS
+static pthread_mutex_t      __nara_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/**/
+
+static uint64_t
+__nara_stats_now(void)
+{
+    struct timespec         now;
+    
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**/
+
+static uint64_t
+__nara_stats_cpu_now(void)
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    struct timespec         now;
+    
+    if ( clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0 ) return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+    return 0;
+}
+
+/**/
+
+static void
+__nara_stats_clock(
+    nara_stats_clock_t      *clock
+)
+{
+    struct rusage           usage;
+    
+    clock->wallNanos = __nara_stats_now();
+    getrusage(RUSAGE_SELF, &usage);
+    clock->userSeconds = usage.ru_utime.tv_sec + 1e-6 * usage.ru_utime.tv_usec;
+    clock->systemSeconds = usage.ru_stime.tv_sec + 1e-6 * usage.ru_stime.tv_usec;
+}
+
+/**/
+
+static nara_stats_block_t*
+__nara_stats_block(void)
+{
+    nara_stats_block_t      *block = __nara_stats_local;
+    
+    if ( ! block ) {
+        /* First use on this thread; the block lives until the process exits: */
+        block = (nara_stats_block_t*)calloc(1, sizeof(nara_stats_block_t));
+        if ( ! block ) {
+            static nara_stats_block_t   discarded;
+            
+            return &discarded;
+        }
+        block->stamp = __nara_stats_now();
+        block->cpuStamp = __nara_stats_cpu_now();
+#ifdef HAVE_PTHREADS
+        pthread_mutex_lock(&__nara_stats_lock);
+#endif
+        block->next = __nara_stats_blocks;
+        __nara_stats_blocks = block;
+#ifdef HAVE_PTHREADS
+        pthread_mutex_unlock(&__nara_stats_lock);
+#endif
+        __nara_stats_local = block;
+    }
+    return block;
+}
+
+/**/
+
+void
+nara_stats_enable(void)
+{
+    __nara_stats_clock(&__nara_stats_start);
+    nara_stats_is_enabled = 1;
+}
+
+/**/
+
+void
+__nara_stats_add_bytes(
+    uint64_t                nBytes
+)
+{
+    __nara_stats_block()->bytes += nBytes;
+}
+
+/**/
+
+void
+__nara_stats_add_record(
+    unsigned int            counter
+)
+{
+    if ( counter < nara_stats_records_max ) __nara_stats_block()->records[counter]++;
+}
+
+/**/
+
+void
+__nara_stats_add_records(
+    unsigned int            counter,
+    uint64_t                nRecords
+)
+{
+    if ( counter < nara_stats_records_max ) __nara_stats_block()->records[counter] += nRecords;
+}
+
+/**/
+
+void
+__nara_stats_add_chunk(
+    uint64_t                nRecords
+)
+{
+    nara_stats_block_t      *block = __nara_stats_block();
+    
+    if ( (block->nChunks == 0) || (nRecords < block->chunkRecordsMin) ) block->chunkRecordsMin = nRecords;
+    if ( nRecords > block->chunkRecordsMax ) block->chunkRecordsMax = nRecords;
+    block->nChunks++;
+}
+
+/**/
+
+void
+__nara_stats_add_record_buffers(
+    uint64_t                nAllocations,
+    uint64_t                nHeapAllocations
+)
+{
+    nara_stats_block_t      *block = __nara_stats_block();
+    
+    block->recordBuffers += nAllocations;
+    block->recordBufferHeapAllocations += nHeapAllocations;
+}
+
+/**/
+
+int
+__nara_stats_enter(
+    int                     stage
+)
+{
+    nara_stats_block_t      *block = __nara_stats_block();
+    uint64_t                now = __nara_stats_now(), cpuNow = __nara_stats_cpu_now();
+    int                     previousStage = block->stage;
+    
+    block->stageNanos[block->stage] += now - block->stamp;
+    block->stageCPUNanos[block->stage] += cpuNow - block->cpuStamp;
+    block->stamp = now;
+    block->cpuStamp = cpuNow;
+    block->stage = stage;
+    return previousStage;
+}
+
+/**/
+
+void
+__nara_stats_leave(
+    int                     previousStage
+)
+{
+    __nara_stats_enter(previousStage);
+}
+
+/**/
+
+/*
+ * The summary count is only reported when there were summary (1986) records,
+ * and the classroom count is left out when those were all there was:
+ */
+static int
+__nara_stats_shows_records(
+    const nara_stats_block_t    *total,
+    unsigned int                counter
+)
+{
+    switch ( counter ) {
+        case nara_stats_records_classroom:
+            return ( total->records[nara_stats_records_classroom] || ! total->records[nara_stats_records_summary] );
+        case nara_stats_records_summary:
+            return ( total->records[nara_stats_records_summary] != 0 );
+    }
+    return 1;
+}
+
+/**/
+
+void
+nara_stats_report(
+    FILE                    *fptr,
+    int                     format
+)
+{
+    nara_stats_block_t      total, *block;
+    nara_stats_clock_t      end;
+    uint64_t                nRecords = 0;
+    double                  wallSeconds, chunkRecordsMean = 0.0;
+    unsigned int            i;
+    
+    __nara_stats_clock(&end);
+    wallSeconds = 1e-9 * (end.wallNanos - __nara_stats_start.wallNanos);
+    
+    /* Sum the per-thread blocks: */
+    memset(&total, 0, sizeof(total));
+#ifdef HAVE_PTHREADS
+    pthread_mutex_lock(&__nara_stats_lock);
+#endif
+    for ( block = __nara_stats_blocks; block; block = block->next ) {
+        total.bytes += block->bytes;
+        for ( i = 0; i < nara_stats_records_max; i++ ) total.records[i] += block->records[i];
+        for ( i = 0; i < nara_stats_stage_max; i++ ) {
+            total.stageNanos[i] += block->stageNanos[i];
+            total.stageCPUNanos[i] += block->stageCPUNanos[i];
+        }
+        total.recordBuffers += block->recordBuffers;
+        total.recordBufferHeapAllocations += block->recordBufferHeapAllocations;
+        if ( block->nChunks ) {
+            if ( (total.nChunks == 0) || (block->chunkRecordsMin < total.chunkRecordsMin) ) total.chunkRecordsMin = block->chunkRecordsMin;
+            if ( block->chunkRecordsMax > total.chunkRecordsMax ) total.chunkRecordsMax = block->chunkRecordsMax;
+            total.nChunks += block->nChunks;
+        }
+    }
+#ifdef HAVE_PTHREADS
+    pthread_mutex_unlock(&__nara_stats_lock);
+#endif
+    for ( i = 1; i < nara_stats_records_max; i++ ) nRecords += total.records[i];
+    if ( total.nChunks ) chunkRecordsMean = (double)nRecords / (double)total.nChunks;
+    if ( wallSeconds <= 0.0 ) wallSeconds = 1e-9;
+    
+    switch ( format ) {
+        
+        case nara_stats_report_json: {
+            fprintf(fptr, "{\"bytesRead\":%llu,\"records\":{\"total\":%llu", (unsigned long long)total.bytes, (unsigned long long)nRecords);
+            for ( i = 1; i < nara_stats_records_max; i++ )
+                if ( __nara_stats_shows_records(&total, i) ) fprintf(fptr, ",\"%s\":%llu", __nara_stats_record_labels[i], (unsigned long long)total.records[i]);
+            fprintf(fptr, "},\"chunks\":{\"count\":%llu,\"recordsMin\":%llu,\"recordsMean\":%.3f,\"recordsMax\":%llu}",
+                    (unsigned long long)total.nChunks, (unsigned long long)total.chunkRecordsMin, chunkRecordsMean, (unsigned long long)total.chunkRecordsMax
+                );
+            fprintf(fptr, ",\"recordBuffers\":{\"allocations\":%llu,\"heapAllocations\":%llu}", (unsigned long long)total.recordBuffers, (unsigned long long)total.recordBufferHeapAllocations);
+            fprintf(fptr, ",\"wallSeconds\":%.6f,\"cpuSeconds\":{\"user\":%.6f,\"system\":%.6f},\"stageSeconds\":{",
+                    wallSeconds, end.userSeconds - __nara_stats_start.userSeconds, end.systemSeconds - __nara_stats_start.systemSeconds
+                );
+            for ( i = 1; i < nara_stats_stage_max; i++ ) fprintf(fptr, "%s\"%s\":%.6f", (i > 1) ? "," : "", __nara_stats_stage_labels[i], 1e-9 * total.stageNanos[i]);
+            fprintf(fptr, "},\"stageCPUSeconds\":{");
+            for ( i = 1; i < nara_stats_stage_max; i++ ) fprintf(fptr, "%s\"%s\":%.6f", (i > 1) ? "," : "", __nara_stats_stage_labels[i], 1e-9 * total.stageCPUNanos[i]);
+            fprintf(fptr, "},\"recordsPerSecond\":%.1f,\"megabytesPerSecond\":%.3f}\n", nRecords / wallSeconds, 1e-6 * total.bytes / wallSeconds);
+            break;
+        }
+        
+        default: {
+            fprintf(fptr, "statistics:\n");
+            fprintf(fptr, "  bytes read:          %llu\n", (unsigned long long)total.bytes);
+            fprintf(fptr, "  records:             %llu\n", (unsigned long long)nRecords);
+            for ( i = 1; i < nara_stats_records_max; i++ )
+                if ( __nara_stats_shows_records(&total, i) ) fprintf(fptr, "    %-18s%llu\n", __nara_stats_record_labels[i], (unsigned long long)total.records[i]);
+            if ( total.nChunks ) {
+                fprintf(fptr, "  state chunks:        %llu (records per chunk: min %llu, mean %.1f, max %llu)\n",
+                        (unsigned long long)total.nChunks, (unsigned long long)total.chunkRecordsMin, chunkRecordsMean, (unsigned long long)total.chunkRecordsMax
+                    );
+            }
+            if ( total.recordBuffers ) {
+                fprintf(fptr, "  record buffers:      %llu (heap allocations: %llu)\n",
+                        (unsigned long long)total.recordBuffers, (unsigned long long)total.recordBufferHeapAllocations
+                    );
+            }
+            fprintf(fptr, "  wall time:           %.3f s\n", wallSeconds);
+            fprintf(fptr, "  cpu time:            %.3f s user, %.3f s system\n", end.userSeconds - __nara_stats_start.userSeconds, end.systemSeconds - __nara_stats_start.systemSeconds);
+            fprintf(fptr, "  stage time (summed over threads):\n");
+            for ( i = 1; i < nara_stats_stage_max; i++ )
+                fprintf(fptr, "    %-18s%.3f s (cpu %.3f s)\n", __nara_stats_stage_labels[i], 1e-9 * total.stageNanos[i], 1e-9 * total.stageCPUNanos[i]);
+            fprintf(fptr, "  throughput:          %.0f records/s, %.2f MB/s\n", nRecords / wallSeconds, 1e-6 * total.bytes / wallSeconds);
+            break;
+        }
+        
+    }
+}
@@ -0,0 +1,185 @@
+/*
+ * nara_stats
+ *
+ * Optional conversion statistics:  bytes read, records per type and per state
+ * chunk, record buffers allocated for stdio input, and the time spent in each
+ * stage of the pipeline (read, process, format, write).
+ *
+ * Each thread accumulates into its own block of counters so the hot paths take
+ * no locks; the blocks are summed when the report is produced.  Stage time is
+ * exclusive (e.g. a write(2) triggered while formatting counts as write, not
+ * format) and is summed over all threads; each stage reports both wall time
+ * and the CPU time of the threads that were in it.
+ *
+ * When statistics are not enabled every hook reduces to a single test of
+ * nara_stats_is_enabled.
+ *
+ */
+
+#ifndef __NARA_STATS_H__
+#define __NARA_STATS_H__
+
+#include "nara_base.h"
+
+/*!
+    @enum nara_stats_stage
+
+    The pipeline stages that are timed.  nara_stats_stage_none is time not
+    attributed to any stage.
+ */
+enum {
+    nara_stats_stage_none = 0,
+    nara_stats_stage_read,
+    nara_stats_stage_process,
+    nara_stats_stage_format,
+    nara_stats_stage_write,
+    nara_stats_stage_max
+};
+
+/*!
+    @enum nara_stats_report_format
+
+    Formats for nara_stats_report().
+ */
+enum {
+    nara_stats_report_text = 0,
+    nara_stats_report_json
+};
+
+/*!
+    @enum nara_stats_records
+
+    The record counters:  one per record type, plus one for the 1986 summary
+    records (which take the place of the classroom records in that layout).
+ */
+enum {
+    nara_stats_records_district = 1,
+    nara_stats_records_school,
+    nara_stats_records_classroom,
+    nara_stats_records_summary,
+    nara_stats_records_max
+};
+
+extern int nara_stats_is_enabled;
+
+/*!
+    @function nara_stats_enable
+
+    Start collecting statistics; the wall and CPU clocks for the report start
+    now.
+ */
+void nara_stats_enable(void);
+
+/*!
+    @function nara_stats_report
+
+    Write the statistics collected so far to fptr in the given format.  All
+    threads that contributed must have finished.
+ */
+void nara_stats_report(FILE *fptr, int format);
+
+void __nara_stats_add_bytes(uint64_t nBytes);
+void __nara_stats_add_record(unsigned int counter);
+void __nara_stats_add_records(unsigned int counter, uint64_t nRecords);
+void __nara_stats_add_chunk(uint64_t nRecords);
+void __nara_stats_add_record_buffers(uint64_t nAllocations, uint64_t nHeapAllocations);
+int __nara_stats_enter(int stage);
+void __nara_stats_leave(int previousStage);
+
+/*!
+    @function nara_stats_add_bytes
+
+    Count nBytes consumed from an input source.
+ */
+static inline void
+nara_stats_add_bytes(
+    uint64_t    nBytes
+)
+{
+    if ( nara_stats_is_enabled ) __nara_stats_add_bytes(nBytes);
+}
+
+/*!
+    @function nara_stats_add_record
+
+    Count a record against the given counter (a nara_stats_records_* value).
+ */
+static inline void
+nara_stats_add_record(
+    unsigned int    counter
+)
+{
+    if ( nara_stats_is_enabled ) __nara_stats_add_record(counter);
+}
+
+/*!
+    @function nara_stats_add_records
+
+    Count nRecords records against the given counter at once.
+ */
+static inline void
+nara_stats_add_records(
+    unsigned int    counter,
+    uint64_t        nRecords
+)
+{
+    if ( nara_stats_is_enabled ) __nara_stats_add_records(counter, nRecords);
+}
+
+/*!
+    @function nara_stats_add_chunk
+
+    Count a (pre-1976) state chunk containing nRecords records.
+ */
+static inline void
+nara_stats_add_chunk(
+    uint64_t    nRecords
+)
+{
+    if ( nara_stats_is_enabled ) __nara_stats_add_chunk(nRecords);
+}
+
+/*!
+    @function nara_stats_add_record_buffers
+
+    Count the record buffers a record pool handed out (nAllocations) and the
+    heap allocations it made to do so (nHeapAllocations).
+ */
+static inline void
+nara_stats_add_record_buffers(
+    uint64_t    nAllocations,
+    uint64_t    nHeapAllocations
+)
+{
+    if ( nara_stats_is_enabled ) __nara_stats_add_record_buffers(nAllocations, nHeapAllocations);
+}
+
+/*!
+    @function nara_stats_enter
+
+    Charge the calling thread's time from here on to stage.  Returns the
+    stage that was in effect, to be passed to nara_stats_leave() at the end
+    of the timed section.  Sections may nest.
+ */
+static inline int
+nara_stats_enter(
+    int         stage
+)
+{
+    return nara_stats_is_enabled ? __nara_stats_enter(stage) : nara_stats_stage_none;
+}
+
+/*!
+    @function nara_stats_leave
+
+    End a section begun with nara_stats_enter().
+ */
+static inline void
+nara_stats_leave(
+    int         previousStage
+)
+{
+    if ( nara_stats_is_enabled ) __nara_stats_leave(previousStage);
+}
+
+#endif /* __NARA_STATS_H__ */
@@ -16,34 +16,21 @@ typedef union {
 
 /**/
 
-int
-__nara_record_is_type_classroom(
-    nara_record_t*      theRecord,
-    size_t              byteSize
-)
-{
-    return ( (byteSize == 40) && (nara_be_to_host_32(theRecord->recordType) == nara_record_type_classroom) );
-}
-
-/**/
-
-nara_record_t*
+static nara_record_t*
 __nara_record_process_classroom(
     nara_record_t*      theRecord
 )
 {
     nara_classroom_internal_t   *classroom = (nara_classroom_internal_t*)theRecord;
-    unsigned int                i, iMax;
     
-    iMax = sizeof(classroom->compact.f1) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) classroom->compact.f1[i] = nara_be_to_host_32(classroom->compact.f1[i]);
+    nara_be_to_host_u32_array(classroom->compact.f1, sizeof(classroom->compact.f1) / sizeof(uint32_t));
     
     return theRecord;
 }
 
 /**/
 
-void
+static void
 __nara_export_init_classroom(
     nara_export_context_t   exportContext
 )
@@ -63,16 +50,16 @@ __nara_export_init_classroom(
             /*
              * Write column headers to the file:
              */
-            if ( CONTEXT->classroomFptr ) {
-                fprintf(CONTEXT->classroomFptr,
+            if ( CONTEXT->classroomOut ) {
+                EMIT_LITERAL(CONTEXT->classroomOut,
                         "schoolSystemCode,"
                         "schoolCode,"
                         "gradeLevel,"
                         "classroomCode,"
                     );
                 for ( i = 0; i < nara_ethnicity_total - 1; i++ )
-                    fprintf(CONTEXT->classroomFptr, "\"pupilCounts_%s\",", nara_ethnicity_labels[i]);
-                fprintf(CONTEXT->classroomFptr, "\"pupilCounts_%s\"\n", nara_ethnicity_labels[i]);
+                    EMIT_STR(CONTEXT->classroomOut, "\"pupilCounts_", nara_ethnicity_labels[i], "\",");
+                EMIT_STR(CONTEXT->classroomOut, "\"pupilCounts_", nara_ethnicity_labels[i], "\"\n");
             }
             break;
         }
@@ -81,7 +68,7 @@ __nara_export_init_classroom(
 
 /**/
 
-void
+static void
 __nara_export_destroy_classroom(
     nara_export_context_t   exportContext
 )
@@ -90,7 +77,7 @@ __nara_export_destroy_classroom(
 
 /**/
 
-void
+static void
 __nara_record_export_classroom(
     nara_export_context_t   exportContext,
     nara_record_t           *theRecord
@@ -105,21 +92,17 @@ __nara_record_export_classroom(
         case nara_export_format_yaml: {
             nara_export_context_yaml_t  *CONTEXT = (nara_export_context_yaml_t*)exportContext;
             
-            if ( CONTEXT->fptr ) {
-                fprintf(CONTEXT->fptr,
-                        "- recordType: classroom\n"
-                        "  schoolSystemCode: %u\n"
-                        "  schoolCode: %u\n"
-                        "  gradeLevel: %u\n"
-                        "  classroomCode: %u\n"
-                        "  pupilCounts:\n",
-                        classroom->schoolSystemCode,
-                        classroom->schoolCode,
-                        classroom->gradeLevel,
-                        classroom->classroomCode
-                    );
-                for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], classroom->pupilCounts[i]);
+            if ( CONTEXT->out ) {
+                EMIT_LITERAL(CONTEXT->out, "- recordType: classroom\n");
+                EMIT_U32(CONTEXT->out, "  schoolSystemCode: ", classroom->schoolSystemCode, "\n");
+                EMIT_U32(CONTEXT->out, "  schoolCode: ", classroom->schoolCode, "\n");
+                EMIT_U32(CONTEXT->out, "  gradeLevel: ", classroom->gradeLevel, "\n");
+                EMIT_U32(CONTEXT->out, "  classroomCode: ", classroom->classroomCode, "\n");
+                EMIT_LITERAL(CONTEXT->out, "  pupilCounts:\n");
+                for ( i = 0; i < nara_ethnicity_total; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", classroom->pupilCounts[i], "\n");
+                }
             }
             break;
         }
@@ -127,20 +110,14 @@ __nara_record_export_classroom(
         case nara_export_format_csv: {
             nara_export_context_csv_t   *CONTEXT = (nara_export_context_csv_t*)exportContext;
             
-            if ( CONTEXT->classroomFptr ) {
-                fprintf(CONTEXT->classroomFptr,
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,",
-                        classroom->schoolSystemCode,
-                        classroom->schoolCode,
-                        classroom->gradeLevel,
-                        classroom->classroomCode
-                    );
+            if ( CONTEXT->classroomOut ) {
+                EMIT_U32(CONTEXT->classroomOut, "", classroom->schoolSystemCode, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", classroom->schoolCode, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", classroom->gradeLevel, ",");
+                EMIT_U32(CONTEXT->classroomOut, "", classroom->classroomCode, ",");
                 for ( i = 0; i < nara_ethnicity_total - 1; i++ )
-                    fprintf(CONTEXT->classroomFptr, "%u,", classroom->pupilCounts[i]);
-                fprintf(CONTEXT->classroomFptr, "%u\n", classroom->pupilCounts[i]);
+                    EMIT_U32(CONTEXT->classroomOut, "", classroom->pupilCounts[i], ",");
+                EMIT_U32(CONTEXT->classroomOut, "", classroom->pupilCounts[i], "\n");
             }
             break;
         }
@@ -149,12 +126,18 @@ __nara_record_export_classroom(
 
 /**/
 
-nara_record_t*
-__nara_record_destroy_classroom(
-    nara_record_t       *theRecord
+static void
+__nara_record_columns_classroom(
+    nara_record_columns_t   columns
 )
 {
-    free((void*)theRecord);
-    return NULL;
+    unsigned int            i;
+    
+    COLUMN_U32(columns, nara_classroom_t, schoolSystemCode, "schoolSystemCode");
+    COLUMN_U32(columns, nara_classroom_t, schoolCode, "schoolCode");
+    COLUMN_U32(columns, nara_classroom_t, gradeLevel, "gradeLevel");
+    COLUMN_U32(columns, nara_classroom_t, classroomCode, "classroomCode");
+    for ( i = 0; i < nara_ethnicity_total; i++ )
+        COLUMN_U32(columns, nara_classroom_t, pupilCounts[i], "\"pupilCounts_%s\"", nara_ethnicity_labels[i]);
 }
     
\ No newline at end of file
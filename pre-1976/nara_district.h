@@ -22,8 +22,6 @@ enum {
     nara_ethnicity_max
 };
 
-extern const char* nara_ethnicity_labels[nara_ethnicity_max];
-
 typedef struct {
     uint32_t        recordType;
     uint32_t        schoolSystemCode;
@@ -7,7 +7,7 @@
 
 #include "nara_district.h"
 
-const char* nara_ethnicity_labels[nara_ethnicity_max] = {
+static const char* nara_ethnicity_labels[nara_ethnicity_max] = {
                 "American Indian",
                 "Black",
                 "Asian American",
@@ -35,18 +35,7 @@ typedef union {
 
 /**/
 
-int
-__nara_record_is_type_district(
-    nara_record_t*      theRecord,
-    size_t              byteSize
-)
-{
-    return ( (byteSize == 472) && (nara_be_to_host_32(theRecord->recordType) == nara_record_type_district) );
-}
-
-/**/
-
-nara_record_t*
+static nara_record_t*
 __nara_record_process_district(
     nara_record_t*      theRecord
 )
@@ -56,16 +45,11 @@ __nara_record_process_district(
     char                        *fromPtr, *toPtr;
     size_t                      fromLen, toLen;
     
-    unsigned int                i, iMax;
+    nara_be_to_host_u32_array(district->compact.f1, sizeof(district->compact.f1) / sizeof(uint32_t));
     
-    iMax = sizeof(district->compact.f1) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) district->compact.f1[i] = nara_be_to_host_32(district->compact.f1[i]);
+    nara_be_to_host_u32_array(district->compact.f2, sizeof(district->compact.f2) / sizeof(uint32_t));
     
-    iMax = sizeof(district->compact.f2) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) district->compact.f2[i] = nara_be_to_host_32(district->compact.f2[i]);
-    
-    iMax = sizeof(district->compact.f3) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) district->compact.f3[i] = nara_be_to_host_32(district->compact.f3[i]);
+    nara_be_to_host_u32_array(district->compact.f3, sizeof(district->compact.f3) / sizeof(uint32_t));
     
     TRANSCODE(district, systemName, "district name");
     TRANSCODE(district, systemStreetAddr, "district street address");
@@ -81,7 +65,7 @@ __nara_record_process_district(
 
 /**/
 
-void
+static void
 __nara_export_init_district(
     nara_export_context_t   exportContext
 )
@@ -101,8 +85,8 @@ __nara_export_init_district(
             /*
              * Write column headers to the file:
              */
-            if ( CONTEXT->districtFptr ) {
-                fprintf(CONTEXT->districtFptr,
+            if ( CONTEXT->districtOut ) {
+                EMIT_LITERAL(CONTEXT->districtOut,
                         "schoolSystemCode,"
                         "oeCode1970,"
                         "srgCode,"
@@ -135,35 +119,35 @@ __nara_export_init_district(
                         "samplingWeight,"
                     );
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilCounts_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"expelledPupilCounts_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"expelledPupilCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"systemTeacherCounts_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"systemTeacherCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"professionalStaffCounts_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"professionalStaffCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"professionalsInMoreThanOneSchool_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"professionalsInMoreThanOneSchool_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsInAnotherSystemCounts_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsInAnotherSystemCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsInNonPublicSchoolsCounts_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsInNonPublicSchoolsCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsSchoolAgeNotInSchoolCounts_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsSchoolAgeNotInSchoolCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsNonResidentCounts_%s\",", nara_ethnicity_labels[i]);
-    
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsNonResidentCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_total - 1; i++ )
-                    fprintf(CONTEXT->districtFptr, "\"pupilsResidentCounts_%s\",", nara_ethnicity_labels[i]);
-                fprintf(CONTEXT->districtFptr, "\"pupilsResidentCounts_%s\"\n", nara_ethnicity_labels[i]);
+                    EMIT_STR(CONTEXT->districtOut, "\"pupilsResidentCounts_", nara_ethnicity_labels[i], "\",");
+                EMIT_STR(CONTEXT->districtOut, "\"pupilsResidentCounts_", nara_ethnicity_labels[i], "\"\n");
             }
             break;
         }
@@ -172,7 +156,7 @@ __nara_export_init_district(
 
 /**/
 
-void
+static void
 __nara_export_destroy_district(
     nara_export_context_t   exportContext
 )
@@ -181,7 +165,7 @@ __nara_export_destroy_district(
 
 /**/
 
-void
+static void
 __nara_record_export_district(
     nara_export_context_t   exportContext,
     nara_record_t           *theRecord
@@ -214,110 +198,98 @@ __nara_record_export_district(
         case nara_export_format_yaml: {
             nara_export_context_yaml_t  *CONTEXT = (nara_export_context_yaml_t*)exportContext;
             
-            if ( CONTEXT->fptr ) {
-                fprintf(CONTEXT->fptr,
-                        "- recordType: district\n"
-                        "  schoolSystemCode: %u\n"
-                        "  oeCode1970: %u\n"
-                        "  srgCode: \"%s\"\n"
-                        "  systemName: \"%s\"\n"
-                        "  systemStreetAddr: \"%s\"\n"
-                        "  systemCity: \"%s\"\n"
-                        "  systemCounty: \"%s\"\n"
-                        "  systemState: \"%s\"\n"
-                        "  systemZipCode: \"%s\"\n"
-                        "  systemAdminOfficer: \"%s\"\n"
-                        "  numSchoolCampusForms: %u\n"
-                        "  nonResidentPupils: %u\n"
-                        "  residentPupils: %u\n"
-                        "  residentPupilsInOtherSystem: %u\n"
-                        "  residentPupilsInNonpublicSchools: %u\n"
-                        "  residentSchoolAgeNotInSchool: %u\n"
-                        "  bilingualInstruction: %u\n"
-                        "  bilingualTeacherCount: %u\n"
-                        "  bilingualPupilCount: %u\n"
-                        "  bilingualInstructionMaterials: %u\n"
-                        "  newSchoolProperty: %u\n"
-                        "  newSchoolConstruction: %u\n"
-                        "  newSchoolCapacity: %u\n"
-                        "  newSchoolGreaterMinorityComposition: %u\n"
-                        "  year: %u\n"
-                        "  stateCode: %u\n"
-                        "  assurance: %u\n"
-                        "  litigationCode: %u\n"
-                        "  selectionCode: %u\n"
-                        "  samplingWeight: %u\n",
-                        district->schoolSystemCode,
-                        district->oeCode1970,
-                        srgCode,
-                        systemName,
-                        systemStreetAddr,
-                        systemCity,
-                        systemCounty,
-                        systemState,
-                        systemZipCode,
-                        systemAdminOfficer,
-                        district->numSchoolCampusForms,
-                        district->nonResidentPupils,
-                        district->residentPupils,
-                        district->residentPupilsInOtherSystem,
-                        district->residentPupilsInNonpublicSchools,
-                        district->residentSchoolAgeNotInSchool,
-                        district->bilingualInstruction,
-                        district->bilingualTeacherCount,
-                        district->bilingualPupilCount,
-                        district->bilingualInstructionMaterials,
-                        district->newSchoolProperty,
-                        district->newSchoolConstruction,
-                        district->newSchoolCapacity,
-                        district->newSchoolGreaterMinorityComposition,
-                        district->year,
-                        district->stateCode,
-                        district->assurance,
-                        district->litigationCode,
-                        district->selectionCode,
-                        district->samplingWeight
-                    );
-        
-                fprintf(CONTEXT->fptr, "  pupilCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  expelledPupilCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->expelledPupilCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  systemTeacherCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->systemTeacherCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  professionalStaffCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->professionalStaffCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  professionalsInMoreThanOneSchool:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->professionalsInMoreThanOneSchool[i]);
-        
-                fprintf(CONTEXT->fptr, "  pupilsInAnotherSystemCounts:\n");
-                for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsInAnotherSystemCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  pupilsInNonPublicSchoolsCounts:\n");
-                for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsInNonPublicSchoolsCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  pupilsSchoolAgeNotInSchoolCounts:\n");
-                for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsSchoolAgeNotInSchoolCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  pupilsNonResidentCounts:\n");
-                for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsNonResidentCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  pupilsResidentCounts:\n");
-                for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], district->pupilsResidentCounts[i]);
+            if ( CONTEXT->out ) {
+                EMIT_LITERAL(CONTEXT->out, "- recordType: district\n");
+                EMIT_U32(CONTEXT->out, "  schoolSystemCode: ", district->schoolSystemCode, "\n");
+                EMIT_U32(CONTEXT->out, "  oeCode1970: ", district->oeCode1970, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  srgCode: ", srgCode, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  systemName: ", systemName, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  systemStreetAddr: ", systemStreetAddr, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  systemCity: ", systemCity, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  systemCounty: ", systemCounty, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  systemState: ", systemState, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  systemZipCode: ", systemZipCode, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  systemAdminOfficer: ", systemAdminOfficer, "\n");
+                EMIT_U32(CONTEXT->out, "  numSchoolCampusForms: ", district->numSchoolCampusForms, "\n");
+                EMIT_U32(CONTEXT->out, "  nonResidentPupils: ", district->nonResidentPupils, "\n");
+                EMIT_U32(CONTEXT->out, "  residentPupils: ", district->residentPupils, "\n");
+                EMIT_U32(CONTEXT->out, "  residentPupilsInOtherSystem: ", district->residentPupilsInOtherSystem, "\n");
+                EMIT_U32(CONTEXT->out, "  residentPupilsInNonpublicSchools: ", district->residentPupilsInNonpublicSchools, "\n");
+                EMIT_U32(CONTEXT->out, "  residentSchoolAgeNotInSchool: ", district->residentSchoolAgeNotInSchool, "\n");
+                EMIT_U32(CONTEXT->out, "  bilingualInstruction: ", district->bilingualInstruction, "\n");
+                EMIT_U32(CONTEXT->out, "  bilingualTeacherCount: ", district->bilingualTeacherCount, "\n");
+                EMIT_U32(CONTEXT->out, "  bilingualPupilCount: ", district->bilingualPupilCount, "\n");
+                EMIT_U32(CONTEXT->out, "  bilingualInstructionMaterials: ", district->bilingualInstructionMaterials, "\n");
+                EMIT_U32(CONTEXT->out, "  newSchoolProperty: ", district->newSchoolProperty, "\n");
+                EMIT_U32(CONTEXT->out, "  newSchoolConstruction: ", district->newSchoolConstruction, "\n");
+                EMIT_U32(CONTEXT->out, "  newSchoolCapacity: ", district->newSchoolCapacity, "\n");
+                EMIT_U32(CONTEXT->out, "  newSchoolGreaterMinorityComposition: ", district->newSchoolGreaterMinorityComposition, "\n");
+                EMIT_U32(CONTEXT->out, "  year: ", district->year, "\n");
+                EMIT_U32(CONTEXT->out, "  stateCode: ", district->stateCode, "\n");
+                EMIT_U32(CONTEXT->out, "  assurance: ", district->assurance, "\n");
+                EMIT_U32(CONTEXT->out, "  litigationCode: ", district->litigationCode, "\n");
+                EMIT_U32(CONTEXT->out, "  selectionCode: ", district->selectionCode, "\n");
+                EMIT_U32(CONTEXT->out, "  samplingWeight: ", district->samplingWeight, "\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  expelledPupilCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->expelledPupilCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  systemTeacherCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->systemTeacherCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  professionalStaffCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->professionalStaffCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  professionalsInMoreThanOneSchool:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->professionalsInMoreThanOneSchool[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsInAnotherSystemCounts:\n");
+                for ( i = 0; i < nara_ethnicity_total; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsInAnotherSystemCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsInNonPublicSchoolsCounts:\n");
+                for ( i = 0; i < nara_ethnicity_total; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsInNonPublicSchoolsCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsSchoolAgeNotInSchoolCounts:\n");
+                for ( i = 0; i < nara_ethnicity_total; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsSchoolAgeNotInSchoolCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsNonResidentCounts:\n");
+                for ( i = 0; i < nara_ethnicity_total; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsNonResidentCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilsResidentCounts:\n");
+                for ( i = 0; i < nara_ethnicity_total; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", district->pupilsResidentCounts[i], "\n");
+                }
             }            
             break;
         }
@@ -325,99 +297,67 @@ __nara_record_export_district(
         case nara_export_format_csv: {
             nara_export_context_csv_t   *CONTEXT = (nara_export_context_csv_t*)exportContext;
             
-            if ( CONTEXT->districtFptr ) {
-                fprintf(CONTEXT->districtFptr,
-                        "%u,"
-                        "%u,"
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,",
-                        district->schoolSystemCode,
-                        district->oeCode1970,
-                        srgCode,
-                        systemName,
-                        systemStreetAddr,
-                        systemCity,
-                        systemCounty,
-                        systemState,
-                        systemZipCode,
-                        systemAdminOfficer,
-                        district->numSchoolCampusForms,
-                        district->nonResidentPupils,
-                        district->residentPupils,
-                        district->residentPupilsInOtherSystem,
-                        district->residentPupilsInNonpublicSchools,
-                        district->residentSchoolAgeNotInSchool,
-                        district->bilingualInstruction,
-                        district->bilingualTeacherCount,
-                        district->bilingualPupilCount,
-                        district->bilingualInstructionMaterials,
-                        district->newSchoolProperty,
-                        district->newSchoolConstruction,
-                        district->newSchoolCapacity,
-                        district->newSchoolGreaterMinorityComposition,
-                        district->year,
-                        district->stateCode,
-                        district->assurance,
-                        district->litigationCode,
-                        district->selectionCode,
-                        district->samplingWeight
-                    );
+            if ( CONTEXT->districtOut ) {
+                EMIT_U32(CONTEXT->districtOut, "", district->schoolSystemCode, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->oeCode1970, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", srgCode, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemName, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemStreetAddr, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemCity, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemCounty, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemState, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemZipCode, ",");
+                EMIT_QUOTED_STR(CONTEXT->districtOut, "", systemAdminOfficer, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->numSchoolCampusForms, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->nonResidentPupils, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->residentPupils, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->residentPupilsInOtherSystem, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->residentPupilsInNonpublicSchools, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->residentSchoolAgeNotInSchool, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->bilingualInstruction, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->bilingualTeacherCount, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->bilingualPupilCount, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->bilingualInstructionMaterials, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->newSchoolProperty, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->newSchoolConstruction, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->newSchoolCapacity, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->newSchoolGreaterMinorityComposition, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->year, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->stateCode, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->assurance, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->litigationCode, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->selectionCode, ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->samplingWeight, ",");
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilCounts[i]);
-        
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->expelledPupilCounts[i]);
-        
+                    EMIT_U32(CONTEXT->districtOut, "", district->expelledPupilCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->systemTeacherCounts[i]);
-        
+                    EMIT_U32(CONTEXT->districtOut, "", district->systemTeacherCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->professionalStaffCounts[i]);
-        
+                    EMIT_U32(CONTEXT->districtOut, "", district->professionalStaffCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->professionalsInMoreThanOneSchool[i]);
-        
+                    EMIT_U32(CONTEXT->districtOut, "", district->professionalsInMoreThanOneSchool[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsInAnotherSystemCounts[i]);
-        
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsInAnotherSystemCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsInNonPublicSchoolsCounts[i]);
-        
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsInNonPublicSchoolsCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsSchoolAgeNotInSchoolCounts[i]);
-        
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsSchoolAgeNotInSchoolCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_total; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsNonResidentCounts[i]);
-        
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsNonResidentCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_total - 1; i++ )
-                    fprintf(CONTEXT->districtFptr, "%u,", district->pupilsResidentCounts[i]);
-                fprintf(CONTEXT->districtFptr, "%u\n", district->pupilsResidentCounts[i]);
+                    EMIT_U32(CONTEXT->districtOut, "", district->pupilsResidentCounts[i], ",");
+                EMIT_U32(CONTEXT->districtOut, "", district->pupilsResidentCounts[i], "\n");
             }
             break;
         }
@@ -427,12 +367,62 @@ __nara_record_export_district(
 
 /**/
 
-nara_record_t*
-__nara_record_destroy_district(
-    nara_record_t       *theRecord
+static void
+__nara_record_columns_district(
+    nara_record_columns_t   columns
 )
 {
-    free((void*)theRecord);
-    return NULL;
+    unsigned int            i;
+    
+    COLUMN_U32(columns, nara_district_t, schoolSystemCode, "schoolSystemCode");
+    COLUMN_U32(columns, nara_district_t, oeCode1970, "oeCode1970");
+    COLUMN_STR(columns, nara_district_t, srgCode, "srgCode");
+    COLUMN_STR(columns, nara_district_t, systemName, "systemName");
+    COLUMN_STR(columns, nara_district_t, systemStreetAddr, "systemStreetAddr");
+    COLUMN_STR(columns, nara_district_t, systemCity, "systemCity");
+    COLUMN_STR(columns, nara_district_t, systemCounty, "systemCounty");
+    COLUMN_STR(columns, nara_district_t, systemState, "systemState");
+    COLUMN_STR(columns, nara_district_t, systemZipCode, "systemZipCode");
+    COLUMN_STR(columns, nara_district_t, systemAdminOfficer, "systemAdminOfficer");
+    COLUMN_U32(columns, nara_district_t, numSchoolCampusForms, "numSchoolCampusForms");
+    COLUMN_U32(columns, nara_district_t, nonResidentPupils, "nonResidentPupils");
+    COLUMN_U32(columns, nara_district_t, residentPupils, "residentPupils");
+    COLUMN_U32(columns, nara_district_t, residentPupilsInOtherSystem, "residentPupilsInOtherSystem");
+    COLUMN_U32(columns, nara_district_t, residentPupilsInNonpublicSchools, "residentPupilsInNonpublicSchools");
+    COLUMN_U32(columns, nara_district_t, residentSchoolAgeNotInSchool, "residentSchoolAgeNotInSchool");
+    COLUMN_U32(columns, nara_district_t, bilingualInstruction, "bilingualInstruction");
+    COLUMN_U32(columns, nara_district_t, bilingualTeacherCount, "bilingualTeacherCount");
+    COLUMN_U32(columns, nara_district_t, bilingualPupilCount, "bilingualPupilCount");
+    COLUMN_U32(columns, nara_district_t, bilingualInstructionMaterials, "bilingualInstructionMaterials");
+    COLUMN_U32(columns, nara_district_t, newSchoolProperty, "newSchoolProperty");
+    COLUMN_U32(columns, nara_district_t, newSchoolConstruction, "newSchoolConstruction");
+    COLUMN_U32(columns, nara_district_t, newSchoolCapacity, "newSchoolCapacity");
+    COLUMN_U32(columns, nara_district_t, newSchoolGreaterMinorityComposition, "newSchoolGreaterMinorityComposition");
+    COLUMN_U32(columns, nara_district_t, year, "year");
+    COLUMN_U32(columns, nara_district_t, stateCode, "stateCode");
+    COLUMN_U32(columns, nara_district_t, assurance, "assurance");
+    COLUMN_U32(columns, nara_district_t, litigationCode, "litigationCode");
+    COLUMN_U32(columns, nara_district_t, selectionCode, "selectionCode");
+    COLUMN_U32(columns, nara_district_t, samplingWeight, "samplingWeight");
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilCounts[i], "\"pupilCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, expelledPupilCounts[i], "\"expelledPupilCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, systemTeacherCounts[i], "\"systemTeacherCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, professionalStaffCounts[i], "\"professionalStaffCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_district_t, professionalsInMoreThanOneSchool[i], "\"professionalsInMoreThanOneSchool_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_total; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsInAnotherSystemCounts[i], "\"pupilsInAnotherSystemCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_total; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsInNonPublicSchoolsCounts[i], "\"pupilsInNonPublicSchoolsCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_total; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsSchoolAgeNotInSchoolCounts[i], "\"pupilsSchoolAgeNotInSchoolCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_total; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsNonResidentCounts[i], "\"pupilsNonResidentCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_total; i++ )
+        COLUMN_U32(columns, nara_district_t, pupilsResidentCounts[i], "\"pupilsResidentCounts_%s\"", nara_ethnicity_labels[i]);
 }
     
\ No newline at end of file
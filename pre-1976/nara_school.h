@@ -32,7 +32,6 @@ enum {
     nara_grade_max
 };
 
-extern const char* nara_grade_labels[nara_grade_max];
     
 enum {
     nara_empl_teacher = 0,
@@ -42,8 +41,6 @@ enum {
     nara_empl_max
 };
 
-extern const char* nara_empl_labels[nara_empl_max];
-
 enum {
     nara_section_distrib_0_to_19 = 0,
     nara_section_distrib_20_to_49,
@@ -52,8 +49,6 @@ enum {
     nara_section_distrib_max
 };
 
-extern const char* nara_section_distrib_labels[nara_section_distrib_max];
-
 typedef struct {
     uint32_t        recordType;
     uint32_t        schoolSystemCode;
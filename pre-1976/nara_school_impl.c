@@ -7,7 +7,7 @@
 
 #include "nara_school.h"
 
-const char* nara_grade_labels[nara_grade_max] = {
+static const char* nara_grade_labels[nara_grade_max] = {
         "Pre-K",
         "Kindergarten",
         "First",
@@ -26,14 +26,14 @@ const char* nara_grade_labels[nara_grade_max] = {
         "Special Education"
     };
 
-const char* nara_empl_labels[nara_empl_max] = {
+static const char* nara_empl_labels[nara_empl_max] = {
         "Teacher",
         "Principal",
         "Assistant Principal",
         "Other"
     };
 
-const char* nara_section_distrib_labels[nara_section_distrib_max] = {
+static const char* nara_section_distrib_labels[nara_section_distrib_max] = {
         "0% to 19%",
         "20% to 49%",
         "50% to 79%",
@@ -57,18 +57,7 @@ typedef union {
 
 /**/
 
-int
-__nara_record_is_type_school(
-    nara_record_t*      theRecord,
-    size_t              byteSize
-)
-{
-    return ( (byteSize == 716) && (nara_be_to_host_32(theRecord->recordType) == nara_record_type_school) );
-}
-
-/**/
-
-nara_record_t*
+static nara_record_t*
 __nara_record_process_school(
     nara_record_t*      theRecord
 )
@@ -78,19 +67,13 @@ __nara_record_process_school(
     char                        *fromPtr, *toPtr;
     size_t                      fromLen, toLen;
     
-    unsigned int                i, iMax;
-    
-    iMax = sizeof(school->compact.f1) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) school->compact.f1[i] = nara_be_to_host_32(school->compact.f1[i]);
+    nara_be_to_host_u32_array(school->compact.f1, sizeof(school->compact.f1) / sizeof(uint32_t));
     
-    iMax = sizeof(school->compact.f2) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) school->compact.f2[i] = nara_be_to_host_32(school->compact.f2[i]);
+    nara_be_to_host_u32_array(school->compact.f2, sizeof(school->compact.f2) / sizeof(uint32_t));
     
-    iMax = sizeof(school->compact.f3) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) school->compact.f3[i] = nara_be_to_host_32(school->compact.f3[i]);
+    nara_be_to_host_u32_array(school->compact.f3, sizeof(school->compact.f3) / sizeof(uint32_t));
     
-    iMax = sizeof(school->compact.f4) / sizeof(uint32_t);
-    for ( i = 0; i < iMax; i ++ ) school->compact.f4[i] = nara_be_to_host_32(school->compact.f4[i]);
+    nara_be_to_host_u32_array(school->compact.f4, sizeof(school->compact.f4) / sizeof(uint32_t));
     
     TRANSCODE(school, schoolName, "school name");
     TRANSCODE(school, schoolStreetAddr, "school street address");
@@ -102,7 +85,7 @@ __nara_record_process_school(
 
 /**/
 
-void
+static void
 __nara_export_init_school(
     nara_export_context_t   exportContext
 )
@@ -122,8 +105,8 @@ __nara_export_init_school(
             /*
              * Write column headers to the file:
              */
-            if ( CONTEXT->schoolFptr ) {
-                fprintf(CONTEXT->schoolFptr,
+            if ( CONTEXT->schoolOut ) {
+                EMIT_LITERAL(CONTEXT->schoolOut,
                         "schoolSystemCode,"
                         "oeCode1970,"
                         "schoolCampusFormNumber,"
@@ -137,62 +120,64 @@ __nara_export_init_school(
                         "lowestGradeOffered,"
                         "lunchProgramOffered,"
                     );
-                    
+                
                 for ( i = 0; i < nara_grade_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"gradeOffered_%s\",", nara_grade_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"gradeOffered_", nara_grade_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"pupilCounts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"pupilCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"retainedCounts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"retainedCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"grade12Counts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"grade12Counts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"specialEdCounts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"specialEdCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( j = 0; j < nara_empl_max; j++ )
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "\"emplCounts_%s_%s\",", nara_empl_labels[j], nara_ethnicity_labels[i]);
-        
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_STR(CONTEXT->schoolOut, "\"emplCounts_", nara_empl_labels[j], "");
+                        EMIT_STR(CONTEXT->schoolOut, "_", nara_ethnicity_labels[i], "\",");
+                    }
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"grade3Counts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"grade3Counts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"grade6Counts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"grade6Counts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"grade9Counts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"grade9Counts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"lowestGradePupilCounts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"lowestGradePupilCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"newStaffCounts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"newStaffCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"participantInLunchProgramCounts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"participantInLunchProgramCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"eligibleForLunchProgramCounts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"eligibleForLunchProgramCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"receivingLunchProgramCounts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"receivingLunchProgramCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"elementaryTeacherCounts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"elementaryTeacherCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"secondaryTeacherCounts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"secondaryTeacherCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"otherTeacherCounts_%s\",", nara_ethnicity_labels[i]);
-        
+                    EMIT_STR(CONTEXT->schoolOut, "\"otherTeacherCounts_", nara_ethnicity_labels[i], "\",");
+                
                 for ( i = 0; i < nara_section_distrib_max - 1; i++ )
-                    fprintf(CONTEXT->schoolFptr, "\"numSectionsInLowestGradeCounts_%s\",", nara_section_distrib_labels[i]);
-                fprintf(CONTEXT->schoolFptr, "\"numSectionsInLowestGradeCounts_%s\"\n", nara_section_distrib_labels[i]);
+                    EMIT_STR(CONTEXT->schoolOut, "\"numSectionsInLowestGradeCounts_", nara_section_distrib_labels[i], "\",");
+                EMIT_STR(CONTEXT->schoolOut, "\"numSectionsInLowestGradeCounts_", nara_section_distrib_labels[i], "\"\n");
             }
             break;
         }
@@ -201,7 +186,7 @@ __nara_export_init_school(
 
 /**/
 
-void
+static void
 __nara_export_destroy_school(
     nara_export_context_t   exportContext
 )
@@ -210,7 +195,7 @@ __nara_export_destroy_school(
 
 /**/
 
-void
+static void
 __nara_record_export_school(
     nara_export_context_t   exportContext,
     nara_record_t           *theRecord
@@ -235,110 +220,131 @@ __nara_record_export_school(
         case nara_export_format_yaml: {
             nara_export_context_yaml_t  *CONTEXT = (nara_export_context_yaml_t*)exportContext;
             
-            if ( CONTEXT->fptr ) {
-                fprintf(CONTEXT->fptr,
-                        "- recordType: school\n"
-                        "  schoolSystemCode: %u\n"
-                        "  oeCode1970: %u\n"
-                        "  schoolCampusFormNumber: %u\n"
-                        "  pupilsBused: %u\n"
-                        "  departmentalizedEnglish: %u\n"
-                        "  schoolName: \"%s\"\n"
-                        "  schoolStreetAddr: \"%s\"\n"
-                        "  schoolCity: \"%s\"\n"
-                        "  schoolCounty: \"%s\"\n"
-                        "  schoolZipCode: %u\n"
-                        "  lowestGradeOffered: %u\n"
-                        "  lunchProgramOffered: %u\n"
-                        ,
-                        school->schoolSystemCode,
-                        school->oeCode1970,
-                        school->schoolCampusFormNumber,
-                        school->pupilsBused,
-                        school->departmentalizedEnglish,
-                        schoolName,
-                        schoolStreetAddr,
-                        schoolCity,
-                        schoolCounty,
-                        school->schoolZipCode,
-                        school->lowestGradeOffered,
-                        school->lunchProgramOffered
-                    );
-        
-                fprintf(CONTEXT->fptr, "  gradeOffered:\n");
-                for ( i = 0; i < nara_grade_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_grade_labels[i], school->gradeOffered[i]);
-        
-                fprintf(CONTEXT->fptr, "  pupilCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->pupilCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  retainedCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->retainedCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  grade12Counts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->grade12Counts[i]);
-        
-                fprintf(CONTEXT->fptr, "  specialEdCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->specialEdCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  emplCounts:\n");
+            if ( CONTEXT->out ) {
+                EMIT_LITERAL(CONTEXT->out, "- recordType: school\n");
+                EMIT_U32(CONTEXT->out, "  schoolSystemCode: ", school->schoolSystemCode, "\n");
+                EMIT_U32(CONTEXT->out, "  oeCode1970: ", school->oeCode1970, "\n");
+                EMIT_U32(CONTEXT->out, "  schoolCampusFormNumber: ", school->schoolCampusFormNumber, "\n");
+                EMIT_U32(CONTEXT->out, "  pupilsBused: ", school->pupilsBused, "\n");
+                EMIT_U32(CONTEXT->out, "  departmentalizedEnglish: ", school->departmentalizedEnglish, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  schoolName: ", schoolName, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  schoolStreetAddr: ", schoolStreetAddr, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  schoolCity: ", schoolCity, "\n");
+                EMIT_QUOTED_STR(CONTEXT->out, "  schoolCounty: ", schoolCounty, "\n");
+                EMIT_U32(CONTEXT->out, "  schoolZipCode: ", school->schoolZipCode, "\n");
+                EMIT_U32(CONTEXT->out, "  lowestGradeOffered: ", school->lowestGradeOffered, "\n");
+                EMIT_U32(CONTEXT->out, "  lunchProgramOffered: ", school->lunchProgramOffered, "\n");
+                
+                EMIT_LITERAL(CONTEXT->out, "  gradeOffered:\n");
+                for ( i = 0; i < nara_grade_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_grade_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->gradeOffered[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  pupilCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->pupilCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  retainedCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->retainedCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  grade12Counts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->grade12Counts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  specialEdCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->specialEdCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  emplCounts:\n");
                 for ( j = 0; j < nara_empl_max; j++ ) {
-                    fprintf(CONTEXT->fptr, "    \"%s\":\n", nara_empl_labels[j]);
-                    for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->fptr, "      \"%s\": %u\n", nara_ethnicity_labels[i], school->emplCounts[j][i]);
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_empl_labels[j], ":\n");
+                    for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                        EMIT_QUOTED_STR(CONTEXT->out, "      ", nara_ethnicity_labels[i], "");
+                        EMIT_U32(CONTEXT->out, ": ", school->emplCounts[j][i], "\n");
+                    }
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  grade3Counts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->grade3Counts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  grade6Counts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->grade6Counts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  grade9Counts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->grade9Counts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  lowestGradePupilCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->lowestGradePupilCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  newStaffCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->newStaffCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  participantInLunchProgramCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->participantInLunchProgramCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  eligibleForLunchProgramCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->eligibleForLunchProgramCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  receivingLunchProgramCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->receivingLunchProgramCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  elementaryTeacherCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->elementaryTeacherCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  secondaryTeacherCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->secondaryTeacherCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  otherTeacherCounts:\n");
+                for ( i = 0; i < nara_ethnicity_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_ethnicity_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->otherTeacherCounts[i], "\n");
+                }
+                
+                EMIT_LITERAL(CONTEXT->out, "  numSectionsInLowestGradeCounts:\n");
+                for ( i = 0; i < nara_section_distrib_max; i++ ) {
+                    EMIT_QUOTED_STR(CONTEXT->out, "    ", nara_section_distrib_labels[i], "");
+                    EMIT_U32(CONTEXT->out, ": ", school->numSectionsInLowestGradeCounts[i], "\n");
                 }
-        
-                fprintf(CONTEXT->fptr, "  grade3Counts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->grade3Counts[i]);
-        
-                fprintf(CONTEXT->fptr, "  grade6Counts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->grade6Counts[i]);
-        
-                fprintf(CONTEXT->fptr, "  grade9Counts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->grade9Counts[i]);
-        
-                fprintf(CONTEXT->fptr, "  lowestGradePupilCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->lowestGradePupilCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  newStaffCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->newStaffCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  participantInLunchProgramCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->participantInLunchProgramCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  eligibleForLunchProgramCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->eligibleForLunchProgramCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  receivingLunchProgramCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->receivingLunchProgramCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  elementaryTeacherCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->elementaryTeacherCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  secondaryTeacherCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->secondaryTeacherCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  otherTeacherCounts:\n");
-                for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_ethnicity_labels[i], school->otherTeacherCounts[i]);
-        
-                fprintf(CONTEXT->fptr, "  numSectionsInLowestGradeCounts:\n");
-                for ( i = 0; i < nara_section_distrib_max; i++ )
-                    fprintf(CONTEXT->fptr, "    \"%s\": %u\n", nara_section_distrib_labels[i], school->numSectionsInLowestGradeCounts[i]);
             }
             break;
         }
@@ -346,88 +352,74 @@ __nara_record_export_school(
         case nara_export_format_csv: {
             nara_export_context_csv_t   *CONTEXT = (nara_export_context_csv_t*)exportContext;
             
-            if ( CONTEXT->schoolFptr ) {
-                fprintf(CONTEXT->schoolFptr,
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "%u,"
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "\"%s\","
-                        "%u,"
-                        "%u,"
-                        "%u,",
-                        school->schoolSystemCode,
-                        school->oeCode1970,
-                        school->schoolCampusFormNumber,
-                        school->pupilsBused,
-                        school->departmentalizedEnglish,
-                        schoolName,
-                        schoolStreetAddr,
-                        schoolCity,
-                        schoolCounty,
-                        school->schoolZipCode,
-                        school->lowestGradeOffered,
-                        school->lunchProgramOffered
-                    );
+            if ( CONTEXT->schoolOut ) {
+                EMIT_U32(CONTEXT->schoolOut, "", school->schoolSystemCode, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->oeCode1970, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->schoolCampusFormNumber, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->pupilsBused, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->departmentalizedEnglish, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", schoolName, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", schoolStreetAddr, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", schoolCity, ",");
+                EMIT_QUOTED_STR(CONTEXT->schoolOut, "", schoolCounty, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->schoolZipCode, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->lowestGradeOffered, ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->lunchProgramOffered, ",");
                 for ( i = 0; i < nara_grade_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->gradeOffered[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->gradeOffered[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->pupilCounts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->pupilCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->retainedCounts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->retainedCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->grade12Counts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->grade12Counts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->specialEdCounts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->specialEdCounts[i], ",");
+                
                 for ( j = 0; j < nara_empl_max; j++ )
                     for ( i = 0; i < nara_ethnicity_max; i++ )
-                        fprintf(CONTEXT->schoolFptr, "%u,", school->emplCounts[j][i]);
-
+                        EMIT_U32(CONTEXT->schoolOut, "", school->emplCounts[j][i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->grade3Counts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->grade3Counts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->grade6Counts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->grade6Counts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->grade9Counts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->grade9Counts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->lowestGradePupilCounts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->lowestGradePupilCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->newStaffCounts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->newStaffCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->participantInLunchProgramCounts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->participantInLunchProgramCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->eligibleForLunchProgramCounts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->eligibleForLunchProgramCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->receivingLunchProgramCounts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->receivingLunchProgramCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->elementaryTeacherCounts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->elementaryTeacherCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->secondaryTeacherCounts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->secondaryTeacherCounts[i], ",");
+                
                 for ( i = 0; i < nara_ethnicity_max; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->otherTeacherCounts[i]);
-
+                    EMIT_U32(CONTEXT->schoolOut, "", school->otherTeacherCounts[i], ",");
+                
                 for ( i = 0; i < nara_section_distrib_max - 1; i++ )
-                    fprintf(CONTEXT->schoolFptr, "%u,", school->numSectionsInLowestGradeCounts[i]);
-                fprintf(CONTEXT->schoolFptr, "%u\n", school->numSectionsInLowestGradeCounts[i]);
+                    EMIT_U32(CONTEXT->schoolOut, "", school->numSectionsInLowestGradeCounts[i], ",");
+                EMIT_U32(CONTEXT->schoolOut, "", school->numSectionsInLowestGradeCounts[i], "\n");
             }
             break;
         }
@@ -436,12 +428,61 @@ __nara_record_export_school(
 
 /**/
 
-nara_record_t*
-__nara_record_destroy_school(
-    nara_record_t       *theRecord
+static void
+__nara_record_columns_school(
+    nara_record_columns_t   columns
 )
 {
-    free((void*)theRecord);
-    return NULL;
+    unsigned int            i, j;
+    
+    COLUMN_U32(columns, nara_school_t, schoolSystemCode, "schoolSystemCode");
+    COLUMN_U32(columns, nara_school_t, oeCode1970, "oeCode1970");
+    COLUMN_U32(columns, nara_school_t, schoolCampusFormNumber, "schoolCampusFormNumber");
+    COLUMN_U32(columns, nara_school_t, pupilsBused, "pupilsBused");
+    COLUMN_U32(columns, nara_school_t, departmentalizedEnglish, "departmentalizedEnglish");
+    COLUMN_STR(columns, nara_school_t, schoolName, "schoolName");
+    COLUMN_STR(columns, nara_school_t, schoolStreetAddr, "schoolStreetAddr");
+    COLUMN_STR(columns, nara_school_t, schoolCity, "schoolCity");
+    COLUMN_STR(columns, nara_school_t, schoolCounty, "schoolCounty");
+    COLUMN_U32(columns, nara_school_t, schoolZipCode, "schoolZipCode");
+    COLUMN_U32(columns, nara_school_t, lowestGradeOffered, "lowestGradeOffered");
+    COLUMN_U32(columns, nara_school_t, lunchProgramOffered, "lunchProgramOffered");
+    for ( i = 0; i < nara_grade_max; i++ )
+        COLUMN_U32(columns, nara_school_t, gradeOffered[i], "\"gradeOffered_%s\"", nara_grade_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, pupilCounts[i], "\"pupilCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, retainedCounts[i], "\"retainedCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, grade12Counts[i], "\"grade12Counts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, specialEdCounts[i], "\"specialEdCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( j = 0; j < nara_empl_max; j++ )
+        for ( i = 0; i < nara_ethnicity_max; i++ )
+            COLUMN_U32(columns, nara_school_t, emplCounts[j][i], "\"emplCounts_%s_%s\"", nara_empl_labels[j], nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, grade3Counts[i], "\"grade3Counts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, grade6Counts[i], "\"grade6Counts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, grade9Counts[i], "\"grade9Counts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, lowestGradePupilCounts[i], "\"lowestGradePupilCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, newStaffCounts[i], "\"newStaffCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, participantInLunchProgramCounts[i], "\"participantInLunchProgramCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, eligibleForLunchProgramCounts[i], "\"eligibleForLunchProgramCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, receivingLunchProgramCounts[i], "\"receivingLunchProgramCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, elementaryTeacherCounts[i], "\"elementaryTeacherCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, secondaryTeacherCounts[i], "\"secondaryTeacherCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_ethnicity_max; i++ )
+        COLUMN_U32(columns, nara_school_t, otherTeacherCounts[i], "\"otherTeacherCounts_%s\"", nara_ethnicity_labels[i]);
+    for ( i = 0; i < nara_section_distrib_max; i++ )
+        COLUMN_U32(columns, nara_school_t, numSectionsInLowestGradeCounts[i], "\"numSectionsInLowestGradeCounts_%s\"", nara_section_distrib_labels[i]);
 }
     
\ No newline at end of file
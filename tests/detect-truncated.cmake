@@ -0,0 +1,39 @@
+#
+# Format detection on a truncated archive:  a fixed-size (1976 or 1986) archive
+# cut short in the middle of a record must still be detected, and convert its
+# complete records exactly as it does with its --format given.
+#
+# Run by ctest with NARA_GEN, NARA_TO_YAML, and WORK_DIR defined.
+#
+
+FOREACH (FORMAT 1976:ebcdic 1976:ascii 1986:ebcdic 1986:ascii)
+    STRING(REPLACE ":" "-" NAME "${FORMAT}")
+    SET(INPUT "${WORK_DIR}/${NAME}.dat")
+    SET(TRUNCATED "${WORK_DIR}/${NAME}.truncated.dat")
+
+    EXECUTE_PROCESS(COMMAND "${NARA_GEN}" --format=${FORMAT} --records=50 --output=${INPUT} RESULT_VARIABLE RC)
+    IF (NOT RC EQUAL 0)
+        MESSAGE(FATAL_ERROR "nara-gen failed for ${FORMAT} (${RC})")
+    ENDIF ()
+
+    # Drop the last 100 bytes, leaving a partial record at the end:
+    FILE(READ "${INPUT}" CONTENT HEX)
+    STRING(LENGTH "${CONTENT}" HEX_LENGTH)
+    MATH(EXPR CUT_LENGTH "${HEX_LENGTH} / 2 - 100")
+    EXECUTE_PROCESS(COMMAND head -c ${CUT_LENGTH} "${INPUT}" OUTPUT_FILE "${TRUNCATED}")
+
+    EXECUTE_PROCESS(COMMAND "${NARA_TO_YAML}" --output=yaml:${WORK_DIR}/${NAME}.detected.yaml "${TRUNCATED}" RESULT_VARIABLE RC ERROR_VARIABLE ERRORS)
+    IF (ERRORS MATCHES "unable to determine the format")
+        MESSAGE(FATAL_ERROR "format of truncated ${FORMAT} archive not detected:\n${ERRORS}")
+    ENDIF ()
+    EXECUTE_PROCESS(COMMAND "${NARA_TO_YAML}" --format=${FORMAT} --output=yaml:${WORK_DIR}/${NAME}.given.yaml "${TRUNCATED}" RESULT_VARIABLE RC ERROR_QUIET)
+
+    FILE(READ "${WORK_DIR}/${NAME}.detected.yaml" DETECTED)
+    FILE(READ "${WORK_DIR}/${NAME}.given.yaml" GIVEN)
+    IF (DETECTED STREQUAL "")
+        MESSAGE(FATAL_ERROR "no records converted from truncated ${FORMAT} archive")
+    ENDIF ()
+    IF (NOT DETECTED STREQUAL GIVEN)
+        MESSAGE(FATAL_ERROR "truncated ${FORMAT} archive converted differently with its format detected")
+    ENDIF ()
+ENDFOREACH ()